@@ -0,0 +1,693 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: benchmark/bench.cpp
+ Description: cldes_bench driver: runs the registered benchmarks, writes
+ text, JSON or CSV results and compares them with a baseline.
+ =========================================================================
+*/
+
+#include "bench.hpp"
+#include "perf_counters.hpp"
+#include "cldes/MemoryHook.hpp"
+#include "cldes/OperationStats.hpp"
+#include "cldes/Trace.hpp"
+#include "cldes/backend/Executor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+namespace bench {
+
+std::vector<Case>&
+registry()
+{
+    static std::vector<Case> cases;
+    return cases;
+}
+
+void
+add(Case aCase)
+{
+    registry().push_back(std::move(aCase));
+}
+
+std::string
+caseId(Case const& aCase, unsigned const aThreads)
+{
+    std::string id = aCase.name;
+    for (auto const& param : aCase.params) {
+        id += "/" + param.first + "=" + param.second;
+    }
+    return id + "/threads=" + std::to_string(aThreads);
+}
+
+/*! \brief Report the statistics of a phase as counters
+ */
+static void
+addPhaseCounters_(cldes::PhaseStats const& aPhase, Counters& aCounters)
+{
+    auto const& name = aPhase.name;
+    aCounters[name + ".calls"] = aPhase.calls;
+    aCounters[name + ".wall_us"] =
+      std::chrono::duration<double, std::micro>(aPhase.wall).count();
+    aCounters[name + ".states_visited"] = aPhase.states_visited;
+    aCounters[name + ".transitions_examined"] = aPhase.transitions_examined;
+    aCounters[name + ".hash_probes"] = aPhase.hash_probes;
+    aCounters[name + ".hash_inserts"] = aPhase.hash_inserts;
+    aCounters[name + ".peak_table_size"] = aPhase.peak_table_size;
+    aCounters[name + ".allocated_bytes"] = aPhase.allocated_bytes;
+}
+
+Result
+measure(Case const& aCase, unsigned const aThreads, Options const& aOptions)
+{
+    // Opened before the workers are spawned, so that they inherit them
+    std::unique_ptr<PerfCounters> perf;
+    if (aOptions.perf) {
+        perf.reset(new PerfCounters{});
+        static bool warned = false;
+        if (!perf->available() && !warned) {
+            std::cerr << "hardware counters are unavailable: "
+                      << perf->error() << std::endl;
+            warned = true;
+        }
+    }
+
+    std::unique_ptr<cldes::backend::Executor> executor;
+    if (aThreads <= 1u) {
+        executor.reset(new cldes::backend::SerialExecutor{});
+    } else {
+        cldes::backend::ExecutorOptions options;
+        options.threads = aThreads - 1u;
+        executor.reset(new cldes::backend::ThreadPoolExecutor{ options });
+    }
+    cldes::backend::ScopedExecutor const scope{ *executor };
+
+    Result result;
+    result.id = caseId(aCase, aThreads);
+    result.name = aCase.name;
+    result.params = aCase.params;
+    result.weak = aCase.weak_threads > 0u;
+    result.series = result.weak
+                      ? aCase.name
+                      : result.id.substr(0ul, result.id.rfind("/threads="));
+    result.threads = aThreads;
+    result.reps = aOptions.reps;
+
+    auto body = aCase.setup();
+    for (auto i = 0u; i < aOptions.warmup; ++i) {
+        Counters discarded;
+        body(discarded);
+    }
+
+    std::vector<double> times;
+    times.reserve(aOptions.reps);
+    for (auto i = 0u; i < aOptions.reps; ++i) {
+        Counters counters;
+        // Statistics of the last repetition are reported with the counters
+        cldes::OperationStats stats;
+        std::unique_ptr<cldes::ScopedStats> stats_scope;
+        if (cldes::kStatsEnabled && i + 1u == aOptions.reps) {
+            stats_scope.reset(new cldes::ScopedStats{ stats });
+        }
+        cldes::MemoryTracker tracker;
+        if (perf) {
+            perf->start();
+        }
+        auto const t1 = std::chrono::steady_clock::now();
+        body(counters);
+        auto const t2 = std::chrono::steady_clock::now();
+        if (perf) {
+            perf->stop();
+        }
+        tracker.stop();
+        stats_scope.reset();
+        result.peak_bytes = tracker.peakBytes();
+        result.allocations = tracker.allocations();
+        times.push_back(
+          std::chrono::duration<double, std::micro>(t2 - t1).count());
+        for (auto const& phase : stats.phases()) {
+            addPhaseCounters_(phase, counters);
+        }
+        result.counters = std::move(counters);
+    }
+    if (perf) {
+        perf->report(result.counters, aOptions.reps);
+    }
+    if (times.empty()) {
+        return result;
+    }
+
+    std::sort(times.begin(), times.end());
+    auto const n = times.size();
+    result.min_us = times.front();
+    result.max_us = times.back();
+    result.median_us = n % 2ul ? times[n / 2ul]
+                               : (times[n / 2ul - 1ul] + times[n / 2ul]) / 2.0;
+    auto sum = 0.0;
+    for (auto t : times) {
+        sum += t;
+    }
+    result.mean_us = sum / n;
+    auto sq = 0.0;
+    for (auto t : times) {
+        sq += (t - result.mean_us) * (t - result.mean_us);
+    }
+    result.stddev_us = n > 1ul ? std::sqrt(sq / (n - 1ul)) : 0.0;
+
+    auto const calls = result.counters.find(kCallsCounter);
+    if (calls != result.counters.end() && calls->second > 0.0) {
+        result.counters["ns_per_call"] =
+          result.median_us * 1000.0 / calls->second;
+        result.counters["allocs_per_call"] =
+          result.allocations / calls->second;
+    }
+
+    return result;
+}
+
+/*! \brief Quote and escape a JSON string
+ */
+static std::string
+jsonString_(std::string const& aString)
+{
+    std::string quoted = "\"";
+    for (auto c : aString) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+/*! \brief Write a result as a single line JSON object
+ * \details readBaseline() relies on one benchmark per line.
+ */
+static void
+writeJson_(std::ostream& aOut, Result const& aResult)
+{
+    aOut << "{\"id\": " << jsonString_(aResult.id)
+         << ", \"name\": " << jsonString_(aResult.name) << ", \"params\": {";
+    auto sep = "";
+    for (auto const& param : aResult.params) {
+        aOut << sep << jsonString_(param.first) << ": "
+             << jsonString_(param.second);
+        sep = ", ";
+    }
+    aOut << "}, \"threads\": " << aResult.threads
+         << ", \"reps\": " << aResult.reps << ", \"min_us\": " << aResult.min_us
+         << ", \"median_us\": " << aResult.median_us
+         << ", \"mean_us\": " << aResult.mean_us
+         << ", \"stddev_us\": " << aResult.stddev_us
+         << ", \"max_us\": " << aResult.max_us
+         << ", \"peak_bytes\": " << aResult.peak_bytes
+         << ", \"allocations\": " << aResult.allocations
+         << ", \"counters\": {";
+    sep = "";
+    for (auto const& counter : aResult.counters) {
+        aOut << sep << jsonString_(counter.first) << ": " << counter.second;
+        sep = ", ";
+    }
+    aOut << "}}";
+}
+
+void
+write(std::ostream& aOut,
+      std::vector<Result> const& aResults,
+      Format const aFormat)
+{
+    auto const precision = aOut.precision(12);
+    switch (aFormat) {
+        case Format::kJson:
+            aOut << "{\"benchmarks\": [" << std::endl;
+            for (auto i = 0ul; i < aResults.size(); ++i) {
+                writeJson_(aOut, aResults[i]);
+                aOut << (i + 1ul < aResults.size() ? "," : "") << std::endl;
+            }
+            aOut << "]}" << std::endl;
+            break;
+        case Format::kCsv:
+            aOut << "id,name,threads,reps,min_us,median_us,mean_us,"
+                    "stddev_us,max_us,peak_bytes,allocations,counters"
+                 << std::endl;
+            for (auto const& result : aResults) {
+                aOut << result.id << "," << result.name << ","
+                     << result.threads << "," << result.reps << ","
+                     << result.min_us << "," << result.median_us << ","
+                     << result.mean_us << "," << result.stddev_us << ","
+                     << result.max_us << "," << result.peak_bytes << ","
+                     << result.allocations << ",";
+                auto sep = "";
+                for (auto const& counter : result.counters) {
+                    aOut << sep << counter.first << "=" << counter.second;
+                    sep = ";";
+                }
+                aOut << std::endl;
+            }
+            break;
+        case Format::kText:
+            aOut.precision(precision);
+            for (auto const& result : aResults) {
+                aOut << std::left << std::setw(64) << result.id << std::right
+                     << " median " << std::setw(12) << std::fixed
+                     << std::setprecision(1) << result.median_us
+                     << " us  min " << std::setw(12) << result.min_us
+                     << " us  sd " << std::setw(10) << result.stddev_us
+                     << " us  peak " << std::setw(10)
+                     << result.peak_bytes / 1024.0 << " KiB";
+                aOut.unsetf(std::ios::fixed);
+                aOut.precision(precision);
+                for (auto const& counter : result.counters) {
+                    aOut << "  " << counter.first << "=" << counter.second;
+                }
+                aOut << std::endl;
+            }
+            break;
+    }
+    aOut.precision(precision);
+}
+
+std::map<std::string, double>
+readBaseline(std::istream& aIn)
+{
+    std::map<std::string, double> medians;
+    std::regex const id_re{ "\"id\": \"([^\"]*)\"" };
+    std::regex const median_re{ "\"median_us\": ([-+0-9.eE]+)" };
+    std::string line;
+    while (std::getline(aIn, line)) {
+        std::smatch id;
+        std::smatch median;
+        if (std::regex_search(line, id, id_re) &&
+            std::regex_search(line, median, median_re)) {
+            medians[id[1]] = std::strtod(median[1].str().c_str(), nullptr);
+        }
+    }
+    return medians;
+}
+
+std::size_t
+compare(std::ostream& aOut,
+        std::vector<Result> const& aResults,
+        std::map<std::string, double> const& aBaseline,
+        double const aThreshold)
+{
+    auto regressions = 0ul;
+    auto const precision = aOut.precision();
+    for (auto const& result : aResults) {
+        auto const it = aBaseline.find(result.id);
+        if (it == aBaseline.end() || it->second <= 0.0) {
+            aOut << "new        " << result.id << std::endl;
+            continue;
+        }
+        auto const change = 100.0 * (result.median_us / it->second - 1.0);
+        char const* verdict = "ok        ";
+        if (change > aThreshold) {
+            verdict = "REGRESSION";
+            ++regressions;
+        } else if (change < -aThreshold) {
+            verdict = "improved  ";
+        }
+        aOut << verdict << " " << result.id << " " << std::fixed
+             << std::setprecision(1) << it->second << " -> "
+             << result.median_us << " us (" << std::showpos << change
+             << std::noshowpos << "%)" << std::endl;
+        aOut.unsetf(std::ios::fixed);
+        aOut.precision(precision);
+    }
+    return regressions;
+}
+
+std::vector<unsigned>
+scalingThreads(unsigned const aMax)
+{
+    std::vector<unsigned> threads;
+    for (auto n = 1u; n < aMax; n *= 2u) {
+        threads.push_back(n);
+    }
+    threads.push_back(std::max(1u, aMax));
+    return threads;
+}
+
+/*! \brief Karp-Flatt metric: serial fraction given speedup on aP workers
+ */
+static double
+serialFraction_(double const aSpeedup, double const aP)
+{
+    return (1.0 / aSpeedup - 1.0 / aP) / (1.0 - 1.0 / aP);
+}
+
+/*! \brief Add the strong scaling counters of aResult relative to aBase
+ */
+static void
+strongScaling_(Result const& aBase, Result& aResult)
+{
+    auto const p = static_cast<double>(aResult.threads) / aBase.threads;
+    auto const speedup = aBase.median_us / aResult.median_us;
+    aResult.counters["scaling.speedup"] = speedup;
+    aResult.counters["scaling.efficiency"] = speedup / p;
+    if (p <= 1.0) {
+        return;
+    }
+    aResult.counters["scaling.serial_fraction"] = serialFraction_(speedup, p);
+
+    std::string const suffix = ".wall_us";
+    for (auto const& counter : aBase.counters) {
+        auto const& name = counter.first;
+        if (name.size() <= suffix.size() ||
+            name.compare(name.size() - suffix.size(), suffix.size(), suffix) ||
+            counter.second <= 0.0) {
+            continue;
+        }
+        auto const it = aResult.counters.find(name);
+        if (it == aResult.counters.end() || it->second <= 0.0) {
+            continue;
+        }
+        auto const phase = name.substr(0ul, name.size() - suffix.size());
+        auto const phase_speedup = counter.second / it->second;
+        aResult.counters[phase + ".speedup"] = phase_speedup;
+        aResult.counters[phase + ".serial_fraction"] =
+          serialFraction_(phase_speedup, p);
+    }
+}
+
+/*! \brief Add the weak scaling counters of aResult relative to aBase
+ */
+static void
+weakScaling_(Result const& aBase, Result& aResult)
+{
+    aResult.counters["scaling.efficiency"] =
+      aBase.median_us / aResult.median_us;
+
+    auto const base = aBase.counters.find(kTransitionsCounter);
+    auto const work = aResult.counters.find(kTransitionsCounter);
+    if (base == aBase.counters.end() || work == aResult.counters.end() ||
+        base->second <= 0.0) {
+        return;
+    }
+    auto const p = static_cast<double>(aResult.threads) / aBase.threads;
+    aResult.counters["scaling.work_efficiency"] =
+      (work->second / aResult.median_us) /
+      (p * base->second / aBase.median_us);
+}
+
+void
+scaling(std::vector<Result>& aResults)
+{
+    std::map<std::string, Result const*> bases;
+    for (auto const& result : aResults) {
+        auto& base = bases[result.series];
+        if (!base || result.threads < base->threads) {
+            base = &result;
+        }
+    }
+
+    // Counters are added on copies: bases point to the results
+    std::vector<Result> scaled = aResults;
+    for (auto& result : scaled) {
+        auto const& base = *bases[result.series];
+        if (base.median_us <= 0.0 || result.median_us <= 0.0) {
+            continue;
+        }
+        if (result.weak) {
+            weakScaling_(base, result);
+        } else {
+            strongScaling_(base, result);
+        }
+    }
+    aResults = std::move(scaled);
+}
+
+void
+writeScaling(std::ostream& aOut, std::vector<Result> const& aResults)
+{
+    auto const precision = aOut.precision();
+    auto const value = [&aOut](Result const& aResult,
+                               std::string const& aName,
+                               int const aWidth) {
+        aOut << std::setw(aWidth);
+        auto const it = aResult.counters.find(aName);
+        if (it == aResult.counters.end()) {
+            aOut << "-";
+        } else {
+            aOut << it->second;
+        }
+    };
+    aOut << std::left << std::setw(64) << "series" << std::right
+         << " threads  speedup  efficiency  work  serial" << std::endl;
+    for (auto const& result : aResults) {
+        if (!result.counters.count("scaling.efficiency")) {
+            continue;
+        }
+        aOut << std::left << std::setw(64)
+             << (result.weak ? result.series + " (weak)" : result.series)
+             << std::right << std::fixed << std::setprecision(2)
+             << std::setw(8) << result.threads;
+        value(result, "scaling.speedup", 9);
+        value(result, "scaling.efficiency", 12);
+        value(result, "scaling.work_efficiency", 6);
+        value(result, "scaling.serial_fraction", 8);
+
+        // Phases which do not scale are the candidates for parallelization
+        std::string const suffix = ".serial_fraction";
+        for (auto const& counter : result.counters) {
+            auto const& name = counter.first;
+            if (name.size() > suffix.size() && name.find("scaling.") != 0ul &&
+                !name.compare(
+                  name.size() - suffix.size(), suffix.size(), suffix)) {
+                aOut << "  " << name.substr(0ul, name.size() - suffix.size())
+                     << "=" << counter.second;
+            }
+        }
+        aOut << std::endl;
+        aOut.unsetf(std::ios::fixed);
+        aOut.precision(precision);
+    }
+}
+
+/*! \brief Parse a comma separated list of thread counts
+ */
+static std::vector<unsigned>
+parseThreads_(std::string const& aList)
+{
+    std::vector<unsigned> threads;
+    std::istringstream in{ aList };
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        auto const n = std::strtoul(item.c_str(), nullptr, 10);
+        if (n > 0ul) {
+            threads.push_back(static_cast<unsigned>(n));
+        }
+    }
+    return threads;
+}
+
+static void
+usage_(char const* aProgram)
+{
+    std::cerr
+      << "usage: " << aProgram << " [options]" << std::endl
+      << "  --filter REGEX     run the benchmarks whose id matches" << std::endl
+      << "  --warmup N         unmeasured runs (1)" << std::endl
+      << "  --reps N           measured runs (5)" << std::endl
+      << "  --threads 1,2,...  thread counts (hardware concurrency)"
+      << std::endl
+      << "  --format F         text, json or csv (text)" << std::endl
+      << "  --output FILE      write the results to FILE" << std::endl
+      << "  --baseline FILE    compare with a previous JSON output"
+      << std::endl
+      << "  --threshold PCT    median slowdown reported as regression (10)"
+      << std::endl
+      << "  --trace FILE       write a Chrome trace of the run to FILE"
+      << std::endl
+      << "  --scaling          run on 1, 2, 4 ... N threads and the weak"
+      << std::endl
+      << "                     scaling series; N is the largest --threads"
+      << std::endl
+      << "  --no-perf          do not read the hardware counters"
+      << std::endl
+      << "  --heavy            also run the heavy benchmarks" << std::endl
+      << "  --list             print the benchmark ids" << std::endl;
+}
+
+/*! \brief Parse the command line
+ * \return false if it is invalid
+ */
+static bool
+parseOptions_(int const aArgc, char* aArgv[], Options& aOptions)
+{
+    for (auto i = 1; i < aArgc; ++i) {
+        std::string const arg = aArgv[i];
+        auto const has_value = i + 1 < aArgc;
+        if (arg == "--list") {
+            aOptions.list = true;
+        } else if (arg == "--heavy") {
+            aOptions.heavy = true;
+        } else if (arg == "--scaling") {
+            aOptions.scaling = true;
+        } else if (arg == "--no-perf") {
+            aOptions.perf = false;
+        } else if (!has_value) {
+            return false;
+        } else if (arg == "--filter") {
+            aOptions.filter = aArgv[++i];
+        } else if (arg == "--warmup") {
+            aOptions.warmup = std::strtoul(aArgv[++i], nullptr, 10);
+        } else if (arg == "--reps") {
+            aOptions.reps = std::strtoul(aArgv[++i], nullptr, 10);
+        } else if (arg == "--threads") {
+            aOptions.threads = parseThreads_(aArgv[++i]);
+        } else if (arg == "--output") {
+            aOptions.output = aArgv[++i];
+        } else if (arg == "--baseline") {
+            aOptions.baseline = aArgv[++i];
+        } else if (arg == "--trace") {
+            aOptions.trace = aArgv[++i];
+        } else if (arg == "--threshold") {
+            aOptions.threshold = std::strtod(aArgv[++i], nullptr);
+        } else if (arg == "--format") {
+            std::string const format = aArgv[++i];
+            if (format == "json") {
+                aOptions.format = Format::kJson;
+            } else if (format == "csv") {
+                aOptions.format = Format::kCsv;
+            } else if (format == "text") {
+                aOptions.format = Format::kText;
+            } else {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    if (aOptions.threads.empty()) {
+        aOptions.threads.push_back(
+          std::max(1u, std::thread::hardware_concurrency()));
+    }
+    if (aOptions.scaling) {
+        aOptions.threads = scalingThreads(*std::max_element(
+          aOptions.threads.begin(), aOptions.threads.end()));
+    }
+    return true;
+}
+} // namespace bench
+
+int
+main(int argc, char* argv[])
+{
+    bench::Options options;
+    if (!bench::parseOptions_(argc, argv, options)) {
+        bench::usage_(argv[0]);
+        return 2;
+    }
+
+    std::unique_ptr<cldes::TraceSession> trace;
+    if (!options.trace.empty() && !options.list) {
+        trace.reset(new cldes::TraceSession{});
+    }
+
+    std::regex const filter{ options.filter };
+    std::vector<bench::Result> results;
+    for (auto const& benchmark : bench::registry()) {
+        if (benchmark.heavy && !options.heavy) {
+            continue;
+        }
+        auto threads = options.threads;
+        if (benchmark.weak_threads > 0u) {
+            // Weak scaling benchmarks only run up to the largest count
+            if (!options.scaling ||
+                benchmark.weak_threads > options.threads.back()) {
+                continue;
+            }
+            threads.assign(1ul, benchmark.weak_threads);
+        } else if (!benchmark.threaded) {
+            if (options.scaling) {
+                continue;
+            }
+            threads.assign(1ul, 1u);
+        }
+        for (auto nthreads : threads) {
+            auto const id = bench::caseId(benchmark, nthreads);
+            if (!std::regex_search(id, filter)) {
+                continue;
+            }
+            if (options.list) {
+                std::cout << id << std::endl;
+                continue;
+            }
+            std::cerr << "running " << id << std::endl;
+            results.push_back(bench::measure(benchmark, nthreads, options));
+        }
+    }
+    if (options.list) {
+        return 0;
+    }
+    if (trace) {
+        trace->stop();
+        if (!trace->write(options.trace)) {
+            std::cerr << "cannot write " << options.trace << std::endl;
+            return 2;
+        }
+    }
+
+    if (options.scaling) {
+        bench::scaling(results);
+        bench::writeScaling(std::cerr, results);
+    }
+
+    if (options.output.empty()) {
+        bench::write(std::cout, results, options.format);
+    } else {
+        std::ofstream out{ options.output };
+        bench::write(out, results, options.format);
+    }
+
+    if (!options.baseline.empty()) {
+        std::ifstream in{ options.baseline };
+        if (!in) {
+            std::cerr << "cannot read " << options.baseline << std::endl;
+            return 2;
+        }
+        auto const baseline = bench::readBaseline(in);
+        auto const regressions =
+          bench::compare(std::cerr, results, baseline, options.threshold);
+        if (regressions > 0ul) {
+            std::cerr << regressions << " regression(s) above "
+                      << options.threshold << "%" << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
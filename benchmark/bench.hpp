@@ -0,0 +1,303 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: benchmark/bench.hpp
+ Description: Registry, measurement and reporting of the cldes_bench
+ benchmark suite.
+ =========================================================================
+*/
+
+#ifndef CLDES_BENCH_HPP
+#define CLDES_BENCH_HPP
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+/*! \brief Parameters of a benchmark, in the order they are printed
+ */
+using Params = std::vector<std::pair<std::string, std::string>>;
+
+/*! \brief Named values reported by a benchmark next to its timings
+ * \details e.g. number of states of the result. Values of the last
+ * repetition are reported.
+ */
+using Counters = std::map<std::string, double>;
+
+/*! \brief Counter of the transitions handled by a repetition
+ * \details Bodies which set it get the hardware misses per transition.
+ */
+char const* const kTransitionsCounter = "transitions";
+
+/*! \brief Counter of the calls made by a repetition
+ * \details Bodies which set it get ns_per_call and allocs_per_call, from the
+ * median time and the allocations of the last repetition.
+ */
+char const* const kCallsCounter = "calls";
+
+/*! \brief Measured body of a benchmark: one call per repetition
+ */
+using Body = std::function<void(Counters&)>;
+
+/*! \brief Builds the inputs of a benchmark and returns its body
+ * \details Runs once per thread count, out of the measured time, under the
+ * executor of the measurement.
+ */
+using Setup = std::function<Body()>;
+
+/*! \brief Registered benchmark
+ */
+struct Case
+{
+    /*! \brief Model and operation, e.g. "clustertool/supC"
+     */
+    std::string name;
+
+    /*! \brief Size and type parameters, e.g. {{"n", "3"}, {"NEvents", "40"}}
+     */
+    Params params;
+
+    /*! \brief Inputs builder
+     */
+    Setup setup;
+
+    /*! \brief Run once per thread count of the options
+     * \details Otherwise, it runs only on a single thread.
+     */
+    bool threaded = true;
+
+    /*! \brief Only run when --heavy is given
+     */
+    bool heavy = false;
+
+    /*! \brief Thread count of a weak scaling benchmark
+     * \details If not 0, the benchmark belongs to the weak scaling series
+     * of its name, whose size grows with the thread count, and runs only
+     * with --scaling, on this number of threads.
+     */
+    unsigned weak_threads = 0u;
+};
+
+/*! \brief All registered benchmarks, in registration order
+ */
+std::vector<Case>&
+registry();
+
+/*! \brief Register a benchmark
+ */
+void
+add(Case aCase);
+
+/*! \brief Registers benchmarks during static initialization
+ * \details Each registration unit defines one static Registrar whose
+ * function calls add().
+ */
+struct Registrar
+{
+    explicit Registrar(std::function<void()> const& aRegister)
+    {
+        aRegister();
+    }
+};
+
+/*! \brief Output format of the results
+ */
+enum class Format
+{
+    kText,
+    kJson,
+    kCsv
+};
+
+/*! \brief Command line options of cldes_bench
+ */
+struct Options
+{
+    /*! \brief Regular expression matched against the benchmark ids
+     */
+    std::string filter;
+
+    /*! \brief Unmeasured runs before the repetitions
+     */
+    unsigned warmup = 1u;
+
+    /*! \brief Measured runs
+     */
+    unsigned reps = 5u;
+
+    /*! \brief Thread counts of the threaded benchmarks
+     * \details 1 runs on a SerialExecutor. Empty means the hardware
+     * concurrency.
+     */
+    std::vector<unsigned> threads;
+
+    Format format = Format::kText;
+
+    /*! \brief File of the results: standard output when it is empty
+     */
+    std::string output;
+
+    /*! \brief Results of a previous run, in JSON, to compare with
+     */
+    std::string baseline;
+
+    /*! \brief File of the Chrome trace of the whole run, if not empty
+     */
+    std::string trace;
+
+    /*! \brief Median slowdown, in percent, reported as a regression
+     */
+    double threshold = 10.0;
+
+    /*! \brief Read the hardware counters around the repetitions
+     */
+    bool perf = true;
+
+    /*! \brief Run the scaling series
+     * \details Threaded benchmarks run on 1, 2, 4 ... N threads, N being
+     * the largest thread count of the options, and the weak scaling
+     * benchmarks run too.
+     */
+    bool scaling = false;
+
+    /*! \brief Print the benchmark ids and exit
+     */
+    bool list = false;
+
+    /*! \brief Run the heavy benchmarks too
+     */
+    bool heavy = false;
+};
+
+/*! \brief Timings of a benchmark on a thread count, in microseconds
+ */
+struct Result
+{
+    std::string id;
+    std::string name;
+    Params params;
+
+    /*! \brief Results of a series only differ by their thread count
+     */
+    std::string series;
+
+    /*! \brief Is the series a weak scaling one
+     */
+    bool weak = false;
+
+    unsigned threads = 1u;
+    unsigned reps = 0u;
+    double min_us = 0.0;
+    double median_us = 0.0;
+    double mean_us = 0.0;
+    double stddev_us = 0.0;
+    double max_us = 0.0;
+
+    /*! \brief Peak memory allocated by the last repetition
+     * \details 0 when the allocation hook is not installed.
+     */
+    uint64_t peak_bytes = 0ul;
+
+    /*! \brief Number of allocations of the last repetition
+     */
+    uint64_t allocations = 0ul;
+
+    /*! \brief Counters of the last repetition
+     * \details hw.* counters are the mean of the repetitions.
+     */
+    Counters counters;
+};
+
+/*! \brief Unique name of a benchmark run
+ * \details name/param=value/.../threads=N: the key of baseline files.
+ */
+std::string
+caseId(Case const& aCase, unsigned const aThreads);
+
+/*! \brief Run the warm-up and the repetitions of a benchmark
+ */
+Result
+measure(Case const& aCase, unsigned const aThreads, Options const& aOptions);
+
+/*! \brief Write results in the given format
+ */
+void
+write(std::ostream& aOut,
+      std::vector<Result> const& aResults,
+      Format const aFormat);
+
+/*! \brief Read the median of each benchmark id of a JSON results file
+ */
+std::map<std::string, double>
+readBaseline(std::istream& aIn);
+
+/*! \brief Print the median change of each result present on the baseline
+ * \return Number of regressions above aThreshold percent
+ */
+std::size_t
+compare(std::ostream& aOut,
+        std::vector<Result> const& aResults,
+        std::map<std::string, double> const& aBaseline,
+        double const aThreshold);
+
+/*! \brief Thread counts of the scaling series: 1, 2, 4 ... and aMax
+ */
+std::vector<unsigned>
+scalingThreads(unsigned const aMax);
+
+/*! \brief Add the scaling counters of each series to its results
+ * \details Compares each result with the one of fewest threads of its
+ * series. Strong scaling series get scaling.speedup, scaling.efficiency
+ * and the Karp-Flatt scaling.serial_fraction, and phases reported by the
+ * operation statistics get <phase>.speedup and <phase>.serial_fraction.
+ * Weak scaling series get scaling.efficiency and, if the benchmark counts
+ * its transitions, scaling.work_efficiency: the transitions per second
+ * per thread relative to the base.
+ */
+void
+scaling(std::vector<Result>& aResults);
+
+/*! \brief Print the scaling counters as a table, one line per result
+ */
+void
+writeScaling(std::ostream& aOut, std::vector<Result> const& aResults);
+
+/*! \brief Name of the StorageIndex type of a benchmark parameter
+ */
+template<typename StorageIndex>
+inline char const*
+indexName()
+{
+    return sizeof(StorageIndex) == 8u ? "u64" : "u32";
+}
+} // namespace bench
+
+#endif // CLDES_BENCH_HPP
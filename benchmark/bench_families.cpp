@@ -0,0 +1,121 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: benchmark/bench_families.cpp
+ Description: cldes_bench registration of the standard benchmark models of
+ the supervisory control literature.
+ =========================================================================
+*/
+
+#include "families.hpp"
+#include "models.hpp"
+
+namespace {
+
+using System = cldes::DESystem<32, unsigned>;
+using Systems = cldes::DESVector<32, unsigned>;
+
+void
+addFamily(std::string const& aName,
+          bench::Params const& aParams,
+          bench::Model<32, unsigned>::Generator const& aGenerate,
+          bool const aHeavy = false)
+{
+    bench::addModel<32, unsigned>(aName, aParams, aGenerate, aHeavy);
+}
+
+bench::Registrar const families{ []() {
+    for (auto n : { 2ul, 4ul, 8ul }) {
+        addFamily("transferline",
+                  { { "n", std::to_string(n) }, { "capacity", "2" } },
+                  [n](Systems& aPlants,
+                      Systems& aSpecs,
+                      System::EventsTable& aNonContr) {
+                      TransferLine(n, 2ul, aPlants, aSpecs, aNonContr);
+                  },
+                  n > 4ul);
+    }
+
+    for (auto n : { 3ul, 5ul, 7ul }) {
+        addFamily("agv",
+                  { { "n", std::to_string(n) } },
+                  [n](Systems& aPlants,
+                      Systems& aSpecs,
+                      System::EventsTable& aNonContr) {
+                      Agv(n, aPlants, aSpecs, aNonContr);
+                  },
+                  n > 5ul);
+    }
+
+    for (auto n : { 3ul, 5ul, 7ul }) {
+        addFamily("philosophers",
+                  { { "n", std::to_string(n) } },
+                  [n](Systems& aPlants,
+                      Systems& aSpecs,
+                      System::EventsTable& aNonContr) {
+                      DiningPhilosophers(n, aPlants, aSpecs, aNonContr);
+                  },
+                  n > 5ul);
+    }
+
+    for (auto size : { std::make_pair(5ul, 1ul),
+                       std::make_pair(9ul, 1ul),
+                       std::make_pair(5ul, 2ul) }) {
+        auto const rooms = size.first;
+        auto const pairs = size.second;
+        addFamily("catmouse",
+                  { { "rooms", std::to_string(rooms) },
+                    { "pairs", std::to_string(pairs) } },
+                  [rooms, pairs](Systems& aPlants,
+                                 Systems& aSpecs,
+                                 System::EventsTable& aNonContr) {
+                      CatAndMouse(rooms, pairs, aPlants, aSpecs, aNonContr);
+                  },
+                  pairs > 1ul);
+    }
+
+    for (auto n : { 2ul, 4ul, 6ul }) {
+        addFamily("manufacturingcell",
+                  { { "n", std::to_string(n) } },
+                  [n](Systems& aPlants,
+                      Systems& aSpecs,
+                      System::EventsTable& aNonContr) {
+                      ManufacturingCell(n, aPlants, aSpecs, aNonContr);
+                  },
+                  n > 4ul);
+    }
+
+    for (auto n : { 1ul, 2ul, 3ul }) {
+        addFamily("bigfactory",
+                  { { "n", std::to_string(n) } },
+                  [n](Systems& aPlants,
+                      Systems& aSpecs,
+                      System::EventsTable& aNonContr) {
+                      BigFactory(n, aPlants, aSpecs, aNonContr);
+                  },
+                  n > 2ul);
+    }
+} };
+} // namespace
@@ -0,0 +1,83 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: benchmark/bench_models.cpp
+ Description: cldes_bench registration of the ClusterTool and FSM models.
+ =========================================================================
+*/
+
+#include "clustertool.hpp"
+#include "fsm.hpp"
+#include "models.hpp"
+
+namespace {
+
+template<uint8_t NEvents, typename StorageIndex>
+void
+addClusterTool(unsigned long const aNClusters,
+               bool const aHeavy = false,
+               unsigned const aWeakThreads = 0u)
+{
+    bench::addModel<NEvents, StorageIndex>(
+      aWeakThreads ? "clustertool_weak" : "clustertool",
+      { { "n", std::to_string(aNClusters) } },
+      [aNClusters](cldes::DESVector<NEvents, StorageIndex>& aPlants,
+                   cldes::DESVector<NEvents, StorageIndex>& aSpecs,
+                   spp::sparse_hash_set<uint8_t>& aNonContr) {
+          ClusterTool<NEvents, StorageIndex>(
+            aNClusters, aPlants, aSpecs, aNonContr);
+      },
+      aHeavy,
+      aWeakThreads);
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+void
+addFsm()
+{
+    bench::addModel<NEvents, StorageIndex>(
+      "fsm", {}, &Fsm<NEvents, StorageIndex>);
+}
+
+bench::Registrar const models{ []() {
+    // Sizes of the former benchmark_clustertool* programs
+    for (auto n = 2ul; n <= 5ul; ++n) {
+        addClusterTool<40, unsigned>(n);
+    }
+    addClusterTool<56, unsigned>(6ul, true);
+    addClusterTool<56, unsigned>(7ul, true);
+    addFsm<32, unsigned>();
+
+    // Wider events sets and states indexes on the same models
+    addClusterTool<64, unsigned long>(3ul);
+    addClusterTool<64, unsigned long>(4ul);
+    addFsm<64, unsigned long>();
+
+    // Weak scaling: one cluster per thread, on the events set of the largest
+    for (auto n = 1u; n <= 7u; ++n) {
+        addClusterTool<56, unsigned>(n, n > 5u, n);
+    }
+} };
+} // namespace
@@ -0,0 +1,390 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: benchmark/bench_primitives.cpp
+ Description: cldes_bench registration of the per-query primitives of the
+ concrete, proxy and type erased systems.
+ =========================================================================
+*/
+
+#include "clustertool.hpp"
+#include "cldes/GenericSystem.hpp"
+#include "models.hpp"
+#include "random.hpp"
+#include <algorithm>
+#include <type_traits>
+
+namespace {
+
+/*! \brief Query of a primitive: a state and an event
+ */
+template<typename StorageIndex>
+using Query = std::pair<StorageIndex, uint8_t>;
+
+/*! \brief Minimum number of calls of a repetition
+ * \details The queries are repeated until they reach it, so a call costs
+ * more than the clock resolution on the smallest systems.
+ */
+unsigned long const kMinCalls = 1ul << 20ul;
+
+/*! \brief Maximum number of states whose queries are collected
+ */
+unsigned long const kMaxQueryStates = 1ul << 16ul;
+
+/*! \brief Seed of the random access pattern
+ */
+uint64_t const kQuerySeed = 0x9c1d5eedul;
+
+/*! \brief Results of the queries, so they are not optimized out
+ */
+uint64_t volatile sink_ = 0ul;
+
+enum class Primitive
+{
+    kTrans,
+    kContainsTrans,
+    kInvTrans,
+    kStateEvents,
+    kInvStateEvents
+};
+
+char const*
+primitiveName(Primitive const aPrimitive)
+{
+    switch (aPrimitive) {
+        case Primitive::kTrans:
+            return "trans";
+        case Primitive::kContainsTrans:
+            return "containstrans";
+        case Primitive::kInvTrans:
+            return "invtrans";
+        case Primitive::kStateEvents:
+            return "getStateEvents";
+        default:
+            return "getInvStateEvents";
+    }
+}
+
+/*! \brief Systems whose primitives are measured, on the same model
+ * \details Each system allocates its inverted graph. Proxies keep
+ * references to the concrete systems, so the fixture is never moved.
+ */
+template<uint8_t NEvents, typename StorageIndex>
+struct Fixture
+{
+    using System = cldes::DESystem<NEvents, StorageIndex>;
+    using Sync = cldes::op::SyncSysProxy<System, System>;
+    using Super = cldes::op::SuperProxy<System, System>;
+    using Generic = cldes::GenericSystem<NEvents, StorageIndex>;
+
+    /*! \brief Synchronized plants
+     */
+    System plant;
+
+    /*! \brief Synchronized specs
+     */
+    System spec;
+
+    /*! \brief Synchronized halves of the plants
+     */
+    std::pair<System, System> halves;
+
+    /*! \brief Virtual composition of the halves of the plants
+     */
+    std::unique_ptr<Sync> sync;
+
+    /*! \brief Supervisor of the synchronized plants and specs
+     */
+    std::unique_ptr<Super> super;
+
+    /*! \brief Type erased copy of the synchronized plants
+     */
+    std::unique_ptr<Generic> generic;
+};
+
+template<uint8_t NEvents, typename StorageIndex>
+std::shared_ptr<Fixture<NEvents, StorageIndex> const>
+makeFixture(unsigned long const aNClusters)
+{
+    using FixtureT = Fixture<NEvents, StorageIndex>;
+
+    auto const model =
+      bench::makeModel<NEvents, StorageIndex>(
+        [aNClusters](cldes::DESVector<NEvents, StorageIndex>& aPlants,
+                     cldes::DESVector<NEvents, StorageIndex>& aSpecs,
+                     spp::sparse_hash_set<uint8_t>& aNonContr) {
+            ClusterTool<NEvents, StorageIndex>(
+              aNClusters, aPlants, aSpecs, aNonContr);
+        });
+    auto fixture = std::make_shared<FixtureT>(
+      FixtureT{ model->plant,
+                model->spec,
+                bench::composeHalves(model->plants),
+                nullptr,
+                nullptr,
+                nullptr });
+    fixture->sync.reset(new typename FixtureT::Sync{ fixture->halves.first,
+                                                     fixture->halves.second });
+    fixture->super.reset(new typename FixtureT::Super{
+      fixture->plant, fixture->spec, model->non_contr });
+    fixture->generic.reset(new typename FixtureT::Generic{ fixture->plant });
+
+    fixture->plant.allocateInvertedGraph();
+    fixture->spec.allocateInvertedGraph();
+    fixture->halves.first.allocateInvertedGraph();
+    fixture->halves.second.allocateInvertedGraph();
+    fixture->generic->allocateInvertedGraph();
+    return fixture;
+}
+
+/*! \brief Queries of the states accessible from the initial state
+ * \details Each state is queried on the events of its transitions, or of
+ * its inverse transitions when aInverse is set. The sequential pattern
+ * sorts them by state, which follows the graph storage of the concrete
+ * systems; the random pattern shuffles them.
+ */
+template<class SysT, typename StorageIndex>
+std::vector<Query<StorageIndex>>
+makeQueries(SysT const& aSys, bool const aInverse, bool const aRandom)
+{
+    std::vector<StorageIndex> states{ aSys.getInitialState() };
+    spp::sparse_hash_set<StorageIndex> visited{ states.front() };
+    for (auto i = 0ul; i < states.size() && states.size() < kMaxQueryStates;
+         ++i) {
+        auto const q = states[i];
+        cldes::forEachEvent(aSys.getStateEvents(q), [&](uint8_t const aE) {
+            auto const next = aSys.trans(q, aE);
+            if (next >= 0 &&
+                visited.insert(static_cast<StorageIndex>(next)).second) {
+                states.push_back(static_cast<StorageIndex>(next));
+            }
+        });
+    }
+
+    std::vector<Query<StorageIndex>> queries;
+    for (auto q : states) {
+        auto const events =
+          aInverse ? aSys.getInvStateEvents(q) : aSys.getStateEvents(q);
+        cldes::forEachEvent(
+          events, [&](uint8_t const aE) { queries.emplace_back(q, aE); });
+    }
+    if (aRandom) {
+        // Fisher-Yates on the portable generator of the random automata
+        RandomStream_ random{ kQuerySeed };
+        for (auto i = queries.size(); i > 1ul; --i) {
+            std::swap(queries[i - 1ul], queries[random.below(i)]);
+        }
+    } else {
+        std::sort(queries.begin(), queries.end());
+    }
+    return queries;
+}
+
+/*! \brief Call aQuery on every query until at least kMinCalls calls
+ */
+template<typename StorageIndex, class Function>
+void
+runQueries(std::vector<Query<StorageIndex>> const& aQueries,
+           Function&& aQuery,
+           bench::Counters& aCounters)
+{
+    if (aQueries.empty()) {
+        return;
+    }
+    auto const rounds = (kMinCalls + aQueries.size() - 1ul) / aQueries.size();
+    uint64_t sum = 0ul;
+    for (auto r = 0ul; r < rounds; ++r) {
+        for (auto const& query : aQueries) {
+            sum += aQuery(query.first, query.second);
+        }
+    }
+    sink_ = sink_ + sum;
+    aCounters[bench::kCallsCounter] = rounds * aQueries.size();
+    aCounters["queries"] = aQueries.size();
+}
+
+/*! \brief Body measuring aPrimitive of aSys
+ * \details aSys must outlive the body.
+ */
+template<class SysT, typename StorageIndex>
+bench::Body
+primitiveBody(SysT const& aSys,
+              Primitive const aPrimitive,
+              std::vector<Query<StorageIndex>> aQueries)
+{
+    using Index = StorageIndex;
+    auto const queries =
+      std::make_shared<std::vector<Query<Index>> const>(std::move(aQueries));
+    auto const* sys = &aSys;
+    switch (aPrimitive) {
+        case Primitive::kTrans:
+            return [sys, queries](bench::Counters& aCounters) {
+                runQueries(*queries,
+                           [sys](Index const aQ, uint8_t const aE) {
+                               return static_cast<uint64_t>(
+                                 sys->trans(aQ, aE));
+                           },
+                           aCounters);
+            };
+        case Primitive::kContainsTrans:
+            return [sys, queries](bench::Counters& aCounters) {
+                runQueries(*queries,
+                           [sys](Index const aQ, uint8_t const aE) {
+                               return static_cast<uint64_t>(
+                                 sys->containstrans(aQ, aE));
+                           },
+                           aCounters);
+            };
+        case Primitive::kInvTrans:
+            return [sys, queries](bench::Counters& aCounters) {
+                runQueries(*queries,
+                           [sys](Index const aQ, uint8_t const aE) {
+                               return static_cast<uint64_t>(
+                                 sys->invtrans(aQ, aE).size());
+                           },
+                           aCounters);
+            };
+        case Primitive::kStateEvents:
+            return [sys, queries](bench::Counters& aCounters) {
+                runQueries(*queries,
+                           [sys](Index const aQ, uint8_t) {
+                               return static_cast<uint64_t>(
+                                 sys->getStateEvents(aQ).count());
+                           },
+                           aCounters);
+            };
+        default:
+            return [sys, queries](bench::Counters& aCounters) {
+                runQueries(*queries,
+                           [sys](Index const aQ, uint8_t) {
+                               return static_cast<uint64_t>(
+                                 sys->getInvStateEvents(aQ).count());
+                           },
+                           aCounters);
+            };
+    }
+}
+
+/*! \brief Register the primitives of a system of the fixture
+ * @param aSystem Name of the system
+ * @param aGet Returns the system of a fixture
+ */
+template<uint8_t NEvents, typename StorageIndex, class Get>
+void
+addSystem(std::string const& aSystem,
+          bench::Params const& aParams,
+          std::function<std::shared_ptr<Fixture<NEvents, StorageIndex> const>()>
+            const& aFixture,
+          Get const aGet)
+{
+    Primitive const primitives[] = { Primitive::kTrans,
+                                     Primitive::kContainsTrans,
+                                     Primitive::kInvTrans,
+                                     Primitive::kStateEvents,
+                                     Primitive::kInvStateEvents };
+    for (auto primitive : primitives) {
+        for (auto random : { false, true }) {
+            bench::Case c;
+            c.name = "primitive/" + aSystem + "/" + primitiveName(primitive);
+            c.params = aParams;
+            c.params.emplace_back("access", random ? "random" : "sequential");
+            c.threaded = false;
+            c.setup = [aFixture, aGet, primitive, random]() -> bench::Body {
+                auto const fixture = aFixture();
+                auto const& sys = aGet(*fixture);
+                using SysT = std::decay_t<decltype(sys)>;
+                auto const inverse = primitive == Primitive::kInvTrans ||
+                                     primitive == Primitive::kInvStateEvents;
+                auto queries =
+                  makeQueries<SysT, StorageIndex>(sys, inverse, random);
+                auto const body = primitiveBody<SysT, StorageIndex>(
+                  sys, primitive, std::move(queries));
+                // The body keeps the fixture of its system alive
+                return [fixture, body](bench::Counters& aCounters) {
+                    body(aCounters);
+                };
+            };
+            bench::add(c);
+        }
+    }
+}
+
+/*! \brief Primitives of the systems of a ClusterTool model
+ * \details DESystem: synchronized plants; SyncSysProxy: composition of
+ * their halves; SuperProxy: supervisor of the synchronized plants and
+ * specs; GenericSystem: type erased synchronized plants.
+ */
+template<uint8_t NEvents, typename StorageIndex>
+void
+addPrimitives(unsigned long const aNClusters)
+{
+    using FixtureT = Fixture<NEvents, StorageIndex>;
+    using FixturePtr = std::shared_ptr<FixtureT const>;
+
+    bench::Params const params{
+        { "n", std::to_string(aNClusters) },
+        { "NEvents", std::to_string(NEvents) },
+        { "StorageIndex", bench::indexName<StorageIndex>() }
+    };
+
+    auto cache = std::make_shared<FixturePtr>();
+    std::function<FixturePtr()> const fixture = [cache, aNClusters]() {
+        if (!*cache) {
+            *cache = makeFixture<NEvents, StorageIndex>(aNClusters);
+        }
+        return *cache;
+    };
+
+    addSystem<NEvents, StorageIndex>(
+      "DESystem", params, fixture, [](FixtureT const& aFixture) -> auto const& {
+          return aFixture.plant;
+      });
+    addSystem<NEvents, StorageIndex>(
+      "SyncSysProxy",
+      params,
+      fixture,
+      [](FixtureT const& aFixture) -> auto const& { return *aFixture.sync; });
+    addSystem<NEvents, StorageIndex>(
+      "SuperProxy",
+      params,
+      fixture,
+      [](FixtureT const& aFixture) -> auto const& { return *aFixture.super; });
+    addSystem<NEvents, StorageIndex>(
+      "GenericSystem",
+      params,
+      fixture,
+      [](FixtureT const& aFixture) -> auto const& {
+          return *aFixture.generic;
+      });
+}
+
+bench::Registrar const primitives{ []() {
+    // Graph sizes, on a single word events set and on a two words one
+    addPrimitives<40, unsigned>(3ul);
+    addPrimitives<40, unsigned>(5ul);
+    addPrimitives<128, unsigned>(3ul);
+    addPrimitives<128, unsigned>(5ul);
+} };
+} // namespace
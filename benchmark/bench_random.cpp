@@ -0,0 +1,209 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: benchmark/bench_random.cpp
+ Description: cldes_bench registration of the random automata: generator
+ throughput and operations on random families of plants and specs.
+ =========================================================================
+*/
+
+#include "models.hpp"
+#include "random.hpp"
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+std::string
+number(double const aValue)
+{
+    std::ostringstream out;
+    out << aValue;
+    return out.str();
+}
+
+bench::Params
+shapeParams(RandomSpec const& aSpec)
+{
+    char const* distributions[] = { "fixed", "uniform", "geometric" };
+    return { { "states", std::to_string(aSpec.states) },
+             { "events", std::to_string(aSpec.events) },
+             { "degree", number(aSpec.degree) },
+             { "distribution",
+               distributions[static_cast<int>(aSpec.distribution)] },
+             { "marked", number(aSpec.marked) },
+             { "seed", std::to_string(aSpec.seed) } };
+}
+
+/*! \brief Operations on a random family of plants and specs
+ * \details The generator throws if the supervisor of the family is empty:
+ * synthesis on such a family stops at the first pass and measures nothing
+ * of interest.
+ */
+template<uint8_t NEvents, typename StorageIndex>
+void
+addFamily(RandomSpec const& aSpec,
+          unsigned const aNPlants,
+          unsigned const aNSpecs,
+          double const aShared,
+          bool const aHeavy = false)
+{
+    auto params = shapeParams(aSpec);
+    params.insert(params.begin(),
+                  { { "plants", std::to_string(aNPlants) },
+                    { "specs", std::to_string(aNSpecs) },
+                    { "shared", number(aShared) } });
+    bench::addModel<NEvents, StorageIndex>(
+      "random",
+      params,
+      [=](cldes::DESVector<NEvents, StorageIndex>& aPlants,
+          cldes::DESVector<NEvents, StorageIndex>& aSpecs,
+          spp::sparse_hash_set<uint8_t>& aNonContr) {
+          RandomFamily<NEvents, StorageIndex>(
+            aSpec, aNPlants, aNSpecs, aShared, aPlants, aSpecs, aNonContr);
+          auto const supervisor =
+            cldes::op::supC(bench::composeLazy(aPlants),
+                            bench::composeLazy(aSpecs),
+                            aNonContr)
+              .materialize();
+          if (supervisor.size() == 0ul) {
+              throw std::runtime_error("random: Empty supervisor");
+          }
+      },
+      aHeavy);
+}
+
+/*! \brief Generation and searches on a single random automaton
+ * \details Synthesis assumes deterministic systems, so nondeterministic
+ * automata are measured on the searches only.
+ */
+template<uint8_t NEvents, typename StorageIndex>
+void
+addAutomaton(RandomSpec const& aSpec, bool const aHeavy = false)
+{
+    using System = cldes::DESystem<NEvents, StorageIndex>;
+
+    auto params = shapeParams(aSpec);
+    params.emplace_back("NEvents", std::to_string(NEvents));
+    params.emplace_back("StorageIndex", bench::indexName<StorageIndex>());
+    std::string const name =
+      aSpec.deterministic ? "random_automaton" : "random_automaton_nd";
+
+    bench::Case generate;
+    generate.name = name + "/generate";
+    generate.params = params;
+    generate.heavy = aHeavy;
+    generate.setup = [aSpec]() -> bench::Body {
+        return [aSpec](bench::Counters& aCounters) {
+            auto const sys = RandomSystem<NEvents, StorageIndex>(aSpec);
+            aCounters[bench::kTransitionsCounter] = sys.getGraph().nonZeros();
+            aCounters["memory_bytes"] = sys.memoryUsage().total();
+        };
+    };
+    bench::add(generate);
+
+    bench::Case accessible;
+    accessible.name = name + "/accessiblePart";
+    accessible.params = params;
+    accessible.heavy = aHeavy;
+    accessible.setup = [aSpec]() -> bench::Body {
+        auto const sys = std::make_shared<System const>(
+          RandomSystem<NEvents, StorageIndex>(aSpec));
+        return [sys](bench::Counters& aCounters) {
+            aCounters["accessible_states"] = sys->accessiblePart().size();
+            aCounters[bench::kTransitionsCounter] =
+              sys->getGraph().nonZeros();
+        };
+    };
+    bench::add(accessible);
+
+    bench::Case trim;
+    trim.name = name + "/trim";
+    trim.params = params;
+    trim.heavy = aHeavy;
+    trim.setup = [aSpec]() -> bench::Body {
+        auto const sys = std::make_shared<System const>(
+          RandomSystem<NEvents, StorageIndex>(aSpec));
+        return [sys](bench::Counters& aCounters) {
+            System trimmed{ *sys };
+            trimmed.trim();
+            aCounters["trim_states"] = trimmed.size();
+            aCounters[bench::kTransitionsCounter] =
+              sys->getGraph().nonZeros();
+        };
+    };
+    bench::add(trim);
+}
+
+bench::Registrar const random_models{ []() {
+    // Most random families block: the seeds are chosen so that the
+    // supervisor of each family is neither empty nor the whole product
+    RandomSpec spec;
+    spec.states = 10ul;
+    spec.events = 6u;
+    spec.degree = 3.0;
+    spec.marked = 0.7;
+    spec.seed = 8ul;
+
+    // Coupling between the components
+    for (auto shared : { 0.25, 0.5, 0.75 }) {
+        addFamily<32, unsigned>(spec, 3u, 2u, shared);
+    }
+
+    // Dense alphabets
+    auto dense = spec;
+    dense.states = 8ul;
+    dense.events = 16u;
+    dense.degree = 8.0;
+    dense.seed = 6ul;
+    addFamily<64, unsigned>(dense, 3u, 2u, 0.25);
+
+    // Long chains
+    auto chain = spec;
+    chain.states = 64ul;
+    chain.degree = 1.0;
+    chain.distribution = DegreeDistribution::kFixed;
+    addFamily<32, unsigned>(chain, 2u, 1u, 0.5);
+
+    // Many marked states
+    auto marked = spec;
+    marked.marked = 0.9;
+    addFamily<32, unsigned>(marked, 3u, 2u, 0.5);
+
+    // Large single automata, built in parallel
+    RandomSpec large;
+    large.states = 100000ul;
+    large.events = 16u;
+    large.degree = 3.0;
+    large.distribution = DegreeDistribution::kGeometric;
+    addAutomaton<32, unsigned>(large);
+    large.deterministic = false;
+    addAutomaton<32, unsigned>(large);
+
+    large.states = 2000000ul;
+    large.deterministic = true;
+    addAutomaton<32, unsigned>(large, true);
+} };
+} // namespace
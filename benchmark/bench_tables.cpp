@@ -0,0 +1,307 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: benchmark/bench_tables.cpp
+ Description: cldes_bench registration of the visited states tables and of
+ the NUMA placement of the systems.
+ =========================================================================
+*/
+
+#include "cldes/ConcurrentStatesTable.hpp"
+#include "cldes/backend/Executor.hpp"
+#include "cldes/backend/Numa.hpp"
+#include "clustertool.hpp"
+#include "models.hpp"
+#include <memory>
+#include <mutex>
+#include <sparsepp/spp.h>
+#include <vector>
+
+namespace {
+
+/*! \brief Inserts of a visited table benchmark
+ * \details Half of the inserts find the state already visited.
+ */
+std::size_t const kTableInserts = 1ul << 22;
+
+/*! \brief Visited table of the inserts
+ */
+enum class VisitedTable
+{
+    kSparsepp,      //!< sparsepp, on a single thread
+    kSparseppMutex, //!< sparsepp behind a mutex
+    kConcurrent,    //!< ConcurrentStatesTable, growing from its default size
+    kReserved,      //!< ConcurrentStatesTable reserved for all states
+};
+
+char const*
+tableName(VisitedTable const aTable)
+{
+    switch (aTable) {
+        case VisitedTable::kSparsepp:
+            return "sparsepp";
+        case VisitedTable::kSparseppMutex:
+            return "sparsepp_mutex";
+        case VisitedTable::kConcurrent:
+            return "concurrent";
+        case VisitedTable::kReserved:
+            return "concurrent_reserved";
+    }
+    return "unknown";
+}
+
+/*! \brief Insert the keys on a visited table
+ * \return Number of states on the table
+ */
+std::size_t
+insertKeys(VisitedTable const aTable, std::vector<unsigned> const& aKeys)
+{
+    auto& executor = cldes::backend::currentExecutor();
+    switch (aTable) {
+        case VisitedTable::kSparsepp: {
+            spp::sparse_hash_set<unsigned> table;
+            for (auto const key : aKeys) {
+                table.insert(key);
+            }
+            return table.size();
+        }
+        case VisitedTable::kSparseppMutex: {
+            spp::sparse_hash_set<unsigned> table;
+            std::mutex table_mutex;
+            executor.parallelFor(
+              0ul,
+              aKeys.size(),
+              [&](std::size_t const aBegin, std::size_t const aEnd, unsigned) {
+                  for (auto i = aBegin; i < aEnd; ++i) {
+                      std::lock_guard<std::mutex> lock{ table_mutex };
+                      table.insert(aKeys[i]);
+                  }
+              },
+              4096ul);
+            return table.size();
+        }
+        case VisitedTable::kConcurrent:
+        case VisitedTable::kReserved: {
+            cldes::ConcurrentStatesTable<unsigned> table{
+                aTable == VisitedTable::kReserved ? aKeys.size() / 2ul
+                                                  : 1024ul
+            };
+            executor.parallelFor(
+              0ul,
+              aKeys.size(),
+              [&](std::size_t const aBegin, std::size_t const aEnd, unsigned) {
+                  for (auto i = aBegin; i < aEnd; ++i) {
+                      table.insert(aKeys[i]);
+                  }
+              },
+              4096ul);
+            return table.size();
+        }
+    }
+    return 0ul;
+}
+
+/*! \brief Inserts on the visited tables of the parallel explorations
+ */
+void
+addVisitedTables()
+{
+    for (auto const table : { VisitedTable::kSparsepp,
+                              VisitedTable::kSparseppMutex,
+                              VisitedTable::kConcurrent,
+                              VisitedTable::kReserved }) {
+        bench::Case c;
+        c.name = "visited_table/insert";
+        c.params = { { "table", tableName(table) },
+                     { "inserts", std::to_string(kTableInserts) } };
+        c.threaded = table != VisitedTable::kSparsepp;
+        c.setup = [table]() -> bench::Body {
+            auto keys = std::make_shared<std::vector<unsigned>>(kTableInserts);
+            for (auto i = 0ul; i < kTableInserts; ++i) {
+                (*keys)[i] = static_cast<unsigned>(cldes::hashState_(i) %
+                                                   (kTableInserts / 2ul));
+            }
+            return [table, keys](bench::Counters& aCounters) {
+                aCounters["states"] = insertKeys(table, *keys);
+                aCounters[bench::kCallsCounter] = keys->size();
+            };
+        };
+        bench::add(c);
+    }
+}
+
+/*! \brief Level synchronous breadth-first search on the rows of aGraph
+ * \details Each level reads the rows of the frontier: the loop is bound
+ * by the memory bandwidth of the graph and of the visited table.
+ */
+template<class Graph>
+std::size_t
+reachability(Graph const& aGraph, cldes::backend::NumaPolicy const aPolicy)
+{
+    using StorageIndex = typename Graph::StorageIndex;
+
+    auto& executor = cldes::backend::currentExecutor();
+    auto const nstates = static_cast<std::size_t>(aGraph.rows());
+    cldes::ConcurrentStatesTable<StorageIndex> visited{ nstates };
+    visited.setNumaPolicy(aPolicy);
+
+    std::vector<std::vector<StorageIndex>> next(executor.concurrency());
+    std::vector<StorageIndex> frontier{ 0u };
+    visited.insert(0u);
+    while (!frontier.empty()) {
+        executor.parallelFor(
+          0ul,
+          frontier.size(),
+          [&](std::size_t const aBegin,
+              std::size_t const aEnd,
+              unsigned const aWorker) {
+              for (auto i = aBegin; i < aEnd; ++i) {
+                  for (typename Graph::InnerIterator e(aGraph, frontier[i]); e;
+                       ++e) {
+                      auto const q = static_cast<StorageIndex>(e.col());
+                      if (visited.insert(q)) {
+                          next[aWorker].push_back(q);
+                      }
+                  }
+              }
+          },
+          64ul);
+        frontier.clear();
+        for (auto& states : next) {
+            frontier.insert(frontier.end(), states.begin(), states.end());
+            states.clear();
+        }
+    }
+    return visited.size();
+}
+
+char const*
+policyName(cldes::backend::NumaPolicy const aPolicy)
+{
+    switch (aPolicy) {
+        case cldes::backend::NumaPolicy::kDefault:
+            return "default";
+        case cldes::backend::NumaPolicy::kInterleave:
+            return "interleave";
+        case cldes::backend::NumaPolicy::kPartitioned:
+            return "partitioned";
+    }
+    return "unknown";
+}
+
+/*! \brief Reachability and supC() on a ClusterTool placed on the NUMA nodes
+ * \details Registers numa/reachability and numa/supC for each policy. With
+ * a policy other than the default, the benchmark runs on a NUMA aware pool
+ * of the same size as the executor of the measurement. On a single node
+ * host, placement falls back to the default.
+ */
+template<uint8_t NEvents, typename StorageIndex>
+void
+addNuma(unsigned long const aNClusters)
+{
+    using ModelT = bench::Model<NEvents, StorageIndex>;
+    using ModelPtr = std::shared_ptr<ModelT const>;
+    using System = typename ModelT::System;
+    using Graph = typename System::GraphHostData;
+    using cldes::backend::NumaPolicy;
+
+    auto cache = std::make_shared<ModelPtr>();
+    auto model = [cache, aNClusters]() {
+        if (!*cache) {
+            *cache = bench::makeModel<NEvents, StorageIndex>(
+              [aNClusters](cldes::DESVector<NEvents, StorageIndex>& aPlants,
+                           cldes::DESVector<NEvents, StorageIndex>& aSpecs,
+                           spp::sparse_hash_set<uint8_t>& aNonContr) {
+                  ClusterTool<NEvents, StorageIndex>(
+                    aNClusters, aPlants, aSpecs, aNonContr);
+              });
+        }
+        return *cache;
+    };
+
+    // Pool of the measurement, NUMA aware unless the policy is the default
+    auto const pool = [](NumaPolicy const aPolicy) {
+        cldes::backend::ExecutorOptions options;
+        options.threads = cldes::backend::currentExecutor().concurrency() - 1u;
+        options.numa = aPolicy != NumaPolicy::kDefault;
+        return std::make_shared<cldes::backend::ThreadPoolExecutor>(options);
+    };
+
+    for (auto const policy : { NumaPolicy::kDefault,
+                               NumaPolicy::kInterleave,
+                               NumaPolicy::kPartitioned }) {
+        bench::Params const params{
+            { "n", std::to_string(aNClusters) },
+            { "policy", policyName(policy) },
+            { "NEvents", std::to_string(NEvents) },
+            { "StorageIndex", bench::indexName<StorageIndex>() }
+        };
+
+        bench::Case reach;
+        reach.name = "numa/reachability";
+        reach.params = params;
+        reach.setup = [model, pool, policy]() -> bench::Body {
+            auto const m = model();
+            auto const executor = pool(policy);
+            // The copy is first touched by this thread: placement moves it
+            auto const graph = std::make_shared<Graph>(m->plant.getGraph());
+            cldes::backend::numaPlaceRows(*graph, policy);
+            return [executor, graph, policy](bench::Counters& aCounters) {
+                cldes::backend::ScopedExecutor const scope{ *executor };
+                aCounters["accessible_states"] = reachability(*graph, policy);
+                aCounters[bench::kTransitionsCounter] = graph->nonZeros();
+            };
+        };
+        bench::add(reach);
+
+        bench::Case supc;
+        supc.name = "numa/supC";
+        supc.params = params;
+        supc.setup = [model, pool, policy]() -> bench::Body {
+            auto const m = model();
+            auto const executor = pool(policy);
+            auto const plant = std::make_shared<System>(m->plant);
+            auto const spec = std::make_shared<System>(m->spec);
+            plant->placeMemory(policy);
+            spec->placeMemory(policy);
+            return [m, executor, plant, spec](bench::Counters& aCounters) {
+                cldes::backend::ScopedExecutor const scope{ *executor };
+                auto const supervisor =
+                  cldes::op::supC(*plant, *spec, m->non_contr);
+                aCounters["supervisor_states"] = supervisor.size();
+                aCounters[bench::kTransitionsCounter] =
+                  supervisor.getGraph().nonZeros();
+            };
+        };
+        bench::add(supc);
+    }
+}
+
+bench::Registrar const tables{ []() {
+    addVisitedTables();
+    // Size of the former benchmark_numa program
+    addNuma<40, unsigned>(5ul);
+} };
+} // namespace
@@ -0,0 +1,451 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: benchmark/families.hpp
+ Description: Scalable benchmark models of the supervisory control
+ literature: transfer line, AGVs, dining philosophers, cat and mouse,
+ manufacturing cell and big factory.
+ =========================================================================
+*/
+
+#ifndef CLDES_BENCH_FAMILIES_HPP
+#define CLDES_BENCH_FAMILIES_HPP
+
+#include "cldes/DESystem.hpp"
+#include <initializer_list>
+#include <sparsepp/spp.h>
+#include <stdexcept>
+#include <vector>
+
+/*! \brief Machine idle -aStart-> working -aFinish-> idle
+ */
+template<uint8_t NEvents, typename StorageIndex>
+cldes::DESystem<NEvents, StorageIndex>
+Machine_(unsigned long const aStart, unsigned long const aFinish)
+{
+    std::set<StorageIndex> marked_states;
+    marked_states.emplace(0);
+
+    cldes::DESystem<NEvents, StorageIndex> m{ 2, 0, marked_states };
+    m(0, 1) = aStart;
+    m(1, 0) = aFinish;
+
+    return m;
+}
+
+/*! \brief Machine which breaks down while working
+ * \details idle -aStart-> working -aFinish-> idle, working -aBreak-> down
+ * -aRepair-> idle
+ */
+template<uint8_t NEvents, typename StorageIndex>
+cldes::DESystem<NEvents, StorageIndex>
+BreakingMachine_(unsigned long const aStart,
+                 unsigned long const aFinish,
+                 unsigned long const aBreak,
+                 unsigned long const aRepair)
+{
+    std::set<StorageIndex> marked_states;
+    marked_states.emplace(0);
+
+    cldes::DESystem<NEvents, StorageIndex> m{ 3, 0, marked_states };
+    m(0, 1) = aStart;
+    m(1, 0) = aFinish;
+    m(1, 2) = aBreak;
+    m(2, 0) = aRepair;
+
+    return m;
+}
+
+/*! \brief Buffer of aCapacity slots, empty when marked
+ * \details Events of aPut add a part, events of aTake remove one: the spec
+ * forbids overflow and underflow. With one slot, it is also the mutual
+ * exclusion spec of a shared resource.
+ */
+template<uint8_t NEvents, typename StorageIndex>
+cldes::DESystem<NEvents, StorageIndex>
+Buffer_(unsigned long const aCapacity,
+        std::initializer_list<unsigned long> const aPut,
+        std::initializer_list<unsigned long> const aTake)
+{
+    std::set<StorageIndex> marked_states;
+    marked_states.emplace(0);
+
+    cldes::DESystem<NEvents, StorageIndex> b{
+        static_cast<StorageIndex>(aCapacity + 1ul), 0, marked_states
+    };
+    for (auto k = 0ul; k < aCapacity; ++k) {
+        for (auto e : aPut) {
+            b(k, k + 1ul) = e;
+        }
+        for (auto e : aTake) {
+            b(k + 1ul, k) = e;
+        }
+    }
+
+    return b;
+}
+
+/*! \brief Transfer line of aNMachines machines and a test unit
+ * \details Machine M_i takes a part from buffer B_{i-1} (a_i = 2i) and
+ * puts it on B_i (b_i = 2i + 1). The test unit TU takes parts from the last
+ * buffer (t), and either accepts (p) or returns them to B_1 (f). Finishing
+ * and test results are non-controllable. Buffers B_1, ..., B_{n-1} and the
+ * last one have aCapacity slots. Events: 2 * aNMachines + 3.
+ */
+template<uint8_t NEvents, typename StorageIndex = unsigned>
+void
+TransferLine(unsigned long const& aNMachines,
+             unsigned long const& aCapacity,
+             cldes::DESVector<NEvents, StorageIndex>& aPlants,
+             cldes::DESVector<NEvents, StorageIndex>& aSpecs,
+             spp::sparse_hash_set<uint8_t>& non_contr)
+{
+    auto const t = 2ul * aNMachines;
+    auto const p = t + 1ul;
+    auto const f = t + 2ul;
+    if (aPlants.size() != 0 || aSpecs.size() != 0 || non_contr.size() ||
+        aNMachines < 2ul || aCapacity == 0ul || f >= NEvents) {
+        throw std::runtime_error("TransferLine: Invalid inputs");
+    }
+
+    for (auto i = 0ul; i < aNMachines; ++i) {
+        aPlants.push_back(
+          Machine_<NEvents, StorageIndex>(2ul * i, 2ul * i + 1ul));
+        non_contr.insert(2ul * i + 1ul);
+    }
+
+    std::set<StorageIndex> marked_states;
+    marked_states.emplace(0);
+
+    cldes::DESystem<NEvents, StorageIndex> tu{ 2, 0, marked_states };
+    tu(0, 1) = t;
+    tu(1, 0) = p;
+    tu(1, 0) = f;
+    aPlants.push_back(tu);
+    non_contr.insert(p);
+    non_contr.insert(f);
+
+    // B_1 also receives the rejected parts
+    aSpecs.push_back(
+      Buffer_<NEvents, StorageIndex>(aCapacity, { 1ul, f }, { 2ul }));
+    for (auto i = 1ul; i + 1ul < aNMachines; ++i) {
+        aSpecs.push_back(Buffer_<NEvents, StorageIndex>(
+          aCapacity, { 2ul * i + 1ul }, { 2ul * i + 2ul }));
+    }
+    aSpecs.push_back(Buffer_<NEvents, StorageIndex>(
+      aCapacity, { 2ul * aNMachines - 1ul }, { t }));
+
+    return;
+}
+
+/*! \brief Ring of aNAgvs AGVs sharing zones
+ * \details AGV i enters zone i (3i), moves to zone i + 1 mod n (3i + 1)
+ * and leaves it (3i + 2, non-controllable). Each zone holds one AGV at a
+ * time. Events: 3 * aNAgvs.
+ */
+template<uint8_t NEvents, typename StorageIndex = unsigned>
+void
+Agv(unsigned long const& aNAgvs,
+    cldes::DESVector<NEvents, StorageIndex>& aPlants,
+    cldes::DESVector<NEvents, StorageIndex>& aSpecs,
+    spp::sparse_hash_set<uint8_t>& non_contr)
+{
+    if (aPlants.size() != 0 || aSpecs.size() != 0 || non_contr.size() ||
+        aNAgvs < 2ul || 3ul * aNAgvs > NEvents) {
+        throw std::runtime_error("Agv: Invalid inputs");
+    }
+
+    std::set<StorageIndex> marked_states;
+    marked_states.emplace(0);
+
+    for (auto i = 0ul; i < aNAgvs; ++i) {
+        auto const istart = 3ul * i;
+
+        cldes::DESystem<NEvents, StorageIndex> agv_i{ 3, 0, marked_states };
+        agv_i(0, 1) = istart;       // enter zone i
+        agv_i(1, 2) = istart + 1ul; // move to zone i + 1
+        agv_i(2, 0) = istart + 2ul; // leave zone i + 1
+
+        non_contr.insert(istart + 2ul);
+
+        aPlants.push_back(agv_i);
+    }
+
+    // Zone z is entered by AGV z and, moving, by AGV z - 1
+    for (auto z = 0ul; z < aNAgvs; ++z) {
+        auto const prev = 3ul * ((z + aNAgvs - 1ul) % aNAgvs);
+        aSpecs.push_back(Buffer_<NEvents, StorageIndex>(
+          1ul, { 3ul * z, prev + 1ul }, { 3ul * z + 1ul, prev + 2ul }));
+    }
+
+    return;
+}
+
+/*! \brief aNPhilosophers dining philosophers
+ * \details Philosopher i takes its left fork (3i), then its right fork
+ * (3i + 1), and puts both back when it finishes eating (3i + 2,
+ * non-controllable). Fork i is the left fork of philosopher i and the
+ * right fork of philosopher i - 1. Events: 3 * aNPhilosophers.
+ */
+template<uint8_t NEvents, typename StorageIndex = unsigned>
+void
+DiningPhilosophers(unsigned long const& aNPhilosophers,
+                   cldes::DESVector<NEvents, StorageIndex>& aPlants,
+                   cldes::DESVector<NEvents, StorageIndex>& aSpecs,
+                   spp::sparse_hash_set<uint8_t>& non_contr)
+{
+    if (aPlants.size() != 0 || aSpecs.size() != 0 || non_contr.size() ||
+        aNPhilosophers < 2ul || 3ul * aNPhilosophers > NEvents) {
+        throw std::runtime_error("DiningPhilosophers: Invalid inputs");
+    }
+
+    std::set<StorageIndex> marked_states;
+    marked_states.emplace(0);
+
+    for (auto i = 0ul; i < aNPhilosophers; ++i) {
+        auto const istart = 3ul * i;
+
+        cldes::DESystem<NEvents, StorageIndex> p_i{ 3, 0, marked_states };
+        p_i(0, 1) = istart;       // take left fork
+        p_i(1, 2) = istart + 1ul; // take right fork
+        p_i(2, 0) = istart + 2ul; // put both forks
+
+        non_contr.insert(istart + 2ul);
+
+        aPlants.push_back(p_i);
+    }
+
+    for (auto i = 0ul; i < aNPhilosophers; ++i) {
+        auto const prev = 3ul * ((i + aNPhilosophers - 1ul) % aNPhilosophers);
+        aSpecs.push_back(Buffer_<NEvents, StorageIndex>(
+          1ul, { 3ul * i, prev + 1ul }, { 3ul * i + 2ul, prev + 2ul }));
+    }
+
+    return;
+}
+
+/*! \brief Cats and mice in a ring of aNRooms rooms
+ * \details Door r connects room r to room r + 1 mod aNRooms. Cat j only
+ * crosses doors clockwise (3 * aNRooms * j + r), while mouse j crosses them
+ * clockwise (3 * aNRooms * j + aNRooms + r) and back
+ * (3 * aNRooms * j + 2 * aNRooms + r). The cats door out of room 0 is
+ * non-controllable. Cats start in room 0 and mice in room aNRooms / 2,
+ * where they are marked. Specs keep each cat and each mouse apart.
+ * Events: 3 * aNRooms * aNPairs.
+ */
+template<uint8_t NEvents, typename StorageIndex = unsigned>
+void
+CatAndMouse(unsigned long const& aNRooms,
+            unsigned long const& aNPairs,
+            cldes::DESVector<NEvents, StorageIndex>& aPlants,
+            cldes::DESVector<NEvents, StorageIndex>& aSpecs,
+            spp::sparse_hash_set<uint8_t>& non_contr)
+{
+    if (aPlants.size() != 0 || aSpecs.size() != 0 || non_contr.size() ||
+        aNRooms < 3ul || aNPairs == 0ul ||
+        3ul * aNRooms * aNPairs > NEvents) {
+        throw std::runtime_error("CatAndMouse: Invalid inputs");
+    }
+
+    auto const n = aNRooms;
+    auto const mouse_room = n / 2ul;
+    auto const cat = [n](unsigned long aJ, unsigned long aDoor) {
+        return 3ul * n * aJ + aDoor;
+    };
+    auto const mouse_cw = [n](unsigned long aJ, unsigned long aDoor) {
+        return 3ul * n * aJ + n + aDoor;
+    };
+    auto const mouse_ccw = [n](unsigned long aJ, unsigned long aDoor) {
+        return 3ul * n * aJ + 2ul * n + aDoor;
+    };
+
+    // Mice states are rooms relative to their initial room, so that all
+    // systems start in state 0
+    auto const mouse_state = [n, mouse_room](unsigned long aRoom) {
+        return (aRoom + n - mouse_room) % n;
+    };
+
+    std::set<StorageIndex> marked_states;
+    marked_states.emplace(0);
+
+    for (auto j = 0ul; j < aNPairs; ++j) {
+        cldes::DESystem<NEvents, StorageIndex> c_j{
+            static_cast<StorageIndex>(n), 0, marked_states
+        };
+        cldes::DESystem<NEvents, StorageIndex> m_j{
+            static_cast<StorageIndex>(n), 0, marked_states
+        };
+        for (auto r = 0ul; r < n; ++r) {
+            auto const next = (r + 1ul) % n;
+            c_j(r, next) = cat(j, r);
+            m_j(mouse_state(r), mouse_state(next)) = mouse_cw(j, r);
+            m_j(mouse_state(next), mouse_state(r)) = mouse_ccw(j, r);
+        }
+        non_contr.insert(cat(j, 0ul));
+
+        aPlants.push_back(c_j);
+        aPlants.push_back(m_j);
+    }
+
+    // State of the position (cat room c, mouse room m):
+    // c + mouse_state(m) * n. States where they meet have no transitions.
+    auto const position = [n, &mouse_state](unsigned long aC,
+                                            unsigned long aM) {
+        return aC + mouse_state(aM) * n;
+    };
+    for (auto jc = 0ul; jc < aNPairs; ++jc) {
+        for (auto jm = 0ul; jm < aNPairs; ++jm) {
+            cldes::DESystem<NEvents, StorageIndex> e{
+                static_cast<StorageIndex>(n * n), 0, marked_states
+            };
+            for (auto c = 0ul; c < n; ++c) {
+                for (auto m = 0ul; m < n; ++m) {
+                    if (c == m) {
+                        continue;
+                    }
+                    auto const q = position(c, m);
+                    auto const c_next = (c + 1ul) % n;
+                    auto const m_next = (m + 1ul) % n;
+                    auto const m_prev = (m + n - 1ul) % n;
+                    if (c_next != m) {
+                        e(q, position(c_next, m)) = cat(jc, c);
+                    }
+                    if (m_next != c) {
+                        e(q, position(c, m_next)) = mouse_cw(jm, m);
+                    }
+                    if (m_prev != c) {
+                        e(q, position(c, m_prev)) = mouse_ccw(jm, m_prev);
+                    }
+                }
+            }
+            aSpecs.push_back(e);
+        }
+    }
+
+    return;
+}
+
+/*! \brief Manufacturing cell of aNMachines machines in series
+ * \details Machine M_i starts (4i), finishes (4i + 1), breaks down while
+ * working (4i + 2) and is repaired (4i + 3): finishing and breaking down
+ * are non-controllable. Buffers of one slot connect consecutive machines,
+ * and M_{i+1} has repair priority over M_i. Events: 4 * aNMachines.
+ */
+template<uint8_t NEvents, typename StorageIndex = unsigned>
+void
+ManufacturingCell(unsigned long const& aNMachines,
+                  cldes::DESVector<NEvents, StorageIndex>& aPlants,
+                  cldes::DESVector<NEvents, StorageIndex>& aSpecs,
+                  spp::sparse_hash_set<uint8_t>& non_contr)
+{
+    if (aPlants.size() != 0 || aSpecs.size() != 0 || non_contr.size() ||
+        aNMachines < 2ul || 4ul * aNMachines > NEvents) {
+        throw std::runtime_error("ManufacturingCell: Invalid inputs");
+    }
+
+    std::set<StorageIndex> marked_states;
+    marked_states.emplace(0);
+
+    for (auto i = 0ul; i < aNMachines; ++i) {
+        auto const istart = 4ul * i;
+        aPlants.push_back(BreakingMachine_<NEvents, StorageIndex>(
+          istart, istart + 1ul, istart + 2ul, istart + 3ul));
+        non_contr.insert(istart + 1ul);
+        non_contr.insert(istart + 2ul);
+    }
+
+    for (auto i = 0ul; i + 1ul < aNMachines; ++i) {
+        auto const istart = 4ul * i;
+        auto const next = istart + 4ul;
+
+        aSpecs.push_back(
+          Buffer_<NEvents, StorageIndex>(1ul, { istart + 1ul }, { next }));
+
+        // Repair priority: M_i is not repaired while M_{i+1} is down
+        cldes::DESystem<NEvents, StorageIndex> r_i{ 2, 0, marked_states };
+        r_i(0, 0) = istart + 3ul;
+        r_i(0, 1) = next + 2ul;
+        r_i(1, 0) = next + 3ul;
+        aSpecs.push_back(r_i);
+    }
+
+    return;
+}
+
+/*! \brief aNLines two machines lines feeding an assembly machine
+ * \details Line k has machines M_{k,1} (4k, 4k + 1) and M_{k,2} (4k + 2,
+ * 4k + 3) with a buffer of one slot between them. All lines put parts on
+ * a shared buffer of aNLines slots, read by the assembly machine, which
+ * starts (4n), finishes (4n + 1), breaks down (4n + 2) and is repaired
+ * (4n + 3). Finishing and breaking down are non-controllable.
+ * Events: 4 * aNLines + 4.
+ */
+template<uint8_t NEvents, typename StorageIndex = unsigned>
+void
+BigFactory(unsigned long const& aNLines,
+           cldes::DESVector<NEvents, StorageIndex>& aPlants,
+           cldes::DESVector<NEvents, StorageIndex>& aSpecs,
+           spp::sparse_hash_set<uint8_t>& non_contr)
+{
+    auto const assembly = 4ul * aNLines;
+    if (aPlants.size() != 0 || aSpecs.size() != 0 || non_contr.size() ||
+        aNLines == 0ul || assembly + 4ul > NEvents) {
+        throw std::runtime_error("BigFactory: Invalid inputs");
+    }
+
+    for (auto k = 0ul; k < aNLines; ++k) {
+        auto const istart = 4ul * k;
+        aPlants.push_back(
+          Machine_<NEvents, StorageIndex>(istart, istart + 1ul));
+        aPlants.push_back(
+          Machine_<NEvents, StorageIndex>(istart + 2ul, istart + 3ul));
+        non_contr.insert(istart + 1ul);
+        non_contr.insert(istart + 3ul);
+
+        aSpecs.push_back(Buffer_<NEvents, StorageIndex>(
+          1ul, { istart + 1ul }, { istart + 2ul }));
+    }
+    aPlants.push_back(BreakingMachine_<NEvents, StorageIndex>(
+      assembly, assembly + 1ul, assembly + 2ul, assembly + 3ul));
+    non_contr.insert(assembly + 1ul);
+    non_contr.insert(assembly + 2ul);
+
+    std::set<StorageIndex> marked_states;
+    marked_states.emplace(0);
+    cldes::DESystem<NEvents, StorageIndex> b{
+        static_cast<StorageIndex>(aNLines + 1ul), 0, marked_states
+    };
+    for (auto s = 0ul; s < aNLines; ++s) {
+        for (auto k = 0ul; k < aNLines; ++k) {
+            b(s, s + 1ul) = 4ul * k + 3ul;
+        }
+        b(s + 1ul, s) = assembly;
+    }
+    aSpecs.push_back(b);
+
+    return;
+}
+
+#endif // CLDES_BENCH_FAMILIES_HPP
@@ -23,59 +23,57 @@
  LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
  Universidade Federal de Minas Gerais
 
- File: test/kernels.hpp
- Description: Test cldes::op::synchronize function, the parallel
- composition implementation.
+ File: benchmark/fsm.hpp
+ Description: Flexible manufacturing system: plants, specs and
+ non-controllable events of the FSM benchmark.
  =========================================================================
 */
 
 #include "cldes/DESystem.hpp"
-#include "cldes/operations/Operations.hpp"
-#include "testlib.hpp"
-#include <chrono>
-#include <cstdlib>
+#include <sparsepp/spp.h>
 #include <vector>
 
-using namespace std::chrono;
-
-int
-main()
+template<uint8_t NEvents, typename StorageIndex = unsigned>
+void
+Fsm(cldes::DESVector<NEvents, StorageIndex>& aPlants,
+    cldes::DESVector<NEvents, StorageIndex>& aSpecs,
+    spp::sparse_hash_set<uint8_t>& non_contr)
 {
-    using StorageIndex = unsigned;
+    if (aPlants.size() != 0 || aSpecs.size() != 0 || non_contr.size() ||
+        NEvents < 32) {
+        throw std::runtime_error("Fsm: Invalid inputs");
+    }
+
+    using System = cldes::DESystem<NEvents, StorageIndex>;
 
     std::set<StorageIndex> marked_states;
     marked_states.emplace(0);
 
-    cldes::DESystem<4>::EventsTable non_contr;
-
-    std::cout << "Generating Plants" << std::endl;
-    std::cout << std::endl;
-
-    cldes::DESystem<32> c_1{ 2, 0, marked_states };
+    System c_1{ 2, 0, marked_states };
     c_1(0, 1) = 0ul;
     c_1(1, 0) = 1ul;
 
     non_contr.insert(1ul);
 
-    cldes::DESystem<32> c_2{ 2, 0, marked_states };
+    System c_2{ 2, 0, marked_states };
     c_2(0, 1) = 3ul;
     c_2(1, 0) = 4ul;
 
     non_contr.insert(4ul);
 
-    cldes::DESystem<32> milling{ 2, 0, marked_states };
+    System milling{ 2, 0, marked_states };
     milling(0, 1) = 5ul;
     milling(1, 0) = 6ul;
 
     non_contr.insert(6ul);
 
-    cldes::DESystem<32> mp{ 2, 0, marked_states };
+    System mp{ 2, 0, marked_states };
     mp(0, 1) = 7ul;
     mp(1, 0) = 8ul;
 
     non_contr.insert(8ul);
 
-    cldes::DESystem<32> lathe{ 3, 0, marked_states };
+    System lathe{ 3, 0, marked_states };
     lathe(0, 1) = 9ul;
     lathe(1, 0) = 10ul;
     lathe(0, 2) = 11ul;
@@ -84,7 +82,7 @@ main()
     non_contr.insert(10ul);
     non_contr.insert(12ul);
 
-    cldes::DESystem<32> c_3{ 3, 0, marked_states };
+    System c_3{ 3, 0, marked_states };
     c_3(0, 1) = 13ul;
     c_3(1, 0) = 14ul;
     c_3(0, 2) = 15ul;
@@ -93,7 +91,7 @@ main()
     non_contr.insert(14ul);
     non_contr.insert(16ul);
 
-    cldes::DESystem<32> robot{ 6, 0, marked_states };
+    System robot{ 6, 0, marked_states };
     robot(0, 1) = 17ul;
     robot(1, 0) = 18ul;
     robot(0, 2) = 19ul;
@@ -111,7 +109,7 @@ main()
     non_contr.insert(24ul);
     non_contr.insert(26ul);
 
-    cldes::DESystem<32> mm{ 4, 0, marked_states };
+    System mm{ 4, 0, marked_states };
     mm(0, 1) = 27ul;
     mm(1, 2) = 28ul;
     mm(1, 3) = 29ul;
@@ -121,23 +119,21 @@ main()
     non_contr.insert(30ul);
     non_contr.insert(31ul);
 
-    std::cout << "Generating Specs" << std::endl;
-
-    cldes::DESystem<32> e_1{ 2, 0, marked_states };
+    System e_1{ 2, 0, marked_states };
     e_1(0, 1) = 1ul;
     e_1(1, 0) = 17ul;
 
-    cldes::DESystem<32> e_2{ 2, 0, marked_states };
+    System e_2{ 2, 0, marked_states };
     e_2(0, 1) = 4ul;
     e_2(1, 0) = 19ul;
 
-    cldes::DESystem<32> e_3{ 3, 0, marked_states };
+    System e_3{ 3, 0, marked_states };
     e_3(0, 1) = 18ul;
     e_3(1, 0) = 5ul;
     e_3(0, 2) = 6ul;
     e_3(2, 0) = 21ul;
 
-    cldes::DESystem<32> e_4{ 4, 0, marked_states };
+    System e_4{ 4, 0, marked_states };
     e_4(0, 1) = 20ul;
     e_4(1, 0) = 9ul;
     e_4(1, 0) = 11ul;
@@ -146,45 +142,28 @@ main()
     e_4(0, 3) = 12ul;
     e_4(3, 0) = 25ul;
 
-    cldes::DESystem<32> e_5{ 2, 0, marked_states };
+    System e_5{ 2, 0, marked_states };
     e_5(0, 1) = 22ul;
     e_5(1, 0) = 27ul;
 
-    cldes::DESystem<32> e_6{ 2, 0, marked_states };
+    System e_6{ 2, 0, marked_states };
     e_6(0, 1) = 24ul;
     e_6(1, 0) = 28ul;
 
-    cldes::DESystem<32> e_7{ 3, 0, marked_states };
+    System e_7{ 3, 0, marked_states };
     e_7(0, 1) = 26ul;
     e_7(1, 0) = 13ul;
     e_7(0, 2) = 16ul;
     e_7(2, 0) = 29ul;
 
-    cldes::DESystem<32> e_8{ 3, 0, marked_states };
+    System e_8{ 3, 0, marked_states };
     e_8(0, 1) = 14ul;
     e_8(1, 0) = 7ul;
     e_8(0, 2) = 8ul;
     e_8(2, 0) = 15ul;
 
-    cldes::DESVector<32, uint32_t> plants = { c_1, c_2,   milling, lathe,
-                                              mm,  robot, c_3,     mp };
-    cldes::DESVector<32, uint32_t> specs = { e_1, e_2, e_3, e_4,
-                                             e_5, e_6, e_7, e_8 };
-
-    std::cout << "Computing the supervisor" << std::endl;
-    high_resolution_clock::time_point t1 = high_resolution_clock::now();
-    auto supervisor = cldes::op::supC(plants, specs, non_contr);
-    high_resolution_clock::time_point t2 = high_resolution_clock::now();
-
-    auto duration = duration_cast<microseconds>(t2 - t1).count();
-
-    std::cout << std::endl;
-    std::cout << "Supervisor synth time spent: " << duration << " microseconds"
-              << std::endl;
+    aPlants = { c_1, c_2, milling, lathe, mm, robot, c_3, mp };
+    aSpecs = { e_1, e_2, e_3, e_4, e_5, e_6, e_7, e_8 };
 
-    std::cout << std::endl;
-    std::cout << "Number of states of the supervisor: " << supervisor.size()
-              << std::endl;
-    std::cout << "Number of transitions of the supervisor "
-              << supervisor.getGraph().nonZeros() << std::endl;
+    return;
 }
@@ -0,0 +1,465 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: benchmark/models.hpp
+ Description: Registration of the operations benchmarks of a model given
+ by its plants, specs and non-controllable events.
+ =========================================================================
+*/
+
+#ifndef CLDES_BENCH_MODELS_HPP
+#define CLDES_BENCH_MODELS_HPP
+
+#include "bench.hpp"
+#include "cldes/DESystem.hpp"
+#include "cldes/operations/Expression.hpp"
+#include "cldes/operations/Operations.hpp"
+#include "cldes/operations/SuperProxy.hpp"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+/*! \brief Components of a model and their parallel compositions
+ */
+template<uint8_t NEvents, typename StorageIndex>
+struct Model
+{
+    using System = cldes::DESystem<NEvents, StorageIndex>;
+    using Systems = cldes::DESVector<NEvents, StorageIndex>;
+    using EventsTable = typename System::EventsTable;
+
+    /*! \brief Fills empty plants, specs and non-controllable events
+     */
+    using Generator = std::function<void(Systems&, Systems&, EventsTable&)>;
+
+    Systems plants;
+    Systems specs;
+    EventsTable non_contr;
+
+    /*! \brief Synchronized plants
+     */
+    System plant;
+
+    /*! \brief Synchronized specs
+     */
+    System spec;
+};
+
+/*! \brief Parallel composition of all systems, from left to right
+ */
+template<uint8_t NEvents, typename StorageIndex>
+cldes::DESystem<NEvents, StorageIndex>
+compose(cldes::DESVector<NEvents, StorageIndex> const& aSystems)
+{
+    auto result = aSystems[0ul];
+    for (auto i = 1ul; i < aSystems.size(); ++i) {
+        result = cldes::op::synchronize(
+          cldes::DESystem<NEvents, StorageIndex>{ result }, aSystems[i]);
+    }
+    return result;
+}
+
+/*! \brief Eager compositions of the first and the second half of systems
+ * \details Leaves of the second level of a balanced synchronization tree.
+ * A single system is paired with a system of one marked state and no
+ * events, which does not change the composition.
+ */
+template<uint8_t NEvents, typename StorageIndex>
+std::pair<cldes::DESystem<NEvents, StorageIndex>,
+          cldes::DESystem<NEvents, StorageIndex>>
+composeHalves(cldes::DESVector<NEvents, StorageIndex> const& aSystems)
+{
+    using System = cldes::DESystem<NEvents, StorageIndex>;
+    using Systems = cldes::DESVector<NEvents, StorageIndex>;
+
+    auto const middle = aSystems.size() / 2ul;
+    if (middle == 0ul) {
+        typename System::StatesSet marked_states{ 0 };
+        return { aSystems[0ul], System{ 1, 0, marked_states } };
+    }
+    Systems const left(aSystems.begin(), aSystems.begin() + middle);
+    Systems const right(aSystems.begin() + middle, aSystems.end());
+    return { compose(left), compose(right) };
+}
+
+/*! \brief Lazy parallel composition of all systems, from left to right
+ * \warning aSystems must outlive the expression.
+ */
+template<uint8_t NEvents, typename StorageIndex>
+cldes::op::Expression<NEvents, StorageIndex>
+composeLazy(cldes::DESVector<NEvents, StorageIndex> const& aSystems)
+{
+    auto result = cldes::op::lazy(aSystems[0ul]);
+    for (auto i = 1ul; i < aSystems.size(); ++i) {
+        result = cldes::op::synchronize(result, cldes::op::lazy(aSystems[i]));
+    }
+    return result;
+}
+
+/*! \brief Evaluation strategy of a synthesis pipeline
+ */
+enum class Pipeline
+{
+    /*! \brief Materialize the compositions, then supC()
+     */
+    kEager,
+
+    /*! \brief Materialize both halves of the compositions, then supC() on
+     * SyncSysProxy objects of them
+     */
+    kTwoLevel,
+
+    /*! \brief A single fused exploration of the expression graph
+     */
+    kLazy
+};
+
+/*! \brief Value of the mode parameter of a pipeline
+ */
+inline char const*
+pipelineName(Pipeline const aPipeline)
+{
+    switch (aPipeline) {
+        case Pipeline::kEager:
+            return "eager";
+        case Pipeline::kTwoLevel:
+            return "two_level";
+        case Pipeline::kLazy:
+            return "lazy";
+    }
+    return "unknown";
+}
+
+/*! \brief Supervisor of the plants and specs of a model, from its leaves
+ */
+template<uint8_t NEvents, typename StorageIndex>
+cldes::DESystem<NEvents, StorageIndex>
+runPipeline(Model<NEvents, StorageIndex> const& aModel,
+            Pipeline const aPipeline)
+{
+    switch (aPipeline) {
+        case Pipeline::kTwoLevel: {
+            auto const plants = composeHalves(aModel.plants);
+            auto const specs = composeHalves(aModel.specs);
+            return cldes::op::supC(
+              cldes::op::synchronizeStage1(plants.first, plants.second),
+              cldes::op::synchronizeStage1(specs.first, specs.second),
+              aModel.non_contr);
+        }
+        case Pipeline::kLazy:
+            return cldes::op::supC(composeLazy(aModel.plants),
+                                   composeLazy(aModel.specs),
+                                   aModel.non_contr)
+              .materialize();
+        case Pipeline::kEager:
+            break;
+    }
+    return cldes::op::supC(
+      compose(aModel.plants), compose(aModel.specs), aModel.non_contr);
+}
+
+/*! \brief Check a supervisor of a model
+ * \details Each check is reported as a counter, 1 when it holds:
+ * - check.admissible: every transition is allowed by the plant and the spec
+ * - check.controllable: no non-controllable event enabled on the plant is
+ *   disabled
+ * - check.nonblocking: every state is accessible and coaccessible
+ *
+ * States of the supervisor are matched to plant and spec states by walking
+ * the three systems from their initial states. Only the graph of the
+ * supervisor is read, so the checks do not rely on its cached tables.
+ */
+template<uint8_t NEvents, typename StorageIndex>
+Counters
+checkSupervisor(Model<NEvents, StorageIndex> const& aModel,
+                cldes::DESystem<NEvents, StorageIndex> const& aSupervisor)
+{
+    using System = cldes::DESystem<NEvents, StorageIndex>;
+    using Signed = typename System::StorageIndexSigned;
+
+    auto admissible = true;
+    auto controllable = true;
+    auto nonblocking = true;
+    auto const n = static_cast<std::size_t>(aSupervisor.size());
+    if (n > 0ul && aSupervisor.getInitialState() >= n) {
+        admissible = controllable = nonblocking = false;
+    } else if (n > 0ul) {
+        cldes::EventsSet<NEvents> non_contr;
+        for (auto const event : aModel.non_contr) {
+            non_contr.set(event);
+        }
+        auto const plant_events = aModel.plant.getEvents();
+        auto const spec_events = aModel.spec.getEvents();
+        auto const graph = aSupervisor.getGraph();
+
+        struct Visit
+        {
+            StorageIndex q, p, e;
+        };
+        std::vector<bool> visited(n, false);
+        std::vector<std::vector<StorageIndex>> predecessors(n);
+        std::vector<Visit> f{ { aSupervisor.getInitialState(),
+                                aModel.plant.getInitialState(),
+                                aModel.spec.getInitialState() } };
+        visited[f.front().q] = true;
+        while (!f.empty()) {
+            auto const x = f.back();
+            f.pop_back();
+            cldes::EventsSet<NEvents> enabled;
+            for (typename System::RowIterator it(graph, x.q); it; ++it) {
+                enabled |= it.value();
+                predecessors[it.col()].push_back(x.q);
+                cldes::forEachEvent(it.value(), [&](uint8_t const aEvent) {
+                    auto const p = plant_events.test(aEvent)
+                                     ? aModel.plant.trans(x.p, aEvent)
+                                     : static_cast<Signed>(x.p);
+                    auto const e = spec_events.test(aEvent)
+                                     ? aModel.spec.trans(x.e, aEvent)
+                                     : static_cast<Signed>(x.e);
+                    if (p < 0 || e < 0) {
+                        admissible = false;
+                        return;
+                    }
+                    auto const q = static_cast<StorageIndex>(it.col());
+                    if (!visited[q]) {
+                        visited[q] = true;
+                        f.push_back({ q,
+                                      static_cast<StorageIndex>(p),
+                                      static_cast<StorageIndex>(e) });
+                    }
+                });
+            }
+            auto const required =
+              aModel.plant.getStateEvents(x.p) & non_contr;
+            if ((required & enabled) != required) {
+                controllable = false;
+            }
+        }
+
+        std::vector<bool> coaccessible(n, false);
+        std::vector<StorageIndex> g;
+        for (auto const q : aSupervisor.getMarkedStates()) {
+            if (q >= n) {
+                nonblocking = false;
+                continue;
+            }
+            coaccessible[q] = true;
+            g.push_back(q);
+        }
+        while (!g.empty()) {
+            auto const q = g.back();
+            g.pop_back();
+            for (auto const from : predecessors[q]) {
+                if (!coaccessible[from]) {
+                    coaccessible[from] = true;
+                    g.push_back(from);
+                }
+            }
+        }
+        for (auto q = 0ul; q < n; ++q) {
+            nonblocking = nonblocking && visited[q] && coaccessible[q];
+        }
+    }
+
+    Counters checks;
+    checks["check.admissible"] = admissible;
+    checks["check.controllable"] = controllable;
+    checks["check.nonblocking"] = nonblocking;
+    return checks;
+}
+
+/*! \brief Generate a model and compose its plants and specs
+ */
+template<uint8_t NEvents, typename StorageIndex>
+std::shared_ptr<Model<NEvents, StorageIndex> const>
+makeModel(typename Model<NEvents, StorageIndex>::Generator const& aGenerate)
+{
+    auto model = std::make_shared<Model<NEvents, StorageIndex>>();
+    aGenerate(model->plants, model->specs, model->non_contr);
+    model->plant = compose(model->plants);
+    model->spec = compose(model->specs);
+    return model;
+}
+
+/*! \brief Register the operations benchmarks of a model
+ * \details Registers, as aName/<operation>:
+ * - synchronize: composition of the plants and of the specs
+ * - trim: trim of copies of the composed plant and spec
+ * - supC: eager supervisor synthesis
+ * - supC_lazy: SuperProxy on the composed plant and spec
+ * - pipeline: supervisor of the plants and specs, composed as part of the
+ *   measured run, with mode=eager, two_level and lazy (see Pipeline).
+ *   The supervisor of each mode gets the same checkSupervisor() counters,
+ *   and check.supremal, 1 when it is the supervisor of the lazy mode. They
+ *   are computed once out of the measured time.
+ *
+ * The model is generated and composed once, by the first benchmark which
+ * needs it, and shared by the others.
+ *
+ * @param aName Name of the model
+ * @param aParams Size parameters of the model
+ * @param aGenerate Generator of the plants, specs and non-controllable events
+ * @param aHeavy Only run with --heavy
+ * @param aWeakThreads Thread count of the model in a weak scaling series,
+ * 0 if it does not belong to one
+ */
+template<uint8_t NEvents, typename StorageIndex>
+void
+addModel(std::string const& aName,
+         Params aParams,
+         typename Model<NEvents, StorageIndex>::Generator const& aGenerate,
+         bool const aHeavy = false,
+         unsigned const aWeakThreads = 0u)
+{
+    using ModelT = Model<NEvents, StorageIndex>;
+    using System = typename ModelT::System;
+    using ModelPtr = std::shared_ptr<ModelT const>;
+
+    aParams.emplace_back("NEvents", std::to_string(NEvents));
+    aParams.emplace_back("StorageIndex", indexName<StorageIndex>());
+
+    auto cache = std::make_shared<ModelPtr>();
+    auto model = [cache, aGenerate]() {
+        if (!*cache) {
+            *cache = makeModel<NEvents, StorageIndex>(aGenerate);
+        }
+        return *cache;
+    };
+
+    Case synchronize;
+    synchronize.name = aName + "/synchronize";
+    synchronize.params = aParams;
+    synchronize.heavy = aHeavy;
+    synchronize.weak_threads = aWeakThreads;
+    synchronize.setup = [model]() -> Body {
+        auto const m = model();
+        return [m](Counters& aCounters) {
+            auto const plant = compose(m->plants);
+            auto const spec = compose(m->specs);
+            aCounters["plant_states"] = plant.size();
+            aCounters["plant_transitions"] = plant.getGraph().nonZeros();
+            aCounters[kTransitionsCounter] = plant.getGraph().nonZeros();
+            aCounters["spec_states"] = spec.size();
+            aCounters["plant_memory_bytes"] = plant.memoryUsage().total();
+        };
+    };
+    add(synchronize);
+
+    Case trim;
+    trim.name = aName + "/trim";
+    trim.params = aParams;
+    trim.heavy = aHeavy;
+    trim.weak_threads = aWeakThreads;
+    trim.setup = [model]() -> Body {
+        auto const m = model();
+        return [m](Counters& aCounters) {
+            System plant{ m->plant };
+            System spec{ m->spec };
+            aCounters[kTransitionsCounter] =
+              plant.getGraph().nonZeros() + spec.getGraph().nonZeros();
+            plant.trim();
+            spec.trim();
+            aCounters["plant_states"] = plant.size();
+            aCounters["spec_states"] = spec.size();
+            aCounters["plant_memory_bytes"] = plant.memoryUsage().total();
+        };
+    };
+    add(trim);
+
+    Case supc;
+    supc.name = aName + "/supC";
+    supc.params = aParams;
+    supc.heavy = aHeavy;
+    supc.weak_threads = aWeakThreads;
+    supc.setup = [model]() -> Body {
+        auto const m = model();
+        return [m](Counters& aCounters) {
+            auto const supervisor =
+              cldes::op::supC(m->plant, m->spec, m->non_contr);
+            aCounters["supervisor_states"] = supervisor.size();
+            aCounters["supervisor_transitions"] =
+              supervisor.getGraph().nonZeros();
+            aCounters[kTransitionsCounter] = supervisor.getGraph().nonZeros();
+            aCounters["supervisor_memory_bytes"] =
+              supervisor.memoryUsage().total();
+        };
+    };
+    add(supc);
+
+    Case lazy;
+    lazy.name = aName + "/supC_lazy";
+    lazy.params = aParams;
+    lazy.heavy = aHeavy;
+    lazy.weak_threads = aWeakThreads;
+    lazy.setup = [model]() -> Body {
+        auto const m = model();
+        return [m](Counters& aCounters) {
+            cldes::op::SuperProxy<System, System> const supervisor{
+                m->plant, m->spec, m->non_contr
+            };
+            aCounters["supervisor_states"] = supervisor.size();
+            aCounters["supervisor_memory_bytes"] =
+              supervisor.memoryUsage().total();
+        };
+    };
+    add(lazy);
+
+    for (auto const mode :
+         { Pipeline::kEager, Pipeline::kTwoLevel, Pipeline::kLazy }) {
+        Case pipeline;
+        pipeline.name = aName + "/pipeline";
+        pipeline.params = aParams;
+        pipeline.params.emplace_back("mode", pipelineName(mode));
+        pipeline.heavy = aHeavy;
+        pipeline.weak_threads = aWeakThreads;
+        pipeline.setup = [model, mode]() -> Body {
+            auto const m = model();
+            auto const result = runPipeline(*m, mode);
+            auto checks =
+              std::make_shared<Counters>(checkSupervisor(*m, result));
+            (*checks)["check.supremal"] =
+              mode == Pipeline::kLazy ||
+              result == runPipeline(*m, Pipeline::kLazy);
+            return [m, mode, checks](Counters& aCounters) {
+                auto const supervisor = runPipeline(*m, mode);
+                aCounters.insert(checks->begin(), checks->end());
+                aCounters["supervisor_states"] = supervisor.size();
+                aCounters["supervisor_transitions"] =
+                  supervisor.getGraph().nonZeros();
+                aCounters[kTransitionsCounter] =
+                  supervisor.getGraph().nonZeros();
+                aCounters["supervisor_memory_bytes"] =
+                  supervisor.memoryUsage().total();
+            };
+        };
+        add(pipeline);
+    }
+}
+} // namespace bench
+
+#endif // CLDES_BENCH_MODELS_HPP
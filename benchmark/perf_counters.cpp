@@ -0,0 +1,236 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: benchmark/perf_counters.cpp
+ Description: Hardware performance counters of the measured repetitions,
+ read with Linux perf_event_open.
+ =========================================================================
+*/
+
+#include "perf_counters.hpp"
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench {
+
+char const*
+perfEventName(PerfEvent const aEvent)
+{
+    switch (aEvent) {
+        case PerfEvent::kCycles:
+            return "hw.cycles";
+        case PerfEvent::kInstructions:
+            return "hw.instructions";
+        case PerfEvent::kL1dMisses:
+            return "hw.l1d_misses";
+        case PerfEvent::kLlcMisses:
+            return "hw.llc_misses";
+        case PerfEvent::kBranchMisses:
+            return "hw.branch_misses";
+        case PerfEvent::kDtlbMisses:
+            return "hw.dtlb_misses";
+    }
+    return "hw.unknown";
+}
+
+#ifdef __linux__
+
+/*! \brief Type and config of perf_event_attr for an event
+ */
+static void
+perfConfig_(PerfEvent const aEvent, perf_event_attr& aAttr)
+{
+    auto const cache_miss = [&aAttr](uint64_t const aCache) {
+        aAttr.type = PERF_TYPE_HW_CACHE;
+        aAttr.config = aCache | (PERF_COUNT_HW_CACHE_OP_READ << 8u) |
+                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16u);
+    };
+    aAttr.type = PERF_TYPE_HARDWARE;
+    switch (aEvent) {
+        case PerfEvent::kCycles:
+            aAttr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PerfEvent::kInstructions:
+            aAttr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PerfEvent::kBranchMisses:
+            aAttr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case PerfEvent::kL1dMisses:
+            cache_miss(PERF_COUNT_HW_CACHE_L1D);
+            break;
+        case PerfEvent::kLlcMisses:
+            cache_miss(PERF_COUNT_HW_CACHE_LL);
+            break;
+        case PerfEvent::kDtlbMisses:
+            cache_miss(PERF_COUNT_HW_CACHE_DTLB);
+            break;
+    }
+}
+
+PerfCounters::PerfCounters()
+{
+    fds_.fill(-1);
+    totals_.fill(0ul);
+    for (auto e = 0; e < kPerfEvents; ++e) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        perfConfig_(static_cast<PerfEvent>(e), attr);
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        auto const fd = static_cast<int>(
+          syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0ul));
+        if (fd < 0) {
+            error_ = std::strerror(errno);
+            continue;
+        }
+        fds_[e] = fd;
+    }
+    if (available()) {
+        error_.clear();
+    }
+}
+
+PerfCounters::~PerfCounters()
+{
+    for (auto fd : fds_) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+void
+PerfCounters::start()
+{
+    for (auto fd : fds_) {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+void
+PerfCounters::stop()
+{
+    for (auto e = 0; e < kPerfEvents; ++e) {
+        if (fds_[e] < 0) {
+            continue;
+        }
+        ioctl(fds_[e], PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t value = 0ul;
+        if (read(fds_[e], &value, sizeof(value)) ==
+            static_cast<ssize_t>(sizeof(value))) {
+            totals_[e] += value;
+        }
+    }
+}
+
+#else
+
+PerfCounters::PerfCounters()
+  : error_{ "perf_event_open is only available on Linux" }
+{
+    fds_.fill(-1);
+    totals_.fill(0ul);
+}
+
+PerfCounters::~PerfCounters() {}
+
+void
+PerfCounters::start()
+{
+}
+
+void
+PerfCounters::stop()
+{
+}
+
+#endif // __linux__
+
+bool
+PerfCounters::available() const
+{
+    for (auto fd : fds_) {
+        if (fd >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+PerfCounters::report(Counters& aCounters, unsigned const aReps) const
+{
+    if (!available() || aReps == 0u) {
+        return;
+    }
+    auto const value = [this, aReps](PerfEvent const aEvent) {
+        return static_cast<double>(totals_[static_cast<int>(aEvent)]) / aReps;
+    };
+    auto const has = [this](PerfEvent const aEvent) {
+        return fds_[static_cast<int>(aEvent)] >= 0;
+    };
+    for (auto e = 0; e < kPerfEvents; ++e) {
+        auto const event = static_cast<PerfEvent>(e);
+        if (has(event)) {
+            aCounters[perfEventName(event)] = value(event);
+        }
+    }
+    if (has(PerfEvent::kCycles) && has(PerfEvent::kInstructions) &&
+        value(PerfEvent::kCycles) > 0.0) {
+        aCounters["hw.ipc"] =
+          value(PerfEvent::kInstructions) / value(PerfEvent::kCycles);
+    }
+
+    auto const transitions = aCounters.find(kTransitionsCounter);
+    if (transitions == aCounters.end() || transitions->second <= 0.0) {
+        return;
+    }
+    for (auto const event : { PerfEvent::kL1dMisses,
+                              PerfEvent::kLlcMisses,
+                              PerfEvent::kBranchMisses,
+                              PerfEvent::kDtlbMisses }) {
+        if (has(event)) {
+            aCounters[std::string{ perfEventName(event) } +
+                      "_per_transition"] =
+              value(event) / transitions->second;
+        }
+    }
+}
+
+} // namespace bench
@@ -0,0 +1,111 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: benchmark/perf_counters.hpp
+ Description: Hardware performance counters of the measured repetitions,
+ read with Linux perf_event_open.
+ =========================================================================
+*/
+
+#ifndef CLDES_BENCH_PERF_COUNTERS_HPP
+#define CLDES_BENCH_PERF_COUNTERS_HPP
+
+#include "bench.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace bench {
+
+/*! \brief Hardware events read around the measured repetitions
+ */
+enum class PerfEvent : int
+{
+    kCycles = 0,
+    kInstructions,
+    kL1dMisses,
+    kLlcMisses,
+    kBranchMisses,
+    kDtlbMisses
+};
+
+/*! \brief Number of PerfEvent values
+ */
+int constexpr kPerfEvents = 6;
+
+/*! \brief Name of the counter reported for an event, e.g. "hw.cycles"
+ */
+char const*
+perfEventName(PerfEvent const aEvent);
+
+/*! \class PerfCounters
+ * \brief Counters of the calling thread and of the threads it creates
+ * \details Create it before the executor of the measurement: workers
+ * inherit the counters of the thread which spawned them. Each event is
+ * opened on its own, so events the processor or the kernel does not
+ * provide are skipped and the others are still read. Kernel code is not
+ * counted, which perf_event_paranoid = 2 allows.
+ */
+class PerfCounters
+{
+public:
+    PerfCounters();
+
+    PerfCounters(PerfCounters const&) = delete;
+    PerfCounters& operator=(PerfCounters const&) = delete;
+
+    ~PerfCounters();
+
+    /*! \brief Check if at least one event is counted
+     */
+    bool available() const;
+
+    /*! \brief Why no event could be opened, e.g. "Permission denied"
+     */
+    std::string const& error() const { return error_; }
+
+    /*! \brief Zero and start the counters
+     */
+    void start();
+
+    /*! \brief Stop the counters and add their values to the totals
+     */
+    void stop();
+
+    /*! \brief Report the totals divided by aReps and the derived metrics
+     * \details Adds hw.* counters: the raw events, hw.ipc and, when the
+     * body reported kTransitionsCounter, the misses per transition.
+     */
+    void report(Counters& aCounters, unsigned const aReps) const;
+
+private:
+    std::array<int, kPerfEvents> fds_;
+    std::array<uint64_t, kPerfEvents> totals_;
+    std::string error_;
+};
+
+} // namespace bench
+
+#endif // CLDES_BENCH_PERF_COUNTERS_HPP
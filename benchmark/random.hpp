@@ -0,0 +1,336 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: benchmark/random.hpp
+ Description: Seeded generator of random automata and of random families
+ of plants and specs.
+ =========================================================================
+*/
+
+#ifndef CLDES_BENCH_RANDOM_HPP
+#define CLDES_BENCH_RANDOM_HPP
+
+#include "cldes/DESystem.hpp"
+#include "cldes/backend/Executor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <sparsepp/spp.h>
+#include <stdexcept>
+#include <vector>
+
+/*! \brief Distribution of the number of transitions leaving each state
+ */
+enum class DegreeDistribution
+{
+    kFixed,     //!< Every state has the mean degree
+    kUniform,   //!< Uniform on [0, 2 * mean]
+    kGeometric, //!< Geometric with the given mean: few hubs, many leaves
+};
+
+/*! \brief Shape of the random automata
+ */
+struct RandomSpec
+{
+    unsigned long states = 1000ul;
+
+    /*! \brief Number of events of each automaton
+     */
+    unsigned events = 8u;
+
+    /*! \brief Mean number of transitions leaving each state
+     */
+    double degree = 2.0;
+
+    DegreeDistribution distribution = DegreeDistribution::kUniform;
+
+    /*! \brief No state has two transitions with the same event
+     */
+    bool deterministic = true;
+
+    /*! \brief Fraction of marked states
+     */
+    double marked = 0.1;
+
+    /*! \brief Fraction of non-controllable events of the family
+     */
+    double uncontrollable = 0.25;
+
+    uint64_t seed = 1ul;
+};
+
+/*! \brief Number of states generated with the same random sequence
+ * \details It does not depend on the number of threads, so the generated
+ * automata do not either.
+ */
+unsigned long const kRandomBlock = 4096ul;
+
+/*! \brief SplitMix64 random generator
+ * \details Portable: the same seed gives the same automata on any standard
+ * library, which is not true for std::uniform_int_distribution.
+ */
+class RandomStream_
+{
+public:
+    explicit RandomStream_(uint64_t const aSeed, uint64_t const aStream = 0ul)
+      : state_{ aSeed ^ (0x9e3779b97f4a7c15ul * (aStream + 1ul)) }
+    {
+        next();
+    }
+
+    uint64_t next() noexcept
+    {
+        uint64_t z = (state_ += 0x9e3779b97f4a7c15ul);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ul;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebul;
+        return z ^ (z >> 31);
+    }
+
+    /*! \brief Integer on [0, aBound)
+     */
+    uint64_t below(uint64_t const aBound) noexcept
+    {
+        return aBound ? next() % aBound : 0ul;
+    }
+
+    /*! \brief Real on [0, 1)
+     */
+    double real() noexcept { return (next() >> 11) / 9007199254740992.0; }
+
+private:
+    uint64_t state_;
+};
+
+/*! \brief Draw the number of transitions leaving a state
+ */
+inline unsigned long
+randomDegree_(RandomSpec const& aSpec, RandomStream_& aRandom)
+{
+    switch (aSpec.distribution) {
+        case DegreeDistribution::kFixed:
+            return static_cast<unsigned long>(std::lround(aSpec.degree));
+        case DegreeDistribution::kUniform:
+            return aRandom.below(
+              static_cast<uint64_t>(std::lround(2.0 * aSpec.degree)) + 1ul);
+        case DegreeDistribution::kGeometric: {
+            // Number of failures before a success of probability p
+            auto const p = 1.0 / (1.0 + aSpec.degree);
+            auto const u = 1.0 - aRandom.real();
+            return static_cast<unsigned long>(
+              std::floor(std::log(u) / std::log(1.0 - p)));
+        }
+    }
+    return 0ul;
+}
+
+/*! \brief Generate a random automaton
+ * \details States are reachable: state q has transitions to the states
+ * q * b + 1, ..., q * b + b, b being the rounded mean degree, and its other
+ * transitions go to uniformly chosen states. Deterministic automata use
+ * distinct events on each state, so their degree is capped by the number
+ * of events. Blocks of kRandomBlock states are generated in parallel on
+ * the current executor.
+ *
+ * @param aSpec Shape of the automaton
+ * @param aAlphabet Events of the automaton: 0, ..., aSpec.events - 1 if it
+ * is empty
+ * @param aStream Index of the automaton in a family: automata with the same
+ * seed and different streams are independent
+ * \return The generated system
+ */
+template<uint8_t NEvents, typename StorageIndex = unsigned>
+cldes::DESystem<NEvents, StorageIndex>
+RandomSystem(RandomSpec const& aSpec,
+             std::vector<uint8_t> aAlphabet = {},
+             uint64_t const aStream = 0ul)
+{
+    using System = cldes::DESystem<NEvents, StorageIndex>;
+    using Triplet = typename System::Triplet_t;
+
+    if (aAlphabet.empty()) {
+        aAlphabet.resize(aSpec.events);
+        std::iota(aAlphabet.begin(), aAlphabet.end(), uint8_t{ 0 });
+    }
+    if (aSpec.states == 0ul || aAlphabet.empty() ||
+        *std::max_element(aAlphabet.begin(), aAlphabet.end()) >= NEvents) {
+        throw std::runtime_error("RandomSystem: Invalid inputs");
+    }
+
+    auto const nstates = aSpec.states;
+    auto const nevents = aAlphabet.size();
+    auto branching = std::max(
+      1ul, static_cast<unsigned long>(std::lround(aSpec.degree)));
+    if (aSpec.deterministic) {
+        branching = std::min(branching, nevents);
+    }
+    auto const nblocks = (nstates + kRandomBlock - 1ul) / kRandomBlock;
+
+    std::vector<std::vector<Triplet>> transitions(nblocks);
+    std::vector<std::vector<StorageIndex>> marked(nblocks);
+    cldes::backend::currentExecutor().parallelFor(
+      0ul,
+      nblocks,
+      [&](std::size_t const aBegin, std::size_t const aEnd, unsigned const) {
+          std::vector<uint8_t> events(aAlphabet);
+          for (auto block = aBegin; block < aEnd; ++block) {
+              RandomStream_ random{ aSpec.seed, aStream * nblocks + block };
+              auto& triplets = transitions[block];
+              auto const first = block * kRandomBlock;
+              auto const last = std::min(nstates, first + kRandomBlock);
+              for (auto q = first; q < last; ++q) {
+                  if (random.real() < aSpec.marked) {
+                      marked[block].push_back(static_cast<StorageIndex>(q));
+                  }
+
+                  auto const child = q * branching + 1ul;
+                  auto const nchildren =
+                    child < nstates ? std::min(branching, nstates - child)
+                                    : 0ul;
+                  auto degree =
+                    std::max(nchildren, randomDegree_(aSpec, random));
+                  if (aSpec.deterministic) {
+                      degree = std::min(degree, nevents);
+                  }
+
+                  for (auto t = 0ul; t < degree; ++t) {
+                      uint8_t event;
+                      if (aSpec.deterministic) {
+                          // Partial Fisher-Yates: distinct events
+                          auto const j = t + random.below(nevents - t);
+                          std::swap(events[t], events[j]);
+                          event = events[t];
+                      } else {
+                          event = aAlphabet[random.below(nevents)];
+                      }
+                      auto const to =
+                        t < nchildren ? child + t : random.below(nstates);
+                      cldes::EventsSet<NEvents> bit;
+                      bit.set(event);
+                      triplets.push_back(
+                        Triplet(static_cast<StorageIndex>(q),
+                                static_cast<StorageIndex>(to),
+                                bit));
+                  }
+              }
+          }
+      },
+      1ul);
+
+    std::vector<Triplet> all;
+    typename System::StatesSet marked_states;
+    for (auto block = 0ul; block < nblocks; ++block) {
+        all.insert(all.end(),
+                   transitions[block].begin(),
+                   transitions[block].end());
+        transitions[block] = std::vector<Triplet>{};
+        marked_states.insert(marked[block].begin(), marked[block].end());
+    }
+    if (marked_states.empty()) {
+        marked_states.insert(0u);
+    }
+
+    return System{ static_cast<StorageIndex>(nstates), 0u, marked_states, all };
+}
+
+/*! \brief Generate a family of random plants and specs
+ * \details Each plant has aSpec.events events: a fraction aShared of them
+ * belongs to a pool shared by all the plants, and the others are private
+ * events of the plant. A fraction aSpec.uncontrollable of the events of
+ * the plants is non-controllable, drawn from the private events. Each spec
+ * has aSpec.events events drawn from the controllable events, so the specs
+ * never disable a non-controllable event by themselves: states are only
+ * removed for blocking, or for leading to a blocking state with
+ * non-controllable events.
+ *
+ * @param aSpec Shape of each automaton
+ * @param aNPlants Number of plants
+ * @param aNSpecs Number of specs
+ * @param aShared Fraction of events of each plant shared with the others
+ * @param aPlants Empty vector which receives the plants
+ * @param aSpecs Empty vector which receives the specs
+ * @param non_contr Empty table which receives the non-controllable events
+ */
+template<uint8_t NEvents, typename StorageIndex = unsigned>
+void
+RandomFamily(RandomSpec const& aSpec,
+             unsigned const aNPlants,
+             unsigned const aNSpecs,
+             double const aShared,
+             cldes::DESVector<NEvents, StorageIndex>& aPlants,
+             cldes::DESVector<NEvents, StorageIndex>& aSpecs,
+             spp::sparse_hash_set<uint8_t>& non_contr)
+{
+    auto const nshared = static_cast<unsigned long>(
+      std::lround(aShared * aSpec.events));
+    auto const nprivate = aSpec.events - nshared;
+    auto const nevents = nshared + aNPlants * nprivate;
+    auto const ncontr = std::min(
+      static_cast<unsigned long>(std::lround(aSpec.uncontrollable * nevents)),
+      aNPlants * nprivate);
+    if (aPlants.size() != 0 || aSpecs.size() != 0 || non_contr.size() ||
+        aNPlants == 0u || aSpec.events == 0u || nevents > NEvents ||
+        (aNSpecs != 0u && aSpec.events > nevents - ncontr)) {
+        throw std::runtime_error("RandomFamily: Invalid inputs");
+    }
+
+    // Events 0, ..., nshared - 1 are shared, the others are private
+    for (auto i = 0u; i < aNPlants; ++i) {
+        std::vector<uint8_t> alphabet(nshared);
+        std::iota(alphabet.begin(), alphabet.end(), uint8_t{ 0 });
+        for (auto e = 0ul; e < nprivate; ++e) {
+            alphabet.push_back(
+              static_cast<uint8_t>(nshared + i * nprivate + e));
+        }
+        aPlants.push_back(
+          RandomSystem<NEvents, StorageIndex>(aSpec, alphabet, i));
+    }
+
+    // Non-controllable events are private events, and the specs are drawn
+    // from the controllable events
+    RandomStream_ random{ aSpec.seed, ~0ul };
+    std::vector<uint8_t> events(nevents - nshared);
+    std::iota(events.begin(), events.end(), static_cast<uint8_t>(nshared));
+    for (auto e = 0ul; e < ncontr; ++e) {
+        std::swap(events[e], events[e + random.below(events.size() - e)]);
+        non_contr.insert(events[e]);
+    }
+    events.erase(events.begin(), events.begin() + ncontr);
+    for (auto e = 0ul; e < nshared; ++e) {
+        events.push_back(static_cast<uint8_t>(e));
+    }
+
+    for (auto i = 0u; i < aNSpecs; ++i) {
+        for (auto e = 0ul; e < aSpec.events; ++e) {
+            std::swap(events[e],
+                      events[e + random.below(events.size() - e)]);
+        }
+        std::vector<uint8_t> const alphabet(events.begin(),
+                                            events.begin() + aSpec.events);
+        aSpecs.push_back(RandomSystem<NEvents, StorageIndex>(
+          aSpec, alphabet, aNPlants + i));
+    }
+}
+
+#endif // CLDES_BENCH_RANDOM_HPP
@@ -0,0 +1,223 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/ConcurrentStatesTable.hpp
+ Description: Lock-free hash table of states shared by the threads of a
+ parallel exploration.
+ =========================================================================
+*/
+/*!
+ * \file cldes/ConcurrentStatesTable.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-28
+ *
+ * Lock-free hash table of states shared by the threads of a parallel
+ * exploration.
+ */
+
+#ifndef CONCURRENT_STATES_TABLE_HPP
+#define CONCURRENT_STATES_TABLE_HPP
+
+#include "cldes/backend/Executor.hpp"
+#include "cldes/src/des/ConcurrentStatesTableFwd.hpp"
+
+namespace cldes {
+
+/*! \class ConcurrentStatesTable
+ * \brief Visited states table for parallel explorations
+ * \details Open addressing with linear probing on an array of 64-bit
+ * slots. A slot holds key + 1, so 0 means empty. insert() claims an empty
+ * slot with a single compare-and-swap: inserts and lookups never lock.
+ *
+ * The table can also map each state to a compact id, assigned in the
+ * order states are inserted: e.g. the row of the state on the resulting
+ * system. Ids live on a second array of slots.
+ *
+ * The table grows when it is half full. Growing waits for the threads on
+ * the table to leave it, allocates new arrays of slots and rehashes all
+ * keys into them with the current executor: for a while, both the old and
+ * the new arrays are allocated. Reserve the expected number of states to
+ * avoid it. Slots are initialized
+ * by the executor workers, so with a first-touch policy each NUMA node
+ * holds a part of the table. setNumaPolicy() places them explicitly.
+ *
+ * \warning Keys must be smaller than the maximum uint64_t.
+ *
+ * \tparam StorageIndex Unsigned type used for indexing states
+ */
+template<typename StorageIndex>
+class ConcurrentStatesTable
+{
+public:
+    /*! \brief Value returned for states without an id
+     */
+    uint64_t static constexpr kNoValue = ~0ul;
+
+    /*! \brief ConcurrentStatesTable constructor
+     *
+     * @param aCapacity Expected number of states
+     * @param aWithIds Allocate the ids array: required by insertWithId()
+     */
+    explicit ConcurrentStatesTable(std::size_t const aCapacity = 1024ul,
+                                   bool const aWithIds = false);
+
+    ConcurrentStatesTable(ConcurrentStatesTable const&) = delete;
+    ConcurrentStatesTable& operator=(ConcurrentStatesTable const&) = delete;
+
+    /*! \brief Insert a state
+     * \details On a table with ids, the state gets an id as with
+     * insertWithId().
+     *
+     * @param aKey State
+     * \return True if the state was not on the table
+     */
+    bool insert(StorageIndex const aKey);
+
+    /*! \brief Insert a state and get its compact id
+     * \details The first thread to insert a state assigns the next id.
+     * The others get the same id.
+     * \throws std::logic_error If the table has no ids array
+     *
+     * @param aKey State
+     * \return Pair (id, true if this call inserted the state)
+     */
+    std::pair<uint64_t, bool> insertWithId(StorageIndex const aKey);
+
+    /*! \brief Check if a state is on the table
+     */
+    bool contains(StorageIndex const aKey) const noexcept;
+
+    /*! \brief Get the id of a state
+     * \return The id or kNoValue, if the state is not on the table
+     */
+    uint64_t find(StorageIndex const aKey) const noexcept;
+
+    /*! \brief Number of states on the table
+     */
+    std::size_t size() const noexcept { return size_.load(); }
+
+    /*! \brief Number of slots
+     */
+    std::size_t capacity() const noexcept { return capacity_.load(); }
+
+    /*! \brief Grow the table to hold aStates without resizing
+     *
+     * @param aStates Number of states
+     * \return void
+     */
+    void reserve(std::size_t const aStates);
+
+    /*! \brief Place the slots on the NUMA nodes
+     * \details Current slots are migrated, and slots allocated when the
+     * table grows follow the same policy.
+     * \warning It must not run concurrently with inserts.
+     *
+     * @param aPolicy Placement policy
+     * \return True if the kernel placed all pages
+     */
+    bool setNumaPolicy(backend::NumaPolicy const aPolicy);
+
+    /*! \brief Call aFunction(state) on all states
+     * \warning It must not run concurrently with inserts.
+     */
+    template<class Function>
+    void forEach(Function&& aFunction) const;
+
+    /*! \brief Call aFunction(state, id) on all states
+     * \warning It must not run concurrently with inserts.
+     */
+    template<class Function>
+    void forEachId(Function&& aFunction) const;
+
+protected:
+    /*! \brief Claim a slot for aEncoded on aKeys
+     * \return Pair (slot, true if it was empty), or (capacity, false) if
+     * aKeys is full
+     */
+    static std::pair<std::size_t, bool> probe_(
+      std::atomic<uint64_t>* const aKeys,
+      std::size_t const aMask,
+      uint64_t const aEncoded) noexcept;
+
+    /*! \brief Find the slot of aEncoded
+     * \return The slot or aMask + 1, when it is not on the table
+     */
+    static std::size_t lookup_(std::atomic<uint64_t> const* const aKeys,
+                               std::size_t const aMask,
+                               uint64_t const aEncoded) noexcept;
+
+    /*! \brief Allocate slots, clear them on the current executor and place
+     * them with aPolicy
+     */
+    static ConcurrentSlots allocate_(std::size_t const aSize,
+                                     uint64_t const aValue,
+                                     backend::NumaPolicy const aPolicy);
+
+    /*! \brief Enter the table: wait while it grows
+     */
+    void enter_() const noexcept;
+
+    /*! \brief Leave the table
+     */
+    void leave_() const noexcept { users_.fetch_sub(1u); }
+
+    /*! \brief Rehash the table on aCapacity slots, if it has less
+     * \details Only one thread grows the table: the others wait for it.
+     */
+    void grow_(std::size_t const aCapacity);
+
+    /*! \brief Grow the table after an insert if it is half full
+     */
+    void growIfLoaded_();
+
+private:
+    ConcurrentSlots keys_;
+    ConcurrentSlots ids_;
+    std::atomic<std::size_t> capacity_;
+    bool with_ids_;
+
+    std::atomic<std::size_t> size_;
+    std::atomic<uint64_t> next_id_;
+
+    /*! \brief Threads on the table
+     */
+    mutable std::atomic<unsigned> users_;
+
+    /*! \brief Set while the table grows
+     */
+    std::atomic<bool> growing_;
+
+    /*! \brief Placement of new slots
+     */
+    backend::NumaPolicy numa_policy_;
+};
+
+} // namespace cldes
+
+// include methods definitions
+#include "cldes/src/des/ConcurrentStatesTableCore.hpp"
+
+#endif // CONCURRENT_STATES_TABLE_HPP
@@ -42,6 +42,10 @@
 #define DESYSTEM_HPP
 
 #include "cldes/DESystemBase.hpp"
+#include "cldes/OperationMonitor.hpp"
+#include "cldes/OperationStats.hpp"
+#include "cldes/Trace.hpp"
+#include "cldes/backend/Numa.hpp"
 #include "cldes/src/des/DESystemFwd.hpp"
 
 namespace cldes {
@@ -191,6 +195,22 @@ public:
              StatesSet& aMarkedStates,
              bool const& aDevCacheEnabled = true);
 
+    /*! \brief DESystem constructor from a list of transitions
+     * \details Builds the graph at once. Inserting the transitions of a
+     * large system one by one with operator() recompresses the graph on
+     * each insertion. Transitions between the same pair of states are
+     * merged.
+     *
+     * @param aStatesNumber Number of states of the system
+     * @param aInitState System's initial state
+     * @param aMarkedStates System's marked states
+     * @param aTransitions Transitions as (from, to, events) triplets
+     */
+    DESystem(StorageIndex const& aStatesNumber,
+             StorageIndex const& aInitState,
+             StatesSet& aMarkedStates,
+             std::vector<Triplet_t> const& aTransitions);
+
     /*! \brief DESystem destructor
      *  \details Override base destructor for avoiding memory leaks.
      */
@@ -237,6 +257,11 @@ public:
      */
     bool constexpr static isVirtual_impl() noexcept { return false; }
 
+    /*! \brief Memory held by the system, by table
+     * \details The inverted graph counts while it is allocated.
+     */
+    MemoryUsage memoryUsage_impl() const noexcept;
+
     /*! \brief Graph getter
      *
      *  \return Eigen sparse matrix of bitset representing the sysmte on
@@ -244,6 +269,19 @@ public:
      */
     GraphHostData constexpr getGraph() const noexcept { return graph_; }
 
+    /*! \brief Place the graphs and states events tables on the NUMA nodes
+     * \details With NumaPolicy::kPartitioned, the rows of each block of
+     * states live on one node: loops over the states on an executor with
+     * ExecutorOptions::numa read local memory. Arrays reallocated later,
+     * e.g. when the system changes, get the default placement again. Only
+     * the pages of the system are moved and no memory policy is left
+     * behind (see backend::numaPlace()).
+     *
+     * @param aPolicy Placement policy
+     * \return True if the kernel placed all pages
+     */
+    bool placeMemory(backend::NumaPolicy const aPolicy) const;
+
     /*! \brief Returns events that lead a transition between two states
      *
      * @param aQfrom State where the transition departs.
@@ -346,8 +384,9 @@ public:
      * @param aEvent Event
      * \return The state where the transition leads or -1 when it is empty
      */
-    StorageIndexSigned trans_impl(StorageIndex const& aQ,
-                                  ScalarType const& aEvent) const noexcept;
+    inline StorageIndexSigned trans_impl(StorageIndex const& aQ,
+                                         ScalarType const& aEvent) const
+      noexcept;
 
     /*! \brief Check if the current system contains at least one inverse
      * transition
@@ -374,8 +413,33 @@ public:
      * \return DES states array containing the inverse transition.
      * It may be empty, if there is none.
      */
-    StatesArray<StorageIndex> invtrans_impl(StorageIndex const& aQ,
-                                            ScalarType const& aEvent) const;
+    inline StatesArray<StorageIndex> invtrans_impl(
+      StorageIndex const& aQ,
+      ScalarType const& aEvent) const;
+
+    /*! \brief Visit the transitions leaving a state
+     * \details It streams the row aQ of the graph.
+     *
+     * @param aQ State
+     * @param aFunction Callable with signature (event, qto)
+     * \return void
+     */
+    template<class Function>
+    void forEachSuccessor_impl(StorageIndex const& aQ,
+                               Function& aFunction) const;
+
+    /*! \brief Visit the transitions arriving to a state
+     * \warning This method requires to run AllocateInvGraph previously.
+     *
+     * @param aQ State
+     * @param aEvents Mask of the visited events
+     * @param aFunction Callable with signature (event, qfrom)
+     * \return void
+     */
+    template<class Function>
+    void forEachPredecessor_impl(StorageIndex const& aQ,
+                                 EventsSet_t const& aEvents,
+                                 Function& aFunction) const;
 
     /*! \brief Get events of all transitions of a specific state
      * \details Since this is information is stored on a vector on concrete
@@ -438,22 +502,19 @@ public:
      *
      * @param aLang Set of events
      */
-    DESystem constexpr& invproj_impl(EventsSet_t const&) const noexcept
+    DESystem const& invproj_impl(EventsSet_t const&) const noexcept
     {
         return *this;
     }
 
-    bool operator==(DESystem const& aRhs)
-    {
-        if (this->init_state_ != aRhs.init_state_) {
-            return false;
-        } else if (this->marked_states_ != aRhs.marked_states_) {
-            return false;
-        } else if (graph_ != aRhs.graph_) {
-            return false;
-        }
-        return true;
-    }
+    /*! \brief Compare two systems
+     * \details Systems are equal when they have the same initial state,
+     * marked states and graph.
+     *
+     * @param aRhs System to compare with
+     * \return True if both systems are equal
+     */
+    bool operator==(DESystem const& aRhs) const noexcept;
 
 protected:
     /*! \brief Method for caching the graph
@@ -538,9 +599,7 @@ protected:
 
 private:
     friend class TransitionProxy<NEvents, StorageIndex>;
-#ifdef CLDES_OPENCL_ENABLED
     friend class DESystemCL<NEvents, StorageIndex>;
-#endif
 
     /*! \brief DESystem operations virtual proxies
      *
@@ -558,6 +617,10 @@ private:
     friend class op::SyncSysProxy;
     template<class SysT_l, class SysT_r>
     friend class op::SuperProxy;
+    template<uint8_t NEv, typename StIdx>
+    friend class op::FusedExplorer;
+    template<class SysT_l, class SysT_r>
+    friend class op::ShardCoordinator;
 
     // TODO: make dispatcher (type erasure) friend when it is done for dynamic
     // polymorphism
@@ -604,4 +667,10 @@ private:
 // Matrix proxy for sync operation
 #include "cldes/operations/SyncSysProxy.hpp"
 
+// Specializations compiled by libcldes
+#ifdef CLDES_EXTERN_TEMPLATES
+#include "cldes/src/Instantiations.hpp"
+CLDES_FOR_EACH_INSTANTIATION(CLDES_EXTERN_DESYSTEM_)
+#endif
+
 #endif // DESYSTEM_HPP
@@ -41,6 +41,7 @@
 
 #include "cldes/Constants.hpp"
 #include "cldes/EventsSet.hpp"
+#include "cldes/MemoryUsage.hpp"
 #include "cldes/src/des/DESystemBaseFwd.hpp"
 
 namespace cldes {
@@ -136,6 +137,16 @@ public:
         return marked_states_;
     }
 
+    /*! \brief Check if a state is marked, without copying the marked states
+     *
+     * @param aQ State to check
+     * \return True if aQ is a marked state
+     */
+    bool isMarked(StorageIndex const& aQ) const noexcept
+    {
+        return marked_states_.find(aQ) != marked_states_.end();
+    }
+
     /*! \brief Set inverted states events
      *
      * \param aEvents Bit set with new events of the system
@@ -299,6 +310,39 @@ public:
         return sys.invtrans_impl(aQfrom, aEvent);
     }
 
+    /*! \brief Visit every transition leaving a state
+     * \details aFunction(event, qto) is called once for each transition
+     * (aQ, event, qto), with no temporary containers. Proxies stream the
+     * rows of their components instead of building products.
+     *
+     * @param aQ State
+     * @param aFunction Callable with signature (ScalarType, StorageIndex)
+     */
+    template<class Function>
+    void forEachSuccessor(StorageIndex const& aQ, Function&& aFunction) const
+    {
+        RealDESystem const& sys = static_cast<RealDESystem const&>(*this);
+        sys.forEachSuccessor_impl(aQ, aFunction);
+    }
+
+    /*! \brief Visit every transition arriving to a state
+     * \details aFunction(event, qfrom) is called once for each transition
+     * (qfrom, event, aQ) whose event is in aEvents. As invtrans(), it
+     * requires allocateInvertedGraph() on concrete systems.
+     *
+     * @param aQ State
+     * @param aEvents Mask of the visited events
+     * @param aFunction Callable with signature (ScalarType, StorageIndex)
+     */
+    template<class Function>
+    void forEachPredecessor(StorageIndex const& aQ,
+                            EventsSet<NEvents> const& aEvents,
+                            Function&& aFunction) const
+    {
+        RealDESystem const& sys = static_cast<RealDESystem const&>(*this);
+        sys.forEachPredecessor_impl(aQ, aEvents, aFunction);
+    }
+
     /*! \brief Returns EventsSet relative to state q
      *
      * @param aQ A state on the sys
@@ -354,10 +398,11 @@ public:
      *
      * @param aLang Language
      */
-    bool constexpr searchObsProp(EventsSet<NEvents> const&) const noexcept
+    bool constexpr searchObsProp(EventsSet<NEvents> const& aAlphabet) const
+      noexcept
     {
         RealDESystem const& sys = static_cast<RealDESystem const&>(*this);
-        return sys;
+        return sys.checkObsProp_impl(aAlphabet);
     }
 
     /*! \brief Projection operation
@@ -374,13 +419,25 @@ public:
      *
      * @param aLang Set of events
      */
-    RealDESystem constexpr& invproj(EventsSet<NEvents> const&) const noexcept
+    RealDESystem const& invproj(EventsSet<NEvents> const&) const noexcept
     {
         RealDESystem const& sys = static_cast<RealDESystem const&>(*this);
         return sys;
     }
 
+    /*! \brief Memory held by the system, by table
+     */
+    MemoryUsage memoryUsage() const noexcept
+    {
+        RealDESystem const& sys = static_cast<RealDESystem const&>(*this);
+        return sys.memoryUsage_impl();
+    }
+
 protected:
+    /*! \brief Memory held by the tables of the base class
+     */
+    MemoryUsage baseMemoryUsage_() const noexcept;
+
     /*! \brief Current system's states number
      */
     StorageIndex states_number_;
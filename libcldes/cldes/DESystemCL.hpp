@@ -25,73 +25,71 @@
 
  File: cldes/DESystemCL.hpp
  Description: DESystemCL class definition. DESystemCL is a Discrete-Event
- System on the device memory.
+ System on the memory of an accelerator backend.
  =========================================================================
 */
 
-#ifdef CLDES_OPENCL_ENABLED
-
 #ifndef DESYSTEMCL_HPP
 #define DESYSTEMCL_HPP
 
-#include "cldes/DESystemBase.hpp"
+#include "cldes/DESystem.hpp"
+#include "cldes/backend/Accelerator.hpp"
 #include "cldes/src/des/DESystemCLFwd.hpp"
 
 namespace cldes {
 
 /*! \class DESystemCL
- * \brief Discrete-Events System on device memory
+ * \brief Discrete-Events System on accelerator memory
+ *
+ * Keeps the graph of a DES as compressed rows with bit mask event sets and
+ * runs the operations which touch the whole graph, BFS and
+ * synchronization, as kernels of an accelerator backend. The default
+ * backend, backend::HostAccelerator, runs them on the host threads, so
+ * DESystemCL works on machines without devices.
  *
- * Implement a DES on the device memory and their respective operations for
- * GPUs.
+ * It implements the interface that proxies use on their components, so it
+ * can also be an operand of SyncSysProxy, SuperProxy and supC().
  *
  * \tparam NEvents Number of events
  * \tparam StorageIndex Unsigned type use for indexing the ajacency matrix
  */
 template<uint8_t NEvents, typename StorageIndex = unsigned int>
-class DESystemCL : public DESystemBase<NEvents, StorageIndex>
+class DESystemCL
 {
 public:
-    /*! Unfortunatelly, viennacl only accepts float type
-     */
-    using GraphHostData = Eigen::SparseMatrix<float, Eigen::RowMajor>;
-    using StatesVector = Eigen::SparseMatrix<float, Eigen::RowMajor>;
-
     /*! \brief StorageIndex signed type
      * \details Eigen uses signed indexes
      */
     using StorageIndexSigned = typename std::make_signed<StorageIndex>::type;
 
-    /*! \brief Base alias
-     * \details Alias to base class with implicit template params
+    /*! \brief EventsSet
      */
-    using DESystemBase = DESystemBase<NEvents, StorageIndex>;
+    using EventsSet_t = EventsSet<NEvents>;
 
     /*! \brief Set of states type
      *  \details Set containg unsigned interget types which represent states.
      */
-    using StatesSet = typename DESystemBase::StatesSet;
+    using StatesSet = std::set<StorageIndex>;
 
-    /*! Adjacency matrix on device memory
+    /*! \brief Backend which runs the kernels
      */
-    using GraphDeviceData = viennacl::compressed_matrix<float>;
+    using Backend = backend::Accelerator<NEvents, StorageIndex>;
 
-    /*! Sparse vector for BFS operations
+    /*! Adjacency matrix on accelerator memory
      */
-    using StatesDeviceVector = viennacl::compressed_matrix<float>;
+    using GraphDeviceData = typename Backend::Graph;
 
-    /*! \brief Graph const iterator
-     * \details Used to iterate over the bfs result
-     */
-    using ColIteratorConst = Eigen::InnerIterator<StatesVector const>;
-
-    /*! \brief DESystemCL constructor by copying ublas object
+    /*! \brief DESystemCL constructor by copying a host system
      *
      * Creates a new system based on a existent host system.
      *
-     * @param aSys System on device memory
+     * @param aSys System on host memory
+     * @param aBackend Backend which runs the kernels
      */
-    DESystemCL(DESystem<NEvents, StorageIndex>& aSys);
+    explicit DESystemCL(
+      DESystem<NEvents, StorageIndex> const& aSys,
+      std::shared_ptr<Backend> aBackend =
+        backend::hostAccelerator<NEvents, StorageIndex>());
 
     /*! \brief DESystemCL destructor
      */
@@ -105,22 +103,47 @@ public:
 
     DESystemCL<NEvents, StorageIndex>& operator=(DESystemCL const&) = default;
 
-    /*! \brief clone method for polymorphic copy
-     *  \return Shared pointer to this object
+    /*! \brief Returns number of states of the system
+     */
+    StorageIndex size() const noexcept { return graph_.rows; }
+
+    /*! \brief Returns number of states of the system
+     */
+    StorageIndex getStatesNumber() const noexcept { return graph_.rows; }
+
+    /*! \brief Returns the initial state
+     */
+    StorageIndex getInitialState() const noexcept { return init_state_; }
+
+    /*! \brief Returns marked states
      */
-    std::shared_ptr<DESystemBase> clone() const override;
+    StatesSet const& getMarkedStates() const noexcept
+    {
+        return marked_states_;
+    }
+
+    /*! \brief Returns the set of events of the system
+     */
+    EventsSet_t getEvents() const noexcept { return events_; }
 
     /*! \brief Check if this system is a proxy
      * \details DESystemCL is always a real sys
      */
-    bool isVirtual() const override;
+    bool constexpr static isVirtual() noexcept { return false; }
+
+    /*! \brief Memory held by the system, by table
+     * \details Graphs are counted as CSR arrays: on device backends, they
+     * are the bytes of device memory.
+     */
+    MemoryUsage memoryUsage() const noexcept;
 
     /*! \brief Graph getter
-     *
-     * Returns a copy of DESystemCL's private data member graph. Considering
-     * that graph is a pointer, it returns the contents of graph.
      */
-    GraphDeviceData getGraph() const;
+    GraphDeviceData const& getGraph() const noexcept { return graph_; }
+
+    /*! \brief Backend getter
+     */
+    Backend& getBackend() const noexcept { return *backend_; }
 
     /*! \brief Returns state set containing the accessible part of automa
      *
@@ -128,14 +151,18 @@ public:
      * starting from its initial state. It returns a set containing all nodes
      * which are accessible from the initial state.
      */
-    StatesSet accessiblePart();
+    StatesSet accessiblePart() const;
 
     /*! \brief Returns state set containing the coaccessible part of automata
      *
-     * Executes a Breadth First Search in the graph, until it reaches a marked
-     * state.
+     * Executes a Breadth First Search in the inverted graph, starting from
+     * the marked states.
+     */
+    StatesSet coaccessiblePart() const;
+
+    /*! \brief Returns the states which are accessible and coaccessible
      */
-    StatesSet coaccessiblePart();
+    StatesSet trimStates() const;
 
     /*! \brief Returns true if DES transition exists
      *
@@ -143,15 +170,19 @@ public:
      * @param aEvent Event
      */
     bool containstrans(StorageIndex const& aQ,
-                       ScalarType const& aEvent) const override;
+                       ScalarType const& aEvent) const noexcept
+    {
+        return states_events_[aQ].test(aEvent);
+    }
 
     /*! \brief Returns DES transition: q_to = f(q, e)
      *
      * @param aQ State
      * @param aEvent Event
+     * \return The state where the transition leads or -1 when it is empty
      */
     StorageIndexSigned trans(StorageIndex const& aQ,
-                             ScalarType const& aEvent) const override;
+                             ScalarType const& aEvent) const noexcept;
 
     /*! \brief Returns true if DES inverse transition exists
      *
@@ -159,126 +190,139 @@ public:
      * @param aEvent Event
      */
     bool containsinvtrans(StorageIndex const& aQ,
-                          ScalarType const& aEvent) const override;
+                          ScalarType const& aEvent) const noexcept
+    {
+        return inv_states_events_[aQ].test(aEvent);
+    }
 
     /*! \brief Returns DES inverse transition: q = f^-1(q_to, e)
+     * \details Requires allocateInvertedGraph().
      *
-     * @param aQfrom State
+     * @param aQ State
      * @param aEvent Event
      */
-    StatesArray<StorageIndex> invtrans(StorageIndex const& aQfrom,
-                                       ScalarType const& aEvent) const override;
-
-    /*! \brief Returns EventsSet relative to state q
-     *
-     * @param aQ A state on the sys
-     */
-    EventsSet<NEvents> getStateEvents(StorageIndex const& aQ) const override;
-
-    /*! \brief Returns EventsSet relative to state inv q
-     *
-     * @param aQ A state on the sys
-     */
-    EventsSet<NEvents> getInvStateEvents(StorageIndex const& aQ) const override;
+    StatesArray<StorageIndex> invtrans(StorageIndex const& aQ,
+                                       ScalarType const& aEvent) const;
 
-    /*! \brief Invert graph
+    /*! \brief Visit every transition leaving a state
      *
+     * @param aQ State
+     * @param aFunction Callable with signature (event, qto)
      */
-    void allocateInvertedGraph() const override;
+    template<class Function>
+    void forEachSuccessor(StorageIndex const& aQ, Function&& aFunction) const;
 
-    /*! \brief Free inverted graph
+    /*! \brief Visit every transition arriving to a state
+     * \details Requires allocateInvertedGraph().
      *
+     * @param aQ State
+     * @param aEvents Mask of the visited events
+     * @param aFunction Callable with signature (event, qfrom)
      */
-    void clearInvertedGraph() const override;
+    template<class Function>
+    void forEachPredecessor(StorageIndex const& aQ,
+                            EventsSet_t const& aEvents,
+                            Function&& aFunction) const;
 
-    /*! \brief Observer property checker
+    /*! \brief Returns EventsSet relative to state q
      *
-     * @param aLang Language
+     * @param aQ A state on the sys
      */
-    bool constexpr checkObsProp_imp(EventsSet aLang) const noexcept
+    EventsSet_t getStateEvents(StorageIndex const& aQ) const noexcept
     {
-        return false;
+        return states_events_[aQ];
     }
 
-    /*! \brief Projection operation
+    /*! \brief Returns EventsSet relative to state inv q
      *
-     * @param aAlphanet Events set which the system will be projected.
+     * @param aQ A state on the sys
      */
-    DESystemCL& constexpr proj_impl(EventsSet aAlphabet) const noexcept
+    EventsSet_t getInvStateEvents(StorageIndex const& aQ) const noexcept
     {
-        return *this;
+        return inv_states_events_[aQ];
     }
 
-    /*! \brief Inverse projection operation
-     *
-     * @param aLang Set of events
+    /*! \brief Invert graph with the transpose kernel
      */
-    DESystemCL& constexpr invproj_impl(EventsSet aAlphabet) const noexcept
-    {
-        return *this;
-    }
+    void allocateInvertedGraph() const;
+
+    /*! \brief Free inverted graph
+     */
+    void clearInvertedGraph() const noexcept { inv_graph_.reset(); }
+
+    /*! \brief Copy the system to host memory
+     */
+    DESystem<NEvents, StorageIndex> toDESystem() const;
 
 protected:
-    /*! \brief Default constructor disabled
-     *
-     * Declare default constructor as protected to avoid the class user of
-     * calling it.
+    /*! \brief Build a system from a graph computed by the backend
      */
-    explicit DESystemCL() = default;
+    DESystemCL(GraphDeviceData aGraph,
+               StorageIndex const aInitState,
+               StatesSet aMarkedStates,
+               EventsSet_t const& aEvents,
+               std::shared_ptr<Backend> aBackend);
+
+    /*! \brief Build the states events tables from graph_
+     */
+    void buildStatesEvents_();
 
 private:
-    friend class DESystem<NEvents, StorageIndex>;
+    template<uint8_t NEv, typename StIdx>
+    friend DESystemCL<NEv, StIdx> op::synchronize(
+      DESystemCL<NEv, StIdx> const& aSys0,
+      DESystemCL<NEv, StIdx> const& aSys1);
 
-    /*! \brief Graph data on device memory
-     *
-     * transposed graph_ data, but on device memory (usually a GPU). It is a
-     * dev_cache_enabled_ is false. It cannot be const, since it may change as
-     * dev_cache_enabled_ changes.
-     *
+    /*! \brief Graph data on accelerator memory
      */
-    GraphDeviceData device_graph_;
-    GraphHostData graph_;
+    GraphDeviceData graph_;
 
-    /*! \brief Pointer to beckend singleton object
+    /*! \brief Inverted graph, built by allocateInvertedGraph()
      */
-    static std::unique_ptr<backend::OclBackend> backend_ptr_;
+    std::shared_ptr<GraphDeviceData const> mutable inv_graph_;
 
-    /*! \brief Setup BFS and return accessed states array
-     *
-     * Executes a breadth first search on the graph starting from N nodes
-     * in aInitialNodes. The algorithm is based on SpGEMM.
-     *
-     * @param aInitialNodes Set of nodes where the searches will start
+    /*! \brief Events leaving and arriving to each state
      */
-    template<class StatesType>
-    std::shared_ptr<StatesSet> bfs_(
-      StatesType const& aInitialNodes,
-      std::function<void(StorageIndex const&, StorageIndex const&)> const&
-        aBfsVisit);
+    std::vector<EventsSet_t> states_events_;
+    std::vector<EventsSet_t> inv_states_events_;
 
-    /*! \brief Calculates Bfs and returns accessed states array
-     *
-     * Executes a breadth first search on the graph starting from one single
-     * node. The algorithm is based on SpGEMM.
-     *
-     * @param aInitialNode Where the search will start
-     */
-    std::shared_ptr<StatesSet> bfsCalc_(
-      StatesVector& aHostX,
-      std::function<void(StorageIndex const&, StorageIndex const&)> const&
-        aBfsVisit,
-      std::vector<StorageIndex> const* const aStatesMap);
+    EventsSet_t events_;
+    StorageIndex init_state_;
+    StatesSet marked_states_;
 
-    /*! \brief Return a pointer to accessed states from the initial state
-     *
-     * Executes a breadth first search on the graph starting from init_state_.
+    /*! \brief Backend which runs the kernels
      */
-    std::shared_ptr<StatesSet> bfs_();
+    std::shared_ptr<Backend> backend_;
+};
+
+/*! \brief SysTraits specialization for accelerator systems
+ */
+template<uint8_t NEvents, typename StorageIndex>
+struct SysTraits<DESystemCL<NEvents, StorageIndex>>
+{
+    uint8_t static constexpr Ne_ = NEvents;
+    using Si_ = StorageIndex;
 };
 
+namespace op {
+
+/*! \brief Parallel composition on the backend of aSys0
+ * \details Runs the CSR join kernel of the backend. The result holds the
+ * accessible part, numbered as the result of the synchronize() of host
+ * systems.
+ *
+ * @param aSys0 Left operand
+ * @param aSys1 Right operand
+ * \return Accessible part of the parallel composition
+ */
+template<uint8_t NEvents, typename StorageIndex>
+DESystemCL<NEvents, StorageIndex> synchronize(
+  DESystemCL<NEvents, StorageIndex> const& aSys0,
+  DESystemCL<NEvents, StorageIndex> const& aSys1);
+}
+
 } // namespace cldes
 
 #include "cldes/src/des/DESystemCLCore.hpp"
 
 #endif // DESYSTEMCL_HPP
-#endif // CLDES_OPENCL_ENABLED
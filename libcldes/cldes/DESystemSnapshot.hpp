@@ -0,0 +1,312 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/DESystemSnapshot.hpp
+ Description: DESystemSnapshot template class declaration. An immutable
+ system with all its indexes built on construction.
+ =========================================================================
+*/
+/*!
+ * \file cldes/DESystemSnapshot.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-24
+ *
+ * DESystemSnapshot template class declaration. An immutable system with all
+ * its indexes built on construction.
+ */
+
+#ifndef DESYSTEM_SNAPSHOT_HPP
+#define DESYSTEM_SNAPSHOT_HPP
+
+#include "cldes/DESystem.hpp"
+#include "cldes/DESystemBase.hpp"
+#include "cldes/src/des/DESystemSnapshotFwd.hpp"
+
+namespace cldes {
+
+/*! \class DESystemSnapshot
+ *  \brief An immutable discrete-events system safe for concurrent queries
+ *  \details DESystem builds its inverted graph on demand, and proxies
+ *  allocate and free it on the components they reference, so concurrent
+ *  operations sharing a system race on it. A snapshot copies a system and
+ *  builds both the forward and the inverted graphs on construction. No
+ *  method changes it afterwards: allocateInvertedGraph() and
+ *  clearInvertedGraph() do nothing, and the base setters are hidden.
+ *  Hence any number of threads can query a snapshot, or use it as a
+ *  component of proxies and operations, without locking.
+ *
+ *  Both graphs are stored in CSR arrays: the transitions leaving (or
+ *  arriving to) a state are contiguous in memory.
+ *
+ * \tparam NEvents Number of events: max 255
+ * \tparam StorageIndex Unsigned type used for indexing states
+ */
+template<uint8_t NEvents, typename StorageIndex>
+class DESystemSnapshot
+  : public DESystemBase<NEvents,
+                        StorageIndex,
+                        DESystemSnapshot<NEvents, StorageIndex>>
+{
+public:
+    /*! \brief Base alias
+     * \details Alias to base class with implicit template params
+     */
+    using Base = DESystemBase<NEvents,
+                              StorageIndex,
+                              DESystemSnapshot<NEvents, StorageIndex>>;
+
+    /*! \brief StorageIndex signed type
+     */
+    using StorageIndexSigned = typename std::make_signed<StorageIndex>::type;
+
+    /*! \brief EventsSet
+     *  \details Set containing 8bit intergets which represent events.
+     */
+    using EventsSet_t = EventsSet<NEvents>;
+
+    /*! \brief Set of states type
+     */
+    using StatesSet = typename Base::StatesSet;
+
+    /*! \brief Table of events per state
+     */
+    using StatesEventsTable = typename Base::StatesEventsTable;
+
+    /*! \brief Snapshot constructor
+     * \details Copy a concrete system and build its indexes.
+     *
+     * @param aSys System which will be copied
+     */
+    explicit DESystemSnapshot(DESystem<NEvents, StorageIndex> const& aSys);
+
+    /*! \brief Move constructor
+     *  \details Enable move semantics
+     */
+    DESystemSnapshot(DESystemSnapshot&&) = default;
+
+    /*! \brief Copy constructor
+     */
+    DESystemSnapshot(DESystemSnapshot const&) = default;
+
+    /*! \brief Snapshots are immutable: assignment is disabled
+     */
+    DESystemSnapshot& operator=(DESystemSnapshot&&) = delete;
+    DESystemSnapshot& operator=(DESystemSnapshot const&) = delete;
+
+    /*! \brief DESystemSnapshot destructor
+     */
+    ~DESystemSnapshot() = default;
+
+    /*! \brief clone method for polymorphic copy
+     *  \return Shared pointer to a copy of this object
+     */
+    std::shared_ptr<Base> clone_impl() const noexcept
+    {
+        std::shared_ptr<Base> this_ptr =
+          std::make_shared<DESystemSnapshot>(*this);
+        return this_ptr;
+    }
+
+    /*! \brief Check if this system is a virtual proxy
+     *
+     *  \return False: a snapshot is a concrete system
+     */
+    bool constexpr static isVirtual_impl() noexcept { return false; }
+
+    /*! \brief Memory held by the system, by table
+     * \details Both graphs are always allocated.
+     */
+    MemoryUsage memoryUsage_impl() const noexcept;
+
+    /*! \brief Check if transition exists
+     *
+     * @param aQ State
+     * @param aEvent Event
+     * \return Returns true if DES transition exists, false otherwise
+     */
+    bool containstrans_impl(StorageIndex const& aQ,
+                            ScalarType const& aEvent) const noexcept
+    {
+        return this->states_events_[aQ].test(aEvent);
+    }
+
+    /*! \brief Transition function
+     * \details Linear on the number of states reached from aQ.
+     *
+     * @param aQ State
+     * @param aEvent Event
+     * \return The state where the transition leads or -1 when it is empty
+     */
+    StorageIndexSigned trans_impl(StorageIndex const& aQ,
+                                  ScalarType const& aEvent) const noexcept;
+
+    /*! \brief Check if the system contains an inverse transition
+     * \details The inverted graph is always available.
+     *
+     * @param aQ State
+     * @param aEvent Event
+     * \return True if DES inverse transition exists, false otherwise
+     */
+    bool containsinvtrans_impl(StorageIndex const& aQ,
+                               ScalarType const& aEvent) const noexcept
+    {
+        return this->inv_states_events_[aQ].test(aEvent);
+    }
+
+    /*! \brief DES inverse transition function
+     * \details It does not require allocateInvertedGraph().
+     *
+     * @param aQ State
+     * @param aEvent Event
+     * \return DES states array containing the inverse transition.
+     * It may be empty, if there is none.
+     */
+    StatesArray<StorageIndex> invtrans_impl(StorageIndex const& aQ,
+                                            ScalarType const& aEvent) const;
+
+    /*! \brief Visit the transitions leaving a state
+     * \details Transitions are contiguous on the CSR arrays.
+     *
+     * @param aQ State
+     * @param aFunction Callable with signature (event, qto)
+     * \return void
+     */
+    template<class Function>
+    void forEachSuccessor_impl(StorageIndex const& aQ,
+                               Function& aFunction) const;
+
+    /*! \brief Visit the transitions arriving to a state
+     * \details It does not require allocateInvertedGraph().
+     *
+     * @param aQ State
+     * @param aEvents Mask of the visited events
+     * @param aFunction Callable with signature (event, qfrom)
+     * \return void
+     */
+    template<class Function>
+    void forEachPredecessor_impl(StorageIndex const& aQ,
+                                 EventsSet_t const& aEvents,
+                                 Function& aFunction) const;
+
+    /*! \brief Get events of all transitions of a specific state
+     *
+     * @param aQ A state on the sys
+     * \return Returns EventsSet_t relative to state q
+     */
+    EventsSet_t getStateEvents_impl(StorageIndex const& aQ) const noexcept
+    {
+        return this->states_events_[aQ];
+    }
+
+    /*! \brief Get events of all transitions that lead to a specific state
+     *
+     * @param aQ A state on the sys
+     * \return Returns EventsSet_t relative to inverse transitions of aQ
+     */
+    EventsSet_t getInvStateEvents_impl(StorageIndex const& aQ) const noexcept
+    {
+        return this->inv_states_events_[aQ];
+    }
+
+    /*! \brief Inverted graph is built on construction: nothing to do
+     *
+     * \return void
+     */
+    void allocateInvertedGraph_impl() const noexcept {}
+
+    /*! \brief Inverted graph lives as long as the snapshot: nothing to do
+     *
+     * \return void
+     */
+    void clearInvertedGraph_impl() const noexcept {}
+
+    /*! \brief Observer property checker
+     *
+     * @param aAlphabet Observable events
+     */
+    bool checkObsProp_impl(EventsSet_t const&) const noexcept { return false; }
+
+protected:
+    /*! \brief Disabled default constructor
+     * \details There is no use for the default constructor.
+     */
+    DESystemSnapshot() = default;
+
+    /*! \brief Build a CSR graph from a list of transitions
+     * \details Counting sort by the source state, so each row keeps the
+     * order of aTransitions.
+     *
+     * @param aTransitions Transitions (source, target, events)
+     * @param[out] aGraph CSR graph
+     * @param[out] aStatesEvents Union of the events of each row
+     * \return void
+     */
+    void buildCsr_(SnapshotTriplets<NEvents, StorageIndex> const& aTransitions,
+                   SnapshotCsr<NEvents, StorageIndex>& aGraph,
+                   StatesEventsTable& aStatesEvents) const noexcept;
+
+private:
+    /*! \brief Base setters are hidden: snapshots are immutable
+     */
+    using Base::insertMarkedState;
+    using Base::resizeStatesEvents;
+    using Base::setEvents;
+    using Base::setInitialState;
+    using Base::setInvStateEvents;
+    using Base::setInvStatesEvents;
+    using Base::setMarkedStates;
+    using Base::setStateEvents;
+    using Base::setStatesEvents;
+    using Base::setStatesNumber;
+    using Base::proj;
+
+    /*! \brief Forward graph: transitions leaving each state
+     */
+    SnapshotCsr<NEvents, StorageIndex> graph_;
+
+    /*! \brief Inverted graph: transitions arriving to each state
+     */
+    SnapshotCsr<NEvents, StorageIndex> inv_graph_;
+};
+
+/*! \brief Build an immutable snapshot of a system
+ *
+ * @param aSys System which will be copied
+ * \return Snapshot of aSys
+ */
+template<uint8_t NEvents, typename StorageIndex>
+DESystemSnapshot<NEvents, StorageIndex>
+makeSnapshot(DESystem<NEvents, StorageIndex> const& aSys)
+{
+    return DESystemSnapshot<NEvents, StorageIndex>{ aSys };
+}
+
+} // namespace cldes
+
+// class methods definitions
+#include "cldes/src/des/DESystemSnapshotCore.hpp"
+
+#endif // DESYSTEM_SNAPSHOT_HPP
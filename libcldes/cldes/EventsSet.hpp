@@ -139,6 +139,22 @@ operator+(EventsSet<NEvents> const& aLhs, EventsSet<NEvents> const& aRhs)
     return aLhs | aRhs;
 }
 
+/*! \brief Call aFunction(event) for each event of aEvents, in order
+ */
+template<uint8_t NEvents, class Function>
+inline void
+forEachEvent(EventsSet<NEvents> const& aEvents, Function&& aFunction)
+{
+    if (aEvents.none()) {
+        return;
+    }
+    for (auto e = 0u; e < NEvents; ++e) {
+        if (aEvents.test(e)) {
+            aFunction(static_cast<uint8_t>(e));
+        }
+    }
+}
+
 template<uint8_t NEvents>
 inline EventsSet<NEvents> const&
 conj(EventsSet<NEvents> const& x) noexcept
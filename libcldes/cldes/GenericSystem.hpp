@@ -36,13 +36,23 @@
  *
  * Generic wrapper dispatcher to implement a type erasure
  * approach, since DESystemBase implement a static polymorphism approach.
+ *
+ * Each query is a virtual call. Explorations should query blocks of states
+ * (getStatesEventsBlock(), getSuccessorsBlock(), isMarkedBlock()), which pay
+ * a single virtual call per block, or pull the concrete system out with
+ * tryCast() or visitAs() and run statically typed.
  */
 
 #ifndef GENERIC_SYSTEM_HPP
 #define GENERIC_SYSTEM_HPP
 
+#include "cldes/Constants.hpp"
+#include "cldes/EventsSet.hpp"
+#include "cldes/MemoryUsage.hpp"
+#include <memory>
 #include <set>
 #include <typeinfo>
+#include <vector>
 
 namespace cldes {
 template<uint8_t NEvents, typename StorageIndex>
@@ -52,6 +62,33 @@ struct GenericSystem
     using StorageIndexSigned = typename std::make_signed<StorageIndex>::type;
     using StatesArray = std::vector<StorageIndex>;
 
+    /*! \brief Transitions of a block of states
+     * \details Transitions leaving the i-th state of the block are on the
+     * range [offsets[i], offsets[i + 1]) of events and states. Reusing a
+     * block between calls reuses its buffers.
+     */
+    struct TransitionsBlock
+    {
+        std::vector<std::size_t> offsets;
+        std::vector<ScalarType> events;
+        std::vector<StorageIndex> states;
+    };
+
+    /*! \brief Non-owning reference to a transitions visitor
+     * \details Visitors cross the virtual boundary without copies or
+     * allocations: it only holds the visitor address and a trampoline.
+     */
+    struct TransitionVisitor
+    {
+        void* context;
+        void (*call)(void*, ScalarType, StorageIndex);
+
+        void operator()(ScalarType const aEvent, StorageIndex const aQ) const
+        {
+            call(context, aEvent, aQ);
+        }
+    };
+
     struct InnerSystemBase
     {
         using ptr = std::unique_ptr<InnerSystemBase>;
@@ -92,9 +129,33 @@ struct GenericSystem
         virtual bool containsinvtrans(StorageIndex const& aQ,
                                       ScalarType e) const noexcept = 0;
 
+        virtual void forEachSuccessor(
+          StorageIndex const& aQ,
+          TransitionVisitor const& aVisitor) const = 0;
+
+        virtual void forEachPredecessor(
+          StorageIndex const& aQ,
+          EventsSet<NEvents> const& aEvents,
+          TransitionVisitor const& aVisitor) const = 0;
+
+        virtual void getStatesEventsBlock(
+          StorageIndex const* aStates,
+          std::size_t const aCount,
+          EventsSet<NEvents>* aEvents) const noexcept = 0;
+
+        virtual void isMarkedBlock(StorageIndex const* aStates,
+                                   std::size_t const aCount,
+                                   bool* aMarked) const noexcept = 0;
+
+        virtual void getSuccessorsBlock(StorageIndex const* aStates,
+                                        std::size_t const aCount,
+                                        TransitionsBlock& aBlock) const = 0;
+
         virtual void allocateInvertedGraph() const noexcept = 0;
 
         virtual void clearInvertedGraph() const noexcept = 0;
+
+        virtual MemoryUsage memoryUsage() const noexcept = 0;
     };
 
     template<typename SysT_>
@@ -181,6 +242,58 @@ struct GenericSystem
             return innersys_.containsinvtrans(aQ, e);
         }
 
+        void forEachSuccessor(StorageIndex const& aQ,
+                              TransitionVisitor const& aVisitor) const override
+        {
+            innersys_.forEachSuccessor(aQ, aVisitor);
+        }
+
+        void forEachPredecessor(
+          StorageIndex const& aQ,
+          EventsSet<NEvents> const& aEvents,
+          TransitionVisitor const& aVisitor) const override
+        {
+            innersys_.forEachPredecessor(aQ, aEvents, aVisitor);
+        }
+
+        void getStatesEventsBlock(StorageIndex const* aStates,
+                                  std::size_t const aCount,
+                                  EventsSet<NEvents>* aEvents) const
+          noexcept override
+        {
+            for (auto i = 0ul; i < aCount; ++i) {
+                aEvents[i] = innersys_.getStateEvents(aStates[i]);
+            }
+        }
+
+        void isMarkedBlock(StorageIndex const* aStates,
+                           std::size_t const aCount,
+                           bool* aMarked) const noexcept override
+        {
+            for (auto i = 0ul; i < aCount; ++i) {
+                aMarked[i] = innersys_.isMarked(aStates[i]);
+            }
+        }
+
+        void getSuccessorsBlock(StorageIndex const* aStates,
+                                std::size_t const aCount,
+                                TransitionsBlock& aBlock) const override
+        {
+            aBlock.offsets.resize(aCount + 1ul);
+            aBlock.events.clear();
+            aBlock.states.clear();
+            aBlock.offsets[0] = 0ul;
+            for (auto i = 0ul; i < aCount; ++i) {
+                innersys_.forEachSuccessor(
+                  aStates[i],
+                  [&aBlock](ScalarType const aEvent, StorageIndex aQto) {
+                      aBlock.events.push_back(aEvent);
+                      aBlock.states.push_back(aQto);
+                  });
+                aBlock.offsets[i + 1ul] = aBlock.states.size();
+            }
+        }
+
         void allocateInvertedGraph() const noexcept override
         {
             return innersys_.allocateInvertedGraph();
@@ -191,6 +304,11 @@ struct GenericSystem
             return innersys_.clearInvertedGraph();
         }
 
+        MemoryUsage memoryUsage() const noexcept override
+        {
+            return innersys_.memoryUsage();
+        }
+
     private:
         SysT_ innersys_;
     };
@@ -228,7 +346,34 @@ struct GenericSystem
     template<typename SysT_>
     SysT_ const& cast() const
     {
-        return *dynamic_cast<InnerSystem<SysT_>&>(*inner_);
+        return *dynamic_cast<InnerSystem<SysT_> const&>(*inner_);
+    }
+
+    /*! \brief Non-virtual fast path
+     * \details Returns the wrapped system when its type is SysT_, so hot
+     * loops can be instantiated for it.
+     *
+     * \return Pointer to the wrapped system or nullptr
+     */
+    template<typename SysT_>
+    SysT_ const* tryCast() const noexcept
+    {
+        if (inner_->type() != typeid(SysT_)) {
+            return nullptr;
+        }
+        return &**static_cast<InnerSystem<SysT_> const*>(inner_.get());
+    }
+
+    /*! \brief Call aFunction with the wrapped system as its concrete type
+     * \details The candidate types SysTs are tried in order.
+     *
+     * @param aFunction Generic callable receiving the concrete system
+     * \return False if the wrapped system is none of SysTs
+     */
+    template<typename... SysTs, class Function>
+    bool visitAs(Function&& aFunction) const
+    {
+        return visitAs_<SysTs...>(aFunction);
     }
 
     std::type_info const& type() const noexcept { return inner_->type(); }
@@ -297,6 +442,97 @@ struct GenericSystem
         return inner_->clearInvertedGraph();
     }
 
+    /*! \brief Memory held by the wrapped system, by table
+     */
+    MemoryUsage memoryUsage() const noexcept { return inner_->memoryUsage(); }
+
+    /*! \brief Events of a block of states: one virtual call per block
+     *
+     * @param aStates First state of the block
+     * @param aCount Number of states
+     * @param[out] aEvents Array of aCount events sets
+     */
+    void getStatesEventsBlock(StorageIndex const* aStates,
+                              std::size_t const aCount,
+                              EventsSet<NEvents>* aEvents) const noexcept
+    {
+        inner_->getStatesEventsBlock(aStates, aCount, aEvents);
+    }
+
+    /*! \brief Marked flags of a block of states
+     * \details It does not copy the marked states as getMarkedStates(), and
+     * reads them from the wrapped system, so changes made through cast() are
+     * seen.
+     *
+     * @param aStates First state of the block
+     * @param aCount Number of states
+     * @param[out] aMarked Array of aCount flags
+     */
+    void isMarkedBlock(StorageIndex const* aStates,
+                       std::size_t const aCount,
+                       bool* aMarked) const noexcept
+    {
+        inner_->isMarkedBlock(aStates, aCount, aMarked);
+    }
+
+    /*! \brief Transitions leaving a block of states
+     *
+     * @param aStates First state of the block
+     * @param aCount Number of states
+     * @param[out] aBlock Transitions of each state
+     */
+    void getSuccessorsBlock(StorageIndex const* aStates,
+                            std::size_t const aCount,
+                            TransitionsBlock& aBlock) const
+    {
+        inner_->getSuccessorsBlock(aStates, aCount, aBlock);
+    }
+
+    template<class Function>
+    void forEachSuccessor(StorageIndex const& aQ, Function&& aFunction) const
+    {
+        inner_->forEachSuccessor(aQ, makeVisitor_(aFunction));
+    }
+
+    template<class Function>
+    void forEachPredecessor(StorageIndex const& aQ,
+                            EventsSet<NEvents> const& aEvents,
+                            Function&& aFunction) const
+    {
+        inner_->forEachPredecessor(aQ, aEvents, makeVisitor_(aFunction));
+    }
+
+    /*! \brief Wrap a callable on a TransitionVisitor
+     */
+    template<class Function>
+    static TransitionVisitor makeVisitor_(Function& aFunction) noexcept
+    {
+        auto* const context = const_cast<void*>(
+          static_cast<void const*>(std::addressof(aFunction)));
+        return TransitionVisitor{
+            context,
+            [](void* aContext, ScalarType const aEvent, StorageIndex aQ) {
+                (*static_cast<Function*>(aContext))(aEvent, aQ);
+            }
+        };
+    }
+
+    template<class Function>
+    bool visitAs_(Function&) const noexcept
+    {
+        return false;
+    }
+
+    template<typename SysT_, typename... SysTs, class Function>
+    bool visitAs_(Function& aFunction) const
+    {
+        if (auto const* sys = tryCast<SysT_>()) {
+            aFunction(*sys);
+            return true;
+        }
+        return visitAs_<SysTs...>(aFunction);
+    }
+
     typename InnerSystemBase::ptr inner_;
 };
 
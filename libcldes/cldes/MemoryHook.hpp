@@ -0,0 +1,295 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/MemoryHook.hpp
+ Description: Replacement of the allocation functions which feeds
+ MemoryTracker.
+ =========================================================================
+*/
+/*!
+ * \file cldes/MemoryHook.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-12-04
+ *
+ * Counting allocation hook. Include it in exactly one translation unit of
+ * the program, e.g. the one with main(). Programs which do not include it
+ * pay nothing, and their trackers read 0.
+ *
+ * On glibc, it replaces malloc(), calloc(), realloc(), free() and the
+ * aligned allocation functions, and forwards them to the glibc ones. The
+ * standard operator new allocates with malloc(), so both are counted, and
+ * so are the sparsepp tables, whose allocator calls malloc() and realloc()
+ * directly. Blocks are counted by their usable size.
+ *
+ * Elsewhere, it replaces the global operator new and operator delete only:
+ * each block carries a header with its size, so deallocations without size
+ * are counted too. Tables allocated with malloc() are not counted there.
+ */
+
+#ifndef MEMORY_HOOK_HPP
+#define MEMORY_HOOK_HPP
+
+#include "cldes/MemoryUsage.hpp"
+#include <cstdlib>
+#include <new>
+
+#ifdef __GLIBC__
+#include <cerrno>
+#include <malloc.h>
+
+extern "C" {
+// Allocation functions of glibc, under their internal names
+void* __libc_malloc(std::size_t aBytes);
+void* __libc_calloc(std::size_t aCount, std::size_t aBytes);
+void* __libc_realloc(void* aPtr, std::size_t aBytes);
+void* __libc_memalign(std::size_t aAlignment, std::size_t aBytes);
+void* __libc_valloc(std::size_t aBytes);
+void* __libc_pvalloc(std::size_t aBytes);
+void __libc_free(void* aPtr);
+}
+#endif
+
+namespace cldes {
+
+/*! \brief Mark the counters as updated
+ */
+static bool const kMemoryHookInstalled_ =
+  (allocationCounters_().hooked.store(true), true);
+
+#ifdef __GLIBC__
+/*! \brief Count a block returned by glibc
+ */
+inline void*
+hookedCount_(void* const aPtr) noexcept
+{
+    if (aPtr != nullptr) {
+        countAllocation_(malloc_usable_size(aPtr));
+    }
+    return aPtr;
+}
+}
+
+extern "C" {
+
+void*
+malloc(std::size_t aBytes) noexcept
+{
+    return cldes::hookedCount_(__libc_malloc(aBytes));
+}
+
+void*
+calloc(std::size_t aCount, std::size_t aBytes) noexcept
+{
+    return cldes::hookedCount_(__libc_calloc(aCount, aBytes));
+}
+
+void*
+realloc(void* aPtr, std::size_t aBytes) noexcept
+{
+    if (aPtr == nullptr) {
+        return cldes::hookedCount_(__libc_malloc(aBytes));
+    }
+    auto const old_bytes = malloc_usable_size(aPtr);
+    auto* const ptr = __libc_realloc(aPtr, aBytes);
+    // Zero bytes free the block; a failure keeps it
+    if (ptr != nullptr || aBytes == 0ul) {
+        cldes::countDeallocation_(old_bytes);
+    }
+    return cldes::hookedCount_(ptr);
+}
+
+void
+free(void* aPtr) noexcept
+{
+    if (aPtr != nullptr) {
+        cldes::countDeallocation_(malloc_usable_size(aPtr));
+        __libc_free(aPtr);
+    }
+}
+
+void*
+memalign(std::size_t aAlignment, std::size_t aBytes) noexcept
+{
+    return cldes::hookedCount_(__libc_memalign(aAlignment, aBytes));
+}
+
+void*
+aligned_alloc(std::size_t aAlignment, std::size_t aBytes) noexcept
+{
+    return cldes::hookedCount_(__libc_memalign(aAlignment, aBytes));
+}
+
+int
+posix_memalign(void** aPtr,
+               std::size_t aAlignment,
+               std::size_t aBytes) noexcept
+{
+    if (aAlignment < sizeof(void*) ||
+        (aAlignment & (aAlignment - 1ul)) != 0ul) {
+        return EINVAL;
+    }
+    auto* const ptr = __libc_memalign(aAlignment, aBytes);
+    if (ptr == nullptr) {
+        return ENOMEM;
+    }
+    *aPtr = cldes::hookedCount_(ptr);
+    return 0;
+}
+
+void*
+valloc(std::size_t aBytes) noexcept
+{
+    return cldes::hookedCount_(__libc_valloc(aBytes));
+}
+
+void*
+pvalloc(std::size_t aBytes) noexcept
+{
+    return cldes::hookedCount_(__libc_pvalloc(aBytes));
+}
+}
+#else
+/*! \brief Size of the header in front of each block
+ * \details It keeps the blocks aligned as malloc aligns them.
+ */
+std::size_t constexpr kMemoryHookHeader = alignof(std::max_align_t);
+
+inline void*
+hookedAllocate_(std::size_t const aBytes) noexcept
+{
+    auto* const block =
+      static_cast<char*>(std::malloc(aBytes + kMemoryHookHeader));
+    if (block == nullptr) {
+        return nullptr;
+    }
+    *reinterpret_cast<std::size_t*>(block) = aBytes;
+    countAllocation_(aBytes);
+    return block + kMemoryHookHeader;
+}
+
+inline void
+hookedDeallocate_(void* const aPtr) noexcept
+{
+    if (aPtr == nullptr) {
+        return;
+    }
+    auto* const block = static_cast<char*>(aPtr) - kMemoryHookHeader;
+    countDeallocation_(*reinterpret_cast<std::size_t*>(block));
+    std::free(block);
+}
+
+/*! \brief Allocate or throw std::bad_alloc, after the new handler
+ */
+inline void*
+hookedNew_(std::size_t const aBytes)
+{
+    auto const bytes = aBytes > 0ul ? aBytes : 1ul;
+    for (;;) {
+        auto* const ptr = hookedAllocate_(bytes);
+        if (ptr != nullptr) {
+            return ptr;
+        }
+        auto const handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc{};
+        }
+        handler();
+    }
+}
+
+}
+
+void*
+operator new(std::size_t aBytes)
+{
+    return cldes::hookedNew_(aBytes);
+}
+
+void*
+operator new[](std::size_t aBytes)
+{
+    return cldes::hookedNew_(aBytes);
+}
+
+void*
+operator new(std::size_t aBytes, std::nothrow_t const&) noexcept
+{
+    try {
+        return cldes::hookedNew_(aBytes);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void*
+operator new[](std::size_t aBytes, std::nothrow_t const&) noexcept
+{
+    try {
+        return cldes::hookedNew_(aBytes);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void
+operator delete(void* aPtr) noexcept
+{
+    cldes::hookedDeallocate_(aPtr);
+}
+
+void
+operator delete[](void* aPtr) noexcept
+{
+    cldes::hookedDeallocate_(aPtr);
+}
+
+void
+operator delete(void* aPtr, std::size_t) noexcept
+{
+    cldes::hookedDeallocate_(aPtr);
+}
+
+void
+operator delete[](void* aPtr, std::size_t) noexcept
+{
+    cldes::hookedDeallocate_(aPtr);
+}
+
+void
+operator delete(void* aPtr, std::nothrow_t const&) noexcept
+{
+    cldes::hookedDeallocate_(aPtr);
+}
+
+void
+operator delete[](void* aPtr, std::nothrow_t const&) noexcept
+{
+    cldes::hookedDeallocate_(aPtr);
+}
+
+#endif
+
+#endif // MEMORY_HOOK_HPP
@@ -0,0 +1,182 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/MemoryUsage.hpp
+ Description: Memory held by systems and peak memory of operations.
+ =========================================================================
+*/
+/*!
+ * \file cldes/MemoryUsage.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-12-04
+ *
+ * Breakdown of the memory held by a system and tracker of the memory
+ * allocated by operations.
+ */
+
+#ifndef MEMORY_USAGE_HPP
+#define MEMORY_USAGE_HPP
+
+#include "cldes/src/MemoryUsageFwd.hpp"
+
+namespace cldes {
+
+/*! \brief Bytes held by a system, by table
+ * \details Returned by memoryUsage() of every system type. Sizes of
+ * hash tables and std::set nodes are estimates; vectors and sparse matrices
+ * count their capacity. Proxies count the tables they own, not their
+ * operands.
+ */
+struct MemoryUsage
+{
+    /*! \brief Adjacency matrix or transitions tables
+     */
+    uint64_t graph = 0ul;
+
+    /*! \brief Cached inverted graph, if allocated
+     */
+    uint64_t inverted_graph = 0ul;
+
+    /*! \brief Events leaving each state
+     */
+    uint64_t states_events = 0ul;
+
+    /*! \brief Events arriving to each state
+     */
+    uint64_t inv_states_events = 0ul;
+
+    /*! \brief Set of marked states
+     */
+    uint64_t marked_states = 0ul;
+
+    /*! \brief Proxy tables: states of the supervisor, virtual states and
+     * transitions waiting to be converted
+     */
+    uint64_t tables = 0ul;
+
+    /*! \brief Sum of all tables
+     */
+    uint64_t total() const noexcept
+    {
+        return graph + inverted_graph + states_events + inv_states_events +
+               marked_states + tables;
+    }
+
+    MemoryUsage& operator+=(MemoryUsage const& aOther) noexcept
+    {
+        graph += aOther.graph;
+        inverted_graph += aOther.inverted_graph;
+        states_events += aOther.states_events;
+        inv_states_events += aOther.inv_states_events;
+        marked_states += aOther.marked_states;
+        tables += aOther.tables;
+        return *this;
+    }
+};
+
+/*! \class MemoryTracker
+ * \brief Peak memory allocated while it is alive
+ * \details It reads the allocation counters of the process, which are
+ * updated only if one translation unit of the program includes
+ * cldes/MemoryHook.hpp, see there which allocations are counted.
+ * Allocations of all threads count: workers of the executors included, but
+ * also unrelated threads. Trackers can be nested.
+ *
+ * \code
+ * cldes::MemoryTracker tracker;
+ * auto supervisor = cldes::op::supC(plant, spec, non_contr);
+ * tracker.stop();
+ * std::cout << tracker.peakBytes() << std::endl;
+ * \endcode
+ */
+class MemoryTracker
+{
+public:
+    /*! \brief Start tracking
+     */
+    MemoryTracker() noexcept;
+
+    MemoryTracker(MemoryTracker const&) = delete;
+    MemoryTracker& operator=(MemoryTracker const&) = delete;
+
+    ~MemoryTracker() { stop(); }
+
+    /*! \brief Freeze the counters
+     * \details Stop trackers in the reverse order they were created.
+     *
+     * \return void
+     */
+    void stop() noexcept;
+
+    /*! \brief Check if the allocation hook is installed
+     * \return False if the counters are always 0
+     */
+    static bool hooked() noexcept
+    {
+        return allocationCounters_().hooked.load();
+    }
+
+    /*! \brief Highest memory in use above the memory at start
+     */
+    uint64_t peakBytes() const noexcept;
+
+    /*! \brief Memory in use minus the memory at start
+     */
+    int64_t currentBytes() const noexcept;
+
+    /*! \brief Number of allocations
+     */
+    uint64_t allocations() const noexcept;
+
+    /*! \brief Number of deallocations
+     */
+    uint64_t deallocations() const noexcept;
+
+    /*! \brief Sum of the sizes of all allocations
+     */
+    uint64_t allocatedBytes() const noexcept;
+
+private:
+    bool running_;
+    int64_t start_current_;
+    int64_t outer_peak_;
+    uint64_t start_allocations_;
+    uint64_t start_deallocations_;
+    uint64_t start_allocated_;
+
+    int64_t peak_;
+    int64_t current_;
+    uint64_t allocations_;
+    uint64_t deallocations_;
+    uint64_t allocated_;
+};
+
+} // namespace cldes
+
+// include methods definitions
+#include "cldes/src/MemoryUsageCore.hpp"
+
+#endif // MEMORY_USAGE_HPP
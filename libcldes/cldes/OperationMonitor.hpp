@@ -0,0 +1,203 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/OperationMonitor.hpp
+ Description: Cancellation, progress reports and resource budgets of long
+ running operations.
+ =========================================================================
+*/
+/*!
+ * \file cldes/OperationMonitor.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-27
+ *
+ * Cancellation, progress reports and resource budgets of long running
+ * operations.
+ */
+
+#ifndef OPERATION_MONITOR_HPP
+#define OPERATION_MONITOR_HPP
+
+#include "cldes/src/OperationMonitorFwd.hpp"
+
+namespace cldes {
+
+/*! \class CancellationToken
+ * \brief Shared flag which requests an operation to stop
+ * \details Copies share the same flag: keep one and pass the other to the
+ * operation.
+ */
+class CancellationToken
+{
+public:
+    CancellationToken()
+      : flag_{ std::make_shared<std::atomic<bool>>(false) }
+    {
+    }
+
+    /*! \brief Request the operations using this token to stop
+     */
+    void cancel() const noexcept { flag_->store(true); }
+
+    /*! \brief Check if cancel() was called on any copy of this token
+     */
+    bool isCancelled() const noexcept { return flag_->load(); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> flag_;
+};
+
+/*! \class OperationMonitor
+ * \brief Watches the progress of an operation
+ * \details Operations report their work with step() on the loops which may
+ * run for a long time. step() returns true when the operation has to stop:
+ * the token was cancelled, or a budget was exceeded. The operation then
+ * leaves its loops and returns an incomplete result, which the caller
+ * discards.
+ *
+ * Workers of a parallel loop share the monitor of the thread which started
+ * the loop: all methods are thread safe. Progress callbacks may run on any
+ * worker, but never concurrently.
+ */
+class OperationMonitor
+{
+public:
+    /*! \brief OperationMonitor constructor
+     * \details The clock of the time budget starts here.
+     *
+     * @param aToken Token checked on every step
+     * @param aBudget Time and memory limits
+     * @param aCallback Progress callback: it can be empty
+     * @param aInterval Number of states between checks of the clock and
+     * progress reports
+     */
+    explicit OperationMonitor(
+      CancellationToken const& aToken = CancellationToken{},
+      OperationBudget const& aBudget = OperationBudget{},
+      ProgressCallback aCallback = ProgressCallback{},
+      uint64_t const aInterval = kDefaultProgressInterval);
+
+    OperationMonitor(OperationMonitor const&) = delete;
+    OperationMonitor& operator=(OperationMonitor const&) = delete;
+
+    /*! \brief Report work done by the operation
+     *
+     * @param aStates Number of states visited since the last step
+     * @param aFrontier Number of states waiting to be visited
+     * @param aBytes Memory allocated (or released, when negative) since the
+     * last step
+     * \return True if the operation has to stop
+     */
+    bool step(uint64_t const aStates,
+              uint64_t const aFrontier,
+              int64_t const aBytes) noexcept;
+
+    /*! \brief Check if the operation has to stop, without reporting work
+     */
+    bool stopped() const noexcept { return reason() != AbortReason::kNone; }
+
+    /*! \brief Why the operation stopped
+     */
+    AbortReason reason() const noexcept
+    {
+        auto const reason = static_cast<AbortReason>(reason_.load());
+        if (reason == AbortReason::kNone && token_.isCancelled()) {
+            return AbortReason::kCancelled;
+        }
+        return reason;
+    }
+
+    /*! \brief Statistics collected so far
+     */
+    OperationProgress progress() const noexcept;
+
+    /*! \brief Send the last progress report
+     *
+     * \return void
+     */
+    void finish() noexcept;
+
+protected:
+    /*! \brief Record the first reason to stop
+     */
+    void abort_(AbortReason const aReason) noexcept;
+
+    /*! \brief Call the progress callback unless another thread is on it
+     */
+    void report_() noexcept;
+
+private:
+    CancellationToken token_;
+    OperationBudget budget_;
+    ProgressCallback callback_;
+    uint64_t interval_;
+    std::chrono::steady_clock::time_point start_;
+
+    std::atomic<uint64_t> states_;
+    std::atomic<uint64_t> frontier_;
+    std::atomic<int64_t> bytes_;
+    std::atomic<uint64_t> next_check_;
+    std::atomic<int> reason_;
+    std::mutex callback_mutex_;
+};
+
+/*! \brief Monitor of the operation running on this thread
+ * \return The installed monitor or nullptr, when the operation is not
+ * monitored
+ */
+inline OperationMonitor*
+currentMonitor() noexcept
+{
+    return currentMonitorPtr_();
+}
+
+/*! \class ScopedMonitor
+ * \brief Install a monitor on the calling thread while it is alive
+ */
+class ScopedMonitor
+{
+public:
+    explicit ScopedMonitor(OperationMonitor& aMonitor) noexcept
+      : previous_{ currentMonitorPtr_() }
+    {
+        currentMonitorPtr_() = &aMonitor;
+    }
+
+    ScopedMonitor(ScopedMonitor const&) = delete;
+    ScopedMonitor& operator=(ScopedMonitor const&) = delete;
+
+    ~ScopedMonitor() { currentMonitorPtr_() = previous_; }
+
+private:
+    OperationMonitor* previous_;
+};
+
+} // namespace cldes
+
+// include methods definitions
+#include "cldes/src/OperationMonitorCore.hpp"
+
+#endif // OPERATION_MONITOR_HPP
@@ -0,0 +1,195 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/OperationStats.hpp
+ Description: Opt-in statistics of the phases of the operations.
+ =========================================================================
+*/
+/*!
+ * \file cldes/OperationStats.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-12-03
+ *
+ * Per-phase wall time, visited states, examined transitions, hash table
+ * traffic and table sizes of the operations.
+ */
+
+#ifndef OPERATION_STATS_HPP
+#define OPERATION_STATS_HPP
+
+#include "cldes/src/OperationStatsFwd.hpp"
+
+namespace cldes {
+
+/*! \class OperationStats
+ * \brief Collects the statistics of the operations running on a thread
+ * \details Install it with ScopedStats before calling an operation. Each
+ * instrumented phase adds its counters to the record of its name:
+ *
+ * - "synchronize.stage2": synchronizeEmptyStage2()
+ * - "supC.findRemovedStates": exploration of the supervisor
+ * - "supC.removeBadStates": backward removal of bad states
+ * - "supC.trim": SuperProxy::trim()
+ * - "supC.materialize": conversion of SuperProxy to DESystem
+ * - "bfs": DESystem breadth first searches
+ *
+ * Nothing is recorded unless CLDES_STATS_ENABLED is defined. Workers of a
+ * parallel loop share the statistics of the thread which started the loop:
+ * all methods are thread safe.
+ */
+class OperationStats
+{
+public:
+    OperationStats() = default;
+
+    OperationStats(OperationStats const&) = delete;
+    OperationStats& operator=(OperationStats const&) = delete;
+
+    /*! \brief Statistics of every phase, in the order they first ran
+     */
+    std::vector<PhaseStats> phases() const;
+
+    /*! \brief Statistics of a single phase
+     * \return Zeroed statistics if the phase did not run
+     */
+    PhaseStats phase(std::string const& aName) const;
+
+    /*! \brief Forget everything recorded so far
+     * \details It must not be called while an operation is running.
+     *
+     * \return void
+     */
+    void clear();
+
+    /*! \brief Statistics as a JSON object
+     * \details {"phases": [{"name": ..., "calls": ..., "wall_ns": ...}]}
+     */
+    std::string toJson() const;
+
+    /*! \brief Record of a phase, created on its first call
+     */
+    PhaseRecord_& record_(char const* aName);
+
+private:
+    mutable std::mutex mutex_;
+    std::deque<PhaseRecord_> records_;
+};
+
+/*! \brief Statistics installed on this thread
+ * \return The installed statistics or nullptr
+ */
+inline OperationStats*
+currentStats() noexcept
+{
+    return currentStatsPtr_();
+}
+
+/*! \class ScopedStats
+ * \brief Install statistics on the calling thread while it is alive
+ */
+class ScopedStats
+{
+public:
+    explicit ScopedStats(OperationStats& aStats) noexcept
+      : previous_{ currentStatsPtr_() }
+    {
+        currentStatsPtr_() = &aStats;
+    }
+
+    ScopedStats(ScopedStats const&) = delete;
+    ScopedStats& operator=(ScopedStats const&) = delete;
+
+    ~ScopedStats() { currentStatsPtr_() = previous_; }
+
+private:
+    OperationStats* previous_;
+};
+
+#ifdef CLDES_STATS_ENABLED
+
+/*! \class StatsPhase
+ * \brief Times a phase and collects its counters while it is alive
+ * \details Construct it on the thread which runs the operation. add() and
+ * peak() may be called from the workers of its parallel loops: accumulate
+ * locally and add once per range.
+ */
+class StatsPhase
+{
+public:
+    explicit StatsPhase(char const* aName)
+      : record_{ currentStatsPtr_() != nullptr
+                   ? &currentStatsPtr_()->record_(aName)
+                   : nullptr }
+      , start_{ std::chrono::steady_clock::now() }
+    {
+    }
+
+    StatsPhase(StatsPhase const&) = delete;
+    StatsPhase& operator=(StatsPhase const&) = delete;
+
+    ~StatsPhase();
+
+    /*! \brief Check if the statistics are being recorded
+     */
+    bool active() const noexcept { return record_ != nullptr; }
+
+    /*! \brief Increment a counter
+     */
+    void add(StatsCounter const aCounter, uint64_t const aValue) const
+      noexcept;
+
+    /*! \brief Report the size of a table
+     */
+    void peak(uint64_t const aSize) const noexcept;
+
+private:
+    PhaseRecord_* record_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+#else
+
+class StatsPhase
+{
+public:
+    explicit StatsPhase(char const*) noexcept {}
+
+    StatsPhase(StatsPhase const&) = delete;
+    StatsPhase& operator=(StatsPhase const&) = delete;
+
+    bool constexpr active() const noexcept { return false; }
+    void add(StatsCounter const, uint64_t const) const noexcept {}
+    void peak(uint64_t const) const noexcept {}
+};
+
+#endif // CLDES_STATS_ENABLED
+
+} // namespace cldes
+
+// include methods definitions
+#include "cldes/src/OperationStatsCore.hpp"
+
+#endif // OPERATION_STATS_HPP
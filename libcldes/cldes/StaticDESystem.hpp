@@ -0,0 +1,342 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/StaticDESystem.hpp
+ Description: StaticDESystem template class declaration. A small system
+ with fixed size stored on arrays built at compile time.
+ =========================================================================
+*/
+/*!
+ * \file cldes/StaticDESystem.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-26
+ *
+ * StaticDESystem template class declaration. A small system with fixed size
+ * stored on arrays built at compile time.
+ */
+
+#ifndef STATIC_DESYSTEM_HPP
+#define STATIC_DESYSTEM_HPP
+
+#include "cldes/Constants.hpp"
+#include "cldes/EventsSet.hpp"
+#include "cldes/MemoryUsage.hpp"
+#include "cldes/src/des/DESystemBaseFwd.hpp"
+#include "cldes/src/des/StaticDESystemFwd.hpp"
+
+namespace cldes {
+
+/*! \class StaticDESystem
+ *  \brief A tiny discrete-events system known at compile time
+ *  \details Small fixed components, such as the machines and buffers of a
+ *  cluster tool, do not need sparse matrices and hash tables. A
+ *  StaticDESystem is built from a list of transitions by a constexpr
+ *  constructor into dense tables: trans() is a single table lookup and
+ *  getStateEvents() a copy of one bit array. When the system is a constexpr
+ *  object, queries are evaluated at compile time.
+ *
+ *  It implements the interface that proxies use on their components, so it
+ *  can be an operand of SyncSysProxy, SuperProxy, synchronize() and supC().
+ *  On products of a large system with static components, the small side is
+ *  completely inlined. It does not derive DESystemBase: a base with virtual
+ *  destructor and a std::set member is not a literal type.
+ *
+ *  \code
+ *  constexpr cldes::StaticDESystem<2, 4> machine{
+ *      0, { 0 }, { { 0, 2, 1 }, { 1, 1, 0 } }
+ *  };
+ *  static_assert(machine.trans(0, 2) == 1, "");
+ *  \endcode
+ *
+ * \warning Tables are plain arrays: C++14 std::array can not be written by
+ * constant expressions. Its size is NStates * NEvents indexes, so keep it
+ * for small systems.
+ *
+ * \tparam NStates Number of states
+ * \tparam NEvents Number of events: max 255
+ * \tparam StorageIndex Unsigned type used for indexing states
+ */
+template<std::size_t NStates,
+         uint8_t NEvents,
+         typename StorageIndex = uint32_t>
+class StaticDESystem
+{
+public:
+    /*! \brief StorageIndex signed type
+     */
+    using StorageIndexSigned = typename std::make_signed<StorageIndex>::type;
+
+    /*! \brief EventsSet
+     *  \details Set containing 8bit intergets which represent events.
+     */
+    using EventsSet_t = EventsSet<NEvents>;
+
+    /*! \brief Set of states type
+     */
+    using StatesSet = std::set<StorageIndex>;
+
+    /*! \brief Transition type used by the constructor
+     */
+    using Transition_t = StaticTransition<StorageIndex>;
+
+    /*! \brief Number of 64 bits words of an events set
+     */
+    std::size_t static constexpr kWords = (NEvents + 63ul) / 64ul;
+
+    /*! \brief StaticDESystem constructor
+     * \details Transitions with states or events out of range, and
+     * transitions leaving a state with the same event to different states,
+     * throw an exception: it is a compilation error on constant
+     * expressions. Repeated transitions are counted once.
+     *
+     * @param aInitState System's initial state
+     * @param aMarkedStates System's marked states
+     * @param aTransitions Transitions list: (from, event, to)
+     */
+    constexpr StaticDESystem(
+      StorageIndex const aInitState,
+      std::initializer_list<StorageIndex> const aMarkedStates,
+      std::initializer_list<Transition_t> const aTransitions);
+
+    /*! \brief Returns number of states of the system
+     */
+    StorageIndex constexpr size() const noexcept { return NStates; }
+
+    /*! \brief Returns number of states of the system
+     */
+    StorageIndex constexpr getStatesNumber() const noexcept { return NStates; }
+
+    /*! \brief Returns the initial state
+     */
+    StorageIndex constexpr getInitialState() const noexcept
+    {
+        return init_state_;
+    }
+
+    /*! \brief Returns the number of distinct transitions
+     */
+    std::size_t constexpr getTransNumber() const noexcept
+    {
+        return trans_number_;
+    }
+
+    /*! \brief Returns the set of events of the system
+     */
+    EventsSet_t constexpr getEvents() const noexcept
+    {
+        return toEventsSet_(events_);
+    }
+
+    /*! \brief Check if a state is marked
+     *
+     * @param aQ State
+     */
+    bool constexpr isMarked(StorageIndex const aQ) const noexcept
+    {
+        return marked_[aQ];
+    }
+
+    /*! \brief Returns marked states
+     * \details It is not a constant expression: it builds a std::set.
+     *
+     * \return Set of usigned integer type representing the marked states.
+     */
+    StatesSet getMarkedStates() const;
+
+    /*! \brief Is it real?
+     *
+     * \return True: static systems are concrete systems
+     */
+    bool constexpr static isVirtual() noexcept { return false; }
+
+    /*! \brief Returns true if DES transition exists
+     *
+     * @param aQ State
+     * @param aEvent Event
+     */
+    bool constexpr containstrans(StorageIndex const aQ,
+                                 ScalarType const aEvent) const noexcept
+    {
+        return trans_[aQ][aEvent] >= 0;
+    }
+
+    /*! \brief Returns DES transition: q_to = f(q, e)
+     *
+     * @param aQ State
+     * @param aEvent Event
+     * \return The state where the transition leads or -1 when it is empty
+     */
+    StorageIndexSigned constexpr trans(StorageIndex const aQ,
+                                       ScalarType const aEvent) const noexcept
+    {
+        return trans_[aQ][aEvent];
+    }
+
+    /*! \brief Returns true if DES inverse transition exists
+     *
+     * @param aQ State
+     * @param aEvent Event
+     */
+    bool constexpr containsinvtrans(StorageIndex const aQ,
+                                    ScalarType const aEvent) const noexcept
+    {
+        return (inv_states_events_[aQ][aEvent / 64u] >> (aEvent % 64u)) & 1ul;
+    }
+
+    /*! \brief Returns DES inverse transition: q = f^-1(q_to, e)
+     * \details Linear on the number of states. Inverted tables are always
+     * available, so it does not require allocateInvertedGraph().
+     *
+     * @param aQ State
+     * @param aEvent Event
+     */
+    StatesArray<StorageIndex> invtrans(StorageIndex const aQ,
+                                       ScalarType const aEvent) const;
+
+    /*! \brief Visit every transition leaving a state
+     *
+     * @param aQ State
+     * @param aFunction Callable with signature (event, qto)
+     */
+    template<class Function>
+    void forEachSuccessor(StorageIndex const aQ, Function&& aFunction) const;
+
+    /*! \brief Visit every transition arriving to a state
+     * \details Linear on the number of states, as invtrans().
+     *
+     * @param aQ State
+     * @param aEvents Mask of the visited events
+     * @param aFunction Callable with signature (event, qfrom)
+     */
+    template<class Function>
+    void forEachPredecessor(StorageIndex const aQ,
+                            EventsSet_t const& aEvents,
+                            Function&& aFunction) const;
+
+    /*! \brief Returns EventsSet relative to state q
+     *
+     * @param aQ A state on the sys
+     */
+    EventsSet_t constexpr getStateEvents(StorageIndex const aQ) const noexcept
+    {
+        return toEventsSet_(states_events_[aQ]);
+    }
+
+    /*! \brief Returns EventsSet relative to state inv q
+     *
+     * @param aQ A state on the sys
+     */
+    EventsSet_t constexpr getInvStateEvents(StorageIndex const aQ) const
+      noexcept
+    {
+        return toEventsSet_(inv_states_events_[aQ]);
+    }
+
+    /*! \brief Inverted tables are built on construction: nothing to do
+     */
+    void constexpr allocateInvertedGraph() const noexcept {}
+
+    /*! \brief Inverted tables are part of the system: nothing to do
+     */
+    void constexpr clearInvertedGraph() const noexcept {}
+
+    /*! \brief Memory held by the system, by table
+     * \details Tables are members: it does not depend on the transitions.
+     */
+    MemoryUsage memoryUsage() const noexcept
+    {
+        MemoryUsage usage;
+        usage.graph = sizeof(trans_);
+        usage.states_events = sizeof(states_events_);
+        usage.inv_states_events = sizeof(inv_states_events_);
+        usage.marked_states = sizeof(marked_);
+        return usage;
+    }
+
+protected:
+    /*! \brief Build an events set from its 64 bits words
+     *
+     * @param aWords Words of the set, less significant first
+     */
+    EventsSet_t static constexpr toEventsSet_(
+      uint64_t const (&aWords)[kWords]) noexcept;
+
+    /*! \brief Set a bit of an events set represented by words
+     *
+     * @param[out] aWords Words of the set, less significant first
+     * @param aEvent Event
+     */
+    void static constexpr setEvent_(uint64_t (&aWords)[kWords],
+                                    ScalarType const aEvent) noexcept
+    {
+        aWords[aEvent / 64u] |= 1ul << (aEvent % 64u);
+    }
+
+private:
+    /*! \brief Initial state
+     */
+    StorageIndex init_state_{};
+
+    /*! \brief Number of transitions
+     */
+    std::size_t trans_number_{};
+
+    /*! \brief Marked states bitmap
+     */
+    bool marked_[NStates]{};
+
+    /*! \brief Transition table: -1 when it is empty
+     */
+    StorageIndexSigned trans_[NStates][NEvents]{};
+
+    /*! \brief Events leaving each state
+     */
+    uint64_t states_events_[NStates][kWords]{};
+
+    /*! \brief Events arriving to each state
+     */
+    uint64_t inv_states_events_[NStates][kWords]{};
+
+    /*! \brief Events of the system
+     */
+    uint64_t events_[kWords]{};
+};
+
+/*! \brief SysTraits specialization for static systems
+ */
+template<std::size_t NStates, uint8_t NEvents, typename StorageIndex>
+struct SysTraits<StaticDESystem<NStates, NEvents, StorageIndex>>
+{
+    uint8_t static constexpr Ne_ = NEvents;
+    using Si_ = StorageIndex;
+};
+
+} // namespace cldes
+
+// class methods definitions
+#include "cldes/src/des/StaticDESystemCore.hpp"
+
+#endif // STATIC_DESYSTEM_HPP
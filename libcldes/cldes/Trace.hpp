@@ -0,0 +1,176 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/Trace.hpp
+ Description: Timeline of the operations in the Chrome trace format.
+ =========================================================================
+*/
+/*!
+ * \file cldes/Trace.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-12-05
+ *
+ * Scoped spans on the phases of the operations, recorded on per-thread
+ * buffers and written in the Chrome/Perfetto trace JSON format.
+ */
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include "cldes/src/TraceFwd.hpp"
+
+namespace cldes {
+
+/*! \class TraceSession
+ * \brief Records the spans of every thread while it is alive
+ * \details Synchronization, synthesis, trim and BFS open spans on their
+ * phases, and their parallel loops open one span per range on the worker
+ * which runs it, which shows load imbalance and serial tails. Each thread
+ * appends to its own buffer: the only lock is taken on the first span of a
+ * thread.
+ *
+ * Without a session, a span costs an atomic load. Stop the session, or
+ * destroy it, only when the traced operations returned: spans keep a
+ * pointer to the session which was active when they started, so it must
+ * outlive all of them.
+ *
+ * \code
+ * cldes::TraceSession trace;
+ * auto supervisor = cldes::op::supC(plant, spec, non_contr);
+ * trace.stop();
+ * trace.write("supC.json"); // open it on chrome://tracing or Perfetto
+ * \endcode
+ */
+class TraceSession
+{
+public:
+    /*! \brief Start recording
+     * \details It replaces the active session until it stops.
+     */
+    TraceSession();
+
+    TraceSession(TraceSession const&) = delete;
+    TraceSession& operator=(TraceSession const&) = delete;
+
+    ~TraceSession() { stop(); }
+
+    /*! \brief Stop recording
+     *
+     * \return void
+     */
+    void stop() noexcept;
+
+    /*! \brief Number of recorded spans
+     */
+    std::size_t size() const;
+
+    /*! \brief Number of spans dropped because a buffer could not grow
+     */
+    std::size_t dropped() const noexcept
+    {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    /*! \brief Write the spans as a Chrome trace JSON object
+     *
+     * \return void
+     */
+    void write(std::ostream& aOut) const;
+
+    /*! \brief Write the spans to a file
+     * \return False if the file could not be written
+     */
+    bool write(std::string const& aPath) const;
+
+    /*! \brief Time since the session started
+     */
+    int64_t now_() const noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 std::chrono::steady_clock::now() - start_)
+          .count();
+    }
+
+    /*! \brief Append a span to the buffer of the calling thread
+     * \details Spans end on noexcept functions: if the buffer cannot grow,
+     * the span is dropped.
+     */
+    void record_(char const* aName,
+                 int64_t const aBegin,
+                 int64_t const aEnd) noexcept;
+
+private:
+    /*! \brief Buffer of the calling thread, created on its first span
+     */
+    TraceBuffer_& buffer_();
+
+    uint64_t id_;
+    std::chrono::steady_clock::time_point start_;
+    TraceSession* previous_;
+    std::atomic<bool> running_;
+    std::atomic<std::size_t> dropped_;
+
+    mutable std::mutex mutex_;
+    std::deque<TraceBuffer_> buffers_;
+};
+
+/*! \class TraceSpan
+ * \brief Span of the calling thread while it is alive
+ * \details aName must outlive the session: use string literals. The active
+ * session must outlive the span.
+ */
+class TraceSpan
+{
+public:
+    explicit TraceSpan(char const* aName) noexcept
+      : session_{ activeTracePtr_().load(std::memory_order_acquire) }
+      , name_{ aName }
+      , begin_{ session_ != nullptr ? session_->now_() : 0l }
+    {
+    }
+
+    TraceSpan(TraceSpan const&) = delete;
+    TraceSpan& operator=(TraceSpan const&) = delete;
+
+    ~TraceSpan() noexcept
+    {
+        if (session_ != nullptr) {
+            session_->record_(name_, begin_, session_->now_());
+        }
+    }
+
+private:
+    TraceSession* session_;
+    char const* name_;
+    int64_t begin_;
+};
+
+} // namespace cldes
+
+// include methods definitions
+#include "cldes/src/TraceCore.hpp"
+
+#endif // TRACE_HPP
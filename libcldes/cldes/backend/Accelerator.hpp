@@ -0,0 +1,180 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/backend/Accelerator.hpp
+ Description: Interface of the backends which run the DESystemCL kernels
+ and its portable host implementation.
+ =========================================================================
+*/
+/*!
+ * \file cldes/backend/Accelerator.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-12-02
+ *
+ * Accelerator backends of DESystemCL.
+ */
+
+#ifndef ACCELERATOR_HPP
+#define ACCELERATOR_HPP
+
+#include "cldes/ConcurrentStatesTable.hpp"
+#include "cldes/EventsSet.hpp"
+#include "cldes/backend/Executor.hpp"
+#include "cldes/src/backend/AcceleratorFwd.hpp"
+
+namespace cldes {
+namespace backend {
+
+/*! \class Accelerator
+ * \brief Kernels of the systems stored on an accelerator
+ * \details DESystemCL keeps its graph as a CsrGraph and calls these kernels
+ * for the operations which touch the whole graph. Implementations decide
+ * where the kernels run: HostAccelerator runs them on the host executor,
+ * and a device implementation can mirror the graphs on device memory
+ * behind the same interface.
+ *
+ * \tparam NEvents Number of events
+ * \tparam StorageIndex Unsigned type used for indexing states
+ */
+template<uint8_t NEvents, typename StorageIndex>
+class Accelerator
+{
+public:
+    using Graph = CsrGraph<NEvents, StorageIndex>;
+    using EventsSet_t = EventsSet<NEvents>;
+
+    Accelerator() = default;
+    Accelerator(Accelerator const&) = delete;
+    Accelerator& operator=(Accelerator const&) = delete;
+
+    /*! \brief Accelerator destructor
+     */
+    virtual ~Accelerator() = default;
+
+    /*! \brief Name of the backend
+     */
+    virtual char const* name() const noexcept = 0;
+
+    /*! \brief Breadth-first search
+     *
+     * @param aGraph Graph
+     * @param aSources States where the search starts
+     * \return States reached from aSources, including them, sorted
+     */
+    virtual std::vector<StorageIndex> reach(
+      Graph const& aGraph,
+      std::vector<StorageIndex> const& aSources) = 0;
+
+    /*! \brief Transpose a graph: rows hold the transitions arriving to
+     * each state
+     */
+    virtual Graph transpose(Graph const& aGraph) = 0;
+
+    /*! \brief Accessible part of the parallel composition of two graphs
+     * \details The state (q0, q1) has key q1 * aLhs.rows + q0. Rows of the
+     * result are numbered by ascending key, as op::synchronize() numbers
+     * the states of its result.
+     *
+     * @param aLhs Left operand graph
+     * @param aLhsEvents Events of the left operand
+     * @param aRhs Right operand graph
+     * @param aRhsEvents Events of the right operand
+     * @param aInit Key of the initial state
+     * @param[out] aKeys Key of each row of the result
+     * \return Graph of the accessible part
+     */
+    virtual Graph synchronize(Graph const& aLhs,
+                              EventsSet_t const& aLhsEvents,
+                              Graph const& aRhs,
+                              EventsSet_t const& aRhsEvents,
+                              uint64_t const aInit,
+                              std::vector<uint64_t>& aKeys) = 0;
+};
+
+/*! \class HostAccelerator
+ * \brief Accelerator kernels on the host threads
+ * \details Kernels are data parallel loops on the current executor: the
+ * BFS expands each level of the frontier in parallel over a bitmap of
+ * visited states, and synchronize() joins the rows of both operands for
+ * each state of the frontier. The result of synchronize() is built in two
+ * passes, counting and then filling the rows, as sparse matrix products
+ * are built on devices.
+ */
+template<uint8_t NEvents, typename StorageIndex>
+class HostAccelerator : public Accelerator<NEvents, StorageIndex>
+{
+public:
+    using Base = Accelerator<NEvents, StorageIndex>;
+    using typename Base::EventsSet_t;
+    using typename Base::Graph;
+
+    /*! \brief Product row: (key of the target state, events)
+     */
+    using JoinRow = std::vector<std::pair<uint64_t, EventsSet_t>>;
+
+    char const* name() const noexcept override { return "host"; }
+
+    std::vector<StorageIndex> reach(
+      Graph const& aGraph,
+      std::vector<StorageIndex> const& aSources) override;
+
+    Graph transpose(Graph const& aGraph) override;
+
+    Graph synchronize(Graph const& aLhs,
+                      EventsSet_t const& aLhsEvents,
+                      Graph const& aRhs,
+                      EventsSet_t const& aRhsEvents,
+                      uint64_t const aInit,
+                      std::vector<uint64_t>& aKeys) override;
+
+protected:
+    /*! \brief Join the row of q0 on aLhs with the row of q1 on aRhs
+     * \details Private events move one operand, shared events move both.
+     *
+     * @param aKey Key of (q0, q1)
+     * @param[out] aRow Transitions leaving (q0, q1), sorted by target key
+     */
+    static void joinRow_(Graph const& aLhs,
+                         EventsSet_t const& aLhsOnly,
+                         Graph const& aRhs,
+                         EventsSet_t const& aRhsOnly,
+                         uint64_t const aKey,
+                         JoinRow& aRow);
+};
+
+/*! \brief Host accelerator shared by the systems which do not choose one
+ */
+template<uint8_t NEvents, typename StorageIndex>
+std::shared_ptr<Accelerator<NEvents, StorageIndex>>
+hostAccelerator();
+
+} // namespace backend
+} // namespace cldes
+
+// include methods definitions
+#include "cldes/src/backend/AcceleratorCore.hpp"
+
+#endif // ACCELERATOR_HPP
@@ -0,0 +1,367 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/backend/Executor.hpp
+ Description: Executors which run the parallel loops of the library: a
+ work-stealing thread pool, an OpenMP adapter and a serial executor.
+ =========================================================================
+*/
+/*!
+ * \file cldes/backend/Executor.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-26
+ *
+ * Pluggable task executors.
+ */
+
+#ifndef EXECUTOR_HPP
+#define EXECUTOR_HPP
+
+#include "cldes/backend/Numa.hpp"
+#include "cldes/src/backend/ExecutorFwd.hpp"
+
+namespace cldes {
+namespace backend {
+
+/*! \class Executor
+ * \brief Interface of the objects which run the library parallel loops
+ * \details Operations do not create threads: they split their loops with
+ * parallelFor() of the current executor. The current executor is the one
+ * installed on the calling thread by a ScopedExecutor, or
+ * defaultExecutor() when there is none.
+ */
+class Executor
+{
+public:
+    /*! \brief Executor constructor
+     *
+     * @param aGrain Default number of iterations of each range
+     */
+    explicit Executor(std::size_t const aGrain = kDefaultGrainSize) noexcept
+      : grain_{ aGrain > 0ul ? aGrain : 1ul }
+    {
+    }
+
+    Executor(Executor const&) = delete;
+    Executor& operator=(Executor const&) = delete;
+
+    /*! \brief Executor destructor
+     */
+    virtual ~Executor() = default;
+
+    /*! \brief Maximum number of ranges running at the same time
+     * \details Worker indexes passed to loop bodies are on
+     * [0, concurrency()).
+     */
+    virtual unsigned concurrency() const noexcept = 0;
+
+    /*! \brief Run a loop body over [aBegin, aEnd)
+     * \details The range is split in ranges of aGrain iterations which may
+     * run concurrently. It returns when all of them are done. An exception
+     * thrown by the body is rethrown here.
+     *
+     * @param aBegin First iteration
+     * @param aEnd Last iteration, exclusive
+     * @param aBody Loop body
+     * @param aGrain Iterations of each range: 0 uses grainSize()
+     * \return void
+     */
+    virtual void parallelFor(std::size_t const aBegin,
+                             std::size_t const aEnd,
+                             ChunkFunction const& aBody,
+                             std::size_t const aGrain = 0ul) = 0;
+
+    /*! \brief Get the default number of iterations of each range
+     */
+    std::size_t grainSize() const noexcept { return grain_; }
+
+    /*! \brief Set the default number of iterations of each range
+     *
+     * @param aGrain Number of iterations: 0 is replaced by 1
+     * \return void
+     */
+    void setGrainSize(std::size_t const aGrain) noexcept
+    {
+        grain_ = aGrain > 0ul ? aGrain : 1ul;
+    }
+
+protected:
+    /*! \brief Resolve the grain of a parallelFor() call
+     */
+    std::size_t resolveGrain_(std::size_t const aGrain) const noexcept
+    {
+        return aGrain > 0ul ? aGrain : grain_;
+    }
+
+private:
+    std::size_t grain_;
+};
+
+/*! \class SerialExecutor
+ * \brief Runs loops on the calling thread
+ */
+class SerialExecutor : public Executor
+{
+public:
+    SerialExecutor() noexcept
+      : Executor{}
+    {
+    }
+
+    unsigned concurrency() const noexcept override { return 1u; }
+
+    void parallelFor(std::size_t const aBegin,
+                     std::size_t const aEnd,
+                     ChunkFunction const& aBody,
+                     std::size_t const aGrain = 0ul) override;
+};
+
+/*! \class ThreadPoolExecutor
+ * \brief Work-stealing thread pool: the default executor
+ * \details Each worker owns a queue of ranges. It runs the newest range of
+ * its own queue and, when it is empty, steals the oldest range of another
+ * queue. The thread calling parallelFor() runs ranges of its loop until all
+ * of them are done. Nested calls from a loop body push the ranges on the
+ * worker own queue, so idle workers steal them instead of deadlocking.
+ *
+ * Workers steal from their neighbors first. With ExecutorOptions::numa,
+ * neighbors share a NUMA node, so stolen ranges are usually local.
+ *
+ * Workers can be joined and restarted with suspend() and resume(), e.g.
+ * around a fork(): see SuspendedThreadPools.
+ */
+class ThreadPoolExecutor : public Executor
+{
+public:
+    /*! \brief ThreadPoolExecutor constructor
+     * \details Workers start on construction and sleep while there is no
+     * work.
+     *
+     * @param aOptions Number of threads, grain and affinity
+     */
+    explicit ThreadPoolExecutor(ExecutorOptions const& aOptions = {});
+
+    /*! \brief ThreadPoolExecutor destructor
+     * \details Joins the workers: it must not run while a loop is running.
+     */
+    ~ThreadPoolExecutor() override;
+
+    /*! \brief Number of workers plus the calling thread
+     * \details It is 1 while the pool is suspended.
+     */
+    unsigned concurrency() const noexcept override
+    {
+        return static_cast<unsigned>(workers_.size()) + 1u;
+    }
+
+    void parallelFor(std::size_t const aBegin,
+                     std::size_t const aEnd,
+                     ChunkFunction const& aBody,
+                     std::size_t const aGrain = 0ul) override;
+
+    /*! \brief Join the workers
+     * \details Until the matching resume(), loops run on the calling
+     * thread. Calls can be nested. It must not run while a loop is running.
+     */
+    void suspend();
+
+    /*! \brief Restart the workers joined by suspend()
+     */
+    void resume();
+
+protected:
+    /*! \brief Queue of ranges owned by a worker
+     */
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<ExecutorTask> tasks;
+    };
+
+    /*! \brief Main loop of worker aWorker
+     */
+    void workerLoop_(unsigned const aWorker) noexcept;
+
+    /*! \brief Pop the newest range of aWorker queue or steal the oldest
+     * range of another queue
+     *
+     * @param aWorker Queue owner
+     * @param aJob If not null, only ranges of this loop are taken
+     * @param[out] aTask Range taken
+     * \return True if a range was taken
+     */
+    bool takeTask_(unsigned const aWorker,
+                   ExecutorTask::Job const* aJob,
+                   ExecutorTask& aTask) noexcept;
+
+    /*! \brief Run a range and signal its loop
+     */
+    void runTask_(ExecutorTask const& aTask, unsigned const aWorker) noexcept;
+
+    /*! \brief Index of the calling thread on this pool
+     * \details Threads which are not workers of this pool get the index
+     * workers_.size(), which has no queue.
+     */
+    unsigned workerIndex_() const noexcept;
+
+    /*! \brief Bind a worker to a CPU
+     */
+    void bindWorker_(unsigned const aWorker,
+                     std::vector<unsigned> const& aCpus) noexcept;
+
+    /*! \brief Bind a worker to all CPUs of its NUMA node
+     *
+     * @param aWorker Worker index
+     * @param aWorkers Number of workers of the pool
+     */
+    void bindWorkerToNode_(unsigned const aWorker,
+                           unsigned const aWorkers) noexcept;
+
+    /*! \brief Start the workers and bind them
+     */
+    void startWorkers_();
+
+    /*! \brief Stop the workers and wait for them
+     */
+    void joinWorkers_() noexcept;
+
+private:
+    /*! \brief Number of workers when the pool runs
+     */
+    unsigned threads_;
+    std::vector<unsigned> cpus_;
+    unsigned suspended_;
+
+    std::vector<std::thread> workers_;
+    std::unique_ptr<WorkerQueue[]> queues_;
+
+    /*! \brief Number of ranges waiting on all queues
+     */
+    std::atomic<std::size_t> queued_;
+    std::atomic<bool> stop_;
+
+    /*! \brief Give each worker a contiguous block of the ranges
+     */
+    bool numa_;
+
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+};
+
+#ifdef CLDES_OPENMP_ENABLED
+/*! \class OpenMPExecutor
+ * \brief Runs loops on an OpenMP parallel region
+ * \details Ranges are scheduled dynamically. Thread affinity follows the
+ * OpenMP runtime settings, e.g. OMP_PROC_BIND and OMP_PLACES.
+ */
+class OpenMPExecutor : public Executor
+{
+public:
+    /*! \brief OpenMPExecutor constructor
+     *
+     * @param aThreads Number of threads: 0 uses omp_get_max_threads()
+     * @param aGrain Default number of iterations of each range
+     */
+    explicit OpenMPExecutor(unsigned const aThreads = 0u,
+                            std::size_t const aGrain = kDefaultGrainSize)
+      : Executor{ aGrain }
+      , threads_{ aThreads }
+    {
+    }
+
+    unsigned concurrency() const noexcept override
+    {
+        return threads_ > 0u ? threads_
+                             : static_cast<unsigned>(omp_get_max_threads());
+    }
+
+    void parallelFor(std::size_t const aBegin,
+                     std::size_t const aEnd,
+                     ChunkFunction const& aBody,
+                     std::size_t const aGrain = 0ul) override;
+
+private:
+    unsigned threads_;
+};
+#endif
+
+/*! \brief Process-wide executor used when none is installed
+ * \details A ThreadPoolExecutor with default options, created on the first
+ * call.
+ */
+Executor& defaultExecutor();
+
+/*! \brief Executor used by the operations called on this thread
+ */
+Executor& currentExecutor();
+
+/*! \class SuspendedThreadPools
+ * \brief Suspend every ThreadPoolExecutor of the process while it is alive
+ * \details It includes defaultExecutor() once it started. Their workers
+ * are joined on construction and restarted on destruction. No loop may run
+ * on any pool meanwhile, so other threads must not run operations.
+ */
+class SuspendedThreadPools
+{
+public:
+    SuspendedThreadPools();
+
+    SuspendedThreadPools(SuspendedThreadPools const&) = delete;
+    SuspendedThreadPools& operator=(SuspendedThreadPools const&) = delete;
+
+    ~SuspendedThreadPools();
+};
+
+/*! \class ScopedExecutor
+ * \brief Install an executor on the calling thread while it is alive
+ * \details Operations called on its scope run their loops on aExecutor.
+ * Guards can be nested: the destructor restores the previous executor.
+ */
+class ScopedExecutor
+{
+public:
+    explicit ScopedExecutor(Executor& aExecutor) noexcept
+      : previous_{ currentExecutorPtr_() }
+    {
+        currentExecutorPtr_() = &aExecutor;
+    }
+
+    ScopedExecutor(ScopedExecutor const&) = delete;
+    ScopedExecutor& operator=(ScopedExecutor const&) = delete;
+
+    ~ScopedExecutor() { currentExecutorPtr_() = previous_; }
+
+private:
+    Executor* previous_;
+};
+
+} // namespace backend
+} // namespace cldes
+
+// include methods definitions
+#include "cldes/src/backend/ExecutorCore.hpp"
+
+#endif // EXECUTOR_HPP
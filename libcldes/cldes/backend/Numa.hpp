@@ -0,0 +1,184 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/backend/Numa.hpp
+ Description: NUMA topology of the host and placement of the pages of
+ graphs and states tables on its nodes.
+ =========================================================================
+*/
+/*!
+ * \file cldes/backend/Numa.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-12-01
+ *
+ * NUMA topology and memory placement.
+ */
+
+#ifndef NUMA_HPP
+#define NUMA_HPP
+
+#include "cldes/src/backend/NumaFwd.hpp"
+
+namespace cldes {
+namespace backend {
+
+/*! \class NumaTopology
+ * \brief NUMA nodes of the host and their CPUs
+ * \details Nodes are indexed on [0, nodes()). Their operating system ids
+ * may have gaps, so placement uses nodeId(). A host without NUMA support
+ * has a single node with all CPUs.
+ */
+class NumaTopology
+{
+public:
+    /*! \brief NumaTopology constructor
+     *
+     * @param aNodeIds Operating system id of each node
+     * @param aCpus CPUs of each node
+     */
+    NumaTopology(std::vector<unsigned> aNodeIds,
+                 std::vector<std::vector<unsigned>> aCpus);
+
+    /*! \brief Topology of the host
+     * \details Read once from /sys/devices/system/node.
+     */
+    static NumaTopology const& system();
+
+    /*! \brief Number of nodes
+     */
+    unsigned nodes() const noexcept
+    {
+        return static_cast<unsigned>(node_ids_.size());
+    }
+
+    /*! \brief Operating system id of aNode
+     */
+    unsigned nodeId(unsigned const aNode) const noexcept
+    {
+        return node_ids_[aNode];
+    }
+
+    /*! \brief CPUs of aNode
+     */
+    std::vector<unsigned> const& cpus(unsigned const aNode) const noexcept
+    {
+        return cpus_[aNode];
+    }
+
+    /*! \brief Node of block aBlock when aBlocks blocks are spread over the
+     * nodes in order
+     * \details Workers and array blocks use the same map, so the block
+     * given to a worker lives on its node.
+     */
+    unsigned nodeOf(std::size_t const aBlock,
+                    std::size_t const aBlocks) const noexcept
+    {
+        return aBlocks == 0ul ? 0u
+                              : static_cast<unsigned>(
+                                  aBlock * nodes() / aBlocks);
+    }
+
+    /*! \brief Split [0, aSize) in one contiguous block per node
+     *
+     * @param aSize Number of elements
+     * \return nodes() + 1 bounds: block k is [bounds[k], bounds[k + 1])
+     */
+    std::vector<std::size_t> blocks(std::size_t const aSize) const;
+
+protected:
+    /*! \brief Read the topology of the host
+     */
+    static NumaTopology detect_();
+
+private:
+    std::vector<unsigned> node_ids_;
+    std::vector<std::vector<unsigned>> cpus_;
+};
+
+/*! \brief Place the pages of an array on the NUMA nodes
+ * \details Pages already touched are migrated, then get the default policy
+ * back: pages touched later, or reused by other allocations once the array
+ * is freed, are placed as usual. Pages are the unit of placement: partial
+ * pages at the bounds of the array, which may hold other allocations, are
+ * not moved, and pages at the bounds of a block follow the next block. It
+ * does nothing on hosts with a single node or out of Linux.
+ *
+ * @param aData First byte of the array
+ * @param aBytes Size of the array
+ * @param aPolicy Placement policy
+ * @param aTopology Nodes used by the placement
+ * \return True if the kernel placed all pages
+ */
+bool numaPlace(void const* aData,
+               std::size_t const aBytes,
+               NumaPolicy const aPolicy,
+               NumaTopology const& aTopology = NumaTopology::system());
+
+/*! \brief Place the blocks of an array on the nodes
+ * \details Block k is [aBounds[k], aBounds[k + 1]) and goes to node k.
+ * Pages shared with other allocations are not moved, so blocks within
+ * them stay where they are.
+ *
+ * @param aData First element of the array
+ * @param aElementBytes Size of each element
+ * @param aBounds nodes() + 1 bounds, in elements
+ * @param aTopology Nodes used by the placement
+ * \return True if the kernel placed all pages
+ */
+bool numaPlaceBlocks(void const* aData,
+                     std::size_t const aElementBytes,
+                     std::vector<std::size_t> const& aBounds,
+                     NumaTopology const& aTopology = NumaTopology::system());
+
+/*! \brief Place the elements of a vector
+ */
+template<class T, class Allocator>
+bool numaPlace(std::vector<T, Allocator> const& aVector,
+               NumaPolicy const aPolicy,
+               NumaTopology const& aTopology = NumaTopology::system());
+
+/*! \brief Place a compressed row major sparse matrix
+ * \details With kPartitioned, the rows are split in one block per node and
+ * the nonzeros of each block go to the node of its rows, so a loop over
+ * the rows on a NUMA aware executor reads local memory.
+ *
+ * @param aMatrix Compressed Eigen sparse matrix
+ * @param aPolicy Placement policy
+ * @param aTopology Nodes used by the placement
+ * \return True if the kernel placed all pages
+ */
+template<class SparseMatrix>
+bool numaPlaceRows(SparseMatrix const& aMatrix,
+                   NumaPolicy const aPolicy,
+                   NumaTopology const& aTopology = NumaTopology::system());
+
+} // namespace backend
+} // namespace cldes
+
+// include methods definitions
+#include "cldes/src/backend/NumaCore.hpp"
+
+#endif // NUMA_HPP
@@ -0,0 +1,165 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/operations/Async.hpp
+ Description: Asynchronous operations with cancellation, progress reports
+ and resource budgets.
+ =========================================================================
+*/
+/*!
+ * \file cldes/operations/Async.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-27
+ *
+ * Asynchronous operations with cancellation, progress reports and resource
+ * budgets.
+ */
+
+#ifndef ASYNC_HPP
+#define ASYNC_HPP
+
+#include "cldes/DESystem.hpp"
+#include "cldes/OperationMonitor.hpp"
+#include "cldes/backend/Executor.hpp"
+#include "cldes/operations/Operations.hpp"
+#include "cldes/src/operations/AsyncFwd.hpp"
+
+namespace cldes {
+namespace op {
+
+/*! \brief Settings of an asynchronous operation
+ */
+struct AsyncOptions
+{
+    /*! \brief Token which stops the operation when it is cancelled
+     */
+    CancellationToken token;
+
+    /*! \brief Time and memory limits: 0 means unlimited
+     */
+    OperationBudget budget;
+
+    /*! \brief Progress callback
+     * \details It runs on the operation threads and must not throw. Calls
+     * are serialized. It is called once more when the operation ends.
+     */
+    ProgressCallback on_progress;
+
+    /*! \brief Number of states between progress reports
+     */
+    uint64_t progress_interval = kDefaultProgressInterval;
+};
+
+/*! \class OperationAborted
+ * \brief Exception stored on the future of an operation which was stopped
+ */
+class OperationAborted : public std::runtime_error
+{
+public:
+    OperationAborted(AbortReason const aReason,
+                     OperationProgress const& aProgress)
+      : std::runtime_error{ abortMessage_(aReason) }
+      , reason_{ aReason }
+      , progress_{ aProgress }
+    {
+    }
+
+    /*! \brief Why the operation stopped
+     */
+    AbortReason reason() const noexcept { return reason_; }
+
+    /*! \brief Statistics of the operation when it stopped
+     */
+    OperationProgress const& progress() const noexcept { return progress_; }
+
+private:
+    AbortReason reason_;
+    OperationProgress progress_;
+};
+
+/*! \brief Run a monitored operation on a new thread
+ * \details The operation runs on the executor of the calling thread. If it
+ * is stopped, its incomplete result is discarded and the future throws
+ * OperationAborted.
+ *
+ * @param aOptions Token, budgets and progress callback
+ * @param aOperation Callable without parameters
+ * \return Future of the operation result
+ */
+template<class Function>
+std::future<typename std::result_of<Function()>::type>
+runAsync(AsyncOptions aOptions, Function&& aOperation);
+
+/*! \brief Asynchronous parallel composition
+ * \warning The operands are referenced: keep them alive until the future
+ * is ready.
+ *
+ * @param aSys0 The left operand of the parallel composition.
+ * @param aSys1 The right operand of the parallel composition.
+ * @param aOptions Token, budgets and progress callback
+ * \return Future of the concrete parallel composition
+ */
+template<class SysT_l, class SysT_r>
+std::future<DESystem_t<SysT_l>>
+synchronizeAsync(SysT_l const& aSys0,
+                 SysT_r const& aSys1,
+                 AsyncOptions aOptions = AsyncOptions{});
+
+/*! \brief Asynchronous monolithic supervisor synthesis
+ * \warning The operands are referenced: keep them alive until the future
+ * is ready.
+ *
+ * @param aP Plant system const reference
+ * @param aE Specs system const reference
+ * @param aNonContr Hash table containing all non-controllable events indexes.
+ * @param aOptions Token, budgets and progress callback
+ * \return Future of the monolithic supervisor
+ */
+template<class SysT_l, class SysT_r>
+std::future<DESystem_t<SysT_l>>
+supCAsync(SysT_l const& aP,
+          SysT_r const& aE,
+          EventsTableHost const& aNonContr,
+          AsyncOptions aOptions = AsyncOptions{});
+
+/*! \brief Asynchronous trim of a concrete system
+ *
+ * @param aSys System to be trimmed: it is moved to the operation
+ * @param aOptions Token, budgets and progress callback
+ * \return Future of the trimmed system
+ */
+template<uint8_t NEvents, typename StorageIndex>
+std::future<DESystem<NEvents, StorageIndex>>
+trimAsync(DESystem<NEvents, StorageIndex> aSys,
+          AsyncOptions aOptions = AsyncOptions{});
+
+} // namespace op
+} // namespace cldes
+
+// include functions definitions
+#include "cldes/src/operations/AsyncCore.hpp"
+
+#endif // ASYNC_HPP
@@ -0,0 +1,318 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/operations/Expression.hpp
+ Description: Lazy operations graph. Operations on expressions return
+ nodes, which are planned and run as a single fused exploration.
+ =========================================================================
+*/
+/*!
+ * \file cldes/operations/Expression.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-28
+ *
+ * Lazy operations graph fusing synchronize, supC, trim and projection.
+ */
+
+#ifndef EXPRESSION_HPP
+#define EXPRESSION_HPP
+
+#include "cldes/Constants.hpp"
+#include "cldes/DESystem.hpp"
+#include "cldes/EventsSet.hpp"
+#include "cldes/OperationMonitor.hpp"
+#include "cldes/operations/Operations.hpp"
+#include "cldes/src/operations/ExpressionFwd.hpp"
+
+namespace cldes {
+namespace op {
+
+/*! \class Expression
+ * \brief Handle to a node of a lazy operations graph
+ * \details synchronize(), supC(), trim() and proj() called with expressions
+ * only record the operation. materialize() plans the graph and explores it
+ * once: the synchronous product of all the leaves under synchronize and
+ * supC nodes is built on the fly from the initial state, so only
+ * accessible states are visited. States which violate controllability are
+ * not expanded. Trimming, the remaining supC iterations and projection run
+ * on the explored graph, and only the final system is built.
+ *
+ * The fused pipeline is proj(trim(supC(synchronize(...)))). Subexpressions
+ * out of this order, such as the plant of supC(trim(P), E), are
+ * materialized first and used as leaves.
+ *
+ * States of the result are the surviving product states sorted by their
+ * product index, as the states of supC().
+ *
+ * \tparam NEvents Number of events
+ * \tparam StorageIndex Unsigned type used for indexing states
+ */
+template<uint8_t NEvents, typename StorageIndex>
+class Expression
+{
+public:
+    using DESystem_t = DESystem<NEvents, StorageIndex>;
+    using Node_t = ExpressionNode<NEvents, StorageIndex>;
+    using Stage_t = FusedStage<NEvents, StorageIndex>;
+
+    /*! \brief Expression constructor
+     *
+     * @param aNode Root node
+     */
+    explicit Expression(std::shared_ptr<Node_t const> aNode) noexcept
+      : node_{ std::move(aNode) }
+    {}
+
+    /*! \brief Operation of the root node
+     */
+    ExpressionKind kind() const noexcept { return node_->kind; }
+
+    /*! \brief Root node
+     */
+    std::shared_ptr<Node_t const> const& node() const noexcept
+    {
+        return node_;
+    }
+
+    /*! \brief Split the graph in a fused stage
+     * \details Subexpressions which can not be fused are materialized.
+     *
+     * \return Stage which computes this expression
+     */
+    Stage_t plan() const;
+
+    /*! \brief Plan and run the expression
+     * \details It reports to the monitor of the calling thread. If the
+     * monitor stops the operation, an empty system is returned.
+     *
+     * \return The system represented by the expression
+     */
+    DESystem_t materialize() const;
+
+protected:
+    /*! \brief Add the leaves of a synchronize tree to a stage
+     *
+     * @param aNode Root of the tree
+     * @param[out] aStage Stage which receives the leaves
+     * \return void
+     */
+    static void collectLeaves_(std::shared_ptr<Node_t const> const& aNode,
+                               Stage_t& aStage);
+
+private:
+    std::shared_ptr<Node_t const> node_;
+};
+
+/*! \class FusedExplorer
+ * \brief Runs a fused stage
+ * \details Product states are identified by the mixed radix index of their
+ * leaves states: leaf i is the digit of weight n_0 * ... * n_(i-1), as on
+ * nested SyncSysProxy objects. The explored graph is kept on CSR arrays.
+ *
+ * \tparam NEvents Number of events
+ * \tparam StorageIndex Unsigned type used for indexing states
+ */
+template<uint8_t NEvents, typename StorageIndex>
+class FusedExplorer
+{
+public:
+    using DESystem_t = DESystem<NEvents, StorageIndex>;
+    using Stage_t = FusedStage<NEvents, StorageIndex>;
+    using EventsSet_t = EventsSet<NEvents>;
+
+    /*! \brief FusedExplorer constructor
+     * \details Throws std::overflow_error when the product state space does
+     * not fit on a ProductKey.
+     *
+     * @param aStage Stage that will be run
+     */
+    explicit FusedExplorer(Stage_t const& aStage);
+
+    /*! \brief Explore, prune and build the result
+     *
+     * \return Resulting system: empty if the initial state is removed or the
+     * operation was stopped
+     */
+    DESystem_t run();
+
+protected:
+    /*! \brief On the fly exploration of the accessible product
+     * \return False if the monitor stopped the exploration
+     */
+    bool explore_();
+
+    /*! \brief Build the inverted graph of the explored transitions
+     */
+    void invert_();
+
+    /*! \brief Remove states which can not reach a marked state
+     * \return States removed by this call
+     */
+    std::vector<StorageIndex> removeBlocking_();
+
+    /*! \brief Remove states which reach removed states by non controllable
+     * events, starting from aRemoved
+     */
+    void removeUncontrollable_(std::vector<StorageIndex>&& aRemoved);
+
+    /*! \brief Remove states that are no longer accessible
+     */
+    void removeInaccessible_();
+
+    /*! \brief Build the resulting system from the surviving states
+     */
+    DESystem_t build_() const;
+
+    /*! \brief Get or create the id of a product state
+     */
+    StorageIndex findOrInsert_(ProductKey const aKey);
+
+    /*! \brief Product key of the initial state
+     */
+    ProductKey initialKey_() const noexcept;
+
+    /*! \brief Number of product states, accessible or not
+     */
+    ProductKey productSize_() const noexcept { return product_size_; }
+
+    /*! \brief Leaves states of a product key
+     *
+     * @param aKey Product key
+     * @param[out] aStates Leaves states: sized as the number of leaves
+     * \return void
+     */
+    void decode_(ProductKey const aKey,
+                 std::vector<StorageIndex>& aStates) const noexcept;
+
+    /*! \brief Events enabled on a product state
+     *
+     * @param aStates Leaves states
+     * @param[out] aPlantEnabled Events enabled on the plant leaves
+     * \return Events enabled on the product
+     */
+    EventsSet_t enabled_(std::vector<StorageIndex> const& aStates,
+                         EventsSet_t& aPlantEnabled) const;
+
+    /*! \brief Product key reached from aKey by aEvent
+     * \warning aEvent must be enabled on aStates.
+     */
+    ProductKey next_(ProductKey const aKey,
+                     std::vector<StorageIndex> const& aStates,
+                     ScalarType const aEvent) const;
+
+private:
+    Stage_t const& stage_;
+
+    std::vector<StorageIndex> sizes_;
+    std::vector<ProductKey> strides_;
+    std::vector<EventsSet_t> alphabets_;
+    ProductKey product_size_;
+
+    /*! \brief Leaves which have each event
+     */
+    std::vector<std::vector<std::size_t>> participants_;
+
+    /*! \brief Marked flags of each leaf
+     */
+    std::vector<std::vector<bool>> marked_leaves_;
+
+    EventsSet_t events_;
+    EventsSet_t plant_events_;
+
+    /*! \brief Explored states: product key and flags of each id
+     */
+    spp::sparse_hash_map<ProductKey, StorageIndex> ids_;
+    std::vector<ProductKey> keys_;
+    std::vector<bool> marked_;
+    std::vector<bool> alive_;
+
+    /*! \brief Explored transitions on CSR arrays
+     */
+    std::vector<std::size_t> offsets_;
+    std::vector<StorageIndex> targets_;
+    std::vector<ScalarType> labels_;
+
+    /*! \brief Inverted transitions on CSR arrays
+     */
+    std::vector<std::size_t> inv_offsets_;
+    std::vector<StorageIndex> inv_sources_;
+    std::vector<ScalarType> inv_labels_;
+};
+
+/*! \brief Leaf referencing a system
+ * \warning aSys must outlive the expression.
+ */
+template<uint8_t NEvents, typename StorageIndex>
+Expression<NEvents, StorageIndex>
+lazy(DESystem<NEvents, StorageIndex> const& aSys);
+
+/*! \brief Leaf owning a system
+ */
+template<uint8_t NEvents, typename StorageIndex>
+Expression<NEvents, StorageIndex>
+lazy(DESystem<NEvents, StorageIndex>&& aSys);
+
+/*! \brief Lazy parallel composition
+ */
+template<uint8_t NEvents, typename StorageIndex>
+Expression<NEvents, StorageIndex>
+synchronize(Expression<NEvents, StorageIndex> const& aSys0,
+            Expression<NEvents, StorageIndex> const& aSys1);
+
+/*! \brief Lazy monolithic supervisor synthesis
+ */
+template<uint8_t NEvents, typename StorageIndex>
+Expression<NEvents, StorageIndex>
+supC(Expression<NEvents, StorageIndex> const& aP,
+     Expression<NEvents, StorageIndex> const& aE,
+     EventsTableHost const& aNonContr);
+
+/*! \brief Lazy trim: accessible and coaccessible part
+ */
+template<uint8_t NEvents, typename StorageIndex>
+Expression<NEvents, StorageIndex>
+trim(Expression<NEvents, StorageIndex> const& aSys);
+
+/*! \brief Lazy projection: transitions of other events are removed
+ */
+template<uint8_t NEvents, typename StorageIndex>
+Expression<NEvents, StorageIndex>
+proj(Expression<NEvents, StorageIndex> const& aSys,
+     EventsSet<NEvents> const& aAlphabet);
+
+/*! \brief Plan and run an expression
+ */
+template<uint8_t NEvents, typename StorageIndex>
+DESystem<NEvents, StorageIndex>
+evaluate(Expression<NEvents, StorageIndex> const& aExpr);
+
+} // namespace op
+} // namespace cldes
+
+// include methods definitions
+#include "cldes/src/operations/ExpressionCore.hpp"
+
+#endif // EXPRESSION_HPP
@@ -34,6 +34,10 @@
 
 #include "cldes/Constants.hpp"
 #include "cldes/DESystem.hpp"
+#include "cldes/OperationMonitor.hpp"
+#include "cldes/OperationStats.hpp"
+#include "cldes/Trace.hpp"
+#include "cldes/backend/Executor.hpp"
 #include "cldes/operations/SyncSysProxy.hpp"
 #include "cldes/operations/SuperProxy.hpp"
 #include "cldes/src/operations/OperationsFwd.hpp"
@@ -82,6 +86,26 @@ DESystem_t<SysT_l> constexpr synchronize(SysT_l const& aSys0,
     return sys;
 }
 
+/*! \brief Calculate the parallel composition on a given executor
+ * \details Same as synchronize(aSys0, aSys1), but the parallel loops run
+ * on aExecutor instead of the current executor.
+ *
+ * @param aSys0 The left operand of the parallel composition.
+ * @param aSys1 The right operand of the parallel composition.
+ * @param aExecutor Executor which runs the operation
+ * \return A concrete system which represents a parallel composition
+ * between two systems
+ */
+template<class SysT_l, class SysT_r>
+DESystem_t<SysT_l>
+synchronize(SysT_l const& aSys0,
+            SysT_r const& aSys1,
+            backend::Executor& aExecutor) noexcept
+{
+    backend::ScopedExecutor const scope{ aExecutor };
+    return synchronize(aSys0, aSys1);
+}
+
 /*! \brief Lazy evaluation of the parallel composition between two systems
  * \details The composed states are sorted by the right operand indexes:
  * e.g. indexes(sys0.size{3} || sys.size{2}) =
@@ -141,6 +165,10 @@ removeBadStates_(SyncSysProxy<SysT_l, SysT_r> const& aVirtualSys,
                  StatesTableHost_t<SysT_l>& aRmTable) noexcept;
 
 /*! \brief Computes the monolithic supervisor of a plant and a spec
+ * \details Bad states and blocking states are removed until neither
+ * removes any state, then the inaccessible ones: the result is the
+ * supremal controllable and nonblocking supervisor, the same as the supC()
+ * of a cldes::op::Expression.
  *
  * @param aP Plant system const reference
  * @param aE Specs system const reference
@@ -153,6 +181,23 @@ supC(SysT_l const& aP,
      SysT_r const& aE,
      EventsTableHost const& aNonContr) noexcept;
 
+/*! \brief Computes the monolithic supervisor on a given executor
+ * \details Same as supC(aP, aE, aNonContr), but the parallel loops run on
+ * aExecutor instead of the current executor.
+ *
+ * @param aP Plant system const reference
+ * @param aE Specs system const reference
+ * @param aNonContr Hash table containing all non-controllable events indexes.
+ * @param aExecutor Executor which runs the operation
+ * \return The monolithic supervisor concrete system
+ */
+template<class SysT_l, class SysT_r>
+DESystem<SysTraits<SysT_l>::Ne_, typename SysTraits<SysT_l>::Si_>
+supC(SysT_l const& aP,
+     SysT_r const& aE,
+     EventsTableHost const& aNonContr,
+     backend::Executor& aExecutor) noexcept;
+
 /*! \brief Computes the monolithic supervisor of plants and specs
  * \details Build a binary expression tree of synchronizations and execute
  * the supervisor synthesis with the second level of the tree.
@@ -179,4 +224,10 @@ supC(SysT_l const& aP,
 // include functions definitions
 #include "cldes/src/operations/OperationsCore.hpp"
 
+// Specializations compiled by libcldes
+#ifdef CLDES_EXTERN_TEMPLATES
+#include "cldes/src/Instantiations.hpp"
+CLDES_FOR_EACH_INSTANTIATION(CLDES_EXTERN_OPERATIONS_)
+#endif
+
 #endif // OPERATIONS_HPP
@@ -0,0 +1,294 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/operations/Planner.hpp
+ Description: Cost based planner which chooses, for each node of a lazy
+ operations graph, between fused, cached and eager evaluation.
+ =========================================================================
+*/
+/*!
+ * \file cldes/operations/Planner.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-29
+ *
+ * Cost model choosing lazy or eager evaluation of operations graphs.
+ */
+
+#ifndef PLANNER_HPP
+#define PLANNER_HPP
+
+#include "cldes/Constants.hpp"
+#include "cldes/DESystem.hpp"
+#include "cldes/EventsSet.hpp"
+#include "cldes/backend/Executor.hpp"
+#include "cldes/operations/Expression.hpp"
+#include "cldes/operations/Operations.hpp"
+#include "cldes/operations/RandomWalk.hpp"
+#include "cldes/src/operations/PlannerFwd.hpp"
+
+namespace cldes {
+namespace op {
+
+/*! \class ProductSampler
+ * \brief Estimates the accessible part of a product of leaves
+ * \details Products with up to PlannerOptions::exact_limit accessible
+ * states are explored breadth first and counted. On larger ones, random
+ * walks from the initial state count how many times each state is seen,
+ * and the number of accessible states is estimated by the Chao1
+ * estimator: seen + f1^2 / (2 f2), where f1 and f2 are the number of
+ * states seen once and twice. It is bounded by the states found and by the
+ * product size.
+ *
+ * \tparam NEvents Number of events
+ * \tparam StorageIndex Unsigned type used for indexing states
+ */
+template<uint8_t NEvents, typename StorageIndex>
+class ProductSampler : public FusedExplorer<NEvents, StorageIndex>
+{
+public:
+    using Base_t = FusedExplorer<NEvents, StorageIndex>;
+    using Stage_t = typename Base_t::Stage_t;
+    using EventsSet_t = typename Base_t::EventsSet_t;
+
+    /*! \brief ProductSampler constructor
+     *
+     * @param aStage Stage holding the leaves: only leaves are used
+     */
+    explicit ProductSampler(Stage_t const& aStage)
+      : Base_t{ aStage }
+      , n_leaves_{ aStage.leaves.size() }
+    {}
+
+    /*! \brief Fill full_states, reachable_states, exact and branching
+     *
+     * @param aOptions Sampling options
+     * @param[out] aEstimate Estimate that is filled
+     * \return void
+     */
+    void sample(PlannerOptions const& aOptions, PlanEstimate& aEstimate) const;
+
+private:
+    std::size_t n_leaves_;
+};
+
+/*! \class ExecutionPlan
+ * \brief Decisions taken by Planner for an operations graph
+ * \details Nodes marked kLazy are fused on the exploration of their
+ * consumer. kCacheRows nodes are explored on their own and their consumer
+ * reads the rows of the resulting system. kMaterialize nodes run the eager
+ * synchronize() on concrete operands and keep its accessible part; a supC
+ * node marked kMaterialize runs the fused exploration of its concrete
+ * operands.
+ *
+ * Every plan of an expression returns the same system as
+ * Expression::materialize(), with the same states numbering.
+ *
+ * \tparam NEvents Number of events
+ * \tparam StorageIndex Unsigned type used for indexing states
+ */
+template<uint8_t NEvents, typename StorageIndex>
+class ExecutionPlan
+{
+public:
+    using DESystem_t = DESystem<NEvents, StorageIndex>;
+    using Expression_t = Expression<NEvents, StorageIndex>;
+    using PlanNode_t = PlanNode<NEvents, StorageIndex>;
+
+    /*! \brief ExecutionPlan constructor
+     *
+     * @param aRoot Root of the plan
+     */
+    explicit ExecutionPlan(std::shared_ptr<PlanNode_t const> aRoot) noexcept
+      : root_{ std::move(aRoot) }
+    {}
+
+    /*! \brief Root of the plan
+     */
+    std::shared_ptr<PlanNode_t const> const& root() const noexcept
+    {
+        return root_;
+    }
+
+    /*! \brief Estimated cost of the plan, in leaf row queries
+     */
+    double cost() const noexcept;
+
+    /*! \brief Human readable plan: one line per node with its decision,
+     * estimates, costs and the reason of the decision
+     */
+    std::string explain() const;
+
+    /*! \brief Run the plan
+     * \details It reports to the monitor of the calling thread. If the
+     * monitor stops the operation, an empty system is returned.
+     *
+     * \return The system represented by the planned expression
+     */
+    DESystem_t execute() const;
+
+protected:
+    /*! \brief Append a node and its children to an explain output
+     */
+    static void explain_(PlanNode_t const& aNode,
+                         std::size_t const aDepth,
+                         std::string& aOut);
+
+    /*! \brief Expression which computes aNode with its decisions: concrete
+     * nodes are replaced by leaves owning their result
+     */
+    static Expression_t toExpression_(PlanNode_t const& aNode);
+
+    /*! \brief Expression of aNode, fused with its lazy children
+     */
+    static Expression_t fused_(PlanNode_t const& aNode);
+
+    /*! \brief Concrete system of a node which is not lazy
+     */
+    static DESystem_t concrete_(PlanNode_t const& aNode);
+
+    /*! \brief Run the eager operation of aNode
+     */
+    static DESystem_t eager_(PlanNode_t const& aNode);
+
+private:
+    std::shared_ptr<PlanNode_t const> root_;
+};
+
+/*! \class Planner
+ * \brief Cost model choosing how each node of an operations graph is
+ * evaluated
+ * \details For each node, the accessible part of the product of the leaves
+ * under it is estimated by a ProductSampler. trim and proj do not change
+ * the estimate: it is an upper bound for them and for supC.
+ *
+ * A fused exploration of R states with k leaves and branching b costs
+ * R * (k * (1 + b) + kPlanHashCost * b). The rows of a child are queried
+ * once for each state explored by its consumer: keeping it lazy adds its
+ * leaves to every query, caching its rows costs its own exploration and a
+ * single leaf afterwards. The eager synchronize() visits every product
+ * state, split among the workers of the current executor, and its
+ * accessible part is then explored as a single leaf. supC() is never eager:
+ * it runs the fused exploration of its concrete operands. The
+ * option with the lowest cost and within PlannerOptions::memory_limit wins.
+ *
+ * \tparam NEvents Number of events
+ * \tparam StorageIndex Unsigned type used for indexing states
+ */
+template<uint8_t NEvents, typename StorageIndex>
+class Planner
+{
+public:
+    using Expression_t = Expression<NEvents, StorageIndex>;
+    using Node_t = ExpressionNode<NEvents, StorageIndex>;
+    using PlanNode_t = PlanNode<NEvents, StorageIndex>;
+    using Plan_t = ExecutionPlan<NEvents, StorageIndex>;
+    using Stage_t = FusedStage<NEvents, StorageIndex>;
+
+    /*! \brief Planner constructor
+     *
+     * @param aOptions Sampling options and memory limit
+     */
+    explicit Planner(PlannerOptions const& aOptions = PlannerOptions{})
+      : options_{ aOptions }
+    {}
+
+    /*! \brief Choose the evaluation of each node of aExpr
+     * \details Throws std::overflow_error when a product does not fit on a
+     * ProductKey.
+     *
+     * @param aExpr Operations graph
+     * \return Execution plan
+     */
+    Plan_t plan(Expression_t const& aExpr) const;
+
+protected:
+    /*! \brief Estimate a subtree and decide its children as operands of
+     * a fused exploration of aNode
+     */
+    std::shared_ptr<PlanNode_t> estimate_(
+      std::shared_ptr<Node_t const> const& aNode) const;
+
+    /*! \brief Fix the decision of aNode and of its subtree
+     *
+     * @param aNode Plan node
+     * @param aDecision Decision of aNode
+     * @param aReason Why it was chosen
+     * \return void
+     */
+    void finalize_(PlanNode_t& aNode,
+                   PlanDecision const aDecision,
+                   std::string aReason) const;
+
+    /*! \brief Why a node was chosen to be fused or eager on its own
+     */
+    std::string standaloneReason_(PlanNode_t const& aNode) const;
+
+    /*! \brief Why a node was chosen to be lazy or concrete inside the
+     * exploration of its consumer
+     */
+    std::string inStageReason_(PlanNode_t const& aNode,
+                               ExpressionKind const aParent) const;
+
+    /*! \brief Add the leaves of a subtree, through every operation
+     */
+    static void flatten_(std::shared_ptr<Node_t const> const& aNode,
+                         Stage_t& aStage);
+
+    /*! \brief True if a fused exploration of aParent can include aChild
+     */
+    static bool fusable_(ExpressionKind const aParent,
+                         ExpressionKind const aChild) noexcept;
+
+    /*! \brief True if aBytes is within the memory limit
+     */
+    bool fits_(double const aBytes) const noexcept;
+
+private:
+    PlannerOptions options_;
+};
+
+/*! \brief Plan an expression with the default options
+ */
+template<uint8_t NEvents, typename StorageIndex>
+ExecutionPlan<NEvents, StorageIndex>
+plan(Expression<NEvents, StorageIndex> const& aExpr,
+     PlannerOptions const& aOptions = PlannerOptions{});
+
+/*! \brief Plan and run an expression, choosing lazy or eager evaluation of
+ * each node
+ */
+template<uint8_t NEvents, typename StorageIndex>
+DESystem<NEvents, StorageIndex>
+evaluateAuto(Expression<NEvents, StorageIndex> const& aExpr,
+             PlannerOptions const& aOptions = PlannerOptions{});
+
+} // namespace op
+} // namespace cldes
+
+// include methods definitions
+#include "cldes/src/operations/PlannerCore.hpp"
+
+#endif // PLANNER_HPP
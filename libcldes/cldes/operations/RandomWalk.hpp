@@ -0,0 +1,216 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/operations/RandomWalk.hpp
+ Description: Parallel Monte Carlo random-walk simulator over concrete
+ systems and virtual proxies.
+ =========================================================================
+*/
+/*!
+ * \file cldes/operations/RandomWalk.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-22
+ *
+ * Parallel Monte Carlo random-walk simulator.
+ */
+
+#ifndef RANDOM_WALK_HPP
+#define RANDOM_WALK_HPP
+
+#include "cldes/Constants.hpp"
+#include "cldes/DESystemBase.hpp"
+#include "cldes/EventsSet.hpp"
+#include "cldes/backend/Executor.hpp"
+#include "cldes/src/operations/RandomWalkFwd.hpp"
+
+namespace cldes {
+namespace op {
+
+/*! \class RandomWalkStats
+ * \brief Statistics collected by a batch of random walks
+ *
+ * \tparam NEvents Number of events
+ * \tparam StorageIndex Unsigned type used for indexing states
+ */
+template<uint8_t NEvents, typename StorageIndex>
+struct RandomWalkStats
+{
+    /*! \brief Number of executed walks
+     */
+    uint64_t walks = 0ul;
+
+    /*! \brief Number of transitions fired by all walks
+     */
+    uint64_t steps = 0ul;
+
+    /*! \brief Number of walks which stopped on a state with no transition
+     */
+    uint64_t blocking_hits = 0ul;
+
+    /*! \brief Number of visits to marked states, initial states included
+     */
+    uint64_t marked_hits = 0ul;
+
+    /*! \brief Number of times each event was fired
+     */
+    std::array<uint64_t, NEvents> event_counts{};
+
+    /*! \brief Number of visits to each state
+     * \details It is empty when visits are not tracked.
+     */
+    std::vector<uint64_t> visits;
+
+    /*! \brief Accumulate the statistics of another batch
+     *
+     * @param aOther Statistics that are added to this one
+     * \return void
+     */
+    void merge(RandomWalkStats const& aOther) noexcept;
+};
+
+/*! \class RandomWalkSimulator
+ * \brief Runs independent random executions of a system on many threads
+ * \details Each walk starts on the initial state and, at each step, chooses
+ * one of the enabled events uniformly or proportionally to user defined
+ * weights. A walk stops when it reaches the maximum length or a blocking
+ * state. Walks only query getStateEvents() and trans(), so lazy
+ * compositions that are too large to be materialized can be simulated.
+ *
+ * Each walk owns a random generator seeded by the simulation seed and the
+ * walk index, so results do not depend on the number of threads. All
+ * buffers are allocated before the walks start: a step does not allocate.
+ *
+ * \warning Visits are counted on a dense table indexed by state. States
+ * greater than or equal to getStatesNumber(), such as the ones of a
+ * SuperProxy, are not counted.
+ *
+ * \tparam SysT Any system type: DESystem or a virtual proxy
+ */
+template<class SysT>
+class RandomWalkSimulator
+{
+public:
+    uint8_t static constexpr NEvents = SysTraits<SysT>::Ne_;
+    using StorageIndex = typename SysTraits<SysT>::Si_;
+
+    using EventsSet_t = EventsSet<NEvents>;
+    using Stats_t = RandomWalkStats<NEvents, StorageIndex>;
+    using EventsWeights_t = std::array<double, NEvents>;
+
+    /*! \brief RandomWalkSimulator constructor
+     *
+     * @param aSys System that will be simulated
+     */
+    explicit RandomWalkSimulator(SysT const& aSys);
+
+    /*! \brief Choose events proportionally to weights
+     * \details Events with weight 0 are never chosen when another enabled
+     * event has positive weight.
+     *
+     * @param aWeights Weight of each event
+     * \return void
+     */
+    void setEventsWeights(EventsWeights_t const& aWeights) noexcept;
+
+    /*! \brief Choose enabled events uniformly: the default behavior
+     *
+     * \return void
+     */
+    void setUniform() noexcept { weighted_ = false; }
+
+    /*! \brief Enable or disable visit frequencies
+     *
+     * @param aTrack True for counting visits of each state
+     * \return void
+     */
+    void trackVisits(bool const aTrack) noexcept { track_visits_ = aTrack; }
+
+    /*! \brief Execute random walks
+     * \details Walks are split among the workers of the current executor.
+     *
+     * @param aWalks Number of walks
+     * @param aMaxSteps Maximum number of transitions of each walk
+     * @param aSeed Simulation seed
+     * \return Statistics of all walks
+     */
+    Stats_t run(uint64_t const aWalks,
+                uint64_t const aMaxSteps,
+                uint64_t const aSeed = kDefaultWalkSeed) const;
+
+protected:
+    /*! \brief Disabled default constructor
+     * \details There is no use for the default constructor.
+     */
+    RandomWalkSimulator() = default;
+
+    /*! \brief Execute a range of walks on the calling thread
+     *
+     * @param aFirst First walk index
+     * @param aLast Last walk index, exclusive
+     * @param aMaxSteps Maximum number of transitions of each walk
+     * @param aSeed Simulation seed
+     * @param[out] aStats Worker statistics
+     * \return void
+     */
+    void walks_(uint64_t const aFirst,
+                uint64_t const aLast,
+                uint64_t const aMaxSteps,
+                uint64_t const aSeed,
+                Stats_t& aStats) const noexcept;
+
+    /*! \brief Choose one of the enabled events
+     *
+     * @param aEvents Enabled events: it can not be empty
+     * @param aRng Random generator of the walk
+     * \return The chosen event
+     */
+    ScalarType chooseEvent_(EventsSet_t const& aEvents,
+                            WalkRng& aRng) const noexcept;
+
+private:
+    /*! \brief Reference to the simulated system
+     */
+    SysT const& sys_;
+
+    /*! \brief Marked states cached for checking visits without copies
+     */
+    spp::sparse_hash_set<StorageIndex> marked_states_;
+
+    /*! \brief Weight of each event when weighted_ is true
+     */
+    EventsWeights_t weights_;
+
+    bool weighted_;
+    bool track_visits_;
+};
+
+} // namespace op
+} // namespace cldes
+
+// include methods definitions
+#include "cldes/src/operations/RandomWalkCore.hpp"
+
+#endif // RANDOM_WALK_HPP
@@ -0,0 +1,355 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/operations/Sharded.hpp
+ Description: Multi-process sharded exploration. Product states are hash
+ partitioned among worker processes, which exchange frontier batches.
+ =========================================================================
+*/
+/*!
+ * \file cldes/operations/Sharded.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-30
+ *
+ * Sharded synchronize and supC on local worker processes.
+ */
+
+#ifndef SHARDED_HPP
+#define SHARDED_HPP
+
+#include "cldes/Constants.hpp"
+#include "cldes/DESystem.hpp"
+#include "cldes/EventsSet.hpp"
+#include "cldes/OperationMonitor.hpp"
+#include "cldes/backend/Executor.hpp"
+#include "cldes/operations/Operations.hpp"
+#include "cldes/src/operations/ShardedFwd.hpp"
+
+namespace cldes {
+namespace op {
+
+/*! \brief Product of two systems as seen by the workers
+ * \details It is built by the coordinator before the workers are forked,
+ * so the workers share it copy-on-write.
+ */
+template<uint8_t NEvents>
+struct ShardProduct
+{
+    ShardKey n0 = 0ul;
+    ShardKey init = 0ul;
+    std::size_t shards = 1ul;
+    std::size_t batch_states = 1ul;
+
+    EventsSet<NEvents> events;
+    EventsSet<NEvents> only_in_0;
+    EventsSet<NEvents> only_in_1;
+
+    bool supc = false;
+    EventsSet<NEvents> non_contr;
+
+    std::vector<bool> marked0;
+    std::vector<bool> marked1;
+};
+
+/*! \class ShardWorker
+ * \brief Worker process of a sharded exploration
+ * \details A worker owns the product states q such that shardOf_(q) is its
+ * shard: it keeps their visited, removed and transitions tables. Each
+ * command of the coordinator is a superstep: the worker processes up to
+ * batch_states states of its frontier, sends the entries owned by other
+ * workers in one batch per worker, and processes the batches it receives.
+ * The batches are exchanged on local socket pairs, which are written
+ * without blocking, so every worker sends and receives at the same time.
+ *
+ * The inverse transitions of a state are kept by the owner of its target:
+ * removing a state sends its non controllable predecessors to their
+ * owners, as SuperProxy does on a single process.
+ *
+ * \tparam SysT_l Plant or left operand type
+ * \tparam SysT_r Specification or right operand type
+ */
+template<class SysT_l, class SysT_r>
+class ShardWorker
+{
+public:
+    uint8_t static constexpr NEvents = SysTraits<SysT_l>::Ne_;
+    using StorageIndex = typename SysTraits<SysT_l>::Si_;
+    using EventsSet_t = EventsSet<NEvents>;
+    using Product_t = ShardProduct<NEvents>;
+
+    /*! \brief ShardWorker constructor
+     *
+     * @param aSys0 Left operand
+     * @param aSys1 Right operand
+     * @param aProduct Product description
+     * @param aShard Shard owned by this worker
+     * @param aControl Socket to the coordinator
+     * @param aPeers Socket to each other worker: ignored on aShard
+     */
+    ShardWorker(SysT_l const& aSys0,
+                SysT_r const& aSys1,
+                Product_t const& aProduct,
+                std::size_t const aShard,
+                int const aControl,
+                std::vector<int> aPeers);
+
+    /*! \brief Run commands until the coordinator sends kStop
+     * \details Throws on communication failures.
+     *
+     * \return void
+     */
+    void run();
+
+protected:
+    /*! \brief Get or create the local id of an owned product state
+     */
+    std::size_t findOrInsert_(ShardKey const aKey, bool& aInserted);
+
+    /*! \brief Send the pending batches and process the received ones
+     *
+     * @param aWords Number of words of each entry
+     * @param aProcess Called with a pointer to each entry
+     * \return void
+     */
+    template<class Function>
+    void exchange_(std::size_t const aWords, Function&& aProcess);
+
+    /*! \brief Superstep bodies: they return the worker count of the report
+     */
+    uint64_t init_();
+    uint64_t expand_();
+    uint64_t index_();
+    uint64_t uncontrollable_();
+    uint64_t markInit_(bool const aCoreach);
+    uint64_t markStep_(bool const aCoreach);
+    uint64_t markFinish_(std::vector<std::size_t>* aNewlyRemoved);
+
+    /*! \brief Send the alive states and their transitions
+     */
+    void collect_();
+
+    /*! \brief Send the report of a superstep
+     */
+    void report_(uint64_t const aCount);
+
+    /*! \brief Estimated bytes of the worker tables
+     */
+    uint64_t tableBytes_() const noexcept;
+
+private:
+    SysT_l const& sys0_;
+    SysT_r const& sys1_;
+    Product_t const& product_;
+    std::size_t shard_;
+    int control_;
+    std::vector<int> peers_;
+
+    /*! \brief Owned states
+     */
+    spp::sparse_hash_map<ShardKey, std::size_t> ids_;
+    std::vector<ShardKey> keys_;
+    std::vector<bool> marked_;
+    std::vector<bool> removed_;
+    std::vector<bool> visited_;
+
+    /*! \brief States waiting to be processed, from head_
+     */
+    std::vector<std::size_t> frontier_;
+    std::size_t head_;
+    std::vector<std::size_t> newly_removed_;
+
+    /*! \brief Transitions leaving owned states, on CSR arrays
+     */
+    std::vector<std::size_t> offsets_;
+    std::vector<ShardKey> targets_;
+    std::vector<ScalarType> labels_;
+
+    /*! \brief Transitions reaching owned states: (target id, source, event)
+     * triples while exploring, then CSR arrays
+     */
+    std::vector<uint64_t> inv_entries_;
+    std::vector<std::size_t> inv_offsets_;
+    std::vector<ShardKey> inv_sources_;
+    std::vector<ScalarType> inv_labels_;
+
+    /*! \brief Outgoing batch of each worker: word 0 is its size
+     */
+    std::vector<std::vector<uint64_t>> out_;
+    std::vector<std::vector<uint64_t>> in_;
+
+    uint64_t messages_;
+    uint64_t max_table_bytes_;
+};
+
+/*! \class ShardCoordinator
+ * \brief Runs synchronize and supC on local worker processes
+ * \details Each operation forks ShardOptions::shards workers, drives them
+ * by supersteps and gathers the result. The memory of the exploration is
+ * split among the workers: only the result is built by the coordinator.
+ * The aggregated memory of the workers is available from stats().
+ *
+ * States of the results are the accessible product states sorted by their
+ * product index q1 * n0 + q0: the same as the fused Expression results.
+ * supC() returns the same system as the fused supC().
+ *
+ * Operands are shared with the workers copy-on-write. Workers do not use
+ * the executor: each of them explores on a single thread.
+ *
+ * Workers are forked. Workers of every ThreadPoolExecutor, also the ones
+ * of defaultExecutor(), are joined while forking and then restarted (see
+ * backend::SuspendedThreadPools), so no lock is held on the workers.
+ *
+ * \warning Threads which are not workers of a pool, e.g. the ones of an
+ * OpenMPExecutor or of the application, must not run while the workers are
+ * forked: a lock held by them would never be released on the workers. No
+ * other thread may run operations on a pool meanwhile.
+ *
+ * \tparam SysT_l Plant or left operand type
+ * \tparam SysT_r Specification or right operand type
+ */
+template<class SysT_l, class SysT_r>
+class ShardCoordinator
+{
+public:
+    uint8_t static constexpr NEvents = SysTraits<SysT_l>::Ne_;
+    using StorageIndex = typename SysTraits<SysT_l>::Si_;
+    using DESystem_t = DESystem<NEvents, StorageIndex>;
+    using EventsSet_t = EventsSet<NEvents>;
+    using Worker_t = ShardWorker<SysT_l, SysT_r>;
+
+    /*! \brief ShardCoordinator constructor
+     * \details Throws std::invalid_argument with no shards, and
+     * std::overflow_error if the product does not fit on a ShardKey.
+     *
+     * @param aSys0 Left operand: plant for supC()
+     * @param aSys1 Right operand: specification for supC()
+     * @param aOptions Number of workers and batch size
+     */
+    ShardCoordinator(SysT_l const& aSys0,
+                     SysT_r const& aSys1,
+                     ShardOptions const& aOptions = ShardOptions{});
+
+    ShardCoordinator(ShardCoordinator const&) = delete;
+    ShardCoordinator& operator=(ShardCoordinator const&) = delete;
+
+    /*! \brief Stop the workers which are still running
+     */
+    ~ShardCoordinator() { shutdown_(); }
+
+    /*! \brief Accessible part of the parallel composition
+     * \details It reports to the monitor of the calling thread. If the
+     * monitor stops the operation, an empty system is returned.
+     */
+    DESystem_t synchronize();
+
+    /*! \brief Monolithic supervisor synthesis
+     * \details It reports to the monitor of the calling thread. If the
+     * monitor stops the operation, an empty system is returned.
+     *
+     * @param aNonContr Non controllable events
+     */
+    DESystem_t supC(EventsTableHost const& aNonContr);
+
+    /*! \brief Stats of the last operation
+     */
+    ShardStats const& stats() const noexcept { return stats_; }
+
+protected:
+    /*! \brief Fork the workers and connect them
+     * \details Thread pools are suspended while forking.
+     */
+    void spawn_();
+
+    /*! \brief Stop the workers and wait for them
+     * \return True if every worker exited normally
+     */
+    bool shutdown_() noexcept;
+
+    /*! \brief Run a superstep on every worker
+     * \return Sum of the workers counts
+     */
+    uint64_t step_(ShardCommand const aCommand);
+
+    /*! \brief Read the report of a worker and update the stats
+     */
+    uint64_t readReport_(std::size_t const aShard);
+
+    /*! \brief Repeat a superstep until all frontiers are empty
+     * \return False if the monitor stopped the operation
+     */
+    bool drain_(ShardCommand const aCommand);
+
+    /*! \brief Gather the alive states and build the result
+     */
+    DESystem_t collect_();
+
+    /*! \brief Run an operation: fork, explore, prune, collect, stop
+     */
+    DESystem_t run_();
+
+private:
+    SysT_l const& sys0_;
+    SysT_r const& sys1_;
+    ShardOptions options_;
+    ShardProduct<NEvents> product_;
+
+    std::vector<pid_t> pids_;
+    std::vector<int> controls_;
+
+    ShardStats stats_;
+    bool stopped_;
+    uint64_t reported_states_;
+    int64_t reported_bytes_;
+};
+
+/*! \brief Sharded parallel composition
+ * \details Accessible part only, see ShardCoordinator.
+ */
+template<class SysT_l, class SysT_r>
+DESystem<SysTraits<SysT_l>::Ne_, typename SysTraits<SysT_l>::Si_>
+shardedSynchronize(SysT_l const& aSys0,
+                   SysT_r const& aSys1,
+                   ShardOptions const& aOptions = ShardOptions{},
+                   ShardStats* aStats = nullptr);
+
+/*! \brief Sharded monolithic supervisor synthesis
+ * \details See ShardCoordinator.
+ */
+template<class SysT_l, class SysT_r>
+DESystem<SysTraits<SysT_l>::Ne_, typename SysTraits<SysT_l>::Si_>
+shardedSupC(SysT_l const& aP,
+            SysT_r const& aE,
+            EventsTableHost const& aNonContr,
+            ShardOptions const& aOptions = ShardOptions{},
+            ShardStats* aStats = nullptr);
+
+} // namespace op
+} // namespace cldes
+
+// include methods definitions
+#include "cldes/src/operations/ShardedCore.hpp"
+
+#endif // SHARDED_HPP
@@ -0,0 +1,200 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/operations/StateEstimator.hpp
+ Description: Online current-state estimator for partially observed
+ systems.
+ =========================================================================
+*/
+/*!
+ * \file cldes/operations/StateEstimator.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-20
+ *
+ * Online current-state estimator for partially observed systems.
+ */
+
+#ifndef STATE_ESTIMATOR_HPP
+#define STATE_ESTIMATOR_HPP
+
+#include "cldes/Constants.hpp"
+#include "cldes/DESystemBase.hpp"
+#include "cldes/EventsSet.hpp"
+#include "cldes/src/operations/StateEstimatorFwd.hpp"
+
+namespace cldes {
+namespace op {
+
+/*! \class StateEstimator
+ * \brief Online estimator of the current state of a partially observed system
+ * \details Tracks the set of states the system may be in after a sequence of
+ * observed events, without building the observer automaton. The estimate is
+ * kept as a sorted vector of states. Each update computes the image of the
+ * estimate by the observed event followed by its unobservable reach, so its
+ * cost is bounded by the number of transitions leaving the estimate.
+ *
+ * Closures of frequently seen images are cached, so recurring estimates are
+ * answered with a single lookup.
+ *
+ * \warning The visited bitmap is indexed by state, so it is sized by
+ * getStatesNumber(). Convert a SuperProxy to DESystem before estimating its
+ * states, since its states are indexed by the underlying product.
+ *
+ * \tparam SysT Any system type: DESystem or a virtual proxy
+ */
+template<class SysT>
+class StateEstimator
+{
+public:
+    uint8_t static constexpr NEvents = SysTraits<SysT>::Ne_;
+    using StorageIndex = typename SysTraits<SysT>::Si_;
+
+    /*! \brief Current estimate type
+     * \details Sorted vector of states without repetitions.
+     */
+    using Estimate_t = StatesArray<StorageIndex>;
+
+    using EventsSet_t = EventsSet<NEvents>;
+
+    /*! \brief StateEstimator constructor
+     * \details The estimate starts as the unobservable reach of the
+     * initial state of the system.
+     *
+     * @param aSys System whose current state is estimated
+     * @param aUnobservable Set of events that are not observed
+     * @param aCacheCapacity Maximum number of cached closures
+     */
+    StateEstimator(SysT const& aSys,
+                   EventsSet_t const& aUnobservable,
+                   std::size_t const aCacheCapacity =
+                     kDefaultEstimatorCacheCapacity);
+
+    /*! \brief Restart the estimation from the initial state
+     *
+     * \return void
+     */
+    void reset() noexcept;
+
+    /*! \brief Update the estimate with an observed event
+     *
+     * @param aEvent The observed event
+     * \return False if the observation is inconsistent with the model, so
+     * the estimate became empty. True otherwise.
+     */
+    bool update(ScalarType const& aEvent) noexcept;
+
+    /*! \brief Current estimate getter
+     *
+     * \return Sorted vector of the states the system can be in
+     */
+    Estimate_t const& getEstimate() const noexcept { return estimate_; }
+
+    /*! \brief Check if a state belongs to the current estimate
+     *
+     * @param aQ State
+     * \return True if aQ belongs to the estimate
+     */
+    bool contains(StorageIndex const& aQ) const noexcept
+    {
+        return std::binary_search(estimate_.begin(), estimate_.end(), aQ);
+    }
+
+    /*! \brief Number of updates answered by the closures cache
+     */
+    std::size_t cacheHits() const noexcept { return cache_hits_; }
+
+    /*! \brief Number of closures computed from scratch
+     */
+    std::size_t cacheMisses() const noexcept { return cache_misses_; }
+
+protected:
+    /*! \brief Disabled default constructor
+     * \details There is no use for the default constructor.
+     */
+    StateEstimator() = default;
+
+    /*! \brief Replace aStates by its unobservable reach
+     * \details aStates entries must be marked on visited_ and it is left
+     * sorted with all visited_ marks cleared.
+     *
+     * @param[out] aStates States set to be closed
+     * \return void
+     */
+    void unobservableReach_(Estimate_t& aStates) noexcept;
+
+    /*! \brief Apply cached closure or compute and cache it
+     *
+     * @param[out] aStates Sorted image that is replaced by its closure
+     * \return void
+     */
+    void closure_(Estimate_t& aStates) noexcept;
+
+private:
+    /*! \brief Reference to the observed system
+     */
+    SysT const& sys_;
+
+    /*! \brief Unobservable events
+     */
+    EventsSet_t unobservable_;
+
+    /*! \brief Current estimate
+     */
+    Estimate_t estimate_;
+
+    /*! \brief Scratch buffer holding the next estimate
+     */
+    Estimate_t next_;
+
+    /*! \brief Scratch stack used by the unobservable reach search
+     */
+    Estimate_t stack_;
+
+    /*! \brief Bitmap of states already inserted on the estimate being built
+     * \details Only the bits of inserted states are cleared after each
+     * update, so an update never touches the whole bitmap.
+     */
+    std::vector<bool> visited_;
+
+    /*! \brief Cache of unobservable closures indexed by the event image
+     */
+    EstimatesCache<StorageIndex> cache_;
+
+    /*! \brief Maximum number of cached closures
+     */
+    std::size_t cache_capacity_;
+
+    std::size_t cache_hits_;
+    std::size_t cache_misses_;
+};
+
+} // namespace op
+} // namespace cldes
+
+// include methods definitions
+#include "cldes/src/operations/StateEstimatorCore.hpp"
+
+#endif // STATE_ESTIMATOR_HPP
@@ -43,6 +43,10 @@
 #include "cldes/Constants.hpp"
 #include "cldes/DESystemBase.hpp"
 #include "cldes/EventsSet.hpp"
+#include "cldes/OperationMonitor.hpp"
+#include "cldes/OperationStats.hpp"
+#include "cldes/Trace.hpp"
+#include "cldes/backend/Executor.hpp"
 #include "cldes/src/operations/SuperProxyFwd.hpp"
 
 namespace cldes {
@@ -146,6 +150,12 @@ public:
      */
     bool constexpr static isVirtual_impl() noexcept { return true; }
 
+    /*! \brief Memory held by the system, by table
+     * \details Operands are not included. Tables hold the states of the
+     * supervisor and the virtual states.
+     */
+    MemoryUsage memoryUsage_impl() const noexcept;
+
     /*! \brief clone method for polymorphic copy
      * \details Method for cloning on a polymorphic way.
      *
@@ -162,24 +172,25 @@ public:
      * @param aQ State
      * @param aEvent Event
      */
-    bool containstrans_impl(StorageIndex const& aQ,
-                            ScalarType const& aEvent) const noexcept;
+    inline bool containstrans_impl(StorageIndex const& aQ,
+                                   ScalarType const& aEvent) const noexcept;
 
     /*! \brief Returns DES transition: q_to = f(q, e)
      *
      * @param aQ State
      * @param aEvent Event
      */
-    StorageIndexSigned trans_impl(StorageIndex const& aQ,
-                                  ScalarType const& aEvent) const noexcept;
+    inline StorageIndexSigned trans_impl(StorageIndex const& aQ,
+                                         ScalarType const& aEvent) const
+      noexcept;
 
     /*! \brief Returns true if DES inverse transition exists
      *
      * @param aQ State
      * @param aEvent Event
      */
-    bool containsinvtrans_impl(StorageIndex const& aQ,
-                               ScalarType const& aEvent) const;
+    inline bool containsinvtrans_impl(StorageIndex const& aQ,
+                                      ScalarType const& aEvent) const;
 
     /*! \brief Returns DES inverse transition
      * \details  q = f^-1(q_to, e)
@@ -187,9 +198,38 @@ public:
      * @param aQ State
      * @param aEvent Event
      */
-    StatesArray<StorageIndex> invtrans_impl(StorageIndex const& aQ,
-                                            ScalarType const& aEvent) const;
+    inline StatesArray<StorageIndex> invtrans_impl(
+      StorageIndex const& aQ,
+      ScalarType const& aEvent) const;
+
+    /*! \brief Visit the transitions leaving a state
+     * \details It streams the rows of both components: shared events are
+     * joined without building any product.
+     *
+     * @param aQ State
+     * @param aFunction Callable with signature (event, qto)
+     * \return void
+     */
+    template<class Function>
+    void forEachSuccessor_impl(StorageIndex const& aQ,
+                               Function& aFunction) const;
+
+    /*! \brief Visit the transitions arriving to a state
+     * \details Predecessors of shared events are the product of the
+     * components predecessors: they are visited by nested calls.
+     *
+     * @param aQ State
+     * @param aEvents Mask of the visited events
+     * @param aFunction Callable with signature (event, qfrom)
+     * \return void
+     */
+    template<class Function>
+    void forEachPredecessor_impl(StorageIndex const& aQ,
+                                 EventsSet<NEvents> const& aEvents,
+                                 Function& aFunction) const;
 
+    /*! \brief Remove the states which cannot reach a marked state
+     */
     void trim() noexcept;
 
     /*! \brief Get events that a state contains
@@ -198,7 +238,7 @@ public:
      * @param aQ A state on the sys
      * \return Bit set with events of state events
      */
-    EventsSet<NEvents> getStateEvents_impl(StorageIndex const& aQ) const
+    inline EventsSet<NEvents> getStateEvents_impl(StorageIndex const& aQ) const
       noexcept;
 
     /*! \brief Get inverse events that a state contains
@@ -206,7 +246,8 @@ public:
      * @param aQ A state on the sys
      * \return Bit set with events index set to true
      */
-    EventsSet<NEvents> getInvStateEvents_impl(StorageIndex const& aQ) const;
+    inline EventsSet<NEvents> getInvStateEvents_impl(
+      StorageIndex const& aQ) const;
 
     /*! \brief Invert graph
      * \details This is used on some operations... it can be very inneficient
@@ -244,7 +285,7 @@ public:
      *
      * @param aLang Set of events
      */
-    SuperProxy constexpr& invproj_impl(EventsSet<NEvents> const&) const noexcept
+    SuperProxy const& invproj_impl(EventsSet<NEvents> const&) const noexcept
     {
         return *this;
     }
@@ -261,6 +302,28 @@ protected:
                             SysT_r const& aE,
                             EventsTableHost const& aNonContr) noexcept;
 
+    /*! \brief Remove the states which cannot reach a marked state
+     * \return Removed states
+     */
+    std::vector<StorageIndex> removeBlocking_() noexcept;
+
+    /*! \brief Remove the states which reach a removed state by non
+     * controllable events
+     *
+     * @param aVirtualSys Product of the operands, with inverted graphs
+     * @param aRemoved States removed so far
+     * @param aNonContrBit Non controllable events of the product
+     * \return True if any state was removed
+     */
+    bool removeUncontrollable_(
+      SyncSysProxy<SysT_l, SysT_r> const& aVirtualSys,
+      std::vector<StorageIndex>&& aRemoved,
+      EventsSet<NEvents> const& aNonContrBit) noexcept;
+
+    /*! \brief Remove the states which the initial state does not reach
+     */
+    void removeInaccessible_() noexcept;
+
     /*! \brief transform a virtual system in a real system: optmized to
      * supervisor synthesis
      *
@@ -306,6 +369,17 @@ private:
 };
 
 } // namespace op
+
+/*! \brief Traits of a SuperProxy
+ * \details Proxies inherit events number and index type from the left
+ * operand, so they can be nested and used as operands of other operations.
+ */
+template<class SysT_l, class SysT_r>
+struct SysTraits<op::SuperProxy<SysT_l, SysT_r>>
+{
+    uint8_t static constexpr Ne_ = SysTraits<SysT_l>::Ne_;
+    using Si_ = typename SysTraits<SysT_l>::Si_;
+};
 } // namespace cldes
 
 // include methods definitions
@@ -42,6 +42,7 @@
 #include "cldes/Constants.hpp"
 #include "cldes/DESystemBase.hpp"
 #include "cldes/EventsSet.hpp"
+#include "cldes/Trace.hpp"
 #include "cldes/src/operations/SyncSysProxyFwd.hpp"
 
 namespace cldes {
@@ -140,6 +141,12 @@ public:
      */
     bool constexpr static isVirtual_impl() noexcept { return true; }
 
+    /*! \brief Memory held by the system, by table
+     * \details Operands are not included. Tables hold the virtual states and
+     * the transitions waiting to be converted.
+     */
+    MemoryUsage memoryUsage_impl() const noexcept;
+
     /*! \brief clone method for polymorphic copy
      * \details Method for cloning on a polymorphic way.
      *
@@ -147,7 +154,7 @@ public:
      */
     std::shared_ptr<Base> constexpr clone_impl() const noexcept
     {
-        std::shared_ptr<Base> this_ptr = std::make_shared<SuperProxy>(*this);
+        std::shared_ptr<Base> this_ptr = std::make_shared<SyncSysProxy>(*this);
         return this_ptr;
     }
 
@@ -156,24 +163,25 @@ public:
      * @param aQ State
      * @param aEvent Event
      */
-    bool containstrans_impl(StorageIndex const& aQ,
-                            ScalarType const& aEvent) const noexcept;
+    inline bool containstrans_impl(StorageIndex const& aQ,
+                                   ScalarType const& aEvent) const noexcept;
 
     /*! \brief Returns DES transition: q_to = f(q, e)
      *
      * @param aQ State
      * @param aEvent Event
      */
-    StorageIndexSigned trans_impl(StorageIndex const& aQ,
-                                  ScalarType const& aEvent) const noexcept;
+    inline StorageIndexSigned trans_impl(StorageIndex const& aQ,
+                                         ScalarType const& aEvent) const
+      noexcept;
 
     /*! \brief Returns true if DES inverse transition exists
      *
      * @param aQ State
      * @param aEvent Event
      */
-    bool containsinvtrans_impl(StorageIndex const& aQ,
-                               ScalarType const& aEvent) const;
+    inline bool containsinvtrans_impl(StorageIndex const& aQ,
+                                      ScalarType const& aEvent) const;
 
     /*! \brief Returns DES inverse transition
      * \details  q = f^-1(q_to, e)
@@ -181,8 +189,35 @@ public:
      * @param aQ State
      * @param aEvent Event
      */
-    StatesArray<StorageIndex> invtrans_impl(StorageIndex const& aQ,
-                                            ScalarType const& aEvent) const;
+    inline StatesArray<StorageIndex> invtrans_impl(
+      StorageIndex const& aQ,
+      ScalarType const& aEvent) const;
+
+    /*! \brief Visit the transitions leaving a state
+     * \details It streams the rows of both components: shared events are
+     * joined without building any product.
+     *
+     * @param aQ State
+     * @param aFunction Callable with signature (event, qto)
+     * \return void
+     */
+    template<class Function>
+    void forEachSuccessor_impl(StorageIndex const& aQ,
+                               Function& aFunction) const;
+
+    /*! \brief Visit the transitions arriving to a state
+     * \details Predecessors of shared events are the product of the
+     * components predecessors: they are visited by nested calls.
+     *
+     * @param aQ State
+     * @param aEvents Mask of the visited events
+     * @param aFunction Callable with signature (event, qfrom)
+     * \return void
+     */
+    template<class Function>
+    void forEachPredecessor_impl(StorageIndex const& aQ,
+                                 EventsSet<NEvents> const& aEvents,
+                                 Function& aFunction) const;
 
     /*! \brief Get events that a state contains
      * \warning On large binery trees, it can be very expensive.
@@ -190,7 +225,7 @@ public:
      * @param aQ A state on the sys
      * \return Bit set with events of state events
      */
-    EventsSet<NEvents> getStateEvents_impl(StorageIndex const& aQ) const
+    inline EventsSet<NEvents> getStateEvents_impl(StorageIndex const& aQ) const
       noexcept;
 
     /*! \brief Get inverse events that a state contains
@@ -198,7 +233,8 @@ public:
      * @param aQ A state on the sys
      * \return Bit set with events index set to true
      */
-    EventsSet<NEvents> getInvStateEvents_impl(StorageIndex const& aQ) const;
+    inline EventsSet<NEvents> getInvStateEvents_impl(
+      StorageIndex const& aQ) const;
 
     /*! \brief Invert graph
      * \details This is used on some operations... it can be very inneficient
@@ -236,7 +272,7 @@ public:
      *
      * @param aLang Set of events
      */
-    SyncSysProxy constexpr& invproj_impl(EventsSet<NEvents> const&) const
+    SyncSysProxy const& invproj_impl(EventsSet<NEvents> const&) const
       noexcept
     {
         return *this;
@@ -288,6 +324,17 @@ private:
 };
 
 } // namespace op
+
+/*! \brief Traits of a SyncSysProxy
+ * \details Proxies inherit events number and index type from the left
+ * operand, so they can be nested and used as operands of other operations.
+ */
+template<class SysT_l, class SysT_r>
+struct SysTraits<op::SyncSysProxy<SysT_l, SysT_r>>
+{
+    uint8_t static constexpr Ne_ = SysTraits<SysT_l>::Ne_;
+    using Si_ = typename SysTraits<SysT_l>::Si_;
+};
 } // namespace cldes
 
 // include methods definitions
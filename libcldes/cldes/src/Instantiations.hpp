@@ -0,0 +1,95 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/Instantiations.hpp
+ Description: Configurations explicitly instantiated by libcldes.
+ =========================================================================
+*/
+/*!
+ * \file cldes/src/Instantiations.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-28
+ *
+ * The library target compiles DESystem, SyncSysProxy, SuperProxy and the
+ * operations between two DESystem for the configurations listed here.
+ * Targets linked to it get CLDES_EXTERN_TEMPLATES defined, so the headers
+ * declare those specializations extern and translation units skip their
+ * instantiation. Other configurations are still instantiated on demand.
+ * Members declared inline, as the per-query ones of the systems, are not
+ * affected by the extern declarations and stay inlinable in their callers.
+ */
+
+#ifndef CLDES_INSTANTIATIONS_HPP
+#define CLDES_INSTANTIATIONS_HPP
+
+#include <cstdint>
+
+/*! \brief Apply MACRO(NEvents, StorageIndex) on each compiled configuration
+ * \details Besides the 32, 64 and 128 events widths, it lists the ones of
+ * the benchmarks linked to the library: ClusterTool(n) uses 8 * n events.
+ */
+#define CLDES_FOR_EACH_INSTANTIATION(MACRO)                                  \
+    MACRO(16, uint32_t)                                                      \
+    MACRO(24, uint32_t)                                                      \
+    MACRO(32, uint32_t)                                                      \
+    MACRO(32, uint64_t)                                                      \
+    MACRO(40, uint32_t)                                                      \
+    MACRO(48, uint64_t)                                                      \
+    MACRO(56, uint64_t)                                                      \
+    MACRO(64, uint32_t)                                                      \
+    MACRO(64, uint64_t)                                                      \
+    MACRO(128, uint32_t)                                                     \
+    MACRO(128, uint64_t)
+
+/*! \brief Explicit instantiation of a concrete system
+ * \details EXTERN is either extern or empty.
+ */
+#define CLDES_INSTANTIATE_DESYSTEM(EXTERN, NE, SI)                           \
+    EXTERN template class cldes::                                            \
+      DESystemBase<NE, SI, cldes::DESystem<NE, SI>>;                         \
+    EXTERN template class cldes::DESystem<NE, SI>;                           \
+    EXTERN template class cldes::op::SyncSysProxy<cldes::DESystem<NE, SI>,   \
+                                                  cldes::DESystem<NE, SI>>;
+
+/*! \brief Explicit instantiation of the operations between two systems
+ * \details EXTERN is either extern or empty.
+ */
+#define CLDES_INSTANTIATE_OPERATIONS(EXTERN, NE, SI)                         \
+    EXTERN template class cldes::op::SuperProxy<cldes::DESystem<NE, SI>,     \
+                                                cldes::DESystem<NE, SI>>;    \
+    EXTERN template void cldes::op::synchronizeEmptyStage2(                  \
+      cldes::op::SyncSysProxy<cldes::DESystem<NE, SI>,                       \
+                              cldes::DESystem<NE, SI>>&) noexcept;           \
+    EXTERN template cldes::DESystem<NE, SI> cldes::op::supC(                 \
+      cldes::DESystem<NE, SI> const&,                                        \
+      cldes::DESystem<NE, SI> const&,                                        \
+      cldes::op::EventsTableHost const&) noexcept;
+
+#define CLDES_EXTERN_DESYSTEM_(NE, SI) CLDES_INSTANTIATE_DESYSTEM(extern, NE, SI)
+#define CLDES_EXTERN_OPERATIONS_(NE, SI)                                     \
+    CLDES_INSTANTIATE_OPERATIONS(extern, NE, SI)
+
+#endif // CLDES_INSTANTIATIONS_HPP
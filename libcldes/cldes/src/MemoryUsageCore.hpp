@@ -0,0 +1,126 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/MemoryUsageCore.hpp
+ Description: MemoryTracker methods definitions.
+ =========================================================================
+*/
+/*!
+ * \file cldes/src/MemoryUsageCore.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-12-04
+ *
+ * Breakdown of the memory held by a system and tracker of the memory
+ * allocated by operations.
+ */
+
+namespace cldes {
+
+inline MemoryTracker::MemoryTracker() noexcept
+  : running_{ true }
+  , peak_{ 0l }
+  , current_{ 0l }
+  , allocations_{ 0ul }
+  , deallocations_{ 0ul }
+  , allocated_{ 0ul }
+{
+    auto& counters = allocationCounters_();
+    start_allocations_ = counters.allocations.load();
+    start_deallocations_ = counters.deallocations.load();
+    start_allocated_ = counters.allocated.load();
+    start_current_ = counters.current.load();
+    // The peak restarts here: the enclosing tracker gets it back on stop()
+    outer_peak_ = counters.peak.exchange(start_current_);
+}
+
+inline void
+MemoryTracker::stop() noexcept
+{
+    if (!running_) {
+        return;
+    }
+    running_ = false;
+    auto& counters = allocationCounters_();
+    peak_ = std::max(counters.peak.load() - start_current_, 0l);
+    current_ = counters.current.load() - start_current_;
+    allocations_ = counters.allocations.load() - start_allocations_;
+    deallocations_ = counters.deallocations.load() - start_deallocations_;
+    allocated_ = counters.allocated.load() - start_allocated_;
+
+    auto peak = counters.peak.load();
+    while (peak < outer_peak_ &&
+           !counters.peak.compare_exchange_weak(peak, outer_peak_)) {
+    }
+}
+
+inline uint64_t
+MemoryTracker::peakBytes() const noexcept
+{
+    if (running_) {
+        return static_cast<uint64_t>(
+          std::max(allocationCounters_().peak.load() - start_current_, 0l));
+    }
+    return static_cast<uint64_t>(peak_);
+}
+
+inline int64_t
+MemoryTracker::currentBytes() const noexcept
+{
+    if (running_) {
+        return allocationCounters_().current.load() - start_current_;
+    }
+    return current_;
+}
+
+inline uint64_t
+MemoryTracker::allocations() const noexcept
+{
+    if (running_) {
+        return allocationCounters_().allocations.load() - start_allocations_;
+    }
+    return allocations_;
+}
+
+inline uint64_t
+MemoryTracker::deallocations() const noexcept
+{
+    if (running_) {
+        return allocationCounters_().deallocations.load() -
+               start_deallocations_;
+    }
+    return deallocations_;
+}
+
+inline uint64_t
+MemoryTracker::allocatedBytes() const noexcept
+{
+    if (running_) {
+        return allocationCounters_().allocated.load() - start_allocated_;
+    }
+    return allocated_;
+}
+
+} // namespace cldes
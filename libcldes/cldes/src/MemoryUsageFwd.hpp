@@ -0,0 +1,147 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/MemoryUsageFwd.hpp
+ Description: MemoryUsage includes, estimates of containers and the
+ allocation counters.
+ =========================================================================
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+namespace cldes {
+
+/*! \brief Estimate of the bytes of a std::set node besides its value
+ * \details Red-black tree nodes hold a color and three pointers.
+ */
+std::size_t constexpr kSetNodeOverhead = 4ul * sizeof(void*);
+
+/*! \brief Bytes held by a std::vector
+ */
+template<typename T, class AllocT>
+inline uint64_t
+vectorBytes_(std::vector<T, AllocT> const& aVector) noexcept
+{
+    return aVector.capacity() * sizeof(T);
+}
+
+/*! \brief Estimate of the bytes held by a std::set
+ */
+template<typename T, class CompareT, class AllocT>
+inline uint64_t
+setBytes_(std::set<T, CompareT, AllocT> const& aSet) noexcept
+{
+    return aSet.size() * (sizeof(T) + kSetNodeOverhead);
+}
+
+/*! \brief Estimate of the bytes held by a sparsepp hash set or map
+ * \details Sparsepp stores the values contiguously in groups and spends
+ * about 4 bits per bucket on the groups bitmaps.
+ */
+template<class HashT>
+inline uint64_t
+hashBytes_(HashT const& aHash) noexcept
+{
+    return aHash.size() * sizeof(typename HashT::value_type) +
+           aHash.bucket_count() / 2ul;
+}
+
+/*! \brief Bytes held by an Eigen sparse matrix
+ * \details Outer indexes, inner indexes and values. Uncompressed matrices
+ * also hold the number of non zeros of each outer vector.
+ */
+template<class MatrixT>
+inline uint64_t
+sparseMatrixBytes_(MatrixT const& aMatrix) noexcept
+{
+    using Index = typename MatrixT::StorageIndex;
+    using Scalar = typename MatrixT::Scalar;
+    auto const outer = static_cast<uint64_t>(aMatrix.outerSize());
+    auto bytes = (outer + 1ul) * sizeof(Index) +
+                 static_cast<uint64_t>(aMatrix.data().allocatedSize()) *
+                   (sizeof(Index) + sizeof(Scalar));
+    if (!aMatrix.isCompressed()) {
+        bytes += outer * sizeof(Index);
+    }
+    return bytes;
+}
+
+/*! \brief Allocation counters of the process
+ * \details Updated by the hook of cldes/MemoryHook.hpp, when it is
+ * included by the program.
+ */
+struct AllocationCounters_
+{
+    std::atomic<int64_t> current{ 0l };
+    std::atomic<int64_t> peak{ 0l };
+    std::atomic<uint64_t> allocations{ 0ul };
+    std::atomic<uint64_t> deallocations{ 0ul };
+    std::atomic<uint64_t> allocated{ 0ul };
+    std::atomic<bool> hooked{ false };
+};
+
+/*! \brief Counters shared by all threads
+ */
+inline AllocationCounters_&
+allocationCounters_() noexcept
+{
+    static AllocationCounters_ counters;
+    return counters;
+}
+
+/*! \brief Count an allocation: called by the allocation hook
+ */
+inline void
+countAllocation_(std::size_t const aBytes) noexcept
+{
+    auto& counters = allocationCounters_();
+    auto const bytes = static_cast<int64_t>(aBytes);
+    auto const current =
+      counters.current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    auto peak = counters.peak.load(std::memory_order_relaxed);
+    while (current > peak &&
+           !counters.peak.compare_exchange_weak(
+             peak, current, std::memory_order_relaxed)) {
+    }
+    counters.allocations.fetch_add(1ul, std::memory_order_relaxed);
+    counters.allocated.fetch_add(aBytes, std::memory_order_relaxed);
+}
+
+/*! \brief Count a deallocation: called by the allocation hook
+ */
+inline void
+countDeallocation_(std::size_t const aBytes) noexcept
+{
+    auto& counters = allocationCounters_();
+    counters.current.fetch_sub(static_cast<int64_t>(aBytes),
+                               std::memory_order_relaxed);
+    counters.deallocations.fetch_add(1ul, std::memory_order_relaxed);
+}
+}
@@ -0,0 +1,127 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/OperationMonitorCore.hpp
+ Description: OperationMonitor methods definitions.
+ =========================================================================
+*/
+/*!
+ * \file cldes/src/OperationMonitorCore.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-27
+ *
+ * Cancellation, progress reports and resource budgets of long running
+ * operations.
+ */
+
+namespace cldes {
+
+inline OperationMonitor::OperationMonitor(CancellationToken const& aToken,
+                                          OperationBudget const& aBudget,
+                                          ProgressCallback aCallback,
+                                          uint64_t const aInterval)
+  : token_{ aToken }
+  , budget_{ aBudget }
+  , callback_{ std::move(aCallback) }
+  , interval_{ aInterval > 0ul ? aInterval : 1ul }
+  , start_{ std::chrono::steady_clock::now() }
+  , states_{ 0ul }
+  , frontier_{ 0ul }
+  , bytes_{ 0l }
+  , next_check_{ interval_ }
+  , reason_{ static_cast<int>(AbortReason::kNone) }
+{
+}
+
+inline bool
+OperationMonitor::step(uint64_t const aStates,
+                       uint64_t const aFrontier,
+                       int64_t const aBytes) noexcept
+{
+    auto const states = states_.fetch_add(aStates) + aStates;
+    frontier_.store(aFrontier, std::memory_order_relaxed);
+    auto const bytes = bytes_.fetch_add(aBytes) + aBytes;
+
+    if (token_.isCancelled()) {
+        abort_(AbortReason::kCancelled);
+    }
+    if (budget_.memory_bytes > 0ul && bytes > 0l &&
+        static_cast<uint64_t>(bytes) > budget_.memory_bytes) {
+        abort_(AbortReason::kMemoryBudget);
+    }
+
+    // The clock and the callback are checked once per interval
+    auto next = next_check_.load(std::memory_order_relaxed);
+    if (states >= next &&
+        next_check_.compare_exchange_strong(next, states + interval_)) {
+        if (budget_.time.count() > 0 &&
+            std::chrono::steady_clock::now() - start_ > budget_.time) {
+            abort_(AbortReason::kTimeBudget);
+        }
+        report_();
+    }
+
+    return stopped();
+}
+
+inline OperationProgress
+OperationMonitor::progress() const noexcept
+{
+    OperationProgress progress;
+    progress.states_explored = states_.load();
+    progress.frontier_size = frontier_.load();
+    auto const bytes = bytes_.load();
+    progress.memory_bytes = bytes > 0l ? static_cast<uint64_t>(bytes) : 0ul;
+    progress.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start_);
+    return progress;
+}
+
+inline void
+OperationMonitor::finish() noexcept
+{
+    std::lock_guard<std::mutex> lock{ callback_mutex_ };
+    if (callback_) {
+        callback_(progress());
+    }
+}
+
+inline void
+OperationMonitor::abort_(AbortReason const aReason) noexcept
+{
+    auto expected = static_cast<int>(AbortReason::kNone);
+    reason_.compare_exchange_strong(expected, static_cast<int>(aReason));
+}
+
+inline void
+OperationMonitor::report_() noexcept
+{
+    std::unique_lock<std::mutex> lock{ callback_mutex_, std::try_to_lock };
+    if (lock.owns_lock() && callback_) {
+        callback_(progress());
+    }
+}
+}
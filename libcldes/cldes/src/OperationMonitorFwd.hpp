@@ -0,0 +1,101 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/OperationMonitorFwd.hpp
+ Description: OperationMonitor includes, options and aliases.
+ =========================================================================
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace cldes {
+
+/*! \brief Why an operation stopped before its end
+ */
+enum class AbortReason : int
+{
+    kNone = 0,
+    kCancelled,
+    kTimeBudget,
+    kMemoryBudget
+};
+
+/*! \brief Statistics of a running operation
+ */
+struct OperationProgress
+{
+    /*! \brief Number of states visited so far
+     */
+    uint64_t states_explored = 0ul;
+
+    /*! \brief Number of states waiting to be visited on the last report
+     */
+    uint64_t frontier_size = 0ul;
+
+    /*! \brief Estimate of the memory held by the operation tables
+     */
+    uint64_t memory_bytes = 0ul;
+
+    /*! \brief Time since the operation started
+     */
+    std::chrono::milliseconds elapsed{ 0 };
+};
+
+/*! \brief Limits of an operation: 0 means unlimited
+ */
+struct OperationBudget
+{
+    std::chrono::milliseconds time{ 0 };
+    uint64_t memory_bytes = 0ul;
+};
+
+/*! \brief Function called with the progress of an operation
+ */
+using ProgressCallback = std::function<void(OperationProgress const&)>;
+
+/*! \brief Default number of states between progress reports
+ */
+uint64_t const kDefaultProgressInterval = 4096ul;
+
+/*! \brief Number of states sequential loops visit between steps
+ */
+uint64_t const kMonitorBatch = 256ul;
+
+class OperationMonitor;
+
+/*! \brief Monitor installed on the calling thread, if any
+ */
+inline OperationMonitor*&
+currentMonitorPtr_() noexcept
+{
+    static thread_local OperationMonitor* monitor = nullptr;
+    return monitor;
+}
+}
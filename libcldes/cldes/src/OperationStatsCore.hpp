@@ -0,0 +1,169 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/OperationStatsCore.hpp
+ Description: OperationStats methods definitions.
+ =========================================================================
+*/
+/*!
+ * \file cldes/src/OperationStatsCore.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-12-03
+ *
+ * Per-phase wall time, visited states, examined transitions, hash table
+ * traffic and table sizes of the operations.
+ */
+
+namespace cldes {
+
+/*! \brief Copy the atomic counters of a record
+ */
+inline PhaseStats
+phaseStats_(PhaseRecord_ const& aRecord)
+{
+    PhaseStats stats;
+    stats.name = aRecord.name;
+    stats.calls = aRecord.calls.load();
+    stats.wall = std::chrono::nanoseconds{ aRecord.wall.load() };
+    auto const counter = [&aRecord](StatsCounter const aCounter) {
+        return aRecord.counters[static_cast<int>(aCounter)].load();
+    };
+    stats.states_visited = counter(StatsCounter::kStatesVisited);
+    stats.transitions_examined = counter(StatsCounter::kTransitionsExamined);
+    stats.hash_probes = counter(StatsCounter::kHashProbes);
+    stats.hash_inserts = counter(StatsCounter::kHashInserts);
+    stats.allocated_bytes = counter(StatsCounter::kAllocatedBytes);
+    stats.peak_table_size = aRecord.peak.load();
+    return stats;
+}
+
+inline std::vector<PhaseStats>
+OperationStats::phases() const
+{
+    std::lock_guard<std::mutex> const lock{ mutex_ };
+    std::vector<PhaseStats> phases;
+    phases.reserve(records_.size());
+    for (auto const& record : records_) {
+        phases.push_back(phaseStats_(record));
+    }
+    return phases;
+}
+
+inline PhaseStats
+OperationStats::phase(std::string const& aName) const
+{
+    std::lock_guard<std::mutex> const lock{ mutex_ };
+    for (auto const& record : records_) {
+        if (aName == record.name) {
+            return phaseStats_(record);
+        }
+    }
+    PhaseStats stats;
+    stats.name = aName;
+    return stats;
+}
+
+inline void
+OperationStats::clear()
+{
+    std::lock_guard<std::mutex> const lock{ mutex_ };
+    records_.clear();
+}
+
+inline std::string
+OperationStats::toJson() const
+{
+    std::ostringstream json;
+    json << "{\"phases\": [";
+    auto first = true;
+    for (auto const& stats : phases()) {
+        json << (first ? "" : ", ") << "{\"name\": \"" << stats.name
+             << "\", \"calls\": " << stats.calls
+             << ", \"wall_ns\": " << stats.wall.count()
+             << ", \"states_visited\": " << stats.states_visited
+             << ", \"transitions_examined\": " << stats.transitions_examined
+             << ", \"hash_probes\": " << stats.hash_probes
+             << ", \"hash_inserts\": " << stats.hash_inserts
+             << ", \"peak_table_size\": " << stats.peak_table_size
+             << ", \"allocated_bytes\": " << stats.allocated_bytes << "}";
+        first = false;
+    }
+    json << "]}";
+    return json.str();
+}
+
+inline PhaseRecord_&
+OperationStats::record_(char const* aName)
+{
+    std::lock_guard<std::mutex> const lock{ mutex_ };
+    for (auto& record : records_) {
+        if (std::strcmp(record.name, aName) == 0) {
+            return record;
+        }
+    }
+    // deque does not move its elements: references stay valid
+    records_.emplace_back(aName);
+    return records_.back();
+}
+
+#ifdef CLDES_STATS_ENABLED
+
+inline StatsPhase::~StatsPhase()
+{
+    if (record_ == nullptr) {
+        return;
+    }
+    auto const wall = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start_);
+    record_->wall.fetch_add(static_cast<uint64_t>(wall.count()));
+    record_->calls.fetch_add(1ul);
+}
+
+inline void
+StatsPhase::add(StatsCounter const aCounter, uint64_t const aValue) const
+  noexcept
+{
+    if (record_ != nullptr && aValue > 0ul) {
+        record_->counters[static_cast<int>(aCounter)].fetch_add(
+          aValue, std::memory_order_relaxed);
+    }
+}
+
+inline void
+StatsPhase::peak(uint64_t const aSize) const noexcept
+{
+    if (record_ == nullptr) {
+        return;
+    }
+    auto current = record_->peak.load(std::memory_order_relaxed);
+    while (current < aSize &&
+           !record_->peak.compare_exchange_weak(current, aSize)) {
+    }
+}
+
+#endif // CLDES_STATS_ENABLED
+
+} // namespace cldes
@@ -0,0 +1,132 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/OperationStatsFwd.hpp
+ Description: OperationStats includes, counters and aliases.
+ =========================================================================
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace cldes {
+
+/*! \brief True when the statistics are compiled in
+ * \details Define CLDES_STATS_ENABLED (cmake -DCLDES_STATS=ON) to collect
+ * them. Otherwise StatsPhase is empty and the instrumentation vanishes.
+ */
+#ifdef CLDES_STATS_ENABLED
+bool constexpr kStatsEnabled = true;
+#else
+bool constexpr kStatsEnabled = false;
+#endif
+
+/*! \brief Counters a phase can increment
+ */
+enum class StatsCounter : int
+{
+    kStatesVisited = 0,
+    kTransitionsExamined,
+    kHashProbes,
+    kHashInserts,
+    kAllocatedBytes
+};
+
+/*! \brief Number of StatsCounter values
+ */
+int constexpr kStatsCounters = 5;
+
+/*! \brief Statistics of a phase of the operations
+ * \details Phases are summed over all their calls. The wall time of a phase
+ * includes the time of the phases it calls.
+ */
+struct PhaseStats
+{
+    /*! \brief Phase name, e.g. "supC.trim"
+     */
+    std::string name;
+
+    /*! \brief Number of times the phase ran
+     */
+    uint64_t calls = 0ul;
+
+    /*! \brief Total wall time
+     */
+    std::chrono::nanoseconds wall{ 0 };
+
+    uint64_t states_visited = 0ul;
+    uint64_t transitions_examined = 0ul;
+    uint64_t hash_probes = 0ul;
+    uint64_t hash_inserts = 0ul;
+
+    /*! \brief Largest table (states set, map or triplets) the phase built
+     */
+    uint64_t peak_table_size = 0ul;
+
+    /*! \brief Estimate of the bytes allocated by the phase tables
+     */
+    uint64_t allocated_bytes = 0ul;
+};
+
+/*! \brief Counters of a phase, updated by concurrent workers
+ */
+struct PhaseRecord_
+{
+    explicit PhaseRecord_(char const* aName) noexcept
+      : name{ aName }
+      , calls{ 0ul }
+      , wall{ 0ul }
+      , peak{ 0ul }
+    {
+        for (auto& counter : counters) {
+            counter.store(0ul);
+        }
+    }
+
+    char const* name;
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> wall;
+    std::atomic<uint64_t> peak;
+    std::atomic<uint64_t> counters[kStatsCounters];
+};
+
+class OperationStats;
+
+/*! \brief Statistics installed on the calling thread, if any
+ */
+inline OperationStats*&
+currentStatsPtr_() noexcept
+{
+    static thread_local OperationStats* stats = nullptr;
+    return stats;
+}
+}
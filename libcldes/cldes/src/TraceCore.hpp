@@ -0,0 +1,153 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/TraceCore.hpp
+ Description: TraceSession methods definitions.
+ =========================================================================
+*/
+/*!
+ * \file cldes/src/TraceCore.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-12-05
+ *
+ * Scoped spans on the phases of the operations, recorded on per-thread
+ * buffers and written in the Chrome/Perfetto trace JSON format.
+ */
+
+namespace cldes {
+
+/*! \brief Unique id of each session: threads check it before reusing their
+ * cached buffer
+ */
+inline uint64_t
+nextTraceId_() noexcept
+{
+    static std::atomic<uint64_t> id{ 0ul };
+    return ++id;
+}
+
+inline TraceSession::TraceSession()
+  : id_{ nextTraceId_() }
+  , start_{ std::chrono::steady_clock::now() }
+  , previous_{ nullptr }
+  , running_{ true }
+  , dropped_{ 0ul }
+{
+    previous_ = activeTracePtr_().exchange(this, std::memory_order_acq_rel);
+}
+
+inline void
+TraceSession::stop() noexcept
+{
+    if (!running_.exchange(false)) {
+        return;
+    }
+    auto* expected = this;
+    activeTracePtr_().compare_exchange_strong(expected, previous_);
+}
+
+inline std::size_t
+TraceSession::size() const
+{
+    std::lock_guard<std::mutex> const lock{ mutex_ };
+    auto size = 0ul;
+    for (auto const& buffer : buffers_) {
+        size += buffer.events.size();
+    }
+    return size;
+}
+
+inline void
+TraceSession::write(std::ostream& aOut) const
+{
+    std::lock_guard<std::mutex> const lock{ mutex_ };
+    aOut << "{\"traceEvents\": [";
+    auto sep = "\n";
+    for (auto const& buffer : buffers_) {
+        aOut << sep << "{\"name\": \"thread_name\", \"ph\": \"M\", "
+             << "\"pid\": 1, \"tid\": " << buffer.tid
+             << ", \"args\": {\"name\": \"cldes thread " << buffer.tid
+             << "\"}}";
+        sep = ",\n";
+    }
+    auto const precision = aOut.precision(3);
+    aOut.setf(std::ios::fixed, std::ios::floatfield);
+    for (auto const& buffer : buffers_) {
+        for (auto const& event : buffer.events) {
+            aOut << sep << "{\"name\": \"" << event.name
+                 << "\", \"cat\": \"cldes\", \"ph\": \"X\", \"pid\": 1, "
+                 << "\"tid\": " << buffer.tid
+                 << ", \"ts\": " << event.begin_ns / 1000.0
+                 << ", \"dur\": " << (event.end_ns - event.begin_ns) / 1000.0
+                 << "}";
+            sep = ",\n";
+        }
+    }
+    aOut.unsetf(std::ios::floatfield);
+    aOut.precision(precision);
+    aOut << "\n], \"displayTimeUnit\": \"ms\"}" << std::endl;
+}
+
+inline bool
+TraceSession::write(std::string const& aPath) const
+{
+    std::ofstream out{ aPath };
+    if (!out) {
+        return false;
+    }
+    write(out);
+    return static_cast<bool>(out);
+}
+
+inline void
+TraceSession::record_(char const* aName,
+                      int64_t const aBegin,
+                      int64_t const aEnd) noexcept
+{
+    if (!running_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    try {
+        buffer_().events.push_back(TraceEvent_{ aName, aBegin, aEnd });
+    } catch (...) {
+        dropped_.fetch_add(1ul, std::memory_order_relaxed);
+    }
+}
+
+inline TraceBuffer_&
+TraceSession::buffer_()
+{
+    auto& thread = traceThread_();
+    if (thread.session != id_) {
+        std::lock_guard<std::mutex> const lock{ mutex_ };
+        buffers_.emplace_back(static_cast<unsigned>(buffers_.size()));
+        thread.session = id_;
+        thread.buffer = &buffers_.back();
+    }
+    return *thread.buffer;
+}
+
+} // namespace cldes
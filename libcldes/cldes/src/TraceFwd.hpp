@@ -0,0 +1,96 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/TraceFwd.hpp
+ Description: TraceSession includes, buffers and the active session.
+ =========================================================================
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace cldes {
+
+/*! \brief Number of events reserved on each thread buffer
+ */
+std::size_t const kTraceReserve = 4096ul;
+
+/*! \brief Complete event: a span of a thread
+ */
+struct TraceEvent_
+{
+    char const* name;
+    int64_t begin_ns;
+    int64_t end_ns;
+};
+
+/*! \brief Events recorded by a single thread
+ * \details Only its thread writes it, so recording takes no lock.
+ */
+struct TraceBuffer_
+{
+    explicit TraceBuffer_(unsigned const aTid)
+      : tid{ aTid }
+    {
+        events.reserve(kTraceReserve);
+    }
+
+    unsigned tid;
+    std::vector<TraceEvent_> events;
+};
+
+class TraceSession;
+
+/*! \brief Session recording the spans of all threads, if any
+ */
+inline std::atomic<TraceSession*>&
+activeTracePtr_() noexcept
+{
+    static std::atomic<TraceSession*> session{ nullptr };
+    return session;
+}
+
+/*! \brief Buffer of the calling thread on the session with the given id
+ */
+struct TraceThread_
+{
+    uint64_t session = 0ul;
+    TraceBuffer_* buffer = nullptr;
+};
+
+inline TraceThread_&
+traceThread_() noexcept
+{
+    static thread_local TraceThread_ thread;
+    return thread;
+}
+}
@@ -0,0 +1,377 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/backend/AcceleratorCore.hpp
+ Description: Host accelerator kernels definitions.
+ =========================================================================
+*/
+/*!
+ * \file cldes/src/backend/AcceleratorCore.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-12-02
+ *
+ * Accelerator backends of DESystemCL.
+ */
+
+namespace cldes {
+namespace backend {
+
+/*! \brief Set bit aQ of aBitmap
+ * \return True if it was already set
+ */
+inline bool
+testAndSetState_(std::atomic<uint64_t>* const aBitmap,
+                 std::size_t const aQ) noexcept
+{
+    auto const bit = 1ul << (aQ % 64ul);
+    auto& word = aBitmap[aQ / 64ul];
+    if (word.load(std::memory_order_relaxed) & bit) {
+        return true;
+    }
+    return word.fetch_or(bit, std::memory_order_relaxed) & bit;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+std::vector<StorageIndex>
+HostAccelerator<NEvents, StorageIndex>::reach(
+  Graph const& aGraph,
+  std::vector<StorageIndex> const& aSources)
+{
+    auto& executor = currentExecutor();
+    auto const nwords = (static_cast<std::size_t>(aGraph.rows) + 63ul) / 64ul;
+    std::unique_ptr<std::atomic<uint64_t>[]> visited{
+        new std::atomic<uint64_t>[nwords]
+    };
+    auto* const bitmap = visited.get();
+    executor.parallelFor(
+      0ul, nwords, [bitmap](std::size_t const aBegin, std::size_t const aEnd,
+                            unsigned const) {
+          for (auto w = aBegin; w < aEnd; ++w) {
+              bitmap[w].store(0ul, std::memory_order_relaxed);
+          }
+      });
+
+    std::vector<StorageIndex> frontier;
+    for (auto q : aSources) {
+        if (!testAndSetState_(bitmap, q)) {
+            frontier.push_back(q);
+        }
+    }
+
+    std::vector<std::vector<StorageIndex>> next(executor.concurrency());
+    while (!frontier.empty()) {
+        executor.parallelFor(
+          0ul,
+          frontier.size(),
+          [&](std::size_t const aBegin,
+              std::size_t const aEnd,
+              unsigned const aWorker) {
+              auto& found = next[aWorker];
+              for (auto i = aBegin; i < aEnd; ++i) {
+                  auto const q = frontier[i];
+                  for (auto t = aGraph.offsets[q]; t < aGraph.offsets[q + 1u];
+                       ++t) {
+                      if (!testAndSetState_(bitmap, aGraph.cols[t])) {
+                          found.push_back(aGraph.cols[t]);
+                      }
+                  }
+              }
+          },
+          kAcceleratorGrain);
+        frontier.clear();
+        for (auto& found : next) {
+            frontier.insert(frontier.end(), found.begin(), found.end());
+            found.clear();
+        }
+    }
+
+    std::vector<StorageIndex> states;
+    for (auto w = 0ul; w < nwords; ++w) {
+        auto word = bitmap[w].load(std::memory_order_relaxed);
+        while (word != 0ul) {
+            auto const bit = static_cast<std::size_t>(__builtin_ctzl(word));
+            states.push_back(static_cast<StorageIndex>(64ul * w + bit));
+            word &= word - 1ul;
+        }
+    }
+    return states;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+typename HostAccelerator<NEvents, StorageIndex>::Graph
+HostAccelerator<NEvents, StorageIndex>::transpose(Graph const& aGraph)
+{
+    auto& executor = currentExecutor();
+    auto const nrows = static_cast<std::size_t>(aGraph.rows);
+    auto const nnz = aGraph.nonZeros();
+
+    Graph inverted;
+    inverted.rows = aGraph.rows;
+    inverted.offsets.assign(nrows + 1ul, 0ul);
+    inverted.cols.resize(nnz);
+    inverted.events.resize(nnz);
+
+    for (auto t = 0ul; t < nnz; ++t) {
+        ++inverted.offsets[aGraph.cols[t] + 1ul];
+    }
+    std::partial_sum(inverted.offsets.begin(),
+                     inverted.offsets.end(),
+                     inverted.offsets.begin());
+
+    // Rows are scattered concurrently and sorted afterwards, so the result
+    // does not depend on the schedule
+    std::unique_ptr<std::atomic<std::size_t>[]> cursors{
+        new std::atomic<std::size_t>[nrows]
+    };
+    for (auto q = 0ul; q < nrows; ++q) {
+        cursors[q].store(inverted.offsets[q], std::memory_order_relaxed);
+    }
+    executor.parallelFor(
+      0ul,
+      nrows,
+      [&](std::size_t const aBegin, std::size_t const aEnd, unsigned const) {
+          for (auto q = aBegin; q < aEnd; ++q) {
+              for (auto t = aGraph.offsets[q]; t < aGraph.offsets[q + 1ul];
+                   ++t) {
+                  auto const slot = cursors[aGraph.cols[t]].fetch_add(
+                    1ul, std::memory_order_relaxed);
+                  inverted.cols[slot] = static_cast<StorageIndex>(q);
+                  inverted.events[slot] = aGraph.events[t];
+              }
+          }
+      },
+      kAcceleratorGrain);
+
+    executor.parallelFor(
+      0ul,
+      nrows,
+      [&inverted](
+        std::size_t const aBegin, std::size_t const aEnd, unsigned const) {
+          std::vector<std::pair<StorageIndex, EventsSet_t>> row;
+          for (auto q = aBegin; q < aEnd; ++q) {
+              auto const first = inverted.offsets[q];
+              auto const last = inverted.offsets[q + 1ul];
+              row.clear();
+              for (auto t = first; t < last; ++t) {
+                  row.emplace_back(inverted.cols[t], inverted.events[t]);
+              }
+              std::sort(row.begin(),
+                        row.end(),
+                        [](std::pair<StorageIndex, EventsSet_t> const& aLhs,
+                           std::pair<StorageIndex, EventsSet_t> const& aRhs) {
+                            return aLhs.first < aRhs.first;
+                        });
+              for (auto t = first; t < last; ++t) {
+                  inverted.cols[t] = row[t - first].first;
+                  inverted.events[t] = row[t - first].second;
+              }
+          }
+      },
+      kAcceleratorGrain);
+
+    return inverted;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+void
+HostAccelerator<NEvents, StorageIndex>::joinRow_(Graph const& aLhs,
+                                                 EventsSet_t const& aLhsOnly,
+                                                 Graph const& aRhs,
+                                                 EventsSet_t const& aRhsOnly,
+                                                 uint64_t const aKey,
+                                                 JoinRow& aRow)
+{
+    auto const n0 = static_cast<uint64_t>(aLhs.rows);
+    auto const q0 = aKey % n0;
+    auto const q1 = aKey / n0;
+    auto const lhs_first = aLhs.offsets[q0];
+    auto const lhs_last = aLhs.offsets[q0 + 1ul];
+    auto const rhs_first = aRhs.offsets[q1];
+    auto const rhs_last = aRhs.offsets[q1 + 1ul];
+
+    aRow.clear();
+    for (auto i = lhs_first; i < lhs_last; ++i) {
+        auto const c0 = static_cast<uint64_t>(aLhs.cols[i]);
+        EventsSet_t const lhs_only{ aLhs.events[i] & aLhsOnly };
+        if (lhs_only.any()) {
+            aRow.emplace_back(q1 * n0 + c0, lhs_only);
+        }
+        EventsSet_t const shared{ aLhs.events[i] & ~aLhsOnly };
+        if (shared.none()) {
+            continue;
+        }
+        for (auto j = rhs_first; j < rhs_last; ++j) {
+            EventsSet_t const both{ shared & aRhs.events[j] };
+            if (both.any()) {
+                aRow.emplace_back(aRhs.cols[j] * n0 + c0, both);
+            }
+        }
+    }
+    for (auto j = rhs_first; j < rhs_last; ++j) {
+        EventsSet_t const rhs_only{ aRhs.events[j] & aRhsOnly };
+        if (rhs_only.any()) {
+            aRow.emplace_back(aRhs.cols[j] * n0 + q0, rhs_only);
+        }
+    }
+
+    // Transitions to the same state are merged
+    std::sort(aRow.begin(),
+              aRow.end(),
+              [](typename JoinRow::value_type const& aLhsEntry,
+                 typename JoinRow::value_type const& aRhsEntry) {
+                  return aLhsEntry.first < aRhsEntry.first;
+              });
+    auto last = 0ul;
+    for (auto t = 1ul; t < aRow.size(); ++t) {
+        if (aRow[t].first == aRow[last].first) {
+            aRow[last].second |= aRow[t].second;
+        } else {
+            aRow[++last] = aRow[t];
+        }
+    }
+    if (!aRow.empty()) {
+        aRow.resize(last + 1ul);
+    }
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+typename HostAccelerator<NEvents, StorageIndex>::Graph
+HostAccelerator<NEvents, StorageIndex>::synchronize(
+  Graph const& aLhs,
+  EventsSet_t const& aLhsEvents,
+  Graph const& aRhs,
+  EventsSet_t const& aRhsEvents,
+  uint64_t const aInit,
+  std::vector<uint64_t>& aKeys)
+{
+    auto& executor = currentExecutor();
+    auto const nworkers = executor.concurrency();
+    EventsSet_t const lhs_only{ aLhsEvents & ~aRhsEvents };
+    EventsSet_t const rhs_only{ aRhsEvents & ~aLhsEvents };
+    std::vector<JoinRow> rows(nworkers);
+
+    // Accessible keys: BFS over the joined rows
+    ConcurrentStatesTable<uint64_t> visited{
+        std::max(static_cast<std::size_t>(aLhs.rows),
+                 static_cast<std::size_t>(aRhs.rows))
+    };
+    visited.insert(aInit);
+    std::vector<uint64_t> frontier{ aInit };
+    std::vector<std::vector<uint64_t>> next(nworkers);
+    while (!frontier.empty()) {
+        executor.parallelFor(
+          0ul,
+          frontier.size(),
+          [&](std::size_t const aBegin,
+              std::size_t const aEnd,
+              unsigned const aWorker) {
+              auto& row = rows[aWorker];
+              for (auto i = aBegin; i < aEnd; ++i) {
+                  joinRow_(aLhs, lhs_only, aRhs, rhs_only, frontier[i], row);
+                  for (auto const& entry : row) {
+                      if (visited.insert(entry.first)) {
+                          next[aWorker].push_back(entry.first);
+                      }
+                  }
+              }
+          },
+          kAcceleratorGrain);
+        frontier.clear();
+        for (auto& found : next) {
+            frontier.insert(frontier.end(), found.begin(), found.end());
+            found.clear();
+        }
+    }
+
+    aKeys.clear();
+    aKeys.reserve(visited.size());
+    visited.forEach([&aKeys](uint64_t const aKey) { aKeys.push_back(aKey); });
+    std::sort(aKeys.begin(), aKeys.end());
+    if (aKeys.size() >
+        static_cast<std::size_t>(std::numeric_limits<StorageIndex>::max())) {
+        throw std::overflow_error(
+          "HostAccelerator: Too many states for StorageIndex");
+    }
+
+    Graph result;
+    result.rows = static_cast<StorageIndex>(aKeys.size());
+    result.offsets.assign(aKeys.size() + 1ul, 0ul);
+
+    // Symbolic pass: size of each row
+    executor.parallelFor(
+      0ul,
+      aKeys.size(),
+      [&](std::size_t const aBegin,
+          std::size_t const aEnd,
+          unsigned const aWorker) {
+          auto& row = rows[aWorker];
+          for (auto q = aBegin; q < aEnd; ++q) {
+              joinRow_(aLhs, lhs_only, aRhs, rhs_only, aKeys[q], row);
+              result.offsets[q + 1ul] = row.size();
+          }
+      },
+      kAcceleratorGrain);
+    std::partial_sum(
+      result.offsets.begin(), result.offsets.end(), result.offsets.begin());
+    result.cols.resize(result.offsets.back());
+    result.events.resize(result.offsets.back());
+
+    // Numeric pass: keys are sorted, so targets keep their order
+    executor.parallelFor(
+      0ul,
+      aKeys.size(),
+      [&](std::size_t const aBegin,
+          std::size_t const aEnd,
+          unsigned const aWorker) {
+          auto& row = rows[aWorker];
+          for (auto q = aBegin; q < aEnd; ++q) {
+              joinRow_(aLhs, lhs_only, aRhs, rhs_only, aKeys[q], row);
+              auto slot = result.offsets[q];
+              for (auto const& entry : row) {
+                  auto const target =
+                    std::lower_bound(aKeys.begin(), aKeys.end(), entry.first);
+                  result.cols[slot] =
+                    static_cast<StorageIndex>(target - aKeys.begin());
+                  result.events[slot] = entry.second;
+                  ++slot;
+              }
+          }
+      },
+      kAcceleratorGrain);
+
+    return result;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+std::shared_ptr<Accelerator<NEvents, StorageIndex>>
+hostAccelerator()
+{
+    static std::shared_ptr<Accelerator<NEvents, StorageIndex>> const
+      accelerator = std::make_shared<HostAccelerator<NEvents, StorageIndex>>();
+    return accelerator;
+}
+}
+}
@@ -0,0 +1,83 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/backend/AcceleratorFwd.hpp
+ Description: Accelerator backend includes and compressed graph type.
+ =========================================================================
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace cldes {
+namespace backend {
+
+/*! \brief Graph of a system on the memory of an accelerator
+ * \details Compressed sparse rows. Row q holds the transitions leaving
+ * state q, sorted by target state, and each transition holds the bit mask
+ * of its events. Masks are std::bitset words, so the intersections of the
+ * kernels are word-wide bitwise operations, which the host compiler
+ * vectorizes.
+ *
+ * \tparam NEvents Number of events
+ * \tparam StorageIndex Unsigned type used for indexing states
+ */
+template<uint8_t NEvents, typename StorageIndex>
+struct CsrGraph
+{
+    /*! \brief Number of states
+     */
+    StorageIndex rows = 0;
+
+    /*! \brief First transition of each row: rows + 1 entries
+     */
+    std::vector<std::size_t> offsets{ 0ul };
+
+    /*! \brief Target state of each transition
+     */
+    std::vector<StorageIndex> cols;
+
+    /*! \brief Events of each transition
+     */
+    std::vector<EventsSet<NEvents>> events;
+
+    /*! \brief Number of transitions with at least one event
+     */
+    std::size_t nonZeros() const noexcept { return cols.size(); }
+};
+
+/*! \brief Number of frontier states of each range of the kernels
+ */
+std::size_t const kAcceleratorGrain = 64ul;
+}
+}
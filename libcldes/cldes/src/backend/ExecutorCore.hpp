@@ -0,0 +1,422 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/backend/ExecutorCore.hpp
+ Description: Executors methods definitions.
+ =========================================================================
+*/
+/*!
+ * \file cldes/src/backend/ExecutorCore.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-26
+ *
+ * Pluggable task executors.
+ */
+
+namespace cldes {
+namespace backend {
+
+inline void
+SerialExecutor::parallelFor(std::size_t const aBegin,
+                            std::size_t const aEnd,
+                            ChunkFunction const& aBody,
+                            std::size_t const)
+{
+    if (aBegin < aEnd) {
+        aBody(aBegin, aEnd, 0u);
+    }
+}
+
+/*! \brief Pool and index of the worker running on this thread
+ */
+struct ThreadPoolWorker_
+{
+    ThreadPoolExecutor const* pool = nullptr;
+    unsigned index = 0u;
+};
+
+inline ThreadPoolWorker_&
+threadPoolWorker_() noexcept
+{
+    static thread_local ThreadPoolWorker_ worker;
+    return worker;
+}
+
+/*! \brief Pools alive in the process, for SuspendedThreadPools
+ */
+struct ThreadPools_
+{
+    std::mutex mutex;
+    std::vector<ThreadPoolExecutor*> pools;
+};
+
+inline ThreadPools_&
+threadPools_() noexcept
+{
+    static ThreadPools_ pools;
+    return pools;
+}
+
+inline ThreadPoolExecutor::ThreadPoolExecutor(ExecutorOptions const& aOptions)
+  : Executor{ aOptions.grain }
+  , threads_{ aOptions.threads }
+  , cpus_{ aOptions.cpus }
+  , suspended_{ 0u }
+  , queued_{ 0ul }
+  , stop_{ false }
+  , numa_{ aOptions.numa }
+{
+    if (threads_ == 0u) {
+        auto const hw = std::thread::hardware_concurrency();
+        threads_ = hw > 1u ? hw - 1u : 0u;
+    }
+
+    queues_.reset(new WorkerQueue[threads_]);
+    startWorkers_();
+
+    auto& registry = threadPools_();
+    std::lock_guard<std::mutex> const lock{ registry.mutex };
+    registry.pools.push_back(this);
+}
+
+inline ThreadPoolExecutor::~ThreadPoolExecutor()
+{
+    {
+        auto& registry = threadPools_();
+        std::lock_guard<std::mutex> const lock{ registry.mutex };
+        registry.pools.erase(
+          std::find(registry.pools.begin(), registry.pools.end(), this));
+    }
+    joinWorkers_();
+}
+
+inline void
+ThreadPoolExecutor::suspend()
+{
+    if (suspended_++ == 0u) {
+        joinWorkers_();
+    }
+}
+
+inline void
+ThreadPoolExecutor::resume()
+{
+    if (suspended_ > 0u && --suspended_ == 0u) {
+        startWorkers_();
+    }
+}
+
+inline void
+ThreadPoolExecutor::startWorkers_()
+{
+    stop_.store(false);
+    workers_.reserve(threads_);
+    for (auto w = 0u; w < threads_; ++w) {
+        workers_.emplace_back([this, w]() { workerLoop_(w); });
+        if (!cpus_.empty()) {
+            bindWorker_(w, cpus_);
+        } else if (numa_) {
+            bindWorkerToNode_(w, threads_);
+        }
+    }
+}
+
+inline void
+ThreadPoolExecutor::joinWorkers_() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock{ sleep_mutex_ };
+        stop_.store(true);
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+}
+
+inline void
+ThreadPoolExecutor::parallelFor(std::size_t const aBegin,
+                                std::size_t const aEnd,
+                                ChunkFunction const& aBody,
+                                std::size_t const aGrain)
+{
+    if (aBegin >= aEnd) {
+        return;
+    }
+
+    auto const worker = workerIndex_();
+    auto const grain = resolveGrain_(aGrain);
+    auto const nworkers = static_cast<unsigned>(workers_.size());
+    if (nworkers == 0u || aEnd - aBegin <= grain) {
+        aBody(aBegin, aEnd, worker);
+        return;
+    }
+
+    auto const ntasks = (aEnd - aBegin + grain - 1ul) / grain;
+    ExecutorTask::Job job;
+    job.body = &aBody;
+    job.pending.store(ntasks);
+    queued_.fetch_add(ntasks);
+
+    // Workers push nested loops on their own queue. External threads spread
+    // the ranges over all queues: round robin, or in contiguous blocks
+    // which follow the nodes of the workers.
+    for (auto t = 0ul; t < ntasks; ++t) {
+        auto const begin = aBegin + t * grain;
+        auto const end = std::min(begin + grain, aEnd);
+        auto owner = worker;
+        if (worker >= nworkers) {
+            owner = static_cast<unsigned>(numa_ ? t * nworkers / ntasks
+                                                : t % nworkers);
+        }
+        std::lock_guard<std::mutex> lock{ queues_[owner].mutex };
+        queues_[owner].tasks.push_back(ExecutorTask{ &job, begin, end });
+    }
+    {
+        std::lock_guard<std::mutex> lock{ sleep_mutex_ };
+    }
+    wake_.notify_all();
+
+    // The caller only runs ranges of its own loop: a body waiting for a
+    // nested loop never resumes a range of an outer loop.
+    ExecutorTask task;
+    while (job.pending.load(std::memory_order_acquire) > 0ul) {
+        if (takeTask_(worker, &job, task)) {
+            runTask_(task, worker);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
+
+inline void
+ThreadPoolExecutor::workerLoop_(unsigned const aWorker) noexcept
+{
+    threadPoolWorker_().pool = this;
+    threadPoolWorker_().index = aWorker;
+    currentExecutorPtr_() = this;
+
+    ExecutorTask task;
+    while (true) {
+        if (takeTask_(aWorker, nullptr, task)) {
+            runTask_(task, aWorker);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock{ sleep_mutex_ };
+        wake_.wait(lock, [this]() { return stop_ || queued_.load() > 0ul; });
+        if (stop_ && queued_.load() == 0ul) {
+            return;
+        }
+    }
+}
+
+inline bool
+ThreadPoolExecutor::takeTask_(unsigned const aWorker,
+                              ExecutorTask::Job const* aJob,
+                              ExecutorTask& aTask) noexcept
+{
+    if (queued_.load() == 0ul) {
+        return false;
+    }
+
+    auto const nworkers = static_cast<unsigned>(workers_.size());
+    // Own queue first, from the back; then the front of the other queues
+    for (auto i = 0u; i < nworkers; ++i) {
+        auto const victim = (aWorker + i) % nworkers;
+        bool const own = victim == aWorker;
+        auto& queue = queues_[victim];
+        std::lock_guard<std::mutex> lock{ queue.mutex };
+        if (queue.tasks.empty()) {
+            continue;
+        }
+        if (aJob == nullptr) {
+            if (own) {
+                aTask = queue.tasks.back();
+                queue.tasks.pop_back();
+            } else {
+                aTask = queue.tasks.front();
+                queue.tasks.pop_front();
+            }
+            queued_.fetch_sub(1ul);
+            return true;
+        }
+        for (auto it = queue.tasks.begin(); it != queue.tasks.end(); ++it) {
+            if (it->job == aJob) {
+                aTask = *it;
+                queue.tasks.erase(it);
+                queued_.fetch_sub(1ul);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+inline void
+ThreadPoolExecutor::runTask_(ExecutorTask const& aTask,
+                             unsigned const aWorker) noexcept
+{
+    auto* job = aTask.job;
+    try {
+        (*job->body)(aTask.begin, aTask.end, aWorker);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock{ job->error_mutex };
+        if (!job->error) {
+            job->error = std::current_exception();
+        }
+    }
+    job->pending.fetch_sub(1ul, std::memory_order_release);
+}
+
+inline unsigned
+ThreadPoolExecutor::workerIndex_() const noexcept
+{
+    auto const& worker = threadPoolWorker_();
+    if (worker.pool == this) {
+        return worker.index;
+    }
+    return static_cast<unsigned>(workers_.size());
+}
+
+inline void
+ThreadPoolExecutor::bindWorker_(unsigned const aWorker,
+                                std::vector<unsigned> const& aCpus) noexcept
+{
+#ifdef __linux__
+    if (aCpus.empty()) {
+        return;
+    }
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(aCpus[aWorker % aCpus.size()], &cpuset);
+    pthread_setaffinity_np(
+      workers_[aWorker].native_handle(), sizeof(cpu_set_t), &cpuset);
+#else
+    (void)aWorker;
+    (void)aCpus;
+#endif
+}
+
+inline void
+ThreadPoolExecutor::bindWorkerToNode_(unsigned const aWorker,
+                                      unsigned const aWorkers) noexcept
+{
+#ifdef __linux__
+    auto const& topology = NumaTopology::system();
+    auto const& cpus =
+      topology.cpus(topology.nodeOf(aWorker, aWorkers));
+    if (cpus.empty()) {
+        return;
+    }
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (auto cpu : cpus) {
+        CPU_SET(cpu, &cpuset);
+    }
+    pthread_setaffinity_np(
+      workers_[aWorker].native_handle(), sizeof(cpu_set_t), &cpuset);
+#else
+    (void)aWorker;
+    (void)aWorkers;
+#endif
+}
+
+#ifdef CLDES_OPENMP_ENABLED
+inline void
+OpenMPExecutor::parallelFor(std::size_t const aBegin,
+                            std::size_t const aEnd,
+                            ChunkFunction const& aBody,
+                            std::size_t const aGrain)
+{
+    if (aBegin >= aEnd) {
+        return;
+    }
+
+    auto const grain = resolveGrain_(aGrain);
+    auto const ntasks = static_cast<long>((aEnd - aBegin + grain - 1ul) / grain);
+    int const nthreads = static_cast<int>(concurrency());
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 1) num_threads(nthreads)
+    for (long t = 0; t < ntasks; ++t) {
+        auto const begin = aBegin + static_cast<std::size_t>(t) * grain;
+        auto const end = std::min(begin + grain, aEnd);
+        try {
+            aBody(begin, end, static_cast<unsigned>(omp_get_thread_num()));
+        } catch (...) {
+#pragma omp critical(cldes_executor_error)
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+#endif
+
+inline SuspendedThreadPools::SuspendedThreadPools()
+{
+    auto& registry = threadPools_();
+    std::lock_guard<std::mutex> const lock{ registry.mutex };
+    for (auto* pool : registry.pools) {
+        pool->suspend();
+    }
+}
+
+inline SuspendedThreadPools::~SuspendedThreadPools()
+{
+    auto& registry = threadPools_();
+    std::lock_guard<std::mutex> const lock{ registry.mutex };
+    for (auto* pool : registry.pools) {
+        pool->resume();
+    }
+}
+
+inline Executor&
+defaultExecutor()
+{
+    static ThreadPoolExecutor executor{};
+    return executor;
+}
+
+inline Executor&
+currentExecutor()
+{
+    auto* executor = currentExecutorPtr_();
+    if (executor != nullptr) {
+        return *executor;
+    }
+    return defaultExecutor();
+}
+}
+}
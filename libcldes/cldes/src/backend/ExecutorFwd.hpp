@@ -0,0 +1,128 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/backend/ExecutorFwd.hpp
+ Description: Executor includes, options and aliases.
+ =========================================================================
+*/
+
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#ifdef CLDES_OPENMP_ENABLED
+#include <omp.h>
+#endif
+
+namespace cldes {
+namespace backend {
+
+/*! \brief Loop body executed by an executor
+ * \details It is called with a range [begin, end) and the index of the
+ * worker which runs it. Worker indexes are smaller than the executor
+ * concurrency(), and a worker runs one range at a time, so bodies can
+ * accumulate results on per-worker buffers without locking.
+ */
+using ChunkFunction =
+  std::function<void(std::size_t const, std::size_t const, unsigned const)>;
+
+/*! \brief Default number of iterations of each range
+ */
+std::size_t const kDefaultGrainSize = 256ul;
+
+/*! \brief Thread pool configuration
+ */
+struct ExecutorOptions
+{
+    /*! \brief Number of worker threads
+     * \details The thread calling parallelFor() also runs ranges, so 0
+     * creates hardware_concurrency() - 1 workers.
+     */
+    unsigned threads = 0u;
+
+    /*! \brief Number of iterations of each range
+     */
+    std::size_t grain = kDefaultGrainSize;
+
+    /*! \brief CPUs of the workers
+     * \details Worker i is bound to cpus[i % cpus.size()]. When it is empty,
+     * the operating system places the workers. Ignored out of Linux.
+     */
+    std::vector<unsigned> cpus;
+
+    /*! \brief Spread the workers over the NUMA nodes
+     * \details Workers are split in one contiguous group per node, bound
+     * to the CPUs of their node, and loops started out of the pool give
+     * each worker a contiguous block of their ranges. Arrays placed with
+     * NumaPolicy::kPartitioned, or first touched by a loop of this pool,
+     * are then mostly read by workers of their own node. Explicit cpus take
+     * precedence over the node binding.
+     */
+    bool numa = false;
+};
+
+class Executor;
+
+/*! \brief Range of iterations waiting on a worker queue
+ */
+struct ExecutorTask
+{
+    struct Job
+    {
+        ChunkFunction const* body;
+        std::atomic<std::size_t> pending;
+        std::exception_ptr error;
+        std::mutex error_mutex;
+    };
+
+    Job* job;
+    std::size_t begin;
+    std::size_t end;
+};
+
+/*! \brief Executor installed on the calling thread, if any
+ */
+inline Executor*&
+currentExecutorPtr_() noexcept
+{
+    static thread_local Executor* executor = nullptr;
+    return executor;
+}
+}
+}
@@ -0,0 +1,323 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/backend/NumaCore.hpp
+ Description: NUMA topology and placement definitions.
+ =========================================================================
+*/
+/*!
+ * \file cldes/src/backend/NumaCore.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-12-01
+ *
+ * NUMA topology and memory placement.
+ */
+
+namespace cldes {
+namespace backend {
+
+inline NumaTopology::NumaTopology(std::vector<unsigned> aNodeIds,
+                                  std::vector<std::vector<unsigned>> aCpus)
+  : node_ids_{ std::move(aNodeIds) }
+  , cpus_{ std::move(aCpus) }
+{
+    if (node_ids_.empty()) {
+        node_ids_.push_back(0u);
+    }
+    cpus_.resize(node_ids_.size());
+}
+
+inline NumaTopology const&
+NumaTopology::system()
+{
+    static NumaTopology const topology = detect_();
+    return topology;
+}
+
+inline std::vector<std::size_t>
+NumaTopology::blocks(std::size_t const aSize) const
+{
+    auto const n = static_cast<std::size_t>(nodes());
+    std::vector<std::size_t> bounds(n + 1ul);
+    for (auto k = 0ul; k <= n; ++k) {
+        bounds[k] = aSize * k / n;
+    }
+    return bounds;
+}
+
+inline NumaTopology
+NumaTopology::detect_()
+{
+    std::vector<std::pair<unsigned, std::vector<unsigned>>> nodes;
+#ifdef __linux__
+    std::string const root = "/sys/devices/system/node/";
+    if (auto* dir = opendir(root.c_str())) {
+        while (auto* entry = readdir(dir)) {
+            std::string const name = entry->d_name;
+            if (name.size() < 5ul || name.compare(0ul, 4ul, "node") != 0 ||
+                name[4] < '0' || name[4] > '9') {
+                continue;
+            }
+            std::ifstream file{ root + name + "/cpulist" };
+            std::string list;
+            std::getline(file, list);
+            auto cpus = parseCpuList_(list);
+            // Nodes without CPUs only hold memory: no worker is local to
+            // them
+            if (!cpus.empty()) {
+                nodes.emplace_back(
+                  static_cast<unsigned>(std::stoul(name.substr(4ul))),
+                  std::move(cpus));
+            }
+        }
+        closedir(dir);
+    }
+#endif
+    std::sort(nodes.begin(), nodes.end());
+
+    std::vector<unsigned> ids;
+    std::vector<std::vector<unsigned>> cpus;
+    for (auto& node : nodes) {
+        ids.push_back(node.first);
+        cpus.push_back(std::move(node.second));
+    }
+    if (ids.empty()) {
+        ids.push_back(0u);
+        cpus.emplace_back();
+        auto const hw = std::max(std::thread::hardware_concurrency(), 1u);
+        for (auto cpu = 0u; cpu < hw; ++cpu) {
+            cpus.back().push_back(cpu);
+        }
+    }
+    return NumaTopology{ std::move(ids), std::move(cpus) };
+}
+
+/*! \brief Size of the pages of the host
+ */
+inline uintptr_t
+numaPageSize_() noexcept
+{
+#ifdef __linux__
+    static auto const page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    return page;
+#else
+    return 4096u;
+#endif
+}
+
+/*! \brief Address of the page holding aAddress
+ */
+inline char const*
+numaPageDown_(void const* aAddress) noexcept
+{
+    auto const address = reinterpret_cast<uintptr_t>(aAddress);
+    return reinterpret_cast<char const*>(address - address % numaPageSize_());
+}
+
+/*! \brief aAddress rounded up to a page bound
+ */
+inline char const*
+numaPageUp_(void const* aAddress) noexcept
+{
+    auto const page = numaPageSize_();
+    auto const address = reinterpret_cast<uintptr_t>(aAddress) + page - 1u;
+    return reinterpret_cast<char const*>(address - address % page);
+}
+
+/*! \brief Set the memory policy of the pages on [aBegin, aEnd)
+ * \details aBegin must be page aligned. An empty aNodes is only valid
+ * with kMpolDefault_.
+ */
+inline bool
+numaBind_(char const* aBegin,
+          char const* aEnd,
+          int const aMode,
+          std::vector<unsigned> const& aNodes,
+          unsigned const aFlags) noexcept
+{
+    if (aBegin >= aEnd) {
+        return true;
+    }
+#ifdef __linux__
+    auto constexpr kBits = 8ul * sizeof(unsigned long);
+    std::vector<unsigned long> mask;
+    for (auto node : aNodes) {
+        if (node / kBits >= mask.size()) {
+            mask.resize(node / kBits + 1ul, 0ul);
+        }
+        mask[node / kBits] |= 1ul << (node % kBits);
+    }
+    // The kernel reads maxnode - 1 bits
+    auto const result = syscall(SYS_mbind,
+                                aBegin,
+                                static_cast<unsigned long>(aEnd - aBegin),
+                                aMode,
+                                mask.empty() ? nullptr : mask.data(),
+                                mask.empty() ? 0ul : mask.size() * kBits + 1ul,
+                                aFlags);
+    return result == 0;
+#else
+    (void)aMode;
+    (void)aNodes;
+    (void)aFlags;
+    return false;
+#endif
+}
+
+/*! \brief Migrate the pages on [aBegin, aEnd) with a policy, then give
+ * them back the default policy
+ * \details Pages stay where they were moved, and no policy outlives the
+ * call: pages freed and reused by other allocations are placed as usual.
+ */
+inline bool
+numaMove_(char const* aBegin,
+          char const* aEnd,
+          int const aMode,
+          std::vector<unsigned> const& aNodes) noexcept
+{
+    auto const moved = numaBind_(aBegin, aEnd, aMode, aNodes, kMpolMfMove_);
+    auto const reset = numaBind_(aBegin, aEnd, kMpolDefault_, {}, 0u);
+    return moved && reset;
+}
+
+inline bool
+numaPlace(void const* aData,
+          std::size_t const aBytes,
+          NumaPolicy const aPolicy,
+          NumaTopology const& aTopology)
+{
+    if (aData == nullptr || aBytes == 0ul || aTopology.nodes() < 2u) {
+        return false;
+    }
+
+    // Pages shared with other allocations are left alone
+    auto const* begin = numaPageUp_(aData);
+    auto const* end = numaPageDown_(static_cast<char const*>(aData) + aBytes);
+    switch (aPolicy) {
+        case NumaPolicy::kDefault:
+            return numaBind_(begin, end, kMpolDefault_, {}, 0u);
+        case NumaPolicy::kInterleave: {
+            std::vector<unsigned> ids;
+            for (auto k = 0u; k < aTopology.nodes(); ++k) {
+                ids.push_back(aTopology.nodeId(k));
+            }
+            return numaMove_(begin, end, kMpolInterleave_, ids);
+        }
+        case NumaPolicy::kPartitioned:
+            return numaPlaceBlocks(
+              aData, 1ul, aTopology.blocks(aBytes), aTopology);
+    }
+    return false;
+}
+
+inline bool
+numaPlaceBlocks(void const* aData,
+                std::size_t const aElementBytes,
+                std::vector<std::size_t> const& aBounds,
+                NumaTopology const& aTopology)
+{
+    auto const nodes = aTopology.nodes();
+    if (aData == nullptr || nodes < 2u || aBounds.size() != nodes + 1ul ||
+        aBounds.back() == aBounds.front()) {
+        return false;
+    }
+
+    // Blocks end on the page of the next block, so no page is moved twice,
+    // and pages shared with other allocations are left alone: blocks
+    // within the first or the last page of the data are skipped
+    auto const* data = static_cast<char const*>(aData);
+    auto const* lower = numaPageUp_(data);
+    auto placed = true;
+    for (auto k = 0u; k < nodes; ++k) {
+        auto const* first = data + aBounds[k] * aElementBytes;
+        auto const* begin = std::max(
+          lower, k == 0u ? numaPageUp_(first) : numaPageDown_(first));
+        auto const* end = numaPageDown_(data + aBounds[k + 1u] * aElementBytes);
+        if (begin >= end) {
+            continue;
+        }
+        placed =
+          numaMove_(begin, end, kMpolBind_, { aTopology.nodeId(k) }) && placed;
+    }
+    return placed;
+}
+
+template<class T, class Allocator>
+bool
+numaPlace(std::vector<T, Allocator> const& aVector,
+          NumaPolicy const aPolicy,
+          NumaTopology const& aTopology)
+{
+    return numaPlace(
+      aVector.data(), aVector.size() * sizeof(T), aPolicy, aTopology);
+}
+
+template<class SparseMatrix>
+bool
+numaPlaceRows(SparseMatrix const& aMatrix,
+              NumaPolicy const aPolicy,
+              NumaTopology const& aTopology)
+{
+    if (!aMatrix.isCompressed() || aMatrix.outerSize() == 0) {
+        return false;
+    }
+
+    auto const rows = static_cast<std::size_t>(aMatrix.outerSize());
+    auto const nonzeros = static_cast<std::size_t>(aMatrix.nonZeros());
+    auto const* outer = aMatrix.outerIndexPtr();
+    auto const* inner = aMatrix.innerIndexPtr();
+    auto const* values = aMatrix.valuePtr();
+
+    if (aPolicy != NumaPolicy::kPartitioned) {
+        auto placed = numaPlace(
+          outer, (rows + 1ul) * sizeof(*outer), aPolicy, aTopology);
+        placed = numaPlace(inner, nonzeros * sizeof(*inner), aPolicy,
+                           aTopology) &&
+                 placed;
+        placed = numaPlace(values, nonzeros * sizeof(*values), aPolicy,
+                           aTopology) &&
+                 placed;
+        return placed;
+    }
+
+    // Nonzeros follow the rows they belong to
+    auto const row_bounds = aTopology.blocks(rows);
+    std::vector<std::size_t> nonzero_bounds(row_bounds.size());
+    for (auto k = 0ul; k < row_bounds.size(); ++k) {
+        nonzero_bounds[k] = static_cast<std::size_t>(outer[row_bounds[k]]);
+    }
+    auto placed =
+      numaPlaceBlocks(outer, sizeof(*outer), row_bounds, aTopology);
+    placed =
+      numaPlaceBlocks(inner, sizeof(*inner), nonzero_bounds, aTopology) &&
+      placed;
+    placed =
+      numaPlaceBlocks(values, sizeof(*values), nonzero_bounds, aTopology) &&
+      placed;
+    return placed;
+}
+}
+}
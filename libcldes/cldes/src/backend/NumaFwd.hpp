@@ -0,0 +1,107 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/backend/NumaFwd.hpp
+ Description: NUMA topology and placement includes, policies and constants.
+ =========================================================================
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace cldes {
+namespace backend {
+
+/*! \brief Where the pages of an array are placed
+ */
+enum class NumaPolicy : int
+{
+    /*! \brief Operating system default: first touch, usually the node of
+     * the thread which writes the page first
+     */
+    kDefault = 0,
+
+    /*! \brief Pages spread round robin over all nodes: the bandwidth of
+     * every node serves every thread, but half of the accesses are remote
+     */
+    kInterleave,
+
+    /*! \brief The array is split in one contiguous block per node: block k
+     * lives on node k. It matches the ranges given to the workers of a NUMA
+     * aware ThreadPoolExecutor, so each worker mostly touches local memory.
+     */
+    kPartitioned
+};
+
+/*! \brief Modes and flags of the mbind system call
+ * \details Copied from linux/mempolicy.h, so libnuma is not required.
+ */
+int const kMpolDefault_ = 0;
+int const kMpolBind_ = 2;
+int const kMpolInterleave_ = 3;
+unsigned const kMpolMfMove_ = 1u << 1u;
+
+/*! \brief Parse a sysfs CPU list, e.g. "0-3,8,10-11"
+ *
+ * @param aList CPU list
+ * \return CPUs of the list, in order
+ */
+inline std::vector<unsigned>
+parseCpuList_(std::string const& aList)
+{
+    std::vector<unsigned> cpus;
+    std::stringstream stream{ aList };
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        if (range.empty() || range[0] < '0' || range[0] > '9') {
+            continue;
+        }
+        auto const dash = range.find('-');
+        auto const first = static_cast<unsigned>(std::stoul(range));
+        auto const last =
+          dash == std::string::npos
+            ? first
+            : static_cast<unsigned>(std::stoul(range.substr(dash + 1ul)));
+        for (auto cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+}
+}
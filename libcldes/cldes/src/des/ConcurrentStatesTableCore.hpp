@@ -0,0 +1,381 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/des/ConcurrentStatesTableCore.hpp
+ Description: ConcurrentStatesTable methods definitions.
+ =========================================================================
+*/
+/*!
+ * \file cldes/src/des/ConcurrentStatesTableCore.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-28
+ *
+ * Lock-free hash table of states shared by the threads of a parallel
+ * exploration.
+ */
+
+namespace cldes {
+
+/*! \brief Smallest power of two holding aStates at half load
+ */
+inline std::size_t
+tableCapacity_(std::size_t const aStates) noexcept
+{
+    std::size_t capacity = 16ul;
+    while (capacity < 2ul * aStates) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+template<typename StorageIndex>
+uint64_t constexpr ConcurrentStatesTable<StorageIndex>::kNoValue;
+
+template<typename StorageIndex>
+ConcurrentStatesTable<StorageIndex>::ConcurrentStatesTable(
+  std::size_t const aCapacity,
+  bool const aWithIds)
+  : capacity_{ tableCapacity_(aCapacity) }
+  , with_ids_{ aWithIds }
+  , size_{ 0ul }
+  , next_id_{ 0ul }
+  , users_{ 0u }
+  , growing_{ false }
+  , numa_policy_{ backend::NumaPolicy::kDefault }
+{
+    keys_ = allocate_(capacity_.load(), 0ul, numa_policy_);
+    if (with_ids_) {
+        ids_ = allocate_(capacity_.load(), kNoValue, numa_policy_);
+    }
+}
+
+template<typename StorageIndex>
+bool
+ConcurrentStatesTable<StorageIndex>::insert(StorageIndex const aKey)
+{
+    if (with_ids_) {
+        // A state without id would block insertWithId() on it forever
+        return insertWithId(aKey).second;
+    }
+
+    auto const encoded = static_cast<uint64_t>(aKey) + 1ul;
+    while (true) {
+        enter_();
+        auto const capacity = capacity_.load(std::memory_order_relaxed);
+        auto const slot = probe_(keys_.get(), capacity - 1ul, encoded);
+        leave_();
+
+        if (slot.first == capacity) {
+            grow_(2ul * capacity);
+            continue;
+        }
+        if (slot.second) {
+            size_.fetch_add(1ul);
+            growIfLoaded_();
+        }
+        return slot.second;
+    }
+}
+
+template<typename StorageIndex>
+std::pair<uint64_t, bool>
+ConcurrentStatesTable<StorageIndex>::insertWithId(StorageIndex const aKey)
+{
+    if (!with_ids_) {
+        throw std::logic_error("ConcurrentStatesTable: Table without ids");
+    }
+
+    auto const encoded = static_cast<uint64_t>(aKey) + 1ul;
+    while (true) {
+        enter_();
+        auto const capacity = capacity_.load(std::memory_order_relaxed);
+        auto const slot = probe_(keys_.get(), capacity - 1ul, encoded);
+        if (slot.first == capacity) {
+            leave_();
+            grow_(2ul * capacity);
+            continue;
+        }
+
+        auto& id_slot = ids_[slot.first];
+        uint64_t id;
+        if (slot.second) {
+            id = next_id_.fetch_add(1ul);
+            id_slot.store(id, std::memory_order_release);
+        } else {
+            // The inserting thread stores the id right after its CAS
+            while ((id = id_slot.load(std::memory_order_acquire)) ==
+                   kNoValue) {
+                std::this_thread::yield();
+            }
+        }
+        leave_();
+
+        if (slot.second) {
+            size_.fetch_add(1ul);
+            growIfLoaded_();
+        }
+        return std::make_pair(id, slot.second);
+    }
+}
+
+template<typename StorageIndex>
+bool
+ConcurrentStatesTable<StorageIndex>::contains(StorageIndex const aKey) const
+  noexcept
+{
+    enter_();
+    auto const mask = capacity_.load(std::memory_order_relaxed) - 1ul;
+    auto const slot =
+      lookup_(keys_.get(), mask, static_cast<uint64_t>(aKey) + 1ul);
+    leave_();
+    return slot <= mask;
+}
+
+template<typename StorageIndex>
+uint64_t
+ConcurrentStatesTable<StorageIndex>::find(StorageIndex const aKey) const
+  noexcept
+{
+    if (!with_ids_) {
+        return kNoValue;
+    }
+    enter_();
+    auto const mask = capacity_.load(std::memory_order_relaxed) - 1ul;
+    auto const slot =
+      lookup_(keys_.get(), mask, static_cast<uint64_t>(aKey) + 1ul);
+    auto const id =
+      slot <= mask ? ids_[slot].load(std::memory_order_acquire) : kNoValue;
+    leave_();
+    return id;
+}
+
+template<typename StorageIndex>
+void
+ConcurrentStatesTable<StorageIndex>::reserve(std::size_t const aStates)
+{
+    grow_(tableCapacity_(aStates));
+}
+
+template<typename StorageIndex>
+template<class Function>
+void
+ConcurrentStatesTable<StorageIndex>::forEach(Function&& aFunction) const
+{
+    auto const capacity = capacity_.load();
+    for (auto i = 0ul; i < capacity; ++i) {
+        auto const encoded = keys_[i].load(std::memory_order_relaxed);
+        if (encoded != 0ul) {
+            aFunction(static_cast<StorageIndex>(encoded - 1ul));
+        }
+    }
+}
+
+template<typename StorageIndex>
+template<class Function>
+void
+ConcurrentStatesTable<StorageIndex>::forEachId(Function&& aFunction) const
+{
+    auto const capacity = capacity_.load();
+    for (auto i = 0ul; i < capacity; ++i) {
+        auto const encoded = keys_[i].load(std::memory_order_relaxed);
+        if (encoded != 0ul) {
+            aFunction(static_cast<StorageIndex>(encoded - 1ul),
+                      with_ids_ ? ids_[i].load(std::memory_order_relaxed)
+                                : kNoValue);
+        }
+    }
+}
+
+template<typename StorageIndex>
+std::pair<std::size_t, bool>
+ConcurrentStatesTable<StorageIndex>::probe_(
+  std::atomic<uint64_t>* const aKeys,
+  std::size_t const aMask,
+  uint64_t const aEncoded) noexcept
+{
+    auto slot = hashState_(aEncoded) & aMask;
+    for (auto probes = 0ul; probes <= aMask; ++probes) {
+        auto current = aKeys[slot].load(std::memory_order_acquire);
+        if (current == 0ul) {
+            if (aKeys[slot].compare_exchange_strong(
+                  current, aEncoded, std::memory_order_acq_rel)) {
+                return std::make_pair(slot, true);
+            }
+            // Lost the race: current holds the winner key
+        }
+        if (current == aEncoded) {
+            return std::make_pair(slot, false);
+        }
+        slot = (slot + 1ul) & aMask;
+    }
+    return std::make_pair(aMask + 1ul, false);
+}
+
+template<typename StorageIndex>
+std::size_t
+ConcurrentStatesTable<StorageIndex>::lookup_(
+  std::atomic<uint64_t> const* const aKeys,
+  std::size_t const aMask,
+  uint64_t const aEncoded) noexcept
+{
+    auto slot = hashState_(aEncoded) & aMask;
+    for (auto probes = 0ul; probes <= aMask; ++probes) {
+        auto const current = aKeys[slot].load(std::memory_order_acquire);
+        if (current == aEncoded) {
+            return slot;
+        }
+        if (current == 0ul) {
+            break;
+        }
+        slot = (slot + 1ul) & aMask;
+    }
+    return aMask + 1ul;
+}
+
+template<typename StorageIndex>
+bool
+ConcurrentStatesTable<StorageIndex>::setNumaPolicy(
+  backend::NumaPolicy const aPolicy)
+{
+    numa_policy_ = aPolicy;
+    auto const bytes = capacity_.load() * sizeof(std::atomic<uint64_t>);
+    auto placed = backend::numaPlace(keys_.get(), bytes, aPolicy);
+    if (with_ids_) {
+        placed = backend::numaPlace(ids_.get(), bytes, aPolicy) && placed;
+    }
+    return placed;
+}
+
+template<typename StorageIndex>
+ConcurrentSlots
+ConcurrentStatesTable<StorageIndex>::allocate_(
+  std::size_t const aSize,
+  uint64_t const aValue,
+  backend::NumaPolicy const aPolicy)
+{
+    ConcurrentSlots slots{ new std::atomic<uint64_t>[aSize] };
+    auto* const data = slots.get();
+    backend::currentExecutor().parallelFor(
+      0ul,
+      aSize,
+      [data, aValue](
+        std::size_t const aBegin, std::size_t const aEnd, unsigned const) {
+          for (auto i = aBegin; i < aEnd; ++i) {
+              data[i].store(aValue, std::memory_order_relaxed);
+          }
+      },
+      1ul << 15);
+    // Placement moves touched pages only
+    if (aPolicy != backend::NumaPolicy::kDefault) {
+        backend::numaPlace(data, aSize * sizeof(*data), aPolicy);
+    }
+    return slots;
+}
+
+template<typename StorageIndex>
+void
+ConcurrentStatesTable<StorageIndex>::enter_() const noexcept
+{
+    while (true) {
+        while (growing_.load()) {
+            std::this_thread::yield();
+        }
+        users_.fetch_add(1u);
+        if (!growing_.load()) {
+            return;
+        }
+        users_.fetch_sub(1u);
+    }
+}
+
+template<typename StorageIndex>
+void
+ConcurrentStatesTable<StorageIndex>::grow_(std::size_t const aCapacity)
+{
+    auto expected = false;
+    if (!growing_.compare_exchange_strong(expected, true)) {
+        // Another thread grows the table
+        while (growing_.load()) {
+            std::this_thread::yield();
+        }
+        return;
+    }
+    while (users_.load() != 0u) {
+        std::this_thread::yield();
+    }
+
+    auto const capacity = capacity_.load();
+    if (capacity < aCapacity) {
+        auto new_keys = allocate_(aCapacity, 0ul, numa_policy_);
+        ConcurrentSlots new_ids;
+        if (with_ids_) {
+            new_ids = allocate_(aCapacity, kNoValue, numa_policy_);
+        }
+
+        auto* const old_keys = keys_.get();
+        auto* const old_ids = ids_.get();
+        auto* const keys = new_keys.get();
+        auto* const ids = new_ids.get();
+        auto const mask = aCapacity - 1ul;
+        backend::currentExecutor().parallelFor(
+          0ul,
+          capacity,
+          [=](std::size_t const aBegin,
+              std::size_t const aEnd,
+              unsigned const) {
+              for (auto i = aBegin; i < aEnd; ++i) {
+                  auto const encoded =
+                    old_keys[i].load(std::memory_order_relaxed);
+                  if (encoded == 0ul) {
+                      continue;
+                  }
+                  auto const slot = probe_(keys, mask, encoded).first;
+                  if (ids != nullptr) {
+                      ids[slot].store(
+                        old_ids[i].load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+                  }
+              }
+          },
+          1ul << 14);
+
+        keys_ = std::move(new_keys);
+        ids_ = std::move(new_ids);
+        capacity_.store(aCapacity);
+    }
+    growing_.store(false);
+}
+
+template<typename StorageIndex>
+void
+ConcurrentStatesTable<StorageIndex>::growIfLoaded_()
+{
+    auto const capacity = capacity_.load();
+    if (2ul * size_.load() > capacity) {
+        grow_(2ul * capacity);
+    }
+}
+}
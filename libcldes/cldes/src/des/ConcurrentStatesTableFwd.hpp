@@ -0,0 +1,60 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/des/ConcurrentStatesTableFwd.hpp
+ Description: ConcurrentStatesTable includes and helpers.
+ =========================================================================
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace cldes {
+
+/*! \brief Slots of a ConcurrentStatesTable
+ * \details std::atomic has a trivial default constructor: new[] does not
+ * touch the pages, so the first write decides where they are placed.
+ */
+using ConcurrentSlots = std::unique_ptr<std::atomic<uint64_t>[]>;
+
+/*! \brief Mix the bits of a state before probing
+ * \details MurmurHash3 finalizer: states of products are sequential and
+ * would cluster on linear probing.
+ */
+inline uint64_t
+hashState_(uint64_t aKey) noexcept
+{
+    aKey ^= aKey >> 33;
+    aKey *= 0xff51afd7ed558ccdul;
+    aKey ^= aKey >> 33;
+    aKey *= 0xc4ceb9fe1a85ec53ul;
+    aKey ^= aKey >> 33;
+    return aKey;
+}
+}
@@ -139,4 +139,16 @@ DESystemBase<NEvents, StorageIndex, RealDESystem>::setInvStateEvents(
 {
     inv_states_events_[aQ] = aEvent;
 }
+
+template<uint8_t NEvents, typename StorageIndex, class RealDESystem>
+MemoryUsage
+DESystemBase<NEvents, StorageIndex, RealDESystem>::baseMemoryUsage_() const
+  noexcept
+{
+    MemoryUsage usage;
+    usage.states_events = vectorBytes_(states_events_);
+    usage.inv_states_events = vectorBytes_(inv_states_events_);
+    usage.marked_states = setBytes_(marked_states_);
+    return usage;
+}
 }
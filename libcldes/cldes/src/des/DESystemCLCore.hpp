@@ -28,255 +28,268 @@
  =========================================================================
 */
 
-#include <algorithm>
-#include <functional>
-#include <vector>
-
 namespace cldes {
 
-// OclBackend disable by now
-template<uint8_t NEvents, typename StorageIndex>
-std::unique_ptr<backend::OclBackend>
-  DESystemCL<NEvents, StorageIndex>::backend_ptr_ = nullptr;
-
 template<uint8_t NEvents, typename StorageIndex>
 DESystemCL<NEvents, StorageIndex>::DESystemCL(
-  DESystem<NEvents, StorageIndex>& aSys)
-  : DESystemBase{ aSys.size(), aSys.getInitialState() }
+  DESystem<NEvents, StorageIndex> const& aSys,
+  std::shared_ptr<Backend> aBackend)
+  : inv_graph_{ nullptr }
+  , events_{ aSys.getEvents() }
+  , init_state_{ aSys.getInitialState() }
+  , marked_states_{ aSys.getMarkedStates() }
+  , backend_{ std::move(aBackend) }
 {
-    GraphHostData ident{ this->states_number_, this->states_number_ };
-    ident.setIdentity();
-    ident += graph_;
-    graph_ = ident.template cast<float>();
-    this->marked_states_ = aSys.getMarkedStates();
+    using GraphHostData =
+      typename DESystem<NEvents, StorageIndex>::GraphHostData;
+
+    graph_.rows = aSys.size();
+    graph_.offsets.assign(aSys.size() + 1ul, 0ul);
+    graph_.cols.reserve(static_cast<std::size_t>(aSys.graph_.nonZeros()));
+    graph_.events.reserve(static_cast<std::size_t>(aSys.graph_.nonZeros()));
+    for (auto q = 0ul; q < aSys.size(); ++q) {
+        for (Eigen::InnerIterator<GraphHostData const> e(aSys.graph_, q); e;
+             ++e) {
+            if (e.value().any()) {
+                graph_.cols.push_back(static_cast<StorageIndex>(e.col()));
+                graph_.events.push_back(e.value());
+            }
+        }
+        graph_.offsets[q + 1ul] = graph_.cols.size();
+    }
+    buildStatesEvents_();
 }
 
 template<uint8_t NEvents, typename StorageIndex>
-std::shared_ptr<DESystemBase<NEvents, StorageIndex>>
-DESystemCL<NEvents, StorageIndex>::clone() const
+DESystemCL<NEvents, StorageIndex>::DESystemCL(GraphDeviceData aGraph,
+                                              StorageIndex const aInitState,
+                                              StatesSet aMarkedStates,
+                                              EventsSet_t const& aEvents,
+                                              std::shared_ptr<Backend> aBackend)
+  : graph_{ std::move(aGraph) }
+  , inv_graph_{ nullptr }
+  , events_{ aEvents }
+  , init_state_{ aInitState }
+  , marked_states_{ std::move(aMarkedStates) }
+  , backend_{ std::move(aBackend) }
 {
-    std::shared_ptr<DESystemBase> this_ptr =
-      std::make_shared<DESystemCL>(*this);
-    return this_ptr;
+    buildStatesEvents_();
 }
 
 template<uint8_t NEvents, typename StorageIndex>
-bool
-DESystemCL<NEvents, StorageIndex>::isVirtual() const
+MemoryUsage
+DESystemCL<NEvents, StorageIndex>::memoryUsage() const noexcept
 {
-    return false;
+    auto const csr_bytes = [](GraphDeviceData const& aGraph) {
+        return vectorBytes_(aGraph.offsets) + vectorBytes_(aGraph.cols) +
+               vectorBytes_(aGraph.events);
+    };
+    MemoryUsage usage;
+    usage.graph = csr_bytes(graph_);
+    if (inv_graph_) {
+        usage.inverted_graph = csr_bytes(*inv_graph_);
+    }
+    usage.states_events = vectorBytes_(states_events_);
+    usage.inv_states_events = vectorBytes_(inv_states_events_);
+    usage.marked_states = setBytes_(marked_states_);
+    return usage;
 }
 
 template<uint8_t NEvents, typename StorageIndex>
-typename DESystemCL<NEvents, StorageIndex>::GraphDeviceData
-DESystemCL<NEvents, StorageIndex>::getGraph() const
+void
+DESystemCL<NEvents, StorageIndex>::buildStatesEvents_()
 {
-    return graph_;
+    states_events_.assign(graph_.rows, EventsSet_t{});
+    inv_states_events_.assign(graph_.rows, EventsSet_t{});
+    for (auto q = 0ul; q < graph_.rows; ++q) {
+        for (auto t = graph_.offsets[q]; t < graph_.offsets[q + 1ul]; ++t) {
+            states_events_[q] |= graph_.events[t];
+            inv_states_events_[graph_.cols[t]] |= graph_.events[t];
+        }
+    }
 }
 
 template<uint8_t NEvents, typename StorageIndex>
 typename DESystemCL<NEvents, StorageIndex>::StatesSet
-DESystemCL<NEvents, StorageIndex>::accessiblePart()
+DESystemCL<NEvents, StorageIndex>::accessiblePart() const
 {
-    auto accessible_states = bfs_();
-    return *accessible_states;
+    if (graph_.rows == 0) {
+        return StatesSet{};
+    }
+    auto const states = backend_->reach(graph_, { init_state_ });
+    return StatesSet(states.begin(), states.end());
 }
 
 template<uint8_t NEvents, typename StorageIndex>
 typename DESystemCL<NEvents, StorageIndex>::StatesSet
-DESystemCL<NEvents, StorageIndex>::coaccessiblePart()
+DESystemCL<NEvents, StorageIndex>::coaccessiblePart() const
 {
-    StorageIndexSigned const n_marked = this->marked_states_.size();
-    StatesVector host_x{ static_cast<StorageIndexSigned>(this->states_number_),
-                         n_marked };
-    host_x.reserve(this->marked_states_.size());
-
-    {
-        auto pos = 0ul;
-        for (auto state : this->marked_states_) {
-            host_x.coeffRef(state, pos) = true;
-            ++pos;
-        }
-    }
-    // Copy search vector to device memory
-    StatesDeviceVector x;
-    viennacl::copy(host_x, x);
-
-    // Copy to device memory
-    viennacl::copy(graph_.transpose().eval(), device_graph_);
-
-    // Executes BFS
-    StatesDeviceVector y;
-    auto n_accessed_states = 0ul;
-    for (auto i = 0ul; i < this->states_number_; ++i) {
-        // Using auto bellow results in compile error
-        // on the following for statement
-        y = viennacl::linalg::prod(device_graph_, x);
-
-        x = std::move(y);
-
-        if (n_accessed_states == x.nnz()) {
-            break;
-        } else {
-            n_accessed_states = x.nnz();
-        }
-    }
-
-    viennacl::copy(x, host_x);
-
-    auto coaccessible_states = StatesSet{};
-
-    // Add results to a std::set vector
-    for (StorageIndexSigned s = 0; s < host_x.outerSize(); ++s) {
-        for (ColIteratorConst e(host_x, s); e; ++e) {
-            coaccessible_states.emplace(e.row());
-        }
-    }
-
-    return coaccessible_states;
+    allocateInvertedGraph();
+    std::vector<StorageIndex> const marked(marked_states_.begin(),
+                                           marked_states_.end());
+    auto const states = backend_->reach(*inv_graph_, marked);
+    return StatesSet(states.begin(), states.end());
 }
 
 template<uint8_t NEvents, typename StorageIndex>
-template<class StatesType>
-std::shared_ptr<typename DESystemCL<NEvents, StorageIndex>::StatesSet>
-DESystemCL<NEvents, StorageIndex>::bfs_(
-  StatesType const& aInitialNode,
-  std::function<void(StorageIndex const&, StorageIndex const&)> const&
-    aBfsVisit)
+typename DESystemCL<NEvents, StorageIndex>::StatesSet
+DESystemCL<NEvents, StorageIndex>::trimStates() const
 {
-    /*
-     * BFS on a Linear Algebra approach:
-     *     Y = G^T * X
-     */
-    StatesVector host_x{ static_cast<Eigen::Index>(this->states_number_), 1 };
-
-    // GPUs does not allow dynamic memory allocation. So, we have
-    // to set X on host first.
-    host_x.coeffRef(aInitialNode, 0) = 1;
-
-    return bfsCalc_(host_x, aBfsVisit, nullptr);
+    auto const accessible = accessiblePart();
+    auto const coaccessible = coaccessiblePart();
+    StatesSet trim_states;
+    std::set_intersection(accessible.begin(),
+                          accessible.end(),
+                          coaccessible.begin(),
+                          coaccessible.end(),
+                          std::inserter(trim_states, trim_states.begin()));
+    return trim_states;
 }
 
 template<uint8_t NEvents, typename StorageIndex>
-std::shared_ptr<typename DESystemCL<NEvents, StorageIndex>::StatesSet>
-DESystemCL<NEvents, StorageIndex>::bfsCalc_(
-  StatesVector& aHostX,
-  std::function<void(StorageIndex const&, StorageIndex const&)> const&
-    aBfsVisit,
-  std::vector<StorageIndex> const* const aStatesMap)
+typename DESystemCL<NEvents, StorageIndex>::StorageIndexSigned
+DESystemCL<NEvents, StorageIndex>::trans(StorageIndex const& aQ,
+                                         ScalarType const& aEvent) const
+  noexcept
 {
-    cl_uint n_initial_nodes = aHostX.cols();
-
-    // Copy search vector to device memory
-    StatesDeviceVector x;
-    viennacl::copy(aHostX, x);
-
-    // Copy to device memory
-    viennacl::copy(graph_, device_graph_);
-
-    // Executes BFS
-    StatesDeviceVector y;
-    auto n_accessed_states = 0ul;
-    for (auto i = 0u; i < this->states_number_; ++i) {
-        // Using auto bellow results in compile error
-        // on the following for statement
-        y = viennacl::linalg::prod(device_graph_, x);
-
-        x = std::move(y);
-
-        if (n_accessed_states == x.nnz()) {
-            break;
-        } else {
-            n_accessed_states = x.nnz();
-        }
+    if (!states_events_[aQ].test(aEvent)) {
+        return -1;
     }
-
-    viennacl::copy(x, aHostX);
-
-    // Unfortunatelly, only C++17 allows shared_ptr to arrays
-    std::shared_ptr<StatesSet> accessed_states{
-        new StatesSet[n_initial_nodes], std::default_delete<StatesSet[]>()
-    };
-
-    // Add results to a std::set vector
-    for (StorageIndexSigned s = 0; s < aHostX.outerSize(); ++s) {
-        for (ColIteratorConst e(aHostX, s); e; ++e) {
-            if (!aStatesMap && !aBfsVisit) {
-                accessed_states.get()[e.col()].emplace(e.row());
-            }
+    for (auto t = graph_.offsets[aQ]; t < graph_.offsets[aQ + 1ul]; ++t) {
+        if (graph_.events[t].test(aEvent)) {
+            return static_cast<StorageIndexSigned>(graph_.cols[t]);
         }
     }
-
-    return accessed_states;
-}
-
-template<uint8_t NEvents, typename StorageIndex>
-std::shared_ptr<typename DESystemCL<NEvents, StorageIndex>::StatesSet>
-DESystemCL<NEvents, StorageIndex>::bfs_()
-{
-    return bfs_(this->init_state_, nullptr);
+    return -1;
 }
 
 template<uint8_t NEvents, typename StorageIndex>
-bool
-DESystemCL<NEvents, StorageIndex>::containstrans(StorageIndex const&,
-                                                 ScalarType const&) const
+StatesArray<StorageIndex>
+DESystemCL<NEvents, StorageIndex>::invtrans(StorageIndex const& aQ,
+                                            ScalarType const& aEvent) const
 {
-    return false;
+    StatesArray<StorageIndex> inv_trans;
+    if (!inv_states_events_[aQ].test(aEvent)) {
+        return inv_trans;
+    }
+    auto const& inverted = *inv_graph_;
+    for (auto t = inverted.offsets[aQ]; t < inverted.offsets[aQ + 1ul]; ++t) {
+        if (inverted.events[t].test(aEvent)) {
+            inv_trans.push_back(inverted.cols[t]);
+        }
+    }
+    return inv_trans;
 }
 
 template<uint8_t NEvents, typename StorageIndex>
-typename DESystemCL<NEvents, StorageIndex>::StorageIndexSigned
-DESystemCL<NEvents, StorageIndex>::trans(StorageIndex const&,
-                                         ScalarType const&) const
+template<class Function>
+void
+DESystemCL<NEvents, StorageIndex>::forEachSuccessor(
+  StorageIndex const& aQ,
+  Function&& aFunction) const
 {
-    return 0;
+    for (auto t = graph_.offsets[aQ]; t < graph_.offsets[aQ + 1ul]; ++t) {
+        StorageIndex const qto = graph_.cols[t];
+        forEachEvent(graph_.events[t],
+                     [&aFunction, qto](ScalarType const aEvent) {
+                         aFunction(aEvent, qto);
+                     });
+    }
 }
 
 template<uint8_t NEvents, typename StorageIndex>
-bool
-DESystemCL<NEvents, StorageIndex>::containsinvtrans(StorageIndex const&,
-                                                    ScalarType const&) const
+template<class Function>
+void
+DESystemCL<NEvents, StorageIndex>::forEachPredecessor(
+  StorageIndex const& aQ,
+  EventsSet_t const& aEvents,
+  Function&& aFunction) const
 {
-    return false;
+    if ((inv_states_events_[aQ] & aEvents).none()) {
+        return;
+    }
+    auto const& inverted = *inv_graph_;
+    for (auto t = inverted.offsets[aQ]; t < inverted.offsets[aQ + 1ul]; ++t) {
+        StorageIndex const qfrom = inverted.cols[t];
+        forEachEvent(EventsSet_t{ inverted.events[t] & aEvents },
+                     [&aFunction, qfrom](ScalarType const aEvent) {
+                         aFunction(aEvent, qfrom);
+                     });
+    }
 }
 
 template<uint8_t NEvents, typename StorageIndex>
-StatesArray<StorageIndex>
-DESystemCL<NEvents, StorageIndex>::invtrans(StorageIndex const&,
-                                            ScalarType const&) const
+void
+DESystemCL<NEvents, StorageIndex>::allocateInvertedGraph() const
 {
-    StatesArray<StorageIndex> foo{};
-    return foo;
+    if (!inv_graph_) {
+        inv_graph_ =
+          std::make_shared<GraphDeviceData const>(backend_->transpose(graph_));
+    }
 }
 
 template<uint8_t NEvents, typename StorageIndex>
-EventsSet<NEvents>
-DESystemCL<NEvents, StorageIndex>::getStateEvents(StorageIndex const&) const
+DESystem<NEvents, StorageIndex>
+DESystemCL<NEvents, StorageIndex>::toDESystem() const
 {
-    EventsSet<NEvents> foo;
-    return foo;
+    DESystem<NEvents, StorageIndex> sys;
+    sys.states_number_ = graph_.rows;
+    sys.init_state_ = init_state_;
+    sys.marked_states_ = marked_states_;
+    sys.events_ = events_;
+    sys.states_events_ = states_events_;
+    sys.inv_states_events_ = inv_states_events_;
+    sys.trans_number_ = 0ul;
+
+    std::vector<Triplet<NEvents>> triplet;
+    triplet.reserve(graph_.nonZeros());
+    for (auto q = 0ul; q < graph_.rows; ++q) {
+        for (auto t = graph_.offsets[q]; t < graph_.offsets[q + 1ul]; ++t) {
+            triplet.push_back(Triplet<NEvents>(
+              static_cast<StorageIndex>(q), graph_.cols[t], graph_.events[t]));
+            sys.trans_number_ += graph_.events[t].count();
+        }
+    }
+    sys.graph_.resize(graph_.rows, graph_.rows);
+    sys.graph_.setFromTriplets(triplet.begin(), triplet.end());
+    sys.graph_.makeCompressed();
+    return sys;
 }
 
-template<uint8_t NEvents, typename StorageIndex>
-EventsSet<NEvents>
-DESystemCL<NEvents, StorageIndex>::getInvStateEvents(StorageIndex const&) const
-{
-    EventsSet<NEvents> foo;
-    return foo;
-}
+namespace op {
 
 template<uint8_t NEvents, typename StorageIndex>
-void
-DESystemCL<NEvents, StorageIndex>::allocateInvertedGraph() const
+DESystemCL<NEvents, StorageIndex>
+synchronize(DESystemCL<NEvents, StorageIndex> const& aSys0,
+            DESystemCL<NEvents, StorageIndex> const& aSys1)
 {
-    return;
+    using System = DESystemCL<NEvents, StorageIndex>;
+
+    auto const n0 = static_cast<uint64_t>(aSys0.size());
+    auto const init = static_cast<uint64_t>(aSys1.init_state_) * n0 +
+                      static_cast<uint64_t>(aSys0.init_state_);
+    std::vector<uint64_t> keys;
+    auto graph = aSys0.backend_->synchronize(
+      aSys0.graph_, aSys0.events_, aSys1.graph_, aSys1.events_, init, keys);
+
+    typename System::StatesSet marked_states;
+    for (auto q = 0ul; q < keys.size(); ++q) {
+        if (aSys0.marked_states_.count(
+              static_cast<StorageIndex>(keys[q] % n0)) &&
+            aSys1.marked_states_.count(
+              static_cast<StorageIndex>(keys[q] / n0))) {
+            marked_states.emplace_hint(marked_states.end(),
+                                       static_cast<StorageIndex>(q));
+        }
+    }
+    auto const init_state = static_cast<StorageIndex>(
+      std::lower_bound(keys.begin(), keys.end(), init) - keys.begin());
+
+    return System{ std::move(graph),
+                   init_state,
+                   std::move(marked_states),
+                   EventsSet<NEvents>{ aSys0.events_ | aSys1.events_ },
+                   aSys0.backend_ };
 }
-
-template<uint8_t NEvents, typename StorageIndex>
-void
-DESystemCL<NEvents, StorageIndex>::clearInvertedGraph() const
-{
-    return;
 }
 }
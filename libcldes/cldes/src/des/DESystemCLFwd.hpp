@@ -28,46 +28,21 @@
  =========================================================================
 */
 
-
-#include <CL/cl.hpp>
-
-#define VIENNACL_WITH_EIGEN 1
-
-#ifndef VIENNACL_WITH_OPENCL
-#define VIENNACL_WITH_OPENCL
-#endif
-
-#include "viennacl/compressed_matrix.hpp"
-#include "viennacl/linalg/prod.hpp"
-#include "viennacl/ocl/backend.hpp"
-
-// OclBackend should always be included after viennacl headers
-#include "cldes/backend/OclBackend.hpp"
-
-template<typename T>
-struct Eigen_vector
-{
-    typedef typename T::ERROR_NO_EIGEN_TYPE_AVAILABLE error_type;
-};
-template<>
-struct Eigen_vector<float>
-{
-    typedef Eigen::VectorXf type;
-};
-template<>
-struct Eigen_vector<double>
-{
-    typedef Eigen::VectorXd type;
-};
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
 
 namespace cldes {
 
 template<uint8_t NEvents, typename StorageIndex>
-class DESystem;
+class DESystemCL;
 
 namespace op {
-namespace backend {
-class OclBackend;
-}
+
+template<uint8_t NEvents, typename StorageIndex>
+DESystemCL<NEvents, StorageIndex> synchronize(
+  DESystemCL<NEvents, StorageIndex> const& aSys0,
+  DESystemCL<NEvents, StorageIndex> const& aSys1);
 }
 }
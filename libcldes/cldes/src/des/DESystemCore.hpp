@@ -70,6 +70,28 @@ DESystem<NEvents, StorageIndex>::DESystem(StorageIndex const& aStatesNumber,
     }
 }
 
+template<uint8_t NEvents, typename StorageIndex>
+DESystem<NEvents, StorageIndex>::DESystem(
+  StorageIndex const& aStatesNumber,
+  StorageIndex const& aInitState,
+  StatesSet& aMarkedStates,
+  std::vector<Triplet_t> const& aTransitions)
+  : DESystem{ aStatesNumber, aInitState, aMarkedStates }
+{
+    graph_.setFromTriplets(aTransitions.begin(), aTransitions.end());
+    graph_.makeCompressed();
+
+    for (auto q = 0l; q < graph_.rows(); ++q) {
+        for (typename GraphHostData::InnerIterator e(graph_, q); e; ++e) {
+            this->states_events_[q] |= e.value();
+            this->inv_states_events_[e.col()] |= e.value();
+            this->events_ |= e.value();
+            this->trans_number_ += e.value().count();
+        }
+    }
+    is_cache_outdated_ = true;
+}
+
 template<uint8_t NEvents, typename StorageIndex>
 TransitionProxy<NEvents, StorageIndex>
 DESystem<NEvents, StorageIndex>::operator()(StorageIndex const& aQfrom,
@@ -78,6 +100,35 @@ DESystem<NEvents, StorageIndex>::operator()(StorageIndex const& aQfrom,
     return TransitionProxy<NEvents, StorageIndex>(*this, aQfrom, aQto);
 }
 
+template<uint8_t NEvents, typename StorageIndex>
+MemoryUsage
+DESystem<NEvents, StorageIndex>::memoryUsage_impl() const noexcept
+{
+    auto usage = this->baseMemoryUsage_();
+    usage.graph = sparseMatrixBytes_(graph_);
+    if (inv_graph_) {
+        usage.inverted_graph = sparseMatrixBytes_(*inv_graph_);
+    }
+    return usage;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+bool
+DESystem<NEvents, StorageIndex>::placeMemory(
+  backend::NumaPolicy const aPolicy) const
+{
+    auto placed = backend::numaPlaceRows(graph_, aPolicy);
+    if (inv_graph_) {
+        placed = backend::numaPlaceRows(*inv_graph_, aPolicy) && placed;
+    }
+    placed = backend::numaPlace(this->states_events_, aPolicy) && placed;
+    if (!this->inv_states_events_.empty()) {
+        placed =
+          backend::numaPlace(this->inv_states_events_, aPolicy) && placed;
+    }
+    return placed;
+}
+
 template<uint8_t NEvents, typename StorageIndex>
 typename DESystem<NEvents, StorageIndex>::StatesSet
 DESystem<NEvents, StorageIndex>::accessiblePart() const noexcept
@@ -91,7 +142,10 @@ template<uint8_t NEvents, typename StorageIndex>
 typename DESystem<NEvents, StorageIndex>::StatesSet
 DESystem<NEvents, StorageIndex>::coaccessiblePart() const noexcept
 {
-    GraphHostData searchgraph{ this->states_number_, this->states_number_ };
+    GraphHostData searchgraph{
+        static_cast<StorageIndexSigned>(this->states_number_),
+        static_cast<StorageIndexSigned>(this->states_number_)
+    };
     searchgraph.setIdentity();
     searchgraph += graph_;
     StatesVector const invgraph{ searchgraph.template cast<bool>() };
@@ -142,9 +196,15 @@ template<uint8_t NEvents, typename StorageIndex>
 DESystemBase<NEvents, StorageIndex, DESystem<NEvents, StorageIndex>>&
 DESystem<NEvents, StorageIndex>::trim() noexcept
 {
+    TraceSpan const span{ "trim" };
     spp::sparse_hash_set<StorageIndex> trimstates;
     {
         auto trimstatesstl = this->trimStates();
+        auto const* monitor = currentMonitor();
+        if (monitor != nullptr && monitor->stopped()) {
+            // The search was interrupted: keep the system untouched
+            return *this;
+        }
         if (trimstatesstl.size() == static_cast<size_t>(graph_.rows())) {
             return *this;
         }
@@ -239,6 +299,71 @@ DESystem<NEvents, StorageIndex>::invtrans_impl(StorageIndex const& aQ,
     return inv_trans;
 }
 
+template<uint8_t NEvents, typename StorageIndex>
+template<class Function>
+void
+DESystem<NEvents, StorageIndex>::forEachSuccessor_impl(
+  StorageIndex const& aQ,
+  Function& aFunction) const
+{
+    for (RowIterator qiter(graph_, aQ); qiter; ++qiter) {
+        StorageIndex const qto = qiter.col();
+        forEachEvent(qiter.value(),
+                     [&aFunction, qto](ScalarType const aEvent) {
+                         aFunction(aEvent, qto);
+                     });
+    }
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+template<class Function>
+void
+DESystem<NEvents, StorageIndex>::forEachPredecessor_impl(
+  StorageIndex const& aQ,
+  EventsSet_t const& aEvents,
+  Function& aFunction) const
+{
+    if ((this->inv_states_events_[aQ] & aEvents).none()) {
+        return;
+    }
+    for (RowIterator qiter(*inv_graph_, aQ); qiter; ++qiter) {
+        StorageIndex const qfrom = qiter.col();
+        forEachEvent(EventsSet_t{ qiter.value() & aEvents },
+                     [&aFunction, qfrom](ScalarType const aEvent) {
+                         aFunction(aEvent, qfrom);
+                     });
+    }
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+bool
+DESystem<NEvents, StorageIndex>::operator==(DESystem const& aRhs) const
+  noexcept
+{
+    if (this->init_state_ != aRhs.init_state_) {
+        return false;
+    } else if (this->marked_states_ != aRhs.marked_states_) {
+        return false;
+    } else if (graph_.rows() != aRhs.graph_.rows() ||
+               graph_.nonZeros() != aRhs.graph_.nonZeros()) {
+        return false;
+    }
+    for (auto q = 0l; q < graph_.outerSize(); ++q) {
+        RowIterator lhs_it(graph_, q);
+        RowIterator rhs_it(aRhs.graph_, q);
+        for (; lhs_it && rhs_it; ++lhs_it, ++rhs_it) {
+            if (lhs_it.col() != rhs_it.col() ||
+                lhs_it.value() != rhs_it.value()) {
+                return false;
+            }
+        }
+        if (lhs_it || rhs_it) {
+            return false;
+        }
+    }
+    return true;
+}
+
 template<uint8_t NEvents, typename StorageIndex>
 void
 DESystem<NEvents, StorageIndex>::allocateInvertedGraph_impl() const noexcept
@@ -322,18 +447,37 @@ DESystem<NEvents, StorageIndex>::bfsCalc_(StatesVector&& aHostX,
      * BFS on a Linear Algebra approach:
      *     \f$Y = G^T * X\f$
      */
+    TraceSpan const span{ "bfs" };
+    StatsPhase const phase{ "bfs" };
     StatesVector y{ static_cast<StorageIndexSigned>(this->states_number_),
                     static_cast<StorageIndexSigned>(aHostX.cols()) };
     auto n_accessed_states = 0l;
+    auto* const monitor = currentMonitor();
     for (StorageIndex i = 0ul; i < this->states_number_; ++i) {
         y = aSearchGraph * aHostX;
+        // Every product reads the whole graph
+        phase.add(StatsCounter::kTransitionsExamined,
+                  static_cast<uint64_t>(aSearchGraph.nonZeros()));
         if (n_accessed_states == y.nonZeros()) {
             break;
-        } else {
-            n_accessed_states = y.nonZeros();
+        }
+        auto const n_new_states = y.nonZeros() - n_accessed_states;
+        n_accessed_states = y.nonZeros();
+        if (monitor != nullptr &&
+            monitor->step(static_cast<uint64_t>(n_new_states),
+                          static_cast<uint64_t>(n_new_states),
+                          n_new_states * static_cast<int64_t>(
+                                           sizeof(StorageIndexSigned) + 1ul))) {
+            break;
         }
         aHostX = y;
     }
+    phase.add(StatsCounter::kStatesVisited,
+              static_cast<uint64_t>(y.nonZeros()));
+    phase.add(StatsCounter::kAllocatedBytes,
+              static_cast<uint64_t>(y.nonZeros()) *
+                (sizeof(StorageIndexSigned) + 1ul));
+    phase.peak(static_cast<uint64_t>(y.nonZeros()));
     y.pruned();
     return y;
 }
@@ -390,7 +534,8 @@ cldes::DESystem<NEvents, StorageIndex>&
 DESystem<NEvents, StorageIndex>::proj_impl(
   EventsSet_t const& aAlphabet) noexcept
 {
-    for (StorageIndex q = 0; q < graph_.rows(); ++q) {
+    for (StorageIndex q = 0; q < static_cast<StorageIndex>(graph_.rows());
+         ++q) {
         for (RowIteratorGraph d(graph_, q); d; ++d) {
             d.valueRef() &= aAlphabet;
         }
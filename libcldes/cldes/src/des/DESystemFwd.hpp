@@ -42,10 +42,8 @@
 
 namespace cldes {
 
-#ifdef CLDES_OPENCL_ENABLED
 template<uint8_t NEvents, typename StorageIndex>
 class DESystemCL;
-#endif
 
 /*! \brief Vector that contains arguments of inverse transition function
  *
@@ -92,6 +90,10 @@ template<class SysT_l, class SysT_r>
 class SyncSysProxy;
 template<class SysT_l, class SysT_r>
 class SuperProxy;
+template<uint8_t NEvents, typename StorageIndex>
+class FusedExplorer;
+template<class SysT_l, class SysT_r>
+class ShardCoordinator;
 }
 
 /*! \brief Alias for graph 3-tuple
@@ -0,0 +1,187 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/des/DESystemSnapshotCore.hpp
+ Description: DESystemSnapshot methods definitions
+ =========================================================================
+*/
+/*!
+ * \file cldes/src/des/DESystemSnapshotCore.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-24
+ *
+ * DESystemSnapshot template class definition.
+ */
+
+namespace cldes {
+template<uint8_t NEvents, typename StorageIndex>
+DESystemSnapshot<NEvents, StorageIndex>::DESystemSnapshot(
+  DESystem<NEvents, StorageIndex> const& aSys)
+  : Base{ aSys.getStatesNumber(), aSys.getInitialState() }
+{
+    using RowIterator = typename DESystem<NEvents, StorageIndex>::RowIterator;
+
+    this->events_ = aSys.getEvents();
+    this->marked_states_ = aSys.getMarkedStates();
+
+    // Rows are visited in order and each row is sorted by column, so the
+    // counting sort keeps both graphs sorted.
+    auto const graph = aSys.getGraph();
+    SnapshotTriplets<NEvents, StorageIndex> transitions;
+    transitions.reserve(graph.nonZeros());
+    for (StorageIndex q = 0; q < this->states_number_; ++q) {
+        for (RowIterator qiter(graph, q); qiter; ++qiter) {
+            transitions.emplace_back(
+              q, static_cast<StorageIndex>(qiter.col()), qiter.value());
+        }
+    }
+    this->trans_number_ = transitions.size();
+    buildCsr_(transitions, graph_, this->states_events_);
+
+    for (auto& transition : transitions) {
+        std::swap(std::get<0>(transition), std::get<1>(transition));
+    }
+    buildCsr_(transitions, inv_graph_, this->inv_states_events_);
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+MemoryUsage
+DESystemSnapshot<NEvents, StorageIndex>::memoryUsage_impl() const noexcept
+{
+    auto const csr_bytes = [](SnapshotCsr<NEvents, StorageIndex> const& aCsr) {
+        return vectorBytes_(aCsr.offsets) + vectorBytes_(aCsr.states) +
+               vectorBytes_(aCsr.events);
+    };
+    auto usage = this->baseMemoryUsage_();
+    usage.graph = csr_bytes(graph_);
+    usage.inverted_graph = csr_bytes(inv_graph_);
+    return usage;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+void
+DESystemSnapshot<NEvents, StorageIndex>::buildCsr_(
+  SnapshotTriplets<NEvents, StorageIndex> const& aTransitions,
+  SnapshotCsr<NEvents, StorageIndex>& aGraph,
+  StatesEventsTable& aStatesEvents) const noexcept
+{
+    auto const n_states = this->states_number_;
+
+    aGraph.offsets.assign(n_states + 1ul, 0);
+    for (auto const& transition : aTransitions) {
+        ++aGraph.offsets[std::get<0>(transition) + 1ul];
+    }
+    for (auto q = 0ul; q < n_states; ++q) {
+        aGraph.offsets[q + 1ul] += aGraph.offsets[q];
+    }
+
+    aGraph.states.resize(aTransitions.size());
+    aGraph.events.resize(aTransitions.size());
+    aStatesEvents.assign(n_states, EventsSet_t{});
+    std::vector<StorageIndex> next(aGraph.offsets.begin(),
+                                   aGraph.offsets.end() - 1);
+    for (auto const& transition : aTransitions) {
+        auto const q = std::get<0>(transition);
+        auto const pos = next[q]++;
+        aGraph.states[pos] = std::get<1>(transition);
+        aGraph.events[pos] = std::get<2>(transition);
+        aStatesEvents[q] |= std::get<2>(transition);
+    }
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+typename DESystemSnapshot<NEvents, StorageIndex>::StorageIndexSigned
+DESystemSnapshot<NEvents, StorageIndex>::trans_impl(
+  StorageIndex const& aQ,
+  ScalarType const& aEvent) const noexcept
+{
+    if (!this->states_events_[aQ].test(aEvent)) {
+        return -1;
+    }
+    for (auto i = graph_.offsets[aQ]; i < graph_.offsets[aQ + 1ul]; ++i) {
+        if (graph_.events[i].test(aEvent)) {
+            return graph_.states[i];
+        }
+    }
+    return -1;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+StatesArray<StorageIndex>
+DESystemSnapshot<NEvents, StorageIndex>::invtrans_impl(
+  StorageIndex const& aQ,
+  ScalarType const& aEvent) const
+{
+    StatesArray<StorageIndex> inv_trans;
+    if (!this->inv_states_events_[aQ].test(aEvent)) {
+        return inv_trans;
+    }
+    for (auto i = inv_graph_.offsets[aQ]; i < inv_graph_.offsets[aQ + 1ul];
+         ++i) {
+        if (inv_graph_.events[i].test(aEvent)) {
+            inv_trans.push_back(inv_graph_.states[i]);
+        }
+    }
+    return inv_trans;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+template<class Function>
+void
+DESystemSnapshot<NEvents, StorageIndex>::forEachSuccessor_impl(
+  StorageIndex const& aQ,
+  Function& aFunction) const
+{
+    for (auto i = graph_.offsets[aQ]; i < graph_.offsets[aQ + 1ul]; ++i) {
+        auto const qto = graph_.states[i];
+        forEachEvent(graph_.events[i],
+                     [&aFunction, qto](ScalarType const aEvent) {
+                         aFunction(aEvent, qto);
+                     });
+    }
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+template<class Function>
+void
+DESystemSnapshot<NEvents, StorageIndex>::forEachPredecessor_impl(
+  StorageIndex const& aQ,
+  EventsSet_t const& aEvents,
+  Function& aFunction) const
+{
+    if ((this->inv_states_events_[aQ] & aEvents).none()) {
+        return;
+    }
+    for (auto i = inv_graph_.offsets[aQ]; i < inv_graph_.offsets[aQ + 1ul];
+         ++i) {
+        auto const qfrom = inv_graph_.states[i];
+        forEachEvent(EventsSet_t{ inv_graph_.events[i] & aEvents },
+                     [&aFunction, qfrom](ScalarType const aEvent) {
+                         aFunction(aEvent, qfrom);
+                     });
+    }
+}
+}
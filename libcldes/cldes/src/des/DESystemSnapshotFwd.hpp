@@ -0,0 +1,53 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/des/DESystemSnapshotFwd.hpp
+ Description: DESystemSnapshot includes and alias definitions.
+ =========================================================================
+*/
+
+#include <tuple>
+#include <vector>
+
+namespace cldes {
+
+/*! \brief Graph stored on compressed sparse rows
+ * \details Transitions leaving state q are on the range
+ * [offsets[q], offsets[q + 1]) of states and events.
+ */
+template<uint8_t NEvents, typename StorageIndex>
+struct SnapshotCsr
+{
+    std::vector<StorageIndex> offsets;
+    std::vector<StorageIndex> states;
+    std::vector<EventsSet<NEvents>> events;
+};
+
+/*! \brief Transitions (source, target, events) used to build the graphs
+ */
+template<uint8_t NEvents, typename StorageIndex>
+using SnapshotTriplets =
+  std::vector<std::tuple<StorageIndex, StorageIndex, EventsSet<NEvents>>>;
+}
@@ -0,0 +1,165 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/des/StaticDESystemCore.hpp
+ Description: StaticDESystem methods definitions
+ =========================================================================
+*/
+/*!
+ * \file cldes/src/des/StaticDESystemCore.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-26
+ *
+ * StaticDESystem template class definition.
+ */
+
+namespace cldes {
+template<std::size_t NStates, uint8_t NEvents, typename StorageIndex>
+constexpr StaticDESystem<NStates, NEvents, StorageIndex>::StaticDESystem(
+  StorageIndex const aInitState,
+  std::initializer_list<StorageIndex> const aMarkedStates,
+  std::initializer_list<Transition_t> const aTransitions)
+  : init_state_{ aInitState }
+{
+    if (aInitState >= NStates) {
+        throw std::out_of_range("StaticDESystem: Invalid initial state");
+    }
+    for (auto q = 0ul; q < NStates; ++q) {
+        for (auto e = 0ul; e < NEvents; ++e) {
+            trans_[q][e] = -1;
+        }
+    }
+    for (auto const q : aMarkedStates) {
+        if (q >= NStates) {
+            throw std::out_of_range("StaticDESystem: Invalid marked state");
+        }
+        marked_[q] = true;
+    }
+    for (auto const& transition : aTransitions) {
+        if (transition.from >= NStates || transition.to >= NStates ||
+            transition.event >= NEvents) {
+            throw std::out_of_range("StaticDESystem: Invalid transition");
+        }
+        auto& to = trans_[transition.from][transition.event];
+        if (to == static_cast<StorageIndexSigned>(transition.to)) {
+            continue;
+        }
+        if (to >= 0) {
+            throw std::invalid_argument(
+              "StaticDESystem: Nondeterministic transition");
+        }
+        to = static_cast<StorageIndexSigned>(transition.to);
+        ++trans_number_;
+        setEvent_(states_events_[transition.from], transition.event);
+        setEvent_(inv_states_events_[transition.to], transition.event);
+        setEvent_(events_, transition.event);
+    }
+}
+
+template<std::size_t NStates, uint8_t NEvents, typename StorageIndex>
+typename StaticDESystem<NStates, NEvents, StorageIndex>::StatesSet
+StaticDESystem<NStates, NEvents, StorageIndex>::getMarkedStates() const
+{
+    StatesSet marked_states;
+    for (StorageIndex q = 0; q < NStates; ++q) {
+        if (marked_[q]) {
+            marked_states.emplace_hint(marked_states.end(), q);
+        }
+    }
+    return marked_states;
+}
+
+template<std::size_t NStates, uint8_t NEvents, typename StorageIndex>
+StatesArray<StorageIndex>
+StaticDESystem<NStates, NEvents, StorageIndex>::invtrans(
+  StorageIndex const aQ,
+  ScalarType const aEvent) const
+{
+    StatesArray<StorageIndex> inv_trans;
+    if (!containsinvtrans(aQ, aEvent)) {
+        return inv_trans;
+    }
+    for (StorageIndex q = 0; q < NStates; ++q) {
+        if (trans_[q][aEvent] == static_cast<StorageIndexSigned>(aQ)) {
+            inv_trans.push_back(q);
+        }
+    }
+    return inv_trans;
+}
+
+template<std::size_t NStates, uint8_t NEvents, typename StorageIndex>
+template<class Function>
+void
+StaticDESystem<NStates, NEvents, StorageIndex>::forEachSuccessor(
+  StorageIndex const aQ,
+  Function&& aFunction) const
+{
+    for (auto e = 0u; e < NEvents; ++e) {
+        if (trans_[aQ][e] >= 0) {
+            aFunction(static_cast<ScalarType>(e),
+                      static_cast<StorageIndex>(trans_[aQ][e]));
+        }
+    }
+}
+
+template<std::size_t NStates, uint8_t NEvents, typename StorageIndex>
+template<class Function>
+void
+StaticDESystem<NStates, NEvents, StorageIndex>::forEachPredecessor(
+  StorageIndex const aQ,
+  EventsSet_t const& aEvents,
+  Function&& aFunction) const
+{
+    auto const events = getInvStateEvents(aQ) & aEvents;
+    if (events.none()) {
+        return;
+    }
+    for (StorageIndex q = 0; q < NStates; ++q) {
+        forEachEvent(EventsSet_t{ events }, [&](ScalarType const aEvent) {
+            if (trans_[q][aEvent] == static_cast<StorageIndexSigned>(aQ)) {
+                aFunction(aEvent, q);
+            }
+        });
+    }
+}
+
+template<std::size_t NStates, uint8_t NEvents, typename StorageIndex>
+constexpr typename StaticDESystem<NStates, NEvents, StorageIndex>::EventsSet_t
+StaticDESystem<NStates, NEvents, StorageIndex>::toEventsSet_(
+  uint64_t const (&aWords)[kWords]) noexcept
+{
+    // Systems with up to 64 events are built by constant expressions
+    if (kWords == 1ul) {
+        return EventsSet_t{ aWords[0] };
+    }
+    EventsSet_t events{};
+    for (auto w = kWords; w > 0ul; --w) {
+        events <<= 64u;
+        events |= EventsSet_t{ aWords[w - 1ul] };
+    }
+    return events;
+}
+}
@@ -0,0 +1,48 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/des/StaticDESystemFwd.hpp
+ Description: StaticDESystem includes and alias definitions.
+ =========================================================================
+*/
+
+#include <cstddef>
+#include <initializer_list>
+#include <set>
+#include <stdexcept>
+#include <type_traits>
+
+namespace cldes {
+
+/*! \brief Transition of a static system: f(from, event) = to
+ */
+template<typename StorageIndex>
+struct StaticTransition
+{
+    StorageIndex from;
+    ScalarType event;
+    StorageIndex to;
+};
+}
@@ -0,0 +1,102 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/operations/AsyncCore.hpp
+ Description: Asynchronous operations definitions.
+ =========================================================================
+*/
+/*!
+ * \file cldes/src/operations/AsyncCore.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-27
+ *
+ * Asynchronous operations with cancellation, progress reports and resource
+ * budgets.
+ */
+
+namespace cldes {
+
+template<class Function>
+std::future<typename std::result_of<Function()>::type>
+op::runAsync(AsyncOptions aOptions, Function&& aOperation)
+{
+    // The new thread keeps the executor of the caller
+    auto* const executor = &backend::currentExecutor();
+    return std::async(
+      std::launch::async,
+      [executor,
+       options = std::move(aOptions),
+       operation = std::forward<Function>(aOperation)]() mutable {
+          backend::ScopedExecutor const executor_scope{ *executor };
+          OperationMonitor monitor{ options.token,
+                                    options.budget,
+                                    std::move(options.on_progress),
+                                    options.progress_interval };
+          ScopedMonitor const monitor_scope{ monitor };
+
+          auto result = operation();
+          monitor.finish();
+          if (monitor.stopped()) {
+              throw OperationAborted{ monitor.reason(), monitor.progress() };
+          }
+          return result;
+      });
+}
+
+template<class SysT_l, class SysT_r>
+std::future<op::DESystem_t<SysT_l>>
+op::synchronizeAsync(SysT_l const& aSys0,
+                     SysT_r const& aSys1,
+                     AsyncOptions aOptions)
+{
+    return runAsync(std::move(aOptions), [&aSys0, &aSys1]() {
+        return synchronize(aSys0, aSys1);
+    });
+}
+
+template<class SysT_l, class SysT_r>
+std::future<op::DESystem_t<SysT_l>>
+op::supCAsync(SysT_l const& aP,
+              SysT_r const& aE,
+              EventsTableHost const& aNonContr,
+              AsyncOptions aOptions)
+{
+    return runAsync(std::move(aOptions), [&aP, &aE, aNonContr]() {
+        return supC(aP, aE, aNonContr);
+    });
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+std::future<DESystem<NEvents, StorageIndex>>
+op::trimAsync(DESystem<NEvents, StorageIndex> aSys, AsyncOptions aOptions)
+{
+    return runAsync(std::move(aOptions),
+                    [sys = std::move(aSys)]() mutable {
+                        sys.trim();
+                        return std::move(sys);
+                    });
+}
+}
@@ -0,0 +1,565 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/operations/ExpressionCore.hpp
+ Description: Lazy operations graph and fused explorer definitions.
+ =========================================================================
+*/
+/*!
+ * \file cldes/src/operations/ExpressionCore.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-28
+ *
+ * Lazy operations graph fusing synchronize, supC, trim and projection.
+ */
+
+namespace cldes {
+namespace op {
+
+template<uint8_t NEvents, typename StorageIndex>
+typename Expression<NEvents, StorageIndex>::Stage_t
+Expression<NEvents, StorageIndex>::plan() const
+{
+    Stage_t stage;
+    auto node = node_;
+
+    // Fused order: proj(trim(supC(synchronize(...))))
+    while (node->kind == ExpressionKind::kProj) {
+        if (stage.proj) {
+            stage.alphabet &= node->alphabet;
+        } else {
+            stage.alphabet = node->alphabet;
+        }
+        stage.proj = true;
+        node = node->children[0];
+    }
+    while (node->kind == ExpressionKind::kTrim) {
+        stage.trim = true;
+        node = node->children[0];
+    }
+    if (node->kind == ExpressionKind::kSupC) {
+        stage.supc = true;
+        stage.non_contr = node->non_contr;
+        collectLeaves_(node->children[0], stage);
+        stage.plant_leaves = stage.leaves.size();
+        collectLeaves_(node->children[1], stage);
+    } else {
+        collectLeaves_(node, stage);
+        stage.plant_leaves = stage.leaves.size();
+    }
+    return stage;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+void
+Expression<NEvents, StorageIndex>::collectLeaves_(
+  std::shared_ptr<Node_t const> const& aNode,
+  Stage_t& aStage)
+{
+    switch (aNode->kind) {
+        case ExpressionKind::kSystem:
+            aStage.leaves.push_back(aNode->system);
+            break;
+        case ExpressionKind::kSynchronize:
+            collectLeaves_(aNode->children[0], aStage);
+            collectLeaves_(aNode->children[1], aStage);
+            break;
+        default:
+            aStage.materialized.push_back(
+              std::make_shared<DESystem_t const>(
+                Expression{ aNode }.materialize()));
+            aStage.leaves.push_back(aStage.materialized.back().get());
+            break;
+    }
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+typename Expression<NEvents, StorageIndex>::DESystem_t
+Expression<NEvents, StorageIndex>::materialize() const
+{
+    auto const stage = plan();
+    auto const* monitor = currentMonitor();
+    if (monitor != nullptr && monitor->stopped()) {
+        return DESystem_t{};
+    }
+    FusedExplorer<NEvents, StorageIndex> explorer{ stage };
+    return explorer.run();
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+FusedExplorer<NEvents, StorageIndex>::FusedExplorer(Stage_t const& aStage)
+  : stage_{ aStage }
+  , participants_(NEvents)
+{
+    ProductKey stride = 1ul;
+    for (auto i = 0ul; i < stage_.leaves.size(); ++i) {
+        auto const& leaf = *stage_.leaves[i];
+        auto const n_states = leaf.getStatesNumber();
+        sizes_.push_back(n_states);
+        strides_.push_back(stride);
+        if (n_states != 0 &&
+            stride > std::numeric_limits<ProductKey>::max() / n_states) {
+            throw std::overflow_error(
+              "FusedExplorer: Product does not fit on 64 bits");
+        }
+        stride *= n_states;
+
+        alphabets_.push_back(leaf.getEvents());
+        events_ |= leaf.getEvents();
+        if (i < stage_.plant_leaves) {
+            plant_events_ |= leaf.getEvents();
+        }
+        forEachEvent(leaf.getEvents(), [this, i](ScalarType const aEvent) {
+            participants_[aEvent].push_back(i);
+        });
+
+        std::vector<bool> marked(n_states, false);
+        for (auto q : leaf.getMarkedStates()) {
+            marked[q] = true;
+        }
+        marked_leaves_.push_back(std::move(marked));
+    }
+    product_size_ = stride;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+typename FusedExplorer<NEvents, StorageIndex>::DESystem_t
+FusedExplorer<NEvents, StorageIndex>::run()
+{
+    if (stage_.leaves.empty() || !explore_()) {
+        return DESystem_t{};
+    }
+
+    if (stage_.supc) {
+        invert_();
+        // States found bad while exploring were not expanded
+        std::vector<StorageIndex> removed;
+        for (auto q = 0ul; q < keys_.size(); ++q) {
+            if (!alive_[q]) {
+                removed.push_back(static_cast<StorageIndex>(q));
+            }
+        }
+        removeUncontrollable_(std::move(removed));
+        // Removing blocking states may uncover uncontrollable ones
+        while (true) {
+            auto blocking = removeBlocking_();
+            if (blocking.empty()) {
+                break;
+            }
+            removeUncontrollable_(std::move(blocking));
+        }
+        removeInaccessible_();
+    } else if (stage_.trim) {
+        invert_();
+        removeBlocking_();
+    }
+    return build_();
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+StorageIndex
+FusedExplorer<NEvents, StorageIndex>::findOrInsert_(ProductKey const aKey)
+{
+    auto const it = ids_.find(aKey);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    if (keys_.size() >
+        static_cast<std::size_t>(std::numeric_limits<StorageIndex>::max())) {
+        throw std::overflow_error(
+          "FusedExplorer: Too many states for StorageIndex");
+    }
+    auto const id = static_cast<StorageIndex>(keys_.size());
+    ids_.emplace(aKey, id);
+    keys_.push_back(aKey);
+    return id;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+ProductKey
+FusedExplorer<NEvents, StorageIndex>::initialKey_() const noexcept
+{
+    ProductKey key = 0ul;
+    for (auto i = 0ul; i < stage_.leaves.size(); ++i) {
+        key += stage_.leaves[i]->getInitialState() * strides_[i];
+    }
+    return key;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+void
+FusedExplorer<NEvents, StorageIndex>::decode_(
+  ProductKey const aKey,
+  std::vector<StorageIndex>& aStates) const noexcept
+{
+    for (auto i = 0ul; i < aStates.size(); ++i) {
+        aStates[i] =
+          static_cast<StorageIndex>((aKey / strides_[i]) % sizes_[i]);
+    }
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+typename FusedExplorer<NEvents, StorageIndex>::EventsSet_t
+FusedExplorer<NEvents, StorageIndex>::enabled_(
+  std::vector<StorageIndex> const& aStates,
+  EventsSet_t& aPlantEnabled) const
+{
+    EventsSet_t enabled = events_;
+    aPlantEnabled = plant_events_;
+    for (auto i = 0ul; i < aStates.size(); ++i) {
+        auto const leaf_enabled =
+          stage_.leaves[i]->getStateEvents(aStates[i]) | ~alphabets_[i];
+        enabled &= leaf_enabled;
+        if (i < stage_.plant_leaves) {
+            aPlantEnabled &= leaf_enabled;
+        }
+    }
+    return enabled;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+ProductKey
+FusedExplorer<NEvents, StorageIndex>::next_(
+  ProductKey const aKey,
+  std::vector<StorageIndex> const& aStates,
+  ScalarType const aEvent) const
+{
+    auto next = aKey;
+    for (auto i : participants_[aEvent]) {
+        auto const qto = stage_.leaves[i]->trans(aStates[i], aEvent);
+        next = next - aStates[i] * strides_[i] +
+               static_cast<ProductKey>(qto) * strides_[i];
+    }
+    return next;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+bool
+FusedExplorer<NEvents, StorageIndex>::explore_()
+{
+    auto const n_leaves = stage_.leaves.size();
+    std::vector<StorageIndex> states(n_leaves);
+
+    findOrInsert_(initialKey_());
+    offsets_.push_back(0ul);
+
+    // Bad states are not expanded: they are flagged as not alive
+    std::vector<bool> bad;
+    auto const plant_non_contr = stage_.non_contr & plant_events_;
+
+    auto* const monitor = currentMonitor();
+    auto visited = 0ul;
+    auto reported_states = 0ul;
+    auto reported_transitions = 0ul;
+    for (auto id = 0ul; id < keys_.size(); ++id) {
+        if (monitor != nullptr && ++visited % kMonitorBatch == 0ul) {
+            auto const bytes =
+              (keys_.size() - reported_states) *
+                (2ul * sizeof(ProductKey) + sizeof(StorageIndex)) +
+              (targets_.size() - reported_transitions) *
+                (sizeof(StorageIndex) + sizeof(ScalarType));
+            reported_states = keys_.size();
+            reported_transitions = targets_.size();
+            if (monitor->step(kMonitorBatch,
+                              keys_.size() - id,
+                              static_cast<int64_t>(bytes))) {
+                return false;
+            }
+        }
+
+        auto const key = keys_[id];
+        decode_(key, states);
+        EventsSet_t plant_enabled;
+        auto const enabled = enabled_(states, plant_enabled);
+        auto is_marked = true;
+        for (auto i = 0ul; i < n_leaves; ++i) {
+            is_marked = is_marked && marked_leaves_[i][states[i]];
+        }
+        marked_.push_back(is_marked);
+
+        if (stage_.supc && (plant_enabled & plant_non_contr & ~enabled).any()) {
+            bad.resize(keys_.size(), false);
+            bad[id] = true;
+            offsets_.push_back(targets_.size());
+            continue;
+        }
+
+        forEachEvent(enabled, [&](ScalarType const aEvent) {
+            targets_.push_back(findOrInsert_(next_(key, states, aEvent)));
+            labels_.push_back(aEvent);
+        });
+        offsets_.push_back(targets_.size());
+    }
+
+    bad.resize(keys_.size(), false);
+    alive_ = std::move(bad);
+    alive_.flip();
+    return true;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+void
+FusedExplorer<NEvents, StorageIndex>::invert_()
+{
+    auto const n_states = keys_.size();
+    inv_offsets_.assign(n_states + 1ul, 0ul);
+    for (auto qto : targets_) {
+        ++inv_offsets_[qto + 1ul];
+    }
+    for (auto q = 0ul; q < n_states; ++q) {
+        inv_offsets_[q + 1ul] += inv_offsets_[q];
+    }
+    inv_sources_.resize(targets_.size());
+    inv_labels_.resize(targets_.size());
+    std::vector<std::size_t> next(inv_offsets_.begin(), inv_offsets_.end() - 1);
+    for (auto q = 0ul; q < n_states; ++q) {
+        for (auto t = offsets_[q]; t < offsets_[q + 1ul]; ++t) {
+            auto const pos = next[targets_[t]]++;
+            inv_sources_[pos] = static_cast<StorageIndex>(q);
+            inv_labels_[pos] = labels_[t];
+        }
+    }
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+std::vector<StorageIndex>
+FusedExplorer<NEvents, StorageIndex>::removeBlocking_()
+{
+    auto const n_states = keys_.size();
+    std::vector<bool> coaccessible(n_states, false);
+    std::vector<StorageIndex> stack;
+    for (auto q = 0ul; q < n_states; ++q) {
+        if (alive_[q] && marked_[q]) {
+            coaccessible[q] = true;
+            stack.push_back(static_cast<StorageIndex>(q));
+        }
+    }
+    while (!stack.empty()) {
+        auto const q = stack.back();
+        stack.pop_back();
+        for (auto t = inv_offsets_[q]; t < inv_offsets_[q + 1ul]; ++t) {
+            auto const qfrom = inv_sources_[t];
+            if (alive_[qfrom] && !coaccessible[qfrom]) {
+                coaccessible[qfrom] = true;
+                stack.push_back(qfrom);
+            }
+        }
+    }
+
+    std::vector<StorageIndex> removed;
+    for (auto q = 0ul; q < n_states; ++q) {
+        if (alive_[q] && !coaccessible[q]) {
+            alive_[q] = false;
+            removed.push_back(static_cast<StorageIndex>(q));
+        }
+    }
+    return removed;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+void
+FusedExplorer<NEvents, StorageIndex>::removeUncontrollable_(
+  std::vector<StorageIndex>&& aRemoved)
+{
+    auto stack = std::move(aRemoved);
+    while (!stack.empty()) {
+        auto const q = stack.back();
+        stack.pop_back();
+        for (auto t = inv_offsets_[q]; t < inv_offsets_[q + 1ul]; ++t) {
+            auto const qfrom = inv_sources_[t];
+            if (alive_[qfrom] && stage_.non_contr.test(inv_labels_[t])) {
+                alive_[qfrom] = false;
+                stack.push_back(qfrom);
+            }
+        }
+    }
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+void
+FusedExplorer<NEvents, StorageIndex>::removeInaccessible_()
+{
+    auto const n_states = keys_.size();
+    std::vector<bool> accessible(n_states, false);
+    std::vector<StorageIndex> stack;
+    if (alive_[0]) {
+        accessible[0] = true;
+        stack.push_back(0);
+    }
+    while (!stack.empty()) {
+        auto const q = stack.back();
+        stack.pop_back();
+        for (auto t = offsets_[q]; t < offsets_[q + 1ul]; ++t) {
+            auto const qto = targets_[t];
+            if (alive_[qto] && !accessible[qto]) {
+                accessible[qto] = true;
+                stack.push_back(qto);
+            }
+        }
+    }
+    for (auto q = 0ul; q < n_states; ++q) {
+        alive_[q] = alive_[q] && accessible[q];
+    }
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+typename FusedExplorer<NEvents, StorageIndex>::DESystem_t
+FusedExplorer<NEvents, StorageIndex>::build_() const
+{
+    if (!alive_[0]) {
+        return DESystem_t{};
+    }
+
+    // Surviving states are numbered by their product index
+    std::vector<StorageIndex> order;
+    for (auto q = 0ul; q < keys_.size(); ++q) {
+        if (alive_[q]) {
+            order.push_back(static_cast<StorageIndex>(q));
+        }
+    }
+    std::sort(order.begin(),
+              order.end(),
+              [this](StorageIndex const aL, StorageIndex const aR) {
+                  return keys_[aL] < keys_[aR];
+              });
+    std::vector<StorageIndex> new_ids(keys_.size(), 0);
+    for (auto i = 0ul; i < order.size(); ++i) {
+        new_ids[order[i]] = static_cast<StorageIndex>(i);
+    }
+
+    auto const n_states = static_cast<StorageIndex>(order.size());
+    DESystem_t sys;
+    sys.states_number_ = n_states;
+    sys.init_state_ = new_ids[0];
+    sys.events_ = events_;
+    sys.states_events_.assign(n_states, EventsSet_t{});
+    sys.inv_states_events_.assign(n_states, EventsSet_t{});
+    sys.trans_number_ = 0ul;
+
+    std::vector<Triplet<NEvents>> triplet;
+    for (auto q : order) {
+        auto const qfrom = new_ids[q];
+        if (marked_[q]) {
+            sys.marked_states_.insert(qfrom);
+        }
+        for (auto t = offsets_[q]; t < offsets_[q + 1ul]; ++t) {
+            if (!alive_[targets_[t]] ||
+                (stage_.proj && !stage_.alphabet.test(labels_[t]))) {
+                continue;
+            }
+            auto const qto = new_ids[targets_[t]];
+            EventsSet_t event_set;
+            event_set.set(labels_[t]);
+            triplet.push_back(Triplet<NEvents>(qfrom, qto, event_set));
+            sys.states_events_[qfrom] |= event_set;
+            sys.inv_states_events_[qto] |= event_set;
+            ++sys.trans_number_;
+        }
+    }
+    // Events of a pair of states are joined by setFromTriplets
+    sys.graph_.resize(n_states, n_states);
+    sys.graph_.setFromTriplets(triplet.begin(), triplet.end());
+    sys.graph_.makeCompressed();
+    return sys;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+Expression<NEvents, StorageIndex>
+lazy(DESystem<NEvents, StorageIndex> const& aSys)
+{
+    auto node = std::make_shared<ExpressionNode<NEvents, StorageIndex>>();
+    node->system = &aSys;
+    return Expression<NEvents, StorageIndex>{ std::move(node) };
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+Expression<NEvents, StorageIndex>
+lazy(DESystem<NEvents, StorageIndex>&& aSys)
+{
+    auto node = std::make_shared<ExpressionNode<NEvents, StorageIndex>>();
+    node->owned =
+      std::make_shared<DESystem<NEvents, StorageIndex> const>(std::move(aSys));
+    node->system = node->owned.get();
+    return Expression<NEvents, StorageIndex>{ std::move(node) };
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+Expression<NEvents, StorageIndex>
+synchronize(Expression<NEvents, StorageIndex> const& aSys0,
+            Expression<NEvents, StorageIndex> const& aSys1)
+{
+    auto node = std::make_shared<ExpressionNode<NEvents, StorageIndex>>();
+    node->kind = ExpressionKind::kSynchronize;
+    node->children = { aSys0.node(), aSys1.node() };
+    return Expression<NEvents, StorageIndex>{ std::move(node) };
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+Expression<NEvents, StorageIndex>
+supC(Expression<NEvents, StorageIndex> const& aP,
+     Expression<NEvents, StorageIndex> const& aE,
+     EventsTableHost const& aNonContr)
+{
+    auto node = std::make_shared<ExpressionNode<NEvents, StorageIndex>>();
+    node->kind = ExpressionKind::kSupC;
+    node->children = { aP.node(), aE.node() };
+    for (ScalarType event : aNonContr) {
+        node->non_contr.set(event);
+    }
+    return Expression<NEvents, StorageIndex>{ std::move(node) };
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+Expression<NEvents, StorageIndex>
+trim(Expression<NEvents, StorageIndex> const& aSys)
+{
+    auto node = std::make_shared<ExpressionNode<NEvents, StorageIndex>>();
+    node->kind = ExpressionKind::kTrim;
+    node->children = { aSys.node() };
+    return Expression<NEvents, StorageIndex>{ std::move(node) };
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+Expression<NEvents, StorageIndex>
+proj(Expression<NEvents, StorageIndex> const& aSys,
+     EventsSet<NEvents> const& aAlphabet)
+{
+    auto node = std::make_shared<ExpressionNode<NEvents, StorageIndex>>();
+    node->kind = ExpressionKind::kProj;
+    node->children = { aSys.node() };
+    node->alphabet = aAlphabet;
+    return Expression<NEvents, StorageIndex>{ std::move(node) };
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+DESystem<NEvents, StorageIndex>
+evaluate(Expression<NEvents, StorageIndex> const& aExpr)
+{
+    return aExpr.materialize();
+}
+
+} // namespace op
+} // namespace cldes
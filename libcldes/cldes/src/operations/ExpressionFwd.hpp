@@ -0,0 +1,115 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/operations/ExpressionFwd.hpp
+ Description: Lazy operations graph includes, nodes and fused stages.
+ =========================================================================
+*/
+
+#include <cstdint>
+#include <memory>
+#include <sparsepp/spp.h>
+#include <stdexcept>
+#include <vector>
+
+namespace cldes {
+namespace op {
+
+/*! \brief Operation represented by an expression node
+ */
+enum class ExpressionKind : int
+{
+    kSystem = 0,
+    kSynchronize,
+    kSupC,
+    kTrim,
+    kProj
+};
+
+/*! \brief Node of a lazy operations graph
+ * \details Nodes are immutable and shared by the expressions which
+ * reference them. Leaves hold a system: either a reference to a user owned
+ * system or a system owned by the node.
+ */
+template<uint8_t NEvents, typename StorageIndex>
+struct ExpressionNode
+{
+    using DESystem_t = DESystem<NEvents, StorageIndex>;
+
+    ExpressionKind kind = ExpressionKind::kSystem;
+
+    /*! \brief Operands: plant and specification for kSupC
+     */
+    std::vector<std::shared_ptr<ExpressionNode const>> children;
+
+    /*! \brief System of a kSystem leaf
+     */
+    DESystem_t const* system = nullptr;
+
+    /*! \brief Keeps alive systems moved into the graph
+     */
+    std::shared_ptr<DESystem_t const> owned;
+
+    /*! \brief Alphabet of kProj nodes
+     */
+    EventsSet<NEvents> alphabet;
+
+    /*! \brief Non controllable events of kSupC nodes
+     */
+    EventsSet<NEvents> non_contr;
+};
+
+/*! \brief Pipeline executed by a single fused exploration
+ * \details The synchronous product of all leaves is explored on the fly.
+ * When supc is set, the first plant_leaves leaves compose the plant. Trim
+ * and projection are applied to the explored graph.
+ */
+template<uint8_t NEvents, typename StorageIndex>
+struct FusedStage
+{
+    using DESystem_t = DESystem<NEvents, StorageIndex>;
+
+    std::vector<DESystem_t const*> leaves;
+    std::size_t plant_leaves = 0ul;
+
+    bool supc = false;
+    EventsSet<NEvents> non_contr;
+
+    bool trim = false;
+
+    bool proj = false;
+    EventsSet<NEvents> alphabet;
+
+    /*! \brief Subexpressions which could not be fused: they are
+     * materialized before the exploration
+     */
+    std::vector<std::shared_ptr<DESystem_t const>> materialized;
+};
+
+/*! \brief Mixed radix index of a tuple of leaves states
+ */
+using ProductKey = uint64_t;
+}
+}
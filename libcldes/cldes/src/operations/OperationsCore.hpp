@@ -43,53 +43,74 @@ synchronizeEmptyStage2(SyncSysProxy<SysT_l, SysT_r>& aVirtualSys) noexcept
     uint8_t static constexpr NEvents = SysTraits<SysT_l>::Ne_;
     using StorageIndex = typename SysTraits<SysT_l>::Si_;
 
+    TraceSpan const span{ "synchronize.stage2" };
+    StatsPhase const phase{ "synchronize.stage2" };
+
     // aprox
     StorageIndex const sparcitypattern =
       aVirtualSys.events_.count() * aVirtualSys.states_number_ / 3;
     aVirtualSys.resizeStatesEvents(aVirtualSys.states_number_);
-    aVirtualSys.trans_number_ = 0;
     aVirtualSys.triplet_.reserve(sparcitypattern);
-#ifdef CLDES_OPENMP_ENABLED
-#pragma omp parallel
-    {
-        std::vector<Triplet<NEvents>> triplet_parallel;
-#pragma omp for nowait
-        for (StorageIndex qfrom = 0; qfrom < aVirtualSys.states_number_;
-             ++qfrom) {
-#else
-    {
-        for (StorageIndex qfrom = 0; qfrom < aVirtualSys.states_number_;
-             ++qfrom) {
-#endif
-            aVirtualSys.setStateEvents(qfrom,
-                                       aVirtualSys.getStateEvents(qfrom));
-            aVirtualSys.setInvStateEvents(qfrom,
-                                          aVirtualSys.getInvStateEvents(qfrom));
-            auto event = 0u;
-            auto event_it = aVirtualSys.getStateEvents(qfrom);
-            while (event_it != 0) {
-                if (event_it.test(0)) {
-                    auto const qto = aVirtualSys.trans(qfrom, event);
-#ifdef CLDES_OPENMP_ENABLED
-                    triplet_parallel.push_back(
-#else
-                    aVirtualSys.triplet_.push_back(
-#endif
-                      Triplet<NEvents>(
-                        qfrom, qto, EventsSet<NEvents>{ 1ul << event }));
-                    ++aVirtualSys.trans_number_;
-                }
-                ++event;
-                event_it >>= 1;
-            }
-        }
-#ifdef CLDES_OPENMP_ENABLED
-#pragma omp critical
-        aVirtualSys.triplet_.insert(aVirtualSys.triplet_.end(),
-                                    triplet_parallel.begin(),
-                                    triplet_parallel.end());
-#endif
+
+    // Each worker fills its own buffer: they are merged afterwards
+    auto& executor = backend::currentExecutor();
+    std::vector<std::vector<Triplet<NEvents>>> triplets(
+      executor.concurrency());
+    std::vector<unsigned long> trans_numbers(executor.concurrency(), 0ul);
+    // Workers report to the monitor of the calling thread
+    auto* const monitor = currentMonitor();
+    executor.parallelFor(
+      0ul,
+      aVirtualSys.states_number_,
+      [&aVirtualSys, &triplets, &trans_numbers, monitor, &phase](
+        std::size_t const aBegin,
+        std::size_t const aEnd,
+        unsigned const aWorker) {
+          if (monitor != nullptr && monitor->stopped()) {
+              return;
+          }
+          TraceSpan const range_span{ "synchronize.stage2.range" };
+          auto& triplet = triplets[aWorker];
+          auto const triplet_size = triplet.size();
+          for (auto q = aBegin; q < aEnd; ++q) {
+              auto const qfrom = static_cast<StorageIndex>(q);
+              auto const q_events = aVirtualSys.getStateEvents(qfrom);
+              aVirtualSys.setStateEvents(qfrom, q_events);
+              aVirtualSys.setInvStateEvents(
+                qfrom, aVirtualSys.getInvStateEvents(qfrom));
+              aVirtualSys.forEachSuccessor(
+                qfrom,
+                [&triplet, qfrom](ScalarType const aEvent,
+                                  StorageIndex const aQto) {
+                    EventsSet<NEvents> event_set;
+                    event_set.set(aEvent);
+                    triplet.push_back(
+                      Triplet<NEvents>(qfrom, aQto, event_set));
+                });
+              trans_numbers[aWorker] += q_events.count();
+          }
+          auto const new_triplets = triplet.size() - triplet_size;
+          phase.add(StatsCounter::kStatesVisited, aEnd - aBegin);
+          phase.add(StatsCounter::kTransitionsExamined, new_triplets);
+          phase.add(StatsCounter::kAllocatedBytes,
+                    new_triplets * sizeof(Triplet<NEvents>));
+          if (monitor != nullptr) {
+              monitor->step(aEnd - aBegin,
+                            0ul,
+                            static_cast<int64_t>(
+                              (triplet.size() - triplet_size) *
+                              sizeof(Triplet<NEvents>)));
+          }
+      });
+
+    TraceSpan const merge_span{ "synchronize.stage2.merge" };
+    aVirtualSys.trans_number_ = 0;
+    for (auto w = 0u; w < executor.concurrency(); ++w) {
+        aVirtualSys.triplet_.insert(
+          aVirtualSys.triplet_.end(), triplets[w].begin(), triplets[w].end());
+        aVirtualSys.trans_number_ += trans_numbers[w];
     }
+    phase.peak(aVirtualSys.triplet_.size());
     return;
 }
 
@@ -101,33 +122,43 @@ removeBadStates_(SyncSysProxy<SysT_l, SysT_r> const& aVirtualSys,
                  EventsSet_t<SysT_l> const& aNonContrBit,
                  StatesTableHost_t<SysT_l>& aRmTable) noexcept
 {
+    StatsPhase const phase{ "supC.removeBadStates" };
+    auto visited = 0ul;
+    auto examined = 0ul;
+    auto probes = 0ul;
+    auto inserts = 1ul;
+
     StatesStack<StorageIndex> f;
     f.push(aQ);
     aRmTable.insert(aQ);
     while (!f.empty()) {
         auto const x = f.top();
         f.pop();
-        auto q_events = aVirtualSys.getInvStateEvents(x);
-        q_events &= aNonContrBit;
-        cldes::ScalarType event = 0;
-        while (q_events.any()) {
-            if (q_events.test(0)) {
-                StatesArray<StorageIndex> const finv =
-                  aVirtualSys.invtrans(x, event);
-                for (StorageIndex s : finv) {
-                    if (!aRmTable.contains(s)) {
-                        f.push(s);
-                        aRmTable.insert(s);
-                        if (aC.contains(s)) {
-                            aC.erase(s);
-                        }
-                    }
-                }
-            }
-            ++event;
-            q_events >>= 1;
-        }
+        ++visited;
+        aVirtualSys.forEachPredecessor(
+          x,
+          aNonContrBit,
+          [&aC, &aRmTable, &f, &examined, &probes, &inserts](
+            ScalarType, StorageIndex const aQfrom) {
+              ++examined;
+              ++probes;
+              if (!aRmTable.contains(aQfrom)) {
+                  f.push(aQfrom);
+                  aRmTable.insert(aQfrom);
+                  ++probes;
+                  ++inserts;
+                  if (aC.contains(aQfrom)) {
+                      aC.erase(aQfrom);
+                  }
+              }
+          });
     }
+    phase.add(StatsCounter::kStatesVisited, visited);
+    phase.add(StatsCounter::kTransitionsExamined, examined);
+    phase.add(StatsCounter::kHashProbes, probes);
+    phase.add(StatsCounter::kHashInserts, inserts);
+    phase.add(StatsCounter::kAllocatedBytes, inserts * sizeof(StorageIndex));
+    phase.peak(aRmTable.size());
     return;
 }
 
@@ -140,12 +171,30 @@ supC(SysT_l const& aP,
     uint8_t constexpr NEvents = SysTraits<SysT_l>::Ne_;
     using StorageIndex = typename SysTraits<SysT_l>::Si_;
 
-    DESystem<NEvents, StorageIndex> sys = DESystem<NEvents, StorageIndex>(
-      SuperProxy<SysT_l, SysT_r>{ aP, aE, aNonContr });
+    TraceSpan const span{ "supC" };
+    SuperProxy<SysT_l, SysT_r> virtualsys{ aP, aE, aNonContr };
+    auto const* monitor = currentMonitor();
+    if (monitor != nullptr && monitor->stopped()) {
+        // Do not convert an incomplete synthesis
+        return DESystem<NEvents, StorageIndex>{};
+    }
+    DESystem<NEvents, StorageIndex> sys =
+      DESystem<NEvents, StorageIndex>(virtualsys);
 
     return sys;
 }
 
+template<class SysT_l, class SysT_r>
+DESystem<SysTraits<SysT_l>::Ne_, typename SysTraits<SysT_l>::Si_>
+supC(SysT_l const& aP,
+     SysT_r const& aE,
+     EventsTableHost const& aNonContr,
+     backend::Executor& aExecutor) noexcept
+{
+    backend::ScopedExecutor const scope{ aExecutor };
+    return supC(aP, aE, aNonContr);
+}
+
 template<class SysT>
 SysT&
 proj(SysT const& aSys, EventsSet_t<SysT> const&) noexcept
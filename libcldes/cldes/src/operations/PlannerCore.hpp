@@ -0,0 +1,558 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/operations/PlannerCore.hpp
+ Description: Lazy versus eager planner definitions.
+ =========================================================================
+*/
+/*!
+ * \file cldes/src/operations/PlannerCore.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-29
+ *
+ * Cost model choosing lazy or eager evaluation of operations graphs.
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace cldes {
+namespace op {
+
+/*! \brief Format a cost or a number of states for explain()
+ */
+inline std::string
+planNumber_(double const aValue)
+{
+    if (std::isinf(aValue)) {
+        return "none";
+    }
+    std::ostringstream out;
+    out << std::setprecision(3) << aValue;
+    return out.str();
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+void
+ProductSampler<NEvents, StorageIndex>::sample(PlannerOptions const& aOptions,
+                                              PlanEstimate& aEstimate) const
+{
+    auto const full = static_cast<double>(this->productSize_());
+    aEstimate.full_states = full;
+
+    std::vector<StorageIndex> states(n_leaves_);
+    EventsSet_t plant_enabled;
+    auto const init = this->initialKey_();
+
+    // Breadth first search: exact on small products
+    spp::sparse_hash_set<ProductKey> seen;
+    std::vector<ProductKey> frontier{ init };
+    seen.insert(init);
+    auto transitions = 0.0;
+    auto head = 0ul;
+    while (head < frontier.size() && frontier.size() <= aOptions.exact_limit) {
+        auto const key = frontier[head++];
+        this->decode_(key, states);
+        auto const enabled = this->enabled_(states, plant_enabled);
+        transitions += static_cast<double>(enabled.count());
+        forEachEvent(enabled, [&](ScalarType const aEvent) {
+            auto const next = this->next_(key, states, aEvent);
+            if (seen.insert(next).second) {
+                frontier.push_back(next);
+            }
+        });
+    }
+    if (head == frontier.size()) {
+        aEstimate.exact = true;
+        aEstimate.reachable_states = static_cast<double>(head);
+        aEstimate.branching = transitions / static_cast<double>(head);
+        return;
+    }
+
+    // Random walks: count how many times each state is seen
+    spp::sparse_hash_map<ProductKey, uint64_t> visits;
+    auto enabled_sum = transitions;
+    auto expanded = static_cast<double>(head);
+    for (auto w = 0ul; w < aOptions.walks; ++w) {
+        WalkRng rng{ walkSeed_(aOptions.seed, w) };
+        auto key = init;
+        for (auto step = 0ul; step <= aOptions.walk_steps; ++step) {
+            ++visits[key];
+            this->decode_(key, states);
+            auto const enabled = this->enabled_(states, plant_enabled);
+            auto const n_enabled = enabled.count();
+            enabled_sum += static_cast<double>(n_enabled);
+            expanded += 1.0;
+            if (n_enabled == 0ul || step == aOptions.walk_steps) {
+                break;
+            }
+            std::uniform_int_distribution<std::size_t> pick{ 0ul,
+                                                             n_enabled - 1ul };
+            auto nth = pick(rng);
+            ScalarType event = 0u;
+            forEachEvent(enabled, [&](ScalarType const aEvent) {
+                if (nth == 0ul) {
+                    event = aEvent;
+                }
+                --nth;
+            });
+            key = this->next_(key, states, event);
+        }
+    }
+
+    auto f1 = 0.0;
+    auto f2 = 0.0;
+    for (auto const& visit : visits) {
+        if (visit.second == 1ul) {
+            f1 += 1.0;
+        } else if (visit.second == 2ul) {
+            f2 += 1.0;
+        }
+    }
+    auto const seen_states = static_cast<double>(visits.size());
+    auto const chao1 = f2 > 0.0 ? seen_states + f1 * f1 / (2.0 * f2)
+                                : seen_states + f1 * (f1 - 1.0) / 2.0;
+
+    aEstimate.exact = false;
+    aEstimate.reachable_states = std::min(
+      full, std::max(chao1, static_cast<double>(frontier.size())));
+    aEstimate.branching = enabled_sum / expanded;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+double
+ExecutionPlan<NEvents, StorageIndex>::cost() const noexcept
+{
+    auto const& estimate = root_->estimate;
+    if (root_->decision == PlanDecision::kMaterialize) {
+        return estimate.eager_cost;
+    }
+    return estimate.fused_cost;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+std::string
+ExecutionPlan<NEvents, StorageIndex>::explain() const
+{
+    std::string out;
+    explain_(*root_, 0ul, out);
+    return out;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+void
+ExecutionPlan<NEvents, StorageIndex>::explain_(PlanNode_t const& aNode,
+                                               std::size_t const aDepth,
+                                               std::string& aOut)
+{
+    auto const& estimate = aNode.estimate;
+    std::string const indent(2ul * aDepth, ' ');
+
+    aOut += indent;
+    aOut += expressionKindName(aNode.expression->kind);
+    aOut += " [";
+    aOut += planDecisionName(aNode.decision);
+    aOut += "] ";
+    if (aNode.expression->kind == ExpressionKind::kSystem) {
+        aOut += planNumber_(estimate.full_states) + " states: ";
+        aOut += aNode.reason + "\n";
+        return;
+    }
+    aOut += estimate.exact ? "" : "~";
+    aOut += planNumber_(estimate.reachable_states) + " of ";
+    aOut += planNumber_(estimate.full_states) + " states, branching ";
+    aOut += planNumber_(estimate.branching) + ", ";
+    aOut += std::to_string(estimate.leaves) + " leaves, ";
+    aOut += planNumber_(estimate.queries) + " queries\n";
+
+    aOut += indent + "  cost: fused " + planNumber_(estimate.fused_cost);
+    aOut += ", eager " + planNumber_(estimate.eager_cost);
+    if (aDepth > 0ul) {
+        aOut += ", lazy " + planNumber_(estimate.lazy_cost);
+        aOut += ", cached " + planNumber_(estimate.cache_cost);
+    }
+    aOut += "\n" + indent + "  reason: " + aNode.reason + "\n";
+
+    for (auto const& child : aNode.children) {
+        explain_(*child, aDepth + 1ul, aOut);
+    }
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+typename ExecutionPlan<NEvents, StorageIndex>::DESystem_t
+ExecutionPlan<NEvents, StorageIndex>::execute() const
+{
+    switch (root_->decision) {
+        case PlanDecision::kMaterialize:
+            return eager_(*root_);
+        default:
+            if (root_->expression->kind == ExpressionKind::kSystem) {
+                return *root_->expression->system;
+            }
+            return fused_(*root_).materialize();
+    }
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+typename ExecutionPlan<NEvents, StorageIndex>::Expression_t
+ExecutionPlan<NEvents, StorageIndex>::toExpression_(PlanNode_t const& aNode)
+{
+    if (aNode.expression->kind == ExpressionKind::kSystem) {
+        return Expression_t{ aNode.expression };
+    }
+    switch (aNode.decision) {
+        case PlanDecision::kLazy:
+            return fused_(aNode);
+        default:
+            return lazy(concrete_(aNode));
+    }
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+typename ExecutionPlan<NEvents, StorageIndex>::Expression_t
+ExecutionPlan<NEvents, StorageIndex>::fused_(PlanNode_t const& aNode)
+{
+    auto node = std::make_shared<ExpressionNode<NEvents, StorageIndex>>(
+      *aNode.expression);
+    for (auto i = 0ul; i < aNode.children.size(); ++i) {
+        node->children[i] = toExpression_(*aNode.children[i]).node();
+    }
+    return Expression_t{ std::move(node) };
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+typename ExecutionPlan<NEvents, StorageIndex>::DESystem_t
+ExecutionPlan<NEvents, StorageIndex>::concrete_(PlanNode_t const& aNode)
+{
+    if (aNode.decision == PlanDecision::kMaterialize) {
+        return eager_(aNode);
+    }
+    return fused_(aNode).materialize();
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+typename ExecutionPlan<NEvents, StorageIndex>::DESystem_t
+ExecutionPlan<NEvents, StorageIndex>::eager_(PlanNode_t const& aNode)
+{
+    // Operands: leaves are used in place
+    std::vector<DESystem_t> owned;
+    owned.reserve(aNode.children.size());
+    std::vector<DESystem_t const*> operands;
+    for (auto const& child : aNode.children) {
+        if (child->expression->kind == ExpressionKind::kSystem) {
+            operands.push_back(child->expression->system);
+        } else {
+            owned.push_back(concrete_(*child));
+            operands.push_back(&owned.back());
+        }
+    }
+
+    // supC() has no eager cost: it runs the fused exploration of the
+    // concrete operands, which numbers the supervisor the same way
+    if (aNode.expression->kind == ExpressionKind::kSupC) {
+        EventsTableHost non_contr;
+        forEachEvent(aNode.expression->non_contr,
+                     [&non_contr](ScalarType const aEvent) {
+                         non_contr.insert(aEvent);
+                     });
+        return supC(lazy(*operands[0]), lazy(*operands[1]), non_contr)
+          .materialize();
+    }
+    // Keep only the accessible part, numbered as the fused exploration
+    return lazy(synchronize(*operands[0], *operands[1])).materialize();
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+typename Planner<NEvents, StorageIndex>::Plan_t
+Planner<NEvents, StorageIndex>::plan(Expression_t const& aExpr) const
+{
+    auto root = estimate_(aExpr.node());
+    root->estimate.queries = root->estimate.reachable_states;
+    if (root->expression->kind == ExpressionKind::kSystem) {
+        finalize_(*root, PlanDecision::kLazy, "concrete system");
+    } else if (root->standalone == PlanDecision::kMaterialize) {
+        finalize_(*root, PlanDecision::kMaterialize, standaloneReason_(*root));
+    } else {
+        finalize_(*root, PlanDecision::kLazy, standaloneReason_(*root));
+    }
+    return Plan_t{ std::move(root) };
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+std::shared_ptr<typename Planner<NEvents, StorageIndex>::PlanNode_t>
+Planner<NEvents, StorageIndex>::estimate_(
+  std::shared_ptr<Node_t const> const& aNode) const
+{
+    auto plan_node = std::make_shared<PlanNode_t>();
+    plan_node->expression = aNode;
+    auto& estimate = plan_node->estimate;
+
+    if (aNode->kind == ExpressionKind::kSystem) {
+        auto const& sys = *aNode->system;
+        auto const n_states = static_cast<double>(sys.getStatesNumber());
+        auto transitions = 0.0;
+        for (StorageIndex q = 0; q < sys.getStatesNumber(); ++q) {
+            transitions += static_cast<double>(sys.getStateEvents(q).count());
+        }
+        estimate.full_states = n_states;
+        estimate.reachable_states = n_states;
+        estimate.branching = n_states > 0.0 ? transitions / n_states : 0.0;
+        return plan_node;
+    }
+
+    for (auto const& child : aNode->children) {
+        plan_node->children.push_back(estimate_(child));
+    }
+
+    Stage_t stage;
+    flatten_(aNode, stage);
+    stage.plant_leaves = stage.leaves.size();
+    ProductSampler<NEvents, StorageIndex>{ stage }.sample(options_, estimate);
+
+    auto const rows = estimate.reachable_states;
+    auto const branching = estimate.branching;
+
+    // Children are queried once for each explored state
+    estimate.leaves = 0ul;
+    auto eager_operands = 0.0;
+    for (auto const& child : plan_node->children) {
+        auto& child_estimate = child->estimate;
+        child_estimate.queries = rows;
+        if (child->expression->kind == ExpressionKind::kSystem) {
+            child->in_stage = PlanDecision::kLazy;
+            ++estimate.leaves;
+            continue;
+        }
+
+        auto const standalone_cost =
+          child->standalone == PlanDecision::kMaterialize
+            ? child_estimate.eager_cost
+            : child_estimate.fused_cost;
+        auto const standalone_bytes =
+          child->standalone == PlanDecision::kMaterialize
+            ? child_estimate.eager_bytes
+            : child_estimate.fused_bytes;
+        eager_operands += standalone_cost;
+
+        child_estimate.lazy_cost =
+          rows * static_cast<double>(child_estimate.leaves) *
+            (1.0 + branching) +
+          child_estimate.operands_cost;
+        child_estimate.cache_cost = standalone_cost + rows * (1.0 + branching);
+
+        if (fusable_(aNode->kind, child->expression->kind) &&
+            (child_estimate.lazy_cost <= child_estimate.cache_cost ||
+             !fits_(standalone_bytes))) {
+            child->in_stage = PlanDecision::kLazy;
+            estimate.leaves += child_estimate.leaves;
+            estimate.operands_cost += child_estimate.operands_cost;
+        } else {
+            child->in_stage = child->standalone;
+            ++estimate.leaves;
+            estimate.operands_cost += standalone_cost;
+        }
+    }
+
+    auto const n_leaves = static_cast<double>(estimate.leaves);
+    estimate.fused_cost =
+      rows * (n_leaves * (1.0 + branching) + kPlanHashCost * branching) +
+      estimate.operands_cost;
+    estimate.fused_bytes =
+      rows * (2.0 * sizeof(ProductKey) + sizeof(StorageIndex) +
+              2.0 * sizeof(std::size_t)) +
+      rows * branching * 2.0 * (sizeof(StorageIndex) + sizeof(ScalarType));
+
+    auto const full = estimate.full_states;
+    if (aNode->kind == ExpressionKind::kSynchronize) {
+        auto const workers =
+          static_cast<double>(backend::currentExecutor().concurrency());
+        // Product of every state, then its accessible part as a single leaf
+        estimate.eager_cost =
+          full * (2.0 * (1.0 + branching) + kPlanSortCost * branching) /
+            workers +
+          rows * (1.0 + (1.0 + kPlanHashCost) * branching) + eager_operands;
+        estimate.eager_bytes =
+          full * (2.0 * sizeof(EventsSet<NEvents>) + sizeof(StorageIndex)) +
+          full * branching *
+            (sizeof(StorageIndex) + sizeof(EventsSet<NEvents>));
+    }
+
+    auto const fused_fits = fits_(estimate.fused_bytes);
+    auto const eager_fits =
+      !std::isinf(estimate.eager_cost) && fits_(estimate.eager_bytes);
+    if (eager_fits &&
+        (!fused_fits || estimate.eager_cost < estimate.fused_cost)) {
+        plan_node->standalone = PlanDecision::kMaterialize;
+    } else {
+        plan_node->standalone = PlanDecision::kCacheRows;
+    }
+    return plan_node;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+void
+Planner<NEvents, StorageIndex>::finalize_(PlanNode_t& aNode,
+                                          PlanDecision const aDecision,
+                                          std::string aReason) const
+{
+    aNode.decision = aDecision;
+    aNode.reason = std::move(aReason);
+    auto const kind = aNode.expression->kind;
+    for (auto const& child : aNode.children) {
+        if (child->expression->kind == ExpressionKind::kSystem) {
+            finalize_(*child, PlanDecision::kLazy, "concrete system");
+        } else if (aDecision == PlanDecision::kMaterialize) {
+            // Eager operations take concrete operands
+            auto const decision =
+              child->standalone == PlanDecision::kMaterialize
+                ? PlanDecision::kMaterialize
+                : PlanDecision::kCacheRows;
+            finalize_(*child,
+                      decision,
+                      std::string{ "operand of eager " } +
+                        expressionKindName(kind) + "; " +
+                        standaloneReason_(*child));
+        } else {
+            finalize_(*child, child->in_stage, inStageReason_(*child, kind));
+        }
+    }
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+std::string
+Planner<NEvents, StorageIndex>::standaloneReason_(PlanNode_t const& aNode) const
+{
+    auto const& estimate = aNode.estimate;
+    auto const fused = planNumber_(estimate.fused_cost);
+    auto const eager = planNumber_(estimate.eager_cost);
+    if (std::isinf(estimate.eager_cost)) {
+        return std::string{ "no eager " } +
+               expressionKindName(aNode.expression->kind) +
+               ": fused exploration";
+    }
+    if (!fits_(estimate.fused_bytes) && !fits_(estimate.eager_bytes)) {
+        return "fused and eager over the memory limit: fused exploration";
+    }
+    if (aNode.standalone == PlanDecision::kMaterialize) {
+        if (!fits_(estimate.fused_bytes)) {
+            return "fused exploration over the memory limit";
+        }
+        return "eager " + eager + " < fused " + fused;
+    }
+    if (!fits_(estimate.eager_bytes)) {
+        return "eager result over the memory limit";
+    }
+    return "fused " + fused + " <= eager " + eager;
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+std::string
+Planner<NEvents, StorageIndex>::inStageReason_(
+  PlanNode_t const& aNode,
+  ExpressionKind const aParent) const
+{
+    auto const& estimate = aNode.estimate;
+    auto const lazy = planNumber_(estimate.lazy_cost);
+    auto const cached = planNumber_(estimate.cache_cost);
+    if (aNode.in_stage == PlanDecision::kLazy) {
+        if (estimate.lazy_cost > estimate.cache_cost) {
+            return std::string{ "fused into " } + expressionKindName(aParent) +
+                   ": cached rows over the memory limit";
+        }
+        return std::string{ "fused into " } + expressionKindName(aParent) +
+               ": lazy " + lazy + " <= cached " + cached;
+    }
+    std::string reason;
+    if (!fusable_(aParent, aNode.expression->kind)) {
+        reason = std::string{ "can not be fused into " } +
+                 expressionKindName(aParent);
+    } else {
+        reason = "cached " + cached + " < lazy " + lazy;
+    }
+    return reason + "; " + standaloneReason_(aNode);
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+void
+Planner<NEvents, StorageIndex>::flatten_(
+  std::shared_ptr<Node_t const> const& aNode,
+  Stage_t& aStage)
+{
+    if (aNode->kind == ExpressionKind::kSystem) {
+        aStage.leaves.push_back(aNode->system);
+        return;
+    }
+    for (auto const& child : aNode->children) {
+        flatten_(child, aStage);
+    }
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+bool
+Planner<NEvents, StorageIndex>::fusable_(ExpressionKind const aParent,
+                                         ExpressionKind const aChild) noexcept
+{
+    // Fused order: proj(trim(supC(synchronize(...))))
+    switch (aParent) {
+        case ExpressionKind::kSynchronize:
+        case ExpressionKind::kSupC:
+            return aChild == ExpressionKind::kSynchronize;
+        case ExpressionKind::kTrim:
+            return aChild != ExpressionKind::kProj;
+        case ExpressionKind::kProj:
+            return true;
+        default:
+            return false;
+    }
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+bool
+Planner<NEvents, StorageIndex>::fits_(double const aBytes) const noexcept
+{
+    return options_.memory_limit == 0ul ||
+           aBytes <= static_cast<double>(options_.memory_limit);
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+ExecutionPlan<NEvents, StorageIndex>
+plan(Expression<NEvents, StorageIndex> const& aExpr,
+     PlannerOptions const& aOptions)
+{
+    return Planner<NEvents, StorageIndex>{ aOptions }.plan(aExpr);
+}
+
+template<uint8_t NEvents, typename StorageIndex>
+DESystem<NEvents, StorageIndex>
+evaluateAuto(Expression<NEvents, StorageIndex> const& aExpr,
+             PlannerOptions const& aOptions)
+{
+    return plan(aExpr, aOptions).execute();
+}
+
+} // namespace op
+} // namespace cldes
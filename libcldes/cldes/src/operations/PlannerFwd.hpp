@@ -0,0 +1,215 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/operations/PlannerFwd.hpp
+ Description: Lazy versus eager planner includes, options and plan nodes.
+ =========================================================================
+*/
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <sparsepp/spp.h>
+#include <string>
+#include <vector>
+
+namespace cldes {
+namespace op {
+
+/*! \brief How a node of an operations graph is evaluated
+ */
+enum class PlanDecision : int
+{
+    /*! \brief Fused: its rows are computed on the fly by the exploration of
+     * its consumer. On the root, the whole graph is one fused exploration.
+     */
+    kLazy = 0,
+
+    /*! \brief Its accessible part is explored on its own and its rows are
+     * kept on a concrete system used by the consumer
+     */
+    kCacheRows,
+
+    /*! \brief Computed by the eager operation on concrete operands
+     */
+    kMaterialize
+};
+
+/*! \brief Planner tuning
+ */
+struct PlannerOptions
+{
+    /*! \brief Products with at most this number of accessible states are
+     * counted exactly. Larger ones are sampled by random walks.
+     */
+    uint64_t exact_limit = 4096ul;
+
+    /*! \brief Number of random walks of each sample
+     */
+    uint64_t walks = 64ul;
+
+    /*! \brief Maximum number of transitions of each walk
+     */
+    uint64_t walk_steps = 512ul;
+
+    /*! \brief Walks seed
+     */
+    uint64_t seed = kDefaultWalkSeed;
+
+    /*! \brief Plans whose estimated memory is larger are avoided: 0 means
+     * unlimited
+     */
+    uint64_t memory_limit = 0ul;
+};
+
+/*! \brief Estimates and costs of a plan node
+ * \details Costs are measured in leaf row queries: getStateEvents() or
+ * trans() calls on a concrete system. Hash lookups and eager sorting are
+ * weighted by kPlanHashCost and kPlanSortCost.
+ */
+struct PlanEstimate
+{
+    /*! \brief Number of product states, accessible or not
+     */
+    double full_states = 1.0;
+
+    /*! \brief Estimated number of accessible product states
+     */
+    double reachable_states = 1.0;
+
+    /*! \brief True if reachable_states was counted, not sampled
+     */
+    bool exact = true;
+
+    /*! \brief Mean number of enabled events on accessible states
+     */
+    double branching = 0.0;
+
+    /*! \brief Rows of this node requested by its consumer
+     */
+    double queries = 0.0;
+
+    /*! \brief Leaves of the fused exploration of this node
+     */
+    std::size_t leaves = 1ul;
+
+    /*! \brief Cost of exploring the accessible part on its own
+     */
+    double fused_cost = 0.0;
+
+    /*! \brief Cost of the eager operation: infinity when there is none
+     */
+    double eager_cost = std::numeric_limits<double>::infinity();
+
+    /*! \brief Cost of the operands which are not fused on its exploration
+     */
+    double operands_cost = 0.0;
+
+    /*! \brief Cost added to a fused consumer when it stays lazy
+     */
+    double lazy_cost = 0.0;
+
+    /*! \brief Cost added to a fused consumer when its rows are cached
+     */
+    double cache_cost = 0.0;
+
+    /*! \brief Memory of the cached rows and of the eager result, in bytes
+     */
+    double fused_bytes = 0.0;
+    double eager_bytes = 0.0;
+};
+
+/*! \brief Node of an execution plan
+ * \details It mirrors a node of the operations graph.
+ */
+template<uint8_t NEvents, typename StorageIndex>
+struct PlanNode
+{
+    std::shared_ptr<ExpressionNode<NEvents, StorageIndex> const> expression;
+    std::vector<std::shared_ptr<PlanNode>> children;
+
+    PlanDecision decision = PlanDecision::kLazy;
+    PlanEstimate estimate;
+
+    /*! \brief Decision when evaluated on its own: kCacheRows is a fused
+     * exploration, kMaterialize the eager operation
+     */
+    PlanDecision standalone = PlanDecision::kCacheRows;
+
+    /*! \brief Decision inside the exploration of its consumer
+     */
+    PlanDecision in_stage = PlanDecision::kLazy;
+
+    /*! \brief Why decision was chosen
+     */
+    std::string reason;
+};
+
+/*! \brief Weight of a hash table lookup, in leaf row queries
+ */
+double const kPlanHashCost = 4.0;
+
+/*! \brief Weight of sorting a transition of an eager result
+ */
+double const kPlanSortCost = 2.0;
+
+/*! \brief Name of an operation
+ */
+inline char const*
+expressionKindName(ExpressionKind const aKind) noexcept
+{
+    switch (aKind) {
+        case ExpressionKind::kSystem:
+            return "system";
+        case ExpressionKind::kSynchronize:
+            return "synchronize";
+        case ExpressionKind::kSupC:
+            return "supC";
+        case ExpressionKind::kTrim:
+            return "trim";
+        case ExpressionKind::kProj:
+            return "proj";
+    }
+    return "unknown";
+}
+
+/*! \brief Name of a decision
+ */
+inline char const*
+planDecisionName(PlanDecision const aDecision) noexcept
+{
+    switch (aDecision) {
+        case PlanDecision::kLazy:
+            return "lazy";
+        case PlanDecision::kCacheRows:
+            return "cache rows";
+        case PlanDecision::kMaterialize:
+            return "materialize";
+    }
+    return "unknown";
+}
+}
+}
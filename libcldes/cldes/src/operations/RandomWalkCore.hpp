@@ -0,0 +1,208 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/operations/RandomWalkCore.hpp
+ Description: RandomWalkSimulator methods definitions
+ =========================================================================
+*/
+/*!
+ * \file cldes/src/operations/RandomWalkCore.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-22
+ *
+ * Parallel Monte Carlo random-walk simulator.
+ */
+
+namespace cldes {
+template<uint8_t NEvents, typename StorageIndex>
+void
+op::RandomWalkStats<NEvents, StorageIndex>::merge(
+  RandomWalkStats const& aOther) noexcept
+{
+    walks += aOther.walks;
+    steps += aOther.steps;
+    blocking_hits += aOther.blocking_hits;
+    marked_hits += aOther.marked_hits;
+    for (auto e = 0ul; e < NEvents; ++e) {
+        event_counts[e] += aOther.event_counts[e];
+    }
+    if (visits.size() < aOther.visits.size()) {
+        visits.resize(aOther.visits.size(), 0ul);
+    }
+    for (auto q = 0ul; q < aOther.visits.size(); ++q) {
+        visits[q] += aOther.visits[q];
+    }
+}
+
+template<class SysT>
+op::RandomWalkSimulator<SysT>::RandomWalkSimulator(SysT const& aSys)
+  : sys_{ aSys }
+  , weighted_{ false }
+  , track_visits_{ false }
+{
+    weights_.fill(1.0);
+    for (auto q : sys_.getMarkedStates()) {
+        marked_states_.insert(q);
+    }
+}
+
+template<class SysT>
+void
+op::RandomWalkSimulator<SysT>::setEventsWeights(
+  EventsWeights_t const& aWeights) noexcept
+{
+    weights_ = aWeights;
+    weighted_ = true;
+}
+
+template<class SysT>
+typename op::RandomWalkSimulator<SysT>::Stats_t
+op::RandomWalkSimulator<SysT>::run(uint64_t const aWalks,
+                                   uint64_t const aMaxSteps,
+                                   uint64_t const aSeed) const
+{
+    auto& executor = backend::currentExecutor();
+    auto const nworkers = executor.concurrency();
+    std::vector<Stats_t> stats(nworkers);
+    if (track_visits_) {
+        for (auto& worker_stats : stats) {
+            worker_stats.visits.assign(sys_.getStatesNumber(), 0ul);
+        }
+    }
+
+    // Each walk seeds its own generator, so the split does not change the
+    // result. Walks are long: a few ranges per worker balance the load.
+    auto const grain = std::max(aWalks / (4ul * nworkers), 1ul);
+    executor.parallelFor(0ul,
+                         aWalks,
+                         [this, aMaxSteps, aSeed, &stats](
+                           std::size_t const aBegin,
+                           std::size_t const aEnd,
+                           unsigned const aWorker) {
+                             walks_(aBegin, aEnd, aMaxSteps, aSeed,
+                                    stats[aWorker]);
+                         },
+                         grain);
+
+    for (auto w = 1u; w < nworkers; ++w) {
+        stats[0].merge(stats[w]);
+    }
+    return std::move(stats[0]);
+}
+
+template<class SysT>
+void
+op::RandomWalkSimulator<SysT>::walks_(uint64_t const aFirst,
+                                      uint64_t const aLast,
+                                      uint64_t const aMaxSteps,
+                                      uint64_t const aSeed,
+                                      Stats_t& aStats) const noexcept
+{
+    auto const visits_size = aStats.visits.size();
+    WalkRng rng;
+    for (auto walk = aFirst; walk < aLast; ++walk) {
+        rng.seed(walkSeed_(aSeed, walk));
+        ++aStats.walks;
+
+        StorageIndex q = sys_.getInitialState();
+        if (q < visits_size) {
+            ++aStats.visits[q];
+        }
+        if (marked_states_.find(q) != marked_states_.end()) {
+            ++aStats.marked_hits;
+        }
+
+        for (auto step = 0ul; step < aMaxSteps; ++step) {
+            auto const q_events = sys_.getStateEvents(q);
+            if (q_events.none()) {
+                ++aStats.blocking_hits;
+                break;
+            }
+            auto const event = chooseEvent_(q_events, rng);
+            auto const qto = sys_.trans(q, event);
+            if (qto < 0) {
+                ++aStats.blocking_hits;
+                break;
+            }
+            q = static_cast<StorageIndex>(qto);
+
+            ++aStats.steps;
+            ++aStats.event_counts[event];
+            if (q < visits_size) {
+                ++aStats.visits[q];
+            }
+            if (marked_states_.find(q) != marked_states_.end()) {
+                ++aStats.marked_hits;
+            }
+        }
+    }
+}
+
+template<class SysT>
+ScalarType
+op::RandomWalkSimulator<SysT>::chooseEvent_(EventsSet_t const& aEvents,
+                                            WalkRng& aRng) const noexcept
+{
+    if (weighted_) {
+        auto total = 0.0;
+        for (ScalarType e = 0; e < NEvents; ++e) {
+            if (aEvents.test(e)) {
+                total += weights_[e];
+            }
+        }
+        if (total > 0.0) {
+            std::uniform_real_distribution<double> dist{ 0.0, total };
+            auto target = dist(aRng);
+            ScalarType last = 0;
+            for (ScalarType e = 0; e < NEvents; ++e) {
+                if (aEvents.test(e) && weights_[e] > 0.0) {
+                    last = e;
+                    if (target < weights_[e]) {
+                        return e;
+                    }
+                    target -= weights_[e];
+                }
+            }
+            // Rounding may leave a tiny remainder
+            return last;
+        }
+    }
+
+    std::uniform_int_distribution<std::size_t> dist{ 0ul,
+                                                     aEvents.count() - 1ul };
+    auto k = dist(aRng);
+    ScalarType e = 0;
+    for (; e < NEvents; ++e) {
+        if (aEvents.test(e)) {
+            if (k == 0ul) {
+                break;
+            }
+            --k;
+        }
+    }
+    return e;
+}
+}
@@ -0,0 +1,60 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/operations/RandomWalkFwd.hpp
+ Description: RandomWalkSimulator includes and alias.
+ =========================================================================
+*/
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <sparsepp/spp.h>
+#include <vector>
+
+namespace cldes {
+namespace op {
+
+/*! \brief Random generator owned by each walk
+ */
+using WalkRng = std::mt19937_64;
+
+/*! \brief Seed used when the user does not provide one
+ */
+uint64_t const kDefaultWalkSeed = 0x5eed5eed5eed5eedul;
+
+/*! \brief Derive the seed of a walk from the simulation seed
+ * \details SplitMix64 finalizer: consecutive walks get uncorrelated seeds.
+ */
+inline uint64_t
+walkSeed_(uint64_t const aSeed, uint64_t const aWalk) noexcept
+{
+    uint64_t z = aSeed + (aWalk + 1ul) * 0x9e3779b97f4a7c15ul;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ul;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebul;
+    return z ^ (z >> 31);
+}
+}
+}
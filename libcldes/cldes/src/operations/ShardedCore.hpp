@@ -0,0 +1,909 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/operations/ShardedCore.hpp
+ Description: Multi-process sharded exploration definitions.
+ =========================================================================
+*/
+/*!
+ * \file cldes/src/operations/ShardedCore.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-30
+ *
+ * Sharded synchronize and supC on local worker processes.
+ */
+
+#include <algorithm>
+#include <limits>
+
+namespace cldes {
+namespace op {
+
+template<class SysT_l, class SysT_r>
+ShardWorker<SysT_l, SysT_r>::ShardWorker(SysT_l const& aSys0,
+                                         SysT_r const& aSys1,
+                                         Product_t const& aProduct,
+                                         std::size_t const aShard,
+                                         int const aControl,
+                                         std::vector<int> aPeers)
+  : sys0_{ aSys0 }
+  , sys1_{ aSys1 }
+  , product_{ aProduct }
+  , shard_{ aShard }
+  , control_{ aControl }
+  , peers_{ std::move(aPeers) }
+  , head_{ 0ul }
+  , offsets_{ 0ul }
+  , out_(aProduct.shards, std::vector<uint64_t>(1ul, 0ul))
+  , in_(aProduct.shards)
+  , messages_{ 0ul }
+  , max_table_bytes_{ 0ul }
+{}
+
+template<class SysT_l, class SysT_r>
+void
+ShardWorker<SysT_l, SysT_r>::run()
+{
+    while (true) {
+        uint64_t command;
+        shardRead_(control_, &command, sizeof(command));
+
+        auto count = 0ul;
+        switch (static_cast<ShardCommand>(command)) {
+            case ShardCommand::kStop:
+                return;
+            case ShardCommand::kInit:
+                count = init_();
+                break;
+            case ShardCommand::kExpand:
+                count = expand_();
+                break;
+            case ShardCommand::kIndex:
+                count = index_();
+                break;
+            case ShardCommand::kUncontrollable:
+                count = uncontrollable_();
+                break;
+            case ShardCommand::kCoreachInit:
+                count = markInit_(true);
+                break;
+            case ShardCommand::kCoreachStep:
+                count = markStep_(true);
+                break;
+            case ShardCommand::kCoreachFinish:
+                count = markFinish_(&newly_removed_);
+                break;
+            case ShardCommand::kReachInit:
+                count = markInit_(false);
+                break;
+            case ShardCommand::kReachStep:
+                count = markStep_(false);
+                break;
+            case ShardCommand::kReachFinish:
+                count = markFinish_(nullptr);
+                break;
+            case ShardCommand::kCollect:
+                collect_();
+                break;
+        }
+        report_(count);
+    }
+}
+
+template<class SysT_l, class SysT_r>
+std::size_t
+ShardWorker<SysT_l, SysT_r>::findOrInsert_(ShardKey const aKey,
+                                           bool& aInserted)
+{
+    auto const it = ids_.find(aKey);
+    if (it != ids_.end()) {
+        aInserted = false;
+        return it->second;
+    }
+    auto const id = keys_.size();
+    ids_.emplace(aKey, id);
+    keys_.push_back(aKey);
+    marked_.push_back(product_.marked0[aKey % product_.n0] &&
+                      product_.marked1[aKey / product_.n0]);
+    removed_.push_back(false);
+    visited_.push_back(false);
+    aInserted = true;
+    return id;
+}
+
+template<class SysT_l, class SysT_r>
+template<class Function>
+void
+ShardWorker<SysT_l, SysT_r>::exchange_(std::size_t const aWords,
+                                       Function&& aProcess)
+{
+    auto const n_shards = product_.shards;
+    std::vector<std::size_t> sent(n_shards, 0ul);
+    std::vector<std::size_t> received(n_shards, 0ul);
+    std::vector<bool> done(n_shards, false);
+    done[shard_] = true;
+    auto pending = n_shards - 1ul;
+    for (auto w = 0ul; w < n_shards; ++w) {
+        out_[w][0] = out_[w].size() - 1ul;
+        if (w != shard_) {
+            messages_ += out_[w][0] / aWords;
+            in_[w].assign(1ul, 0ul);
+        }
+    }
+
+    // Each pair of workers sends and receives on the same socket
+    std::vector<pollfd> fds;
+    std::vector<std::size_t> peer_of;
+    while (pending > 0ul) {
+        fds.clear();
+        peer_of.clear();
+        for (auto w = 0ul; w < n_shards; ++w) {
+            if (w == shard_) {
+                continue;
+            }
+            short events = 0;
+            if (sent[w] < out_[w].size() * sizeof(uint64_t)) {
+                events |= POLLOUT;
+            }
+            if (!done[w]) {
+                events |= POLLIN;
+            }
+            if (events != 0) {
+                fds.push_back(pollfd{ peers_[w], events, 0 });
+                peer_of.push_back(w);
+            }
+        }
+        if (::poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "poll");
+        }
+
+        for (auto i = 0ul; i < fds.size(); ++i) {
+            auto const w = peer_of[i];
+            if ((fds[i].revents & POLLOUT) != 0) {
+                auto const bytes = out_[w].size() * sizeof(uint64_t);
+                auto const n = ::send(
+                  fds[i].fd,
+                  reinterpret_cast<char const*>(out_[w].data()) + sent[w],
+                  bytes - sent[w],
+                  MSG_NOSIGNAL | MSG_DONTWAIT);
+                if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK &&
+                    errno != EINTR) {
+                    throw std::system_error(
+                      errno, std::generic_category(), "send");
+                }
+                sent[w] += n > 0 ? static_cast<std::size_t>(n) : 0ul;
+            }
+            if ((fds[i].revents & (POLLIN | POLLHUP | POLLERR)) != 0 &&
+                !done[w]) {
+                // Word 0 is the batch size: read it before the batch
+                auto expected = sizeof(uint64_t);
+                if (received[w] >= sizeof(uint64_t)) {
+                    expected *= 1ul + in_[w][0];
+                }
+                auto const n = ::recv(
+                  fds[i].fd,
+                  reinterpret_cast<char*>(in_[w].data()) + received[w],
+                  expected - received[w],
+                  MSG_DONTWAIT);
+                if (n == 0) {
+                    throw std::runtime_error("ShardWorker: Peer exited");
+                }
+                if (n < 0) {
+                    if (errno == EAGAIN || errno == EWOULDBLOCK ||
+                        errno == EINTR) {
+                        continue;
+                    }
+                    throw std::system_error(
+                      errno, std::generic_category(), "recv");
+                }
+                received[w] += static_cast<std::size_t>(n);
+                if (received[w] == sizeof(uint64_t)) {
+                    in_[w].resize(1ul + in_[w][0]);
+                }
+                if (received[w] == in_[w].size() * sizeof(uint64_t)) {
+                    done[w] = true;
+                }
+            }
+            if (done[w] && sent[w] == out_[w].size() * sizeof(uint64_t)) {
+                --pending;
+            }
+        }
+    }
+
+    // Batches are processed in shard order: runs are deterministic
+    for (auto w = 0ul; w < n_shards; ++w) {
+        auto const& batch = w == shard_ ? out_[w] : in_[w];
+        for (auto i = 1ul; i + aWords <= batch.size(); i += aWords) {
+            aProcess(&batch[i]);
+        }
+    }
+    for (auto w = 0ul; w < n_shards; ++w) {
+        out_[w].assign(1ul, 0ul);
+        if (w != shard_) {
+            in_[w].clear();
+        }
+    }
+}
+
+template<class SysT_l, class SysT_r>
+uint64_t
+ShardWorker<SysT_l, SysT_r>::init_()
+{
+    if (shardOf_(product_.init, product_.shards) == shard_) {
+        bool inserted;
+        frontier_.push_back(findOrInsert_(product_.init, inserted));
+    }
+    return frontier_.size();
+}
+
+template<class SysT_l, class SysT_r>
+uint64_t
+ShardWorker<SysT_l, SysT_r>::expand_()
+{
+    auto const n0 = product_.n0;
+    auto const supc = product_.supc;
+    auto const last = std::min(frontier_.size(), head_ + product_.batch_states);
+
+    // States are expanded in id order: transitions are appended as CSR
+    for (; head_ < last; ++head_) {
+        auto const id = frontier_[head_];
+        auto const key = keys_[id];
+        auto const q0 = static_cast<StorageIndex>(key % n0);
+        auto const q1 = static_cast<StorageIndex>(key / n0);
+        auto const events0 = sys0_.getStateEvents(q0);
+        auto const events1 = sys1_.getStateEvents(q1);
+        EventsSet_t const enabled = (events0 & events1) |
+                                    (events0 & product_.only_in_0) |
+                                    (events1 & product_.only_in_1);
+
+        // Bad states are not expanded
+        if (supc && (events0 & product_.non_contr & ~enabled).any()) {
+            removed_[id] = true;
+            newly_removed_.push_back(id);
+            offsets_.push_back(targets_.size());
+            continue;
+        }
+
+        forEachEvent(enabled, [&](ScalarType const aEvent) {
+            auto const qto0 =
+              events0.test(aEvent) ? sys0_.trans(q0, aEvent) : q0;
+            auto const qto1 =
+              events1.test(aEvent) ? sys1_.trans(q1, aEvent) : q1;
+            auto const to = static_cast<ShardKey>(qto1) * n0 +
+                            static_cast<ShardKey>(qto0);
+            targets_.push_back(to);
+            labels_.push_back(aEvent);
+
+            auto& out = out_[shardOf_(to, product_.shards)];
+            out.push_back(to);
+            if (supc) {
+                out.push_back(key);
+                out.push_back(aEvent);
+            }
+        });
+        offsets_.push_back(targets_.size());
+    }
+    if (head_ == frontier_.size()) {
+        frontier_.clear();
+        head_ = 0ul;
+    }
+
+    exchange_(supc ? 3ul : 1ul, [&](uint64_t const* aEntry) {
+        bool inserted;
+        auto const id = findOrInsert_(aEntry[0], inserted);
+        if (inserted) {
+            frontier_.push_back(id);
+        }
+        if (supc) {
+            inv_entries_.push_back(id);
+            inv_entries_.push_back(aEntry[1]);
+            inv_entries_.push_back(aEntry[2]);
+        }
+    });
+    return frontier_.size() - head_;
+}
+
+template<class SysT_l, class SysT_r>
+uint64_t
+ShardWorker<SysT_l, SysT_r>::index_()
+{
+    auto const n_states = keys_.size();
+    auto const n_entries = inv_entries_.size() / 3ul;
+    inv_offsets_.assign(n_states + 1ul, 0ul);
+    for (auto t = 0ul; t < n_entries; ++t) {
+        ++inv_offsets_[inv_entries_[3ul * t] + 1ul];
+    }
+    for (auto q = 0ul; q < n_states; ++q) {
+        inv_offsets_[q + 1ul] += inv_offsets_[q];
+    }
+    inv_sources_.resize(n_entries);
+    inv_labels_.resize(n_entries);
+    std::vector<std::size_t> next(inv_offsets_.begin(), inv_offsets_.end() - 1);
+    for (auto t = 0ul; t < n_entries; ++t) {
+        auto const pos = next[inv_entries_[3ul * t]]++;
+        inv_sources_[pos] = inv_entries_[3ul * t + 1ul];
+        inv_labels_[pos] = static_cast<ScalarType>(inv_entries_[3ul * t + 2ul]);
+    }
+    max_table_bytes_ = std::max(max_table_bytes_, tableBytes_());
+    std::vector<uint64_t>{}.swap(inv_entries_);
+    return newly_removed_.size();
+}
+
+template<class SysT_l, class SysT_r>
+uint64_t
+ShardWorker<SysT_l, SysT_r>::uncontrollable_()
+{
+    std::vector<std::size_t> current;
+    current.swap(newly_removed_);
+    for (auto id : current) {
+        for (auto t = inv_offsets_[id]; t < inv_offsets_[id + 1ul]; ++t) {
+            if (product_.non_contr.test(inv_labels_[t])) {
+                auto const source = inv_sources_[t];
+                out_[shardOf_(source, product_.shards)].push_back(source);
+            }
+        }
+    }
+    exchange_(1ul, [&](uint64_t const* aEntry) {
+        auto const id = ids_.find(aEntry[0])->second;
+        if (!removed_[id]) {
+            removed_[id] = true;
+            newly_removed_.push_back(id);
+        }
+    });
+    return newly_removed_.size();
+}
+
+template<class SysT_l, class SysT_r>
+uint64_t
+ShardWorker<SysT_l, SysT_r>::markInit_(bool const aCoreach)
+{
+    visited_.assign(keys_.size(), false);
+    frontier_.clear();
+    head_ = 0ul;
+    if (aCoreach) {
+        for (auto id = 0ul; id < keys_.size(); ++id) {
+            if (!removed_[id] && marked_[id]) {
+                visited_[id] = true;
+                frontier_.push_back(id);
+            }
+        }
+    } else if (shardOf_(product_.init, product_.shards) == shard_) {
+        auto const id = ids_.find(product_.init)->second;
+        if (!removed_[id]) {
+            visited_[id] = true;
+            frontier_.push_back(id);
+        }
+    }
+    return frontier_.size();
+}
+
+template<class SysT_l, class SysT_r>
+uint64_t
+ShardWorker<SysT_l, SysT_r>::markStep_(bool const aCoreach)
+{
+    auto const last = std::min(frontier_.size(), head_ + product_.batch_states);
+    for (; head_ < last; ++head_) {
+        auto const id = frontier_[head_];
+        if (aCoreach) {
+            for (auto t = inv_offsets_[id]; t < inv_offsets_[id + 1ul]; ++t) {
+                auto const source = inv_sources_[t];
+                out_[shardOf_(source, product_.shards)].push_back(source);
+            }
+        } else {
+            for (auto t = offsets_[id]; t < offsets_[id + 1ul]; ++t) {
+                auto const target = targets_[t];
+                out_[shardOf_(target, product_.shards)].push_back(target);
+            }
+        }
+    }
+    if (head_ == frontier_.size()) {
+        frontier_.clear();
+        head_ = 0ul;
+    }
+
+    exchange_(1ul, [&](uint64_t const* aEntry) {
+        auto const id = ids_.find(aEntry[0])->second;
+        if (!removed_[id] && !visited_[id]) {
+            visited_[id] = true;
+            frontier_.push_back(id);
+        }
+    });
+    return frontier_.size() - head_;
+}
+
+template<class SysT_l, class SysT_r>
+uint64_t
+ShardWorker<SysT_l, SysT_r>::markFinish_(
+  std::vector<std::size_t>* aNewlyRemoved)
+{
+    auto removed = 0ul;
+    for (auto id = 0ul; id < keys_.size(); ++id) {
+        if (!removed_[id] && !visited_[id]) {
+            removed_[id] = true;
+            ++removed;
+            if (aNewlyRemoved != nullptr) {
+                aNewlyRemoved->push_back(id);
+            }
+        }
+    }
+    return removed;
+}
+
+template<class SysT_l, class SysT_r>
+void
+ShardWorker<SysT_l, SysT_r>::collect_()
+{
+    // Alive states, then their transitions: (source, target, event)
+    std::vector<uint64_t> payload(1ul, 0ul);
+    for (auto id = 0ul; id < keys_.size(); ++id) {
+        if (!removed_[id]) {
+            payload.push_back(keys_[id]);
+        }
+    }
+    payload[0] = payload.size() - 1ul;
+    auto const transitions_pos = payload.size();
+    payload.push_back(0ul);
+    for (auto id = 0ul; id < keys_.size(); ++id) {
+        if (removed_[id]) {
+            continue;
+        }
+        for (auto t = offsets_[id]; t < offsets_[id + 1ul]; ++t) {
+            payload.push_back(keys_[id]);
+            payload.push_back(targets_[t]);
+            payload.push_back(labels_[t]);
+        }
+    }
+    payload[transitions_pos] = (payload.size() - transitions_pos - 1ul) / 3ul;
+    shardWrite_(control_, payload.data(), payload.size() * sizeof(uint64_t));
+}
+
+template<class SysT_l, class SysT_r>
+void
+ShardWorker<SysT_l, SysT_r>::report_(uint64_t const aCount)
+{
+    max_table_bytes_ = std::max(max_table_bytes_, tableBytes_());
+    rusage usage;
+    ::getrusage(RUSAGE_SELF, &usage);
+
+    uint64_t const report[kShardReportWords] = {
+        aCount,
+        keys_.size(),
+        targets_.size(),
+        max_table_bytes_,
+        messages_,
+        static_cast<uint64_t>(usage.ru_maxrss) * 1024ul
+    };
+    shardWrite_(control_, report, sizeof(report));
+}
+
+template<class SysT_l, class SysT_r>
+uint64_t
+ShardWorker<SysT_l, SysT_r>::tableBytes_() const noexcept
+{
+    auto const n_states = keys_.size();
+    return ids_.size() * (sizeof(ShardKey) + sizeof(std::size_t)) +
+           keys_.capacity() * sizeof(ShardKey) + 3ul * n_states / 8ul +
+           frontier_.capacity() * sizeof(std::size_t) +
+           offsets_.capacity() * sizeof(std::size_t) +
+           targets_.capacity() * sizeof(ShardKey) + labels_.capacity() +
+           inv_entries_.capacity() * sizeof(uint64_t) +
+           inv_offsets_.capacity() * sizeof(std::size_t) +
+           inv_sources_.capacity() * sizeof(ShardKey) + inv_labels_.capacity();
+}
+
+template<class SysT_l, class SysT_r>
+ShardCoordinator<SysT_l, SysT_r>::ShardCoordinator(
+  SysT_l const& aSys0,
+  SysT_r const& aSys1,
+  ShardOptions const& aOptions)
+  : sys0_{ aSys0 }
+  , sys1_{ aSys1 }
+  , options_{ aOptions }
+  , stopped_{ false }
+  , reported_states_{ 0ul }
+  , reported_bytes_{ 0l }
+{
+    if (options_.shards == 0ul || options_.batch_states == 0ul) {
+        throw std::invalid_argument(
+          "ShardCoordinator: Shards and batch size must be positive");
+    }
+    ShardKey const n0 = sys0_.getStatesNumber();
+    ShardKey const n1 = sys1_.getStatesNumber();
+    if (n0 != 0ul && n1 > std::numeric_limits<ShardKey>::max() / n0) {
+        throw std::overflow_error(
+          "ShardCoordinator: Product does not fit on 64 bits");
+    }
+
+    product_.n0 = n0;
+    product_.init = static_cast<ShardKey>(sys1_.getInitialState()) * n0 +
+                    static_cast<ShardKey>(sys0_.getInitialState());
+    product_.shards = options_.shards;
+    product_.batch_states = options_.batch_states;
+    product_.events = sys0_.getEvents() | sys1_.getEvents();
+    product_.only_in_0 = sys0_.getEvents() & ~sys1_.getEvents();
+    product_.only_in_1 = sys1_.getEvents() & ~sys0_.getEvents();
+    product_.marked0.assign(n0, false);
+    for (auto q : sys0_.getMarkedStates()) {
+        product_.marked0[q] = true;
+    }
+    product_.marked1.assign(n1, false);
+    for (auto q : sys1_.getMarkedStates()) {
+        product_.marked1[q] = true;
+    }
+}
+
+template<class SysT_l, class SysT_r>
+typename ShardCoordinator<SysT_l, SysT_r>::DESystem_t
+ShardCoordinator<SysT_l, SysT_r>::synchronize()
+{
+    product_.supc = false;
+    product_.non_contr.reset();
+    return run_();
+}
+
+template<class SysT_l, class SysT_r>
+typename ShardCoordinator<SysT_l, SysT_r>::DESystem_t
+ShardCoordinator<SysT_l, SysT_r>::supC(EventsTableHost const& aNonContr)
+{
+    product_.supc = true;
+    product_.non_contr.reset();
+    for (ScalarType event : aNonContr) {
+        product_.non_contr.set(event);
+    }
+    return run_();
+}
+
+template<class SysT_l, class SysT_r>
+void
+ShardCoordinator<SysT_l, SysT_r>::spawn_()
+{
+    auto const n_shards = options_.shards;
+
+    // Sockets: one to each worker and one for each pair of workers
+    std::vector<int> all_fds;
+    std::vector<std::array<int, 2>> controls(n_shards);
+    std::vector<std::vector<int>> peers(n_shards,
+                                        std::vector<int>(n_shards, -1));
+    auto open_pair = [&all_fds](std::array<int, 2>& aPair) {
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, aPair.data()) < 0) {
+            for (auto fd : all_fds) {
+                ::close(fd);
+            }
+            throw std::system_error(
+              errno, std::generic_category(), "socketpair");
+        }
+        all_fds.push_back(aPair[0]);
+        all_fds.push_back(aPair[1]);
+    };
+    for (auto w = 0ul; w < n_shards; ++w) {
+        open_pair(controls[w]);
+        for (auto v = w + 1ul; v < n_shards; ++v) {
+            std::array<int, 2> pair;
+            open_pair(pair);
+            peers[w][v] = pair[0];
+            peers[v][w] = pair[1];
+        }
+    }
+
+    // Only the forking thread exists on the workers: pool workers are
+    // joined, so none of them holds a lock, and restarted once all workers
+    // are forked. The pools of the workers stay suspended.
+    backend::SuspendedThreadPools const suspended;
+    for (auto w = 0ul; w < n_shards; ++w) {
+        auto const pid = ::fork();
+        if (pid < 0) {
+            auto const error = errno;
+            for (auto fd : all_fds) {
+                ::close(fd);
+            }
+            shutdown_();
+            throw std::system_error(error, std::generic_category(), "fork");
+        }
+        if (pid == 0) {
+            // Worker: keep its own sockets only
+            auto status = 0;
+            for (auto fd : all_fds) {
+                if (fd != controls[w][1] &&
+                    std::find(peers[w].begin(), peers[w].end(), fd) ==
+                      peers[w].end()) {
+                    ::close(fd);
+                }
+            }
+            try {
+                Worker_t worker{
+                    sys0_, sys1_, product_, w, controls[w][1], peers[w]
+                };
+                worker.run();
+            } catch (...) {
+                status = 1;
+            }
+            ::_exit(status);
+        }
+        pids_.push_back(pid);
+        controls_.push_back(controls[w][0]);
+    }
+
+    // Coordinator: keep the control sockets only
+    for (auto w = 0ul; w < n_shards; ++w) {
+        ::close(controls[w][1]);
+        for (auto fd : peers[w]) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+    }
+}
+
+template<class SysT_l, class SysT_r>
+bool
+ShardCoordinator<SysT_l, SysT_r>::shutdown_() noexcept
+{
+    auto const stop = static_cast<uint64_t>(ShardCommand::kStop);
+    for (auto fd : controls_) {
+        ::send(fd, &stop, sizeof(stop), MSG_NOSIGNAL);
+        ::close(fd);
+    }
+    auto ok = true;
+    for (auto pid : pids_) {
+        auto status = 0;
+        while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+        }
+        ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+    controls_.clear();
+    pids_.clear();
+    return ok;
+}
+
+template<class SysT_l, class SysT_r>
+uint64_t
+ShardCoordinator<SysT_l, SysT_r>::readReport_(std::size_t const aShard)
+{
+    uint64_t report[kShardReportWords];
+    shardRead_(controls_[aShard], report, sizeof(report));
+    auto& worker = stats_.workers[aShard];
+    worker.states = report[1];
+    worker.transitions = report[2];
+    worker.table_bytes = report[3];
+    worker.messages = report[4];
+    worker.max_rss_bytes = report[5];
+    return report[0];
+}
+
+template<class SysT_l, class SysT_r>
+uint64_t
+ShardCoordinator<SysT_l, SysT_r>::step_(ShardCommand const aCommand)
+{
+    auto const command = static_cast<uint64_t>(aCommand);
+    for (auto fd : controls_) {
+        shardWrite_(fd, &command, sizeof(command));
+    }
+    auto count = 0ul;
+    for (auto w = 0ul; w < controls_.size(); ++w) {
+        count += readReport_(w);
+    }
+    ++stats_.supersteps;
+
+    auto* const monitor = currentMonitor();
+    if (monitor != nullptr) {
+        auto const states = stats_.states();
+        auto const bytes = static_cast<int64_t>(stats_.tableBytes());
+        if (monitor->step(states - reported_states_,
+                          count,
+                          bytes - reported_bytes_)) {
+            stopped_ = true;
+        }
+        reported_states_ = states;
+        reported_bytes_ = bytes;
+    }
+    return count;
+}
+
+template<class SysT_l, class SysT_r>
+bool
+ShardCoordinator<SysT_l, SysT_r>::drain_(ShardCommand const aCommand)
+{
+    while (!stopped_ && step_(aCommand) > 0ul) {
+    }
+    return !stopped_;
+}
+
+template<class SysT_l, class SysT_r>
+typename ShardCoordinator<SysT_l, SysT_r>::DESystem_t
+ShardCoordinator<SysT_l, SysT_r>::run_()
+{
+    stats_ = ShardStats{};
+    stats_.workers.resize(options_.shards);
+    stopped_ = false;
+    reported_states_ = 0ul;
+    reported_bytes_ = 0l;
+
+    auto const* monitor = currentMonitor();
+    if (monitor != nullptr && monitor->stopped()) {
+        return DESystem_t{};
+    }
+
+    spawn_();
+    DESystem_t result;
+    try {
+        step_(ShardCommand::kInit);
+        auto completed = drain_(ShardCommand::kExpand);
+
+        if (completed && product_.supc) {
+            step_(ShardCommand::kIndex);
+            // Removing blocking states may uncover uncontrollable ones
+            while (completed) {
+                completed = drain_(ShardCommand::kUncontrollable);
+                if (!completed) {
+                    break;
+                }
+                step_(ShardCommand::kCoreachInit);
+                completed = drain_(ShardCommand::kCoreachStep);
+                if (!completed ||
+                    step_(ShardCommand::kCoreachFinish) == 0ul) {
+                    break;
+                }
+            }
+            if (completed) {
+                step_(ShardCommand::kReachInit);
+                completed = drain_(ShardCommand::kReachStep);
+                step_(ShardCommand::kReachFinish);
+            }
+        }
+
+        if (completed && !stopped_) {
+            result = collect_();
+        }
+    } catch (...) {
+        shutdown_();
+        throw;
+    }
+    if (!shutdown_()) {
+        throw std::runtime_error("ShardCoordinator: Worker failed");
+    }
+    return result;
+}
+
+template<class SysT_l, class SysT_r>
+typename ShardCoordinator<SysT_l, SysT_r>::DESystem_t
+ShardCoordinator<SysT_l, SysT_r>::collect_()
+{
+    auto const command = static_cast<uint64_t>(ShardCommand::kCollect);
+    for (auto fd : controls_) {
+        shardWrite_(fd, &command, sizeof(command));
+    }
+
+    std::vector<ShardKey> keys;
+    std::vector<uint64_t> transitions;
+    for (auto w = 0ul; w < controls_.size(); ++w) {
+        uint64_t n_keys;
+        shardRead_(controls_[w], &n_keys, sizeof(n_keys));
+        auto const keys_pos = keys.size();
+        keys.resize(keys_pos + n_keys);
+        shardRead_(controls_[w], keys.data() + keys_pos,
+                   n_keys * sizeof(ShardKey));
+
+        uint64_t n_transitions;
+        shardRead_(controls_[w], &n_transitions, sizeof(n_transitions));
+        auto const transitions_pos = transitions.size();
+        transitions.resize(transitions_pos + 3ul * n_transitions);
+        shardRead_(controls_[w], transitions.data() + transitions_pos,
+                   3ul * n_transitions * sizeof(uint64_t));
+
+        readReport_(w);
+    }
+    ++stats_.supersteps;
+
+    // States are numbered by their product index
+    std::sort(keys.begin(), keys.end());
+    auto const index_of = [&keys](ShardKey const aKey) {
+        auto const it = std::lower_bound(keys.begin(), keys.end(), aKey);
+        return it != keys.end() && *it == aKey
+                 ? static_cast<int64_t>(it - keys.begin())
+                 : -1l;
+    };
+    auto const init = index_of(product_.init);
+    if (init < 0) {
+        return DESystem_t{};
+    }
+    if (keys.size() >
+        static_cast<std::size_t>(std::numeric_limits<StorageIndex>::max())) {
+        throw std::overflow_error(
+          "ShardCoordinator: Too many states for StorageIndex");
+    }
+
+    auto const n_states = static_cast<StorageIndex>(keys.size());
+    DESystem_t sys;
+    sys.states_number_ = n_states;
+    sys.init_state_ = static_cast<StorageIndex>(init);
+    sys.events_ = product_.events;
+    sys.states_events_.assign(n_states, EventsSet_t{});
+    sys.inv_states_events_.assign(n_states, EventsSet_t{});
+    sys.trans_number_ = 0ul;
+    for (auto q = 0ul; q < keys.size(); ++q) {
+        if (product_.marked0[keys[q] % product_.n0] &&
+            product_.marked1[keys[q] / product_.n0]) {
+            sys.marked_states_.insert(static_cast<StorageIndex>(q));
+        }
+    }
+
+    std::vector<Triplet<NEvents>> triplet;
+    for (auto t = 0ul; t < transitions.size(); t += 3ul) {
+        auto const qto = index_of(transitions[t + 1ul]);
+        if (qto < 0) {
+            continue;
+        }
+        auto const qfrom = static_cast<StorageIndex>(index_of(transitions[t]));
+        EventsSet_t event_set;
+        event_set.set(transitions[t + 2ul]);
+        triplet.push_back(Triplet<NEvents>(
+          qfrom, static_cast<StorageIndex>(qto), event_set));
+        sys.states_events_[qfrom] |= event_set;
+        sys.inv_states_events_[qto] |= event_set;
+        ++sys.trans_number_;
+    }
+    sys.graph_.resize(n_states, n_states);
+    sys.graph_.setFromTriplets(triplet.begin(), triplet.end());
+    sys.graph_.makeCompressed();
+    return sys;
+}
+
+template<class SysT_l, class SysT_r>
+DESystem<SysTraits<SysT_l>::Ne_, typename SysTraits<SysT_l>::Si_>
+shardedSynchronize(SysT_l const& aSys0,
+                   SysT_r const& aSys1,
+                   ShardOptions const& aOptions,
+                   ShardStats* aStats)
+{
+    ShardCoordinator<SysT_l, SysT_r> coordinator{ aSys0, aSys1, aOptions };
+    auto result = coordinator.synchronize();
+    if (aStats != nullptr) {
+        *aStats = coordinator.stats();
+    }
+    return result;
+}
+
+template<class SysT_l, class SysT_r>
+DESystem<SysTraits<SysT_l>::Ne_, typename SysTraits<SysT_l>::Si_>
+shardedSupC(SysT_l const& aP,
+            SysT_r const& aE,
+            EventsTableHost const& aNonContr,
+            ShardOptions const& aOptions,
+            ShardStats* aStats)
+{
+    ShardCoordinator<SysT_l, SysT_r> coordinator{ aP, aE, aOptions };
+    auto result = coordinator.supC(aNonContr);
+    if (aStats != nullptr) {
+        *aStats = coordinator.stats();
+    }
+    return result;
+}
+
+} // namespace op
+} // namespace cldes
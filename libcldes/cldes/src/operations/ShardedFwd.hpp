@@ -0,0 +1,218 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/operations/ShardedFwd.hpp
+ Description: Multi-process sharded exploration includes, options, stats
+ and the worker protocol.
+ =========================================================================
+*/
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <poll.h>
+#include <signal.h>
+#include <sparsepp/spp.h>
+#include <stdexcept>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <system_error>
+#include <unistd.h>
+#include <vector>
+
+namespace cldes {
+namespace op {
+
+/*! \brief Index of a product state: q1 * n0 + q0, as on SyncSysProxy
+ */
+using ShardKey = uint64_t;
+
+/*! \brief Sharded exploration options
+ */
+struct ShardOptions
+{
+    /*! \brief Number of worker processes
+     */
+    std::size_t shards = 2ul;
+
+    /*! \brief Maximum number of frontier states a worker expands on each
+     * superstep: it bounds the batches exchanged by the workers
+     */
+    std::size_t batch_states = 1ul << 16;
+};
+
+/*! \brief Work and memory of a worker process
+ */
+struct ShardWorkerStats
+{
+    /*! \brief Product states owned by the worker
+     */
+    uint64_t states = 0ul;
+
+    /*! \brief Transitions leaving the states owned by the worker
+     */
+    uint64_t transitions = 0ul;
+
+    /*! \brief Bytes of the visited, removed and transitions tables
+     */
+    uint64_t table_bytes = 0ul;
+
+    /*! \brief Entries sent to other workers
+     */
+    uint64_t messages = 0ul;
+
+    /*! \brief Peak resident set size of the process, in bytes
+     */
+    uint64_t max_rss_bytes = 0ul;
+};
+
+/*! \brief Stats of the last sharded operation
+ */
+struct ShardStats
+{
+    std::vector<ShardWorkerStats> workers;
+
+    /*! \brief Number of supersteps run by the coordinator
+     */
+    uint64_t supersteps = 0ul;
+
+    /*! \brief Sum of the tables of all workers, in bytes
+     */
+    uint64_t tableBytes() const noexcept
+    {
+        auto bytes = 0ul;
+        for (auto const& worker : workers) {
+            bytes += worker.table_bytes;
+        }
+        return bytes;
+    }
+
+    /*! \brief Sum of the peak resident set sizes of all workers, in bytes
+     */
+    uint64_t maxRssBytes() const noexcept
+    {
+        auto bytes = 0ul;
+        for (auto const& worker : workers) {
+            bytes += worker.max_rss_bytes;
+        }
+        return bytes;
+    }
+
+    /*! \brief Number of explored product states
+     */
+    uint64_t states() const noexcept
+    {
+        auto states = 0ul;
+        for (auto const& worker : workers) {
+            states += worker.states;
+        }
+        return states;
+    }
+};
+
+/*! \brief Commands sent by the coordinator on each superstep
+ */
+enum class ShardCommand : uint64_t
+{
+    kStop = 0,
+    kInit,
+    kExpand,
+    kIndex,
+    kUncontrollable,
+    kCoreachInit,
+    kCoreachStep,
+    kCoreachFinish,
+    kReachInit,
+    kReachStep,
+    kReachFinish,
+    kCollect
+};
+
+/*! \brief Words of a worker report: count, states, transitions,
+ * table_bytes, messages and max_rss_bytes
+ */
+std::size_t const kShardReportWords = 6ul;
+
+/*! \brief Worker which owns a product state
+ * \details SplitMix64 finalizer: neighbour states land on different shards.
+ */
+inline std::size_t
+shardOf_(ShardKey const aKey, std::size_t const aShards) noexcept
+{
+    uint64_t z = aKey + 0x9e3779b97f4a7c15ul;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ul;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebul;
+    return static_cast<std::size_t>((z ^ (z >> 31)) % aShards);
+}
+
+/*! \brief Send aBytes bytes on a socket, retrying on interruptions
+ * \details Throws std::system_error on failure. A closed peer is reported
+ * as EPIPE, without raising SIGPIPE.
+ */
+inline void
+shardWrite_(int const aFd, void const* aData, std::size_t const aBytes)
+{
+    auto const* data = static_cast<char const*>(aData);
+    auto written = 0ul;
+    while (written < aBytes) {
+        auto const n =
+          ::send(aFd, data + written, aBytes - written, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "send");
+        }
+        written += static_cast<std::size_t>(n);
+    }
+}
+
+/*! \brief Read exactly aBytes bytes
+ * \details Throws std::runtime_error when the other side closed the pipe,
+ * and std::system_error on failure.
+ */
+inline void
+shardRead_(int const aFd, void* aData, std::size_t const aBytes)
+{
+    auto* data = static_cast<char*>(aData);
+    auto read = 0ul;
+    while (read < aBytes) {
+        auto const n = ::read(aFd, data + read, aBytes - read);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "read");
+        }
+        if (n == 0) {
+            throw std::runtime_error("ShardCoordinator: Worker exited");
+        }
+        read += static_cast<std::size_t>(n);
+    }
+}
+}
+}
@@ -0,0 +1,151 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/operations/StateEstimatorCore.hpp
+ Description: StateEstimator methods definitions
+ =========================================================================
+*/
+/*!
+ * \file cldes/src/operations/StateEstimatorCore.hpp
+ *
+ * \author Adriano Mourao \@madc0ww
+ * \date 2018-11-20
+ *
+ * Online current-state estimator for partially observed systems.
+ */
+
+namespace cldes {
+template<class SysT>
+op::StateEstimator<SysT>::StateEstimator(SysT const& aSys,
+                                         EventsSet_t const& aUnobservable,
+                                         std::size_t const aCacheCapacity)
+  : sys_{ aSys }
+  , unobservable_{ aUnobservable }
+  , visited_(aSys.getStatesNumber(), false)
+  , cache_capacity_{ aCacheCapacity }
+  , cache_hits_{ 0ul }
+  , cache_misses_{ 0ul }
+{
+    reset();
+}
+
+template<class SysT>
+void
+op::StateEstimator<SysT>::reset() noexcept
+{
+    estimate_.clear();
+    auto const q0 = sys_.getInitialState();
+    visited_[q0] = true;
+    estimate_.push_back(q0);
+    closure_(estimate_);
+}
+
+template<class SysT>
+bool
+op::StateEstimator<SysT>::update(ScalarType const& aEvent) noexcept
+{
+    next_.clear();
+    for (StorageIndex q : estimate_) {
+        if (!sys_.containstrans(q, aEvent)) {
+            continue;
+        }
+        auto const qto = sys_.trans(q, aEvent);
+        if (qto < 0 || visited_[qto]) {
+            continue;
+        }
+        visited_[qto] = true;
+        next_.push_back(qto);
+    }
+    std::sort(next_.begin(), next_.end());
+    closure_(next_);
+    std::swap(estimate_, next_);
+    return !estimate_.empty();
+}
+
+template<class SysT>
+void
+op::StateEstimator<SysT>::closure_(Estimate_t& aStates) noexcept
+{
+    if (aStates.empty()) {
+        return;
+    }
+
+    auto const cached = cache_.find(aStates);
+    if (cached != cache_.end()) {
+        ++cache_hits_;
+        for (StorageIndex q : aStates) {
+            visited_[q] = false;
+        }
+        aStates = cached->second;
+        return;
+    }
+
+    ++cache_misses_;
+    if (aStates.size() > kMaxCachedEstimateSize || cache_capacity_ == 0ul) {
+        unobservableReach_(aStates);
+        return;
+    }
+    if (cache_.size() >= cache_capacity_) {
+        cache_.clear();
+    }
+    Estimate_t image{ aStates };
+    unobservableReach_(aStates);
+    cache_.emplace(std::move(image), aStates);
+}
+
+template<class SysT>
+void
+op::StateEstimator<SysT>::unobservableReach_(Estimate_t& aStates) noexcept
+{
+    stack_.assign(aStates.begin(), aStates.end());
+    auto const initial_size = aStates.size();
+    while (!stack_.empty()) {
+        auto const q = stack_.back();
+        stack_.pop_back();
+        auto q_events = sys_.getStateEvents(q) & unobservable_;
+        cldes::ScalarType event = 0;
+        while (q_events.any()) {
+            if (q_events.test(0)) {
+                auto const qto = sys_.trans(q, event);
+                if (qto >= 0 && !visited_[qto]) {
+                    visited_[qto] = true;
+                    aStates.push_back(qto);
+                    stack_.push_back(qto);
+                }
+            }
+            ++event;
+            q_events >>= 1;
+        }
+    }
+    if (aStates.size() != initial_size) {
+        auto const middle = aStates.begin() + initial_size;
+        std::sort(middle, aStates.end());
+        std::inplace_merge(aStates.begin(), middle, aStates.end());
+    }
+    for (StorageIndex q : aStates) {
+        visited_[q] = false;
+    }
+}
+}
@@ -0,0 +1,67 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: cldes/src/operations/StateEstimatorFwd.hpp
+ Description: StateEstimator includes and alias.
+ =========================================================================
+*/
+
+#include <algorithm>
+#include <boost/functional/hash.hpp>
+#include <sparsepp/spp.h>
+#include <vector>
+
+namespace cldes {
+namespace op {
+
+/*! \brief Default number of closures kept by a StateEstimator
+ */
+std::size_t const kDefaultEstimatorCacheCapacity = 4096ul;
+
+/*! \brief Largest image whose closure is cached
+ * \details Large estimates are rarely repeated and are expensive to keep.
+ */
+std::size_t const kMaxCachedEstimateSize = 1024ul;
+
+/*! \brief Hash of a sorted states vector
+ */
+template<typename StorageIndex>
+struct EstimateHash
+{
+    std::size_t operator()(StatesArray<StorageIndex> const& aStates) const
+      noexcept
+    {
+        return boost::hash_range(aStates.begin(), aStates.end());
+    }
+};
+
+/*! \brief Hash map: event image -> unobservable reach of the image
+ */
+template<typename StorageIndex>
+using EstimatesCache = spp::sparse_hash_map<StatesArray<StorageIndex>,
+                                            StatesArray<StorageIndex>,
+                                            EstimateHash<StorageIndex>>;
+}
+}
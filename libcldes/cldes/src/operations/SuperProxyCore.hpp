@@ -78,6 +78,8 @@ op::SuperProxy<SysT_l, SysT_r>::findRemovedStates_(
   SysT_r const& aE,
   EventsTableHost const& aNonContr) noexcept
 {
+    TraceSpan const span{ "supC.findRemovedStates" };
+    StatsPhase const phase{ "supC.findRemovedStates" };
     SyncSysProxy<SysT_l, SysT_r> virtualsys{ aP, aE };
     EventsSet<NEvents> non_contr_bit;
     EventsSet<NEvents> p_non_contr_bit;
@@ -93,9 +95,26 @@ op::SuperProxy<SysT_l, SysT_r>::findRemovedStates_(
     StatesStack<StorageIndex> f;
     f.push(virtualsys.init_state_);
     virtualsys.allocateInvertedGraph();
+    auto* const monitor = currentMonitor();
+    auto visited = 0ul;
+    auto popped = 0ul;
+    auto examined = 0ul;
+    auto probes = 0ul;
     while (!f.empty()) {
         auto const q = f.top();
         f.pop();
+        ++popped;
+        if (monitor != nullptr && ++visited % kMonitorBatch == 0ul &&
+            monitor->step(kMonitorBatch,
+                          f.size(),
+                          static_cast<int64_t>(
+                            kMonitorBatch * sizeof(StorageIndex)))) {
+            // Aborted: the caller discards the incomplete synthesis
+            this->states_number_ = c_.size();
+            virtualsys.clearInvertedGraph();
+            return;
+        }
+        probes += 2ul;
         if (!rmtable.contains(q) && !c_.contains(q)) {
             auto const qx = q % virtualsys.n_states_sys0_;
             auto const q_events = virtualsys.getStateEvents(q);
@@ -106,36 +125,125 @@ op::SuperProxy<SysT_l, SysT_r>::findRemovedStates_(
                 removeBadStates_(virtualsys, c_, q, non_contr_bit, rmtable);
             } else {
                 c_.insert(q);
-                cldes::ScalarType event = 0;
-                auto event_it = q_events;
-                while (event_it.any()) {
-                    if (event_it.test(0)) {
-                        auto const fsqe = virtualsys.trans(q, event);
-                        if (!rmtable.contains(fsqe)) {
-                            if (!c_.contains(fsqe)) {
-                                f.push(fsqe);
-                            }
-                            ++this->trans_number_;
-                        }
-                    }
-                    ++event;
-                    event_it >>= 1;
-                }
+                virtualsys.forEachSuccessor(
+                  q,
+                  [this, &f, &rmtable, &examined, &probes](
+                    ScalarType const, StorageIndex const aQto) {
+                      ++examined;
+                      ++probes;
+                      if (!rmtable.contains(aQto)) {
+                          ++probes;
+                          if (!c_.contains(aQto)) {
+                              f.push(aQto);
+                          }
+                          ++this->trans_number_;
+                      }
+                  });
             }
         } else if (rmtable.contains(q)) {
             --this->trans_number_;
         }
     }
+    phase.add(StatsCounter::kStatesVisited, popped);
+    phase.add(StatsCounter::kTransitionsExamined, examined);
+    phase.add(StatsCounter::kHashProbes, probes);
+    phase.add(StatsCounter::kHashInserts, c_.size());
+    phase.add(StatsCounter::kAllocatedBytes,
+              (c_.size() + rmtable.size()) * sizeof(StorageIndex));
+    phase.peak(c_.size() + rmtable.size());
     rmtable.clear();
     this->states_number_ = c_.size();
-    trim();
+
+    // Removing blocking states may uncover uncontrollable ones
+    while (true) {
+        auto blocking = removeBlocking_();
+        if (blocking.empty() ||
+            !removeUncontrollable_(
+              virtualsys, std::move(blocking), non_contr_bit)) {
+            break;
+        }
+    }
+    if (monitor == nullptr || !monitor->stopped()) {
+        removeInaccessible_();
+    }
     virtualsys.clearInvertedGraph();
     return;
 }
 
+template<class SysT_l, class SysT_r>
+bool
+op::SuperProxy<SysT_l, SysT_r>::removeUncontrollable_(
+  SyncSysProxy<SysT_l, SysT_r> const& aVirtualSys,
+  std::vector<StorageIndex>&& aRemoved,
+  EventsSet<NEvents> const& aNonContrBit) noexcept
+{
+    StatsPhase const phase{ "supC.removeBadStates" };
+    auto const alive = c_.size();
+    auto visited = 0ul;
+    auto examined = 0ul;
+    auto stack = std::move(aRemoved);
+    while (!stack.empty()) {
+        auto const x = stack.back();
+        stack.pop_back();
+        ++visited;
+        aVirtualSys.forEachPredecessor(
+          x,
+          aNonContrBit,
+          [this, &stack, &examined](ScalarType, StorageIndex const aQfrom) {
+              ++examined;
+              if (c_.erase(aQfrom) != 0ul) {
+                  stack.push_back(aQfrom);
+              }
+          });
+    }
+    phase.add(StatsCounter::kStatesVisited, visited);
+    phase.add(StatsCounter::kTransitionsExamined, examined);
+    phase.add(StatsCounter::kHashProbes, examined);
+    this->states_number_ = c_.size();
+    return c_.size() != alive;
+}
+
+template<class SysT_l, class SysT_r>
+void
+op::SuperProxy<SysT_l, SysT_r>::removeInaccessible_() noexcept
+{
+    StatesTableHost<StorageIndex> accessible;
+    StatesStack<StorageIndex> f;
+    if (c_.contains(this->init_state_)) {
+        accessible.insert(this->init_state_);
+        f.push(this->init_state_);
+    }
+    while (!f.empty()) {
+        auto const q = f.top();
+        f.pop();
+        this->forEachSuccessor(
+          q,
+          [this, &accessible, &f](ScalarType, StorageIndex const aQto) {
+              if (c_.contains(aQto) && !accessible.contains(aQto)) {
+                  accessible.insert(aQto);
+                  f.push(aQto);
+              }
+          });
+    }
+    if (accessible.size() != c_.size()) {
+        c_ = std::move(accessible);
+        this->states_number_ = c_.size();
+    }
+}
+
+template<class SysT_l, class SysT_r>
+MemoryUsage
+op::SuperProxy<SysT_l, SysT_r>::memoryUsage_impl() const noexcept
+{
+    auto usage = this->baseMemoryUsage_();
+    usage.tables = vectorBytes_(virtual_states_) + hashBytes_(c_);
+    return usage;
+}
+
 template<class SysT_l, class SysT_r>
 op::SuperProxy<SysT_l, SysT_r>::operator RealSys() noexcept
 {
+    TraceSpan const span{ "supC.materialize" };
     virtual_states_ = StatesTable{ c_.begin(), c_.end() };
     std::sort(virtual_states_.begin(), virtual_states_.end());
     auto sys_ptr = std::make_shared<RealSys>(RealSys{});
@@ -160,6 +268,7 @@ void
 op::SuperProxy<SysT_l, SysT_r>::supCStage2_(
   std::shared_ptr<RealSys> const& aSysPtr) noexcept
 {
+    TraceSpan const span{ "supC.stage2" };
     SparseStatesMap_t statesmap;
     this->setStatesNumber(virtual_states_.size());
 
@@ -173,6 +282,8 @@ op::SuperProxy<SysT_l, SysT_r>::supCStage2_(
     }
     // TODO: Remove the following line?
     this->setInitialState(statesmap[0]);
+    // Marked states of the proxy are indexes of the product
+    this->marked_states_.clear();
     for (StorageIndex s0 : sys0_.getMarkedStates()) {
         for (StorageIndex s1 : sys1_.getMarkedStates()) {
             StorageIndex const key = s1 * n_states_sys0_ + s0;
@@ -192,50 +303,58 @@ op::SuperProxy<SysT_l, SysT_r>::processVirtSys_(
   SparseStatesMap_t&& aStatesMap) noexcept
 {
     uint8_t static constexpr NEvents = SysTraits<SysT_l>::Ne_;
-#ifdef CLDES_OPENMP_ENABLED
-    std::vector<Triplet<NEvents>> triplet;
-#pragma omp parallel
-    {
-        std::vector<Triplet<NEvents>> triplet_parallel;
-#pragma omp for nowait collapse(2)
-        for (auto qit = 0ul; qit < this->states_number_; ++qit) {
-            for (ScalarType e = 0; e < NEvents; ++e) {
-                auto const q = virtual_states_[qit];
-                if (getStateEvents_impl(q).test(e)) {
-                    auto const qto = trans_impl(q, e);
-                    if (aStatesMap.contains(qto)) {
-                        triplet_parallel.push_back(
-                          Triplet<NEvents>{ aStatesMap[q],
-                                            aStatesMap[qto],
-                                            EventsSet<NEvents>{ 1ul << e } });
+    StatsPhase const phase{ "supC.materialize" };
+
+    // The map is only read from now on: find() does not insert
+    SparseStatesMap_t const& states_map = aStatesMap;
+    auto& executor = backend::currentExecutor();
+    std::vector<std::vector<Triplet<NEvents>>> triplets(
+      executor.concurrency());
+    executor.parallelFor(
+      0ul,
+      this->states_number_,
+      [this, &states_map, &triplets, &phase](std::size_t const aBegin,
+                                             std::size_t const aEnd,
+                                             unsigned const aWorker) {
+          TraceSpan const range_span{ "supC.materialize.range" };
+          auto& triplet = triplets[aWorker];
+          auto const triplet_size = triplet.size();
+          auto probes = aEnd - aBegin;
+          for (auto qit = aBegin; qit < aEnd; ++qit) {
+              auto const q = virtual_states_[qit];
+              auto const qmapped = states_map.find(q)->second;
+              this->forEachSuccessor(
+                q,
+                [&states_map, &triplet, &probes, qmapped](
+                  ScalarType const aEvent, StorageIndex const aQto) {
+                    ++probes;
+                    auto const qto_it = states_map.find(aQto);
+                    if (qto_it != states_map.end()) {
+                        EventsSet<NEvents> event_set;
+                        event_set.set(aEvent);
+                        triplet.push_back(Triplet<NEvents>(
+                          qmapped, qto_it->second, event_set));
                     }
-                }
-            }
-        }
-#pragma omp critical
+                });
+          }
+          auto const new_triplets = triplet.size() - triplet_size;
+          phase.add(StatsCounter::kStatesVisited, aEnd - aBegin);
+          phase.add(StatsCounter::kTransitionsExamined,
+                    probes - (aEnd - aBegin));
+          phase.add(StatsCounter::kHashProbes, probes);
+          phase.add(StatsCounter::kAllocatedBytes,
+                    new_triplets * sizeof(Triplet<NEvents>));
+      });
+
+    // Duplicated entries are summed: events sets are joined
+    std::vector<Triplet<NEvents>> triplet;
+    for (auto& worker_triplet : triplets) {
         triplet.insert(
-          triplet.end(), triplet_parallel.begin(), triplet_parallel.end());
+          triplet.end(), worker_triplet.begin(), worker_triplet.end());
     }
+    phase.peak(triplet.size());
+    TraceSpan const set_span{ "supC.setFromTriplets" };
     aSysPtr->graph_.setFromTriplets(triplet.begin(), triplet.end());
-#else
-    for (auto q : virtual_states_) {
-        ScalarType event = 0;
-        auto q_events = getStateEvents_impl(q);
-        while (q_events.any()) {
-            if (q_events.test(0)) {
-                auto qto = trans_impl(q, event);
-                if (qto != -1 && aStatesMap.contains(qto)) {
-                    EventsSet<NEvents> const last_value =
-                      aSysPtr->graph_.coeff(aStatesMap[q], aStatesMap[qto]);
-                    aSysPtr->graph_.coeffRef(aStatesMap[q], aStatesMap[qto]) =
-                      EventsSet<NEvents>{ 1ul << event } | last_value;
-                }
-            }
-            ++event;
-            q_events >>= 1;
-        }
-    }
-#endif
     return;
 }
 
@@ -361,6 +480,92 @@ op::SuperProxy<SysT_l, SysT_r>::invtrans_impl(StorageIndex const& aQ,
     return inv_transitions;
 }
 
+template<class SysT_l, class SysT_r>
+template<class Function>
+void
+op::SuperProxy<SysT_l, SysT_r>::forEachSuccessor_impl(
+  StorageIndex const& aQ,
+  Function& aFunction) const
+{
+    if (!this->c_.contains(aQ)) {
+        return;
+    }
+    // q = (qx, qy)
+    auto const qx = aQ % n_states_sys0_;
+    auto const qy = aQ / n_states_sys0_;
+    sys0_.forEachSuccessor(
+      qx, [this, &aFunction, qy](ScalarType const aEvent, StorageIndex aQ0) {
+          if (only_in_plant_.test(aEvent)) {
+              aFunction(aEvent, qy * n_states_sys0_ + aQ0);
+              return;
+          }
+          auto const q1 = sys1_.trans(qy, aEvent);
+          if (q1 >= 0) {
+              aFunction(aEvent, q1 * n_states_sys0_ + aQ0);
+          }
+      });
+    if ((only_in_spec_ & sys1_.getStateEvents(qy)).none()) {
+        return;
+    }
+    sys1_.forEachSuccessor(
+      qy, [this, &aFunction, qx](ScalarType const aEvent, StorageIndex aQ1) {
+          if (only_in_spec_.test(aEvent)) {
+              aFunction(aEvent, aQ1 * n_states_sys0_ + qx);
+          }
+      });
+}
+
+template<class SysT_l, class SysT_r>
+template<class Function>
+void
+op::SuperProxy<SysT_l, SysT_r>::forEachPredecessor_impl(
+  StorageIndex const& aQ,
+  EventsSet<NEvents> const& aEvents,
+  Function& aFunction) const
+{
+    if (!this->c_.contains(aQ)) {
+        return;
+    }
+    // q = (qx, qy)
+    auto const qx = aQ % n_states_sys0_;
+    auto const qy = aQ / n_states_sys0_;
+    auto const events = aEvents & this->events_;
+    auto const inv_events_1 = sys1_.getInvStateEvents(qy);
+
+    // Shared events are only visited when both components have them
+    auto const shared =
+      events & inv_events_1 & ~(only_in_plant_ | only_in_spec_);
+    auto const events_0 = (events & only_in_plant_) | shared;
+    if (events_0.any()) {
+        sys0_.forEachPredecessor(
+          qx,
+          events_0,
+          [this, &aFunction, qy](ScalarType const aEvent, StorageIndex aQ0) {
+              if (only_in_plant_.test(aEvent)) {
+                  aFunction(aEvent, qy * n_states_sys0_ + aQ0);
+                  return;
+              }
+              EventsSet<NEvents> event;
+              event.set(aEvent);
+              sys1_.forEachPredecessor(
+                qy,
+                event,
+                [this, &aFunction, aQ0](ScalarType const aE, StorageIndex aQ1) {
+                    aFunction(aE, aQ1 * n_states_sys0_ + aQ0);
+                });
+          });
+    }
+    auto const events_1 = events & only_in_spec_ & inv_events_1;
+    if (events_1.any()) {
+        sys1_.forEachPredecessor(
+          qy,
+          events_1,
+          [this, &aFunction, qx](ScalarType const aEvent, StorageIndex aQ1) {
+              aFunction(aEvent, aQ1 * n_states_sys0_ + qx);
+          });
+    }
+}
+
 template<class SysT_l, class SysT_r>
 typename op::SuperProxy<SysT_l, SysT_r>::EventsSet_t
 op::SuperProxy<SysT_l, SysT_r>::getStateEvents_impl(
@@ -407,35 +612,72 @@ template<class SysT_l, class SysT_r>
 void
 op::SuperProxy<SysT_l, SysT_r>::trim() noexcept
 {
+    removeBlocking_();
+}
+
+template<class SysT_l, class SysT_r>
+std::vector<typename op::SuperProxy<SysT_l, SysT_r>::StorageIndex>
+op::SuperProxy<SysT_l, SysT_r>::removeBlocking_() noexcept
+{
+    TraceSpan const span{ "supC.trim" };
+    StatsPhase const phase{ "supC.trim" };
     StatesTableHost<StorageIndex> trimmed_virtual_states;
+    auto* const monitor = currentMonitor();
+    auto visited = 0ul;
+    auto popped = 0ul;
+    auto examined = 0ul;
+    auto probes = 0ul;
+    std::vector<StorageIndex> removed;
     for (auto mstate : this->marked_states_) {
+        // Marked states of the product may have been removed
+        if (!c_.contains(mstate) ||
+            trimmed_virtual_states.contains(mstate)) {
+            continue;
+        }
         StatesStack<StorageIndex> f;
         f.push(mstate);
         while (!f.empty()) {
             auto const q = f.top();
             f.pop();
+            if (monitor != nullptr && ++visited % kMonitorBatch == 0ul &&
+                monitor->step(kMonitorBatch,
+                              f.size(),
+                              static_cast<int64_t>(
+                                kMonitorBatch * sizeof(StorageIndex)))) {
+                return removed;
+            }
+            ++popped;
             trimmed_virtual_states.insert(q);
-            auto const q_events = this->getInvStateEvents(q);
-            cldes::ScalarType event = 0;
-            auto event_it = q_events;
-            while (event_it.any()) {
-                if (event_it.test(0)) {
-                    auto const fsqelist = this->invtrans(q, event);
-                    for (auto fsqe : fsqelist) {
-                        if (c_.contains(fsqe)) {
-                            if (!trimmed_virtual_states.contains(fsqe)) {
-                                f.push(fsqe);
-                            }
-                        }
-                    }
-                }
-                ++event;
-                event_it >>= 1;
+            this->forEachPredecessor(
+              q,
+              this->events_,
+              [this, &trimmed_virtual_states, &f, &examined, &probes](
+                ScalarType, StorageIndex const aQfrom) {
+                  ++examined;
+                  auto const in_c = c_.contains(aQfrom);
+                  probes += in_c ? 2ul : 1ul;
+                  if (in_c && !trimmed_virtual_states.contains(aQfrom)) {
+                      f.push(aQfrom);
+                  }
+              });
+        }
+    }
+    phase.add(StatsCounter::kStatesVisited, popped);
+    phase.add(StatsCounter::kTransitionsExamined, examined);
+    phase.add(StatsCounter::kHashProbes, probes);
+    phase.add(StatsCounter::kHashInserts, popped);
+    phase.add(StatsCounter::kAllocatedBytes,
+              trimmed_virtual_states.size() * sizeof(StorageIndex));
+    phase.peak(trimmed_virtual_states.size());
+    if (trimmed_virtual_states.size() != c_.size()) {
+        for (auto q : c_) {
+            if (!trimmed_virtual_states.contains(q)) {
+                removed.push_back(q);
             }
         }
+        c_ = std::move(trimmed_virtual_states);
     }
-    c_ = trimmed_virtual_states;
     this->states_number_ = c_.size();
-    return;
+    return removed;
 }
 }
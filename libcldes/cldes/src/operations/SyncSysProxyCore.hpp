@@ -62,9 +62,18 @@ op::SyncSysProxy<SysT_l, SysT_r>::SyncSysProxy(SysT_l const& aSys0,
 }
 
 template<class SysT_l, class SysT_r>
-op::SyncSysProxy<SysT_l, SysT_r>::operator RealSys() noexcept
+MemoryUsage
+op::SyncSysProxy<SysT_l, SysT_r>::memoryUsage_impl() const noexcept
 {
+    auto usage = this->baseMemoryUsage_();
+    usage.tables = vectorBytes_(virtual_states_) + vectorBytes_(triplet_);
+    return usage;
+}
 
+template<class SysT_l, class SysT_r>
+op::SyncSysProxy<SysT_l, SysT_r>::operator RealSys() noexcept
+{
+    TraceSpan const span{ "synchronize" };
     synchronizeEmptyStage2(*this);
     auto sys_ptr = std::make_shared<RealSys>(RealSys{});
 
@@ -75,10 +84,14 @@ op::SyncSysProxy<SysT_l, SysT_r>::operator RealSys() noexcept
     sys_ptr->inv_states_events_ = std::move(this->inv_states_events_);
     sys_ptr->events_ = std::move(this->events_);
     sys_ptr->trans_number_ = this->trans_number_;
-    sys_ptr->graph_.resize(this->states_number_, this->states_number_);
-    sys_ptr->graph_.setFromTriplets(triplet_.begin(), triplet_.end());
-    triplet_.clear();
-    sys_ptr->graph_.makeCompressed();
+    {
+        // Serial tail of the conversion
+        TraceSpan const span{ "synchronize.setFromTriplets" };
+        sys_ptr->graph_.resize(this->states_number_, this->states_number_);
+        sys_ptr->graph_.setFromTriplets(triplet_.begin(), triplet_.end());
+        triplet_.clear();
+        sys_ptr->graph_.makeCompressed();
+    }
 
     return *sys_ptr;
 }
@@ -204,6 +217,85 @@ op::SyncSysProxy<SysT_l, SysT_r>::invtrans_impl(StorageIndex const& aQ,
     return inv_transitions;
 }
 
+template<class SysT_l, class SysT_r>
+template<class Function>
+void
+op::SyncSysProxy<SysT_l, SysT_r>::forEachSuccessor_impl(
+  StorageIndex const& aQ,
+  Function& aFunction) const
+{
+    // q = (qx, qy)
+    auto const qx = aQ % n_states_sys0_;
+    auto const qy = aQ / n_states_sys0_;
+    sys0_.forEachSuccessor(
+      qx, [this, &aFunction, qy](ScalarType const aEvent, StorageIndex aQ0) {
+          if (only_in_0_.test(aEvent)) {
+              aFunction(aEvent, qy * n_states_sys0_ + aQ0);
+              return;
+          }
+          auto const q1 = sys1_.trans(qy, aEvent);
+          if (q1 >= 0) {
+              aFunction(aEvent, q1 * n_states_sys0_ + aQ0);
+          }
+      });
+    if ((only_in_1_ & sys1_.getStateEvents(qy)).none()) {
+        return;
+    }
+    sys1_.forEachSuccessor(
+      qy, [this, &aFunction, qx](ScalarType const aEvent, StorageIndex aQ1) {
+          if (only_in_1_.test(aEvent)) {
+              aFunction(aEvent, aQ1 * n_states_sys0_ + qx);
+          }
+      });
+}
+
+template<class SysT_l, class SysT_r>
+template<class Function>
+void
+op::SyncSysProxy<SysT_l, SysT_r>::forEachPredecessor_impl(
+  StorageIndex const& aQ,
+  EventsSet<NEvents> const& aEvents,
+  Function& aFunction) const
+{
+    // q = (qx, qy)
+    auto const qx = aQ % n_states_sys0_;
+    auto const qy = aQ / n_states_sys0_;
+    auto const events = aEvents & this->events_;
+    auto const inv_events_1 = sys1_.getInvStateEvents(qy);
+
+    // Shared events are only visited when both components have them
+    auto const shared = events & inv_events_1 & ~(only_in_0_ | only_in_1_);
+    auto const events_0 = (events & only_in_0_) | shared;
+    if (events_0.any()) {
+        sys0_.forEachPredecessor(
+          qx,
+          events_0,
+          [this, &aFunction, qy](ScalarType const aEvent, StorageIndex aQ0) {
+              if (only_in_0_.test(aEvent)) {
+                  aFunction(aEvent, qy * n_states_sys0_ + aQ0);
+                  return;
+              }
+              EventsSet<NEvents> event;
+              event.set(aEvent);
+              sys1_.forEachPredecessor(
+                qy,
+                event,
+                [this, &aFunction, aQ0](ScalarType const aE, StorageIndex aQ1) {
+                    aFunction(aE, aQ1 * n_states_sys0_ + aQ0);
+                });
+          });
+    }
+    auto const events_1 = events & only_in_1_ & inv_events_1;
+    if (events_1.any()) {
+        sys1_.forEachPredecessor(
+          qy,
+          events_1,
+          [this, &aFunction, qx](ScalarType const aEvent, StorageIndex aQ1) {
+              aFunction(aEvent, aQ1 * n_states_sys0_ + qx);
+          });
+    }
+}
+
 template<class SysT_l, class SysT_r>
 EventsSet<op::SyncSysProxy<SysT_l, SysT_r>::NEvents>
 op::SyncSysProxy<SysT_l, SysT_r>::getStateEvents_impl(
@@ -0,0 +1,165 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: tests/async.cpp
+ Description: Test asynchronous operations, cancellation and budgets.
+ =========================================================================
+*/
+
+
+#include "cldes/DESystem.hpp"
+#include "cldes/operations/Async.hpp"
+#include "testlib.hpp"
+#include <atomic>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+template<class FutureT>
+static cldes::AbortReason
+AbortReasonOf(FutureT&& aFuture, cldes::OperationProgress& aProgress)
+{
+    try {
+        aFuture.get();
+    } catch (cldes::op::OperationAborted const& e) {
+        std::cout << "    " << e.what() << " after "
+                  << e.progress().states_explored << " states" << std::endl;
+        aProgress = e.progress();
+        return e.reason();
+    }
+    return cldes::AbortReason::kNone;
+}
+
+int
+main()
+{
+    using StorageIndex = unsigned;
+
+    cldes::ScalarType const a0 = 0;
+    cldes::ScalarType const a1 = 1;
+    cldes::ScalarType const b0 = 2;
+    cldes::ScalarType const b1 = 3;
+
+    cldes::DESystem<4u>::EventsTable non_contr;
+    non_contr.insert(b0);
+    non_contr.insert(b1);
+
+    std::set<StorageIndex> plant_marked_states = { 0 };
+    cldes::DESystem<4u> plant{ 4, 0, plant_marked_states };
+    plant(0, 1) = a0;
+    plant(0, 2) = a1;
+    plant(1, 0) = b0;
+    plant(1, 3) = a1;
+    plant(2, 0) = b1;
+    plant(2, 3) = a0;
+    plant(3, 1) = b1;
+    plant(3, 2) = b0;
+
+    std::set<StorageIndex> spec_marked_states = { 0, 1 };
+    cldes::DESystem<4u> spec{ 2, 0, spec_marked_states };
+    spec(0, 1) = b0;
+    spec(1, 0) = a1;
+
+    std::cout << "Futures hold the same results" << std::endl;
+    auto supervisor_future = cldes::op::supCAsync(plant, spec, non_contr);
+    auto sync_future = cldes::op::synchronizeAsync(plant, spec);
+    auto const supervisor = supervisor_future.get();
+    assert(supervisor == cldes::op::supC(plant, spec, non_contr));
+    assert(sync_future.get() == cldes::op::synchronize(plant, spec));
+
+    std::ostringstream expected_result;
+    expected_result << "0 1 0 0 0 0 " << std::endl;
+    expected_result << "0 0 0 0 4 0 " << std::endl;
+    expected_result << "8 0 0 1 0 0 " << std::endl;
+    expected_result << "0 8 0 0 0 4 " << std::endl;
+    expected_result << "0 0 2 0 0 0 " << std::endl;
+    expected_result << "0 0 0 0 8 0 " << std::endl;
+    expected_result << ">" << std::endl;
+    ProcessResult(
+      supervisor.getGraph(), "< Async supervisor", expected_result.str().c_str());
+
+    // Two cycles with independent events: their product has 1M states
+    StorageIndex const n_states = 1000u;
+    std::set<StorageIndex> cycle_marked_states = { 0 };
+    cldes::DESystem<4u> cycle0{ n_states, 0, cycle_marked_states };
+    cldes::DESystem<4u> cycle1{ n_states, 0, cycle_marked_states };
+    for (StorageIndex q = 0u; q < n_states; ++q) {
+        cycle0(q, (q + 1u) % n_states) = a0;
+        cycle1(q, (q + 1u) % n_states) = a1;
+    }
+
+    cldes::OperationProgress progress;
+
+    std::cout << "Cancellation" << std::endl;
+    cldes::op::AsyncOptions cancelled;
+    cancelled.token.cancel();
+    assert(AbortReasonOf(cldes::op::synchronizeAsync(cycle0, cycle1, cancelled),
+                         progress) == cldes::AbortReason::kCancelled);
+    assert(progress.states_explored < n_states * n_states);
+
+    std::cout << "Memory budget" << std::endl;
+    cldes::op::AsyncOptions small_memory;
+    small_memory.budget.memory_bytes = 1024ul;
+    assert(AbortReasonOf(
+             cldes::op::supCAsync(cycle0, cycle1, non_contr, small_memory),
+             progress) == cldes::AbortReason::kMemoryBudget);
+    assert(progress.memory_bytes > 1024ul);
+    assert(progress.states_explored < n_states * n_states);
+
+    std::cout << "Time budget" << std::endl;
+    cldes::op::AsyncOptions short_time;
+    short_time.budget.time = std::chrono::milliseconds{ 1 };
+    short_time.progress_interval = 256ul;
+    assert(AbortReasonOf(
+             cldes::op::supCAsync(cycle0, cycle1, non_contr, short_time),
+             progress) == cldes::AbortReason::kTimeBudget);
+    assert(progress.elapsed.count() >= 1);
+
+    std::cout << "Progress reports" << std::endl;
+    std::atomic<unsigned> reports{ 0u };
+    std::atomic<uint64_t> last_states{ 0ul };
+    cldes::op::AsyncOptions reported;
+    reported.on_progress = [&](cldes::OperationProgress const& aProgress) {
+        assert(aProgress.states_explored >= last_states.load());
+        last_states = aProgress.states_explored;
+        ++reports;
+    };
+    auto const product =
+      cldes::op::synchronizeAsync(cycle0, cycle1, reported).get();
+    assert(product.size() == n_states * n_states);
+    assert(reports.load() > 1u);
+    assert(last_states.load() == n_states * n_states);
+
+    std::cout << "Asynchronous trim" << std::endl;
+    std::set<StorageIndex> trim_marked_states = { 1 };
+    cldes::DESystem<4u> untrimmed{ 3, 0, trim_marked_states };
+    untrimmed(0, 1) = a0;
+    untrimmed(1, 0) = b0;
+    untrimmed(0, 2) = a1;
+    auto const trimmed = cldes::op::trimAsync(untrimmed).get();
+    assert(trimmed.size() == 2u);
+
+    return 0;
+}
@@ -33,6 +33,7 @@
 #include <iostream>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "testlib.hpp"
 
@@ -94,6 +95,29 @@ main()
     ProcessResult(trimstates, "< trim states", "0 1 2 >");
     std::cout << "trim time: " << duration << " microseconds" << std::endl;
 
+    std::cout << "Creating the system from its transitions" << std::endl;
+
+    using Triplet = cldes::DESystem<3>::Triplet_t;
+    cldes::EventsSet<3> const ea{ 1ul << a };
+    cldes::EventsSet<3> const eb{ 1ul << b };
+    cldes::EventsSet<3> const eg{ 1ul << g };
+    std::vector<Triplet> const transitions{
+        Triplet(0, 0, ea), Triplet(0, 2, eg), Triplet(1, 0, ea),
+        Triplet(1, 1, eb), Triplet(2, 1, ea), Triplet(2, 1, eg),
+        Triplet(2, 2, eb), Triplet(2, 3, ea)
+    };
+    cldes::DESystem<3> bulk_sys{
+        n_states, init_state, marked_states, transitions
+    };
+
+    assert(ReadResult(bulk_sys.getGraph(), "") == ReadResult(graph, ""));
+    for (auto q = 0; q < n_states; ++q) {
+        assert(bulk_sys.getStateEvents(q) == sys.getStateEvents(q));
+        assert(bulk_sys.getInvStateEvents(q) == sys.getInvStateEvents(q));
+    }
+    assert(bulk_sys.getEvents() == sys.getEvents());
+    ProcessResult(bulk_sys.trimStates(), "< trim states", "0 1 2 >");
+
     std::cout << "Creating new system" << std::endl;
 
     cldes::DESystem<3> new_sys{ n_states, init_state, marked_states };
@@ -30,6 +30,8 @@
 
 #include "cldes/DESystem.hpp"
 #include "cldes/DESystemCL.hpp"
+#include "cldes/operations/Operations.hpp"
+#include "clustertool.hpp"
 #include <iostream>
 #include <set>
 #include <string>
@@ -97,5 +99,72 @@ main()
 
     ProcessResult(new_coaccessible_states, "< Coaccessible part", "0 2 3 >");
 
+    std::cout << "Transitions on the accelerator graph" << std::endl;
+    assert(sys_gpu.trans(2, g) == 1);
+    assert(sys_gpu.trans(0, a) == 0);
+    assert(sys_gpu.trans(3, a) == -1);
+    assert(sys_gpu.containstrans(1, b));
+    sys_gpu.allocateInvertedGraph();
+    ProcessResult(sys_gpu.invtrans(1, a), "< Inverse transition", "2 >");
+    ProcessResult(sys_gpu.trimStates(), "< Trim states", "0 1 2 >");
+
+    std::cout << "Round trip to host memory" << std::endl;
+    assert(sys_gpu.toDESystem() == sys);
+    assert(ReadResult(sys_gpu.toDESystem().getGraph(), "") ==
+           ReadResult(sys.getGraph(), ""));
+
+    std::cout << "Synchronize with the join kernel" << std::endl;
+    cldes::DESystem<3>::StatesSet machine_marked = { 0 };
+    cldes::DESystem<3> machine{ 2, 0, machine_marked };
+    machine(0, 1) = a;
+    machine(1, 0) = b;
+    cldes::DESystem<3>::StatesSet buffer_marked = { 0, 1 };
+    cldes::DESystem<3> buffer{ 2, 0, buffer_marked };
+    buffer(0, 1) = b;
+    buffer(1, 0) = g;
+
+    auto const sync_host = cldes::op::synchronize(machine, buffer);
+    auto const sync_gpu = cldes::op::synchronize(
+      cldes::DESystemCL<3>{ machine }, cldes::DESystemCL<3>{ buffer });
+    assert(sync_gpu.size() == sync_host.size());
+    assert(sync_gpu.getInitialState() == sync_host.getInitialState());
+    assert(sync_gpu.getMarkedStates() == sync_host.getMarkedStates());
+    assert(ReadResult(sync_gpu.toDESystem().getGraph(), "") ==
+           ReadResult(sync_host.getGraph(), ""));
+
+    std::cout << "Synchronize ClusterTool(2) plants" << std::endl;
+    std::vector<cldes::DESystem<40>> plants;
+    std::vector<cldes::DESystem<40>> specs;
+    cldes::DESystem<40>::EventsTable non_contr;
+    ClusterTool(2, plants, specs, non_contr);
+    auto plant_host = plants[0ul];
+    cldes::DESystemCL<40> plant_gpu{ plants[0ul] };
+    for (auto i = 1ul; i < plants.size(); ++i) {
+        plant_host = cldes::op::synchronize(
+          cldes::DESystem<40>{ plant_host }, plants[i]);
+        plant_gpu = cldes::op::synchronize(
+          plant_gpu, cldes::DESystemCL<40>{ plants[i] });
+    }
+    assert(plant_gpu.size() == plant_host.size());
+    assert(plant_gpu.getGraph().nonZeros() ==
+           static_cast<std::size_t>(plant_host.getGraph().nonZeros()));
+    assert(plant_gpu.toDESystem() == plant_host);
+    assert(ReadResult(plant_gpu.toDESystem().getGraph(), "") ==
+           ReadResult(plant_host.getGraph(), ""));
+
+    std::cout << "Accelerator systems as supC operands" << std::endl;
+    auto spec_host = specs[0ul];
+    for (auto i = 1ul; i < specs.size(); ++i) {
+        spec_host = cldes::op::synchronize(cldes::DESystem<40>{ spec_host },
+                                           specs[i]);
+    }
+    cldes::DESystemCL<40> spec_gpu{ spec_host };
+    plant_gpu.allocateInvertedGraph();
+    spec_gpu.allocateInvertedGraph();
+    auto const supervisor_host =
+      cldes::op::supC(plant_host, spec_host, non_contr);
+    auto const supervisor_gpu = cldes::op::supC(plant_gpu, spec_gpu, non_contr);
+    assert(supervisor_gpu == supervisor_host);
+
     return 0;
 }
@@ -0,0 +1,143 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: tests/concurrent_states_table.cpp
+ Description: Test the lock-free visited states table.
+ =========================================================================
+*/
+
+
+#include "cldes/ConcurrentStatesTable.hpp"
+#include "cldes/backend/Executor.hpp"
+#include "testlib.hpp"
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+int
+main()
+{
+    using StorageIndex = unsigned;
+
+    cldes::backend::ExecutorOptions options;
+    options.threads = 3u;
+    options.grain = 64ul;
+    cldes::backend::ThreadPoolExecutor pool{ options };
+    cldes::backend::ScopedExecutor const scope{ pool };
+
+    // Every state is inserted twice, by different ranges
+    std::size_t const n_states = 100000ul;
+    auto const key_of = [](std::size_t const aI) {
+        return static_cast<StorageIndex>((aI % n_states) * 7ul + 3ul);
+    };
+
+    std::cout << "Concurrent inserts with growth" << std::endl;
+    cldes::ConcurrentStatesTable<StorageIndex> table{ 16ul };
+    std::atomic<std::size_t> inserted{ 0ul };
+    pool.parallelFor(
+      0ul,
+      2ul * n_states,
+      [&](std::size_t const aBegin, std::size_t const aEnd, unsigned const) {
+          for (auto i = aBegin; i < aEnd; ++i) {
+              if (table.insert(key_of(i))) {
+                  ++inserted;
+              }
+          }
+      });
+    assert(inserted.load() == n_states);
+    assert(table.size() == n_states);
+    assert(table.capacity() >= 2ul * n_states);
+    for (auto i = 0ul; i < n_states; ++i) {
+        assert(table.contains(key_of(i)));
+        assert(!table.contains(key_of(i) + 1u));
+    }
+    std::size_t visited = 0ul;
+    table.forEach([&visited](StorageIndex const aKey) {
+        assert((aKey - 3u) % 7u == 0u);
+        ++visited;
+    });
+    assert(visited == n_states);
+
+    std::cout << "Compact ids" << std::endl;
+    cldes::ConcurrentStatesTable<StorageIndex> ids{ 16ul, true };
+    std::vector<std::atomic<unsigned>> id_hits(n_states);
+    for (auto& hit : id_hits) {
+        hit.store(0u);
+    }
+    pool.parallelFor(
+      0ul,
+      2ul * n_states,
+      [&](std::size_t const aBegin, std::size_t const aEnd, unsigned const) {
+          for (auto i = aBegin; i < aEnd; ++i) {
+              auto const result = ids.insertWithId(key_of(i));
+              assert(result.first < n_states);
+              if (result.second) {
+                  ++id_hits[result.first];
+              }
+              assert(ids.find(key_of(i)) == result.first);
+          }
+      });
+    for (auto& hit : id_hits) {
+        assert(hit.load() == 1u);
+    }
+    assert(ids.find(1u) ==
+           cldes::ConcurrentStatesTable<StorageIndex>::kNoValue);
+    ids.forEachId([&ids](StorageIndex const aKey, uint64_t const aId) {
+        assert(ids.find(aKey) == aId);
+    });
+
+    std::cout << "Ids of states inserted without id" << std::endl;
+    cldes::ConcurrentStatesTable<StorageIndex> mixed{ 16ul, true };
+    assert(mixed.insert(5u));
+    assert(!mixed.insert(5u));
+    assert(mixed.find(5u) == 0ul);
+    assert(mixed.insertWithId(5u) == std::make_pair(uint64_t{ 0ul }, false));
+    assert(mixed.insertWithId(6u) == std::make_pair(uint64_t{ 1ul }, true));
+
+    std::cout << "Table without ids" << std::endl;
+    auto thrown = false;
+    try {
+        table.insertWithId(key_of(0ul));
+    } catch (std::logic_error const&) {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(table.find(key_of(0ul)) ==
+           cldes::ConcurrentStatesTable<StorageIndex>::kNoValue);
+
+    std::cout << "Reserved table does not grow" << std::endl;
+    cldes::ConcurrentStatesTable<StorageIndex> reserved;
+    reserved.reserve(n_states);
+    auto const capacity = reserved.capacity();
+    for (auto i = 0ul; i < n_states; ++i) {
+        reserved.insert(key_of(i));
+    }
+    assert(reserved.capacity() == capacity);
+    assert(reserved.size() == n_states);
+
+    return 0;
+}
@@ -0,0 +1,204 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: tests/executor.cpp
+ Description: Test the executors which run the parallel loops.
+ =========================================================================
+*/
+
+
+#include "cldes/DESystem.hpp"
+#include "cldes/backend/Executor.hpp"
+#include "cldes/operations/Operations.hpp"
+#include "testlib.hpp"
+#include <atomic>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static void
+CheckCoverage(cldes::backend::Executor& aExecutor, std::size_t const aSize)
+{
+    std::vector<std::atomic<unsigned>> hits(aSize);
+    for (auto& hit : hits) {
+        hit.store(0u);
+    }
+    std::vector<unsigned long> per_worker(aExecutor.concurrency(), 0ul);
+    aExecutor.parallelFor(
+      0ul,
+      aSize,
+      [&](std::size_t const aBegin,
+          std::size_t const aEnd,
+          unsigned const aWorker) {
+          assert(aWorker < aExecutor.concurrency());
+          for (auto i = aBegin; i < aEnd; ++i) {
+              ++hits[i];
+              ++per_worker[aWorker];
+          }
+      },
+      7ul);
+    for (auto& hit : hits) {
+        assert(hit.load() == 1u);
+    }
+    unsigned long total = 0ul;
+    for (auto n : per_worker) {
+        total += n;
+    }
+    assert(total == aSize);
+}
+
+int
+main()
+{
+    using StorageIndex = unsigned;
+
+    cldes::backend::SerialExecutor serial;
+    cldes::backend::ExecutorOptions options;
+    options.threads = 3u;
+    options.grain = 1ul;
+    cldes::backend::ThreadPoolExecutor pool{ options };
+    assert(pool.concurrency() == 4u);
+
+    std::cout << "Every iteration runs once" << std::endl;
+    CheckCoverage(serial, 1000ul);
+    CheckCoverage(pool, 1000ul);
+    CheckCoverage(pool, 3ul);
+    CheckCoverage(pool, 0ul);
+#ifdef CLDES_OPENMP_ENABLED
+    cldes::backend::OpenMPExecutor openmp{ 2u };
+    CheckCoverage(openmp, 1000ul);
+#endif
+
+    std::cout << "Nested loops" << std::endl;
+    std::atomic<unsigned long> nested_sum{ 0ul };
+    pool.parallelFor(
+      0ul, 16ul, [&](std::size_t const aBegin, std::size_t const aEnd,
+                     unsigned const) {
+          for (auto i = aBegin; i < aEnd; ++i) {
+              pool.parallelFor(
+                0ul, 100ul, [&](std::size_t const aInnerBegin,
+                                std::size_t const aInnerEnd, unsigned const) {
+                    for (auto j = aInnerBegin; j < aInnerEnd; ++j) {
+                        nested_sum += j;
+                    }
+                });
+          }
+      });
+    assert(nested_sum.load() == 16ul * 4950ul);
+
+    std::cout << "Exceptions reach the caller" << std::endl;
+    bool caught = false;
+    try {
+        pool.parallelFor(0ul, 100ul, [](std::size_t const aBegin,
+                                        std::size_t const, unsigned const) {
+            if (aBegin == 42ul) {
+                throw std::runtime_error{ "iteration 42" };
+            }
+        });
+    } catch (std::runtime_error const&) {
+        caught = true;
+    }
+    assert(caught);
+
+    std::cout << "Suspended pools run loops on the caller" << std::endl;
+    {
+        cldes::backend::SuspendedThreadPools const suspended;
+        assert(pool.concurrency() == 1u);
+        CheckCoverage(pool, 1000ul);
+        pool.suspend();
+        pool.resume();
+        assert(pool.concurrency() == 1u);
+    }
+    assert(pool.concurrency() == 4u);
+    CheckCoverage(pool, 1000ul);
+
+    std::cout << "Scoped executors" << std::endl;
+    assert(&cldes::backend::currentExecutor() ==
+           &cldes::backend::defaultExecutor());
+    {
+        cldes::backend::ScopedExecutor const outer{ pool };
+        assert(&cldes::backend::currentExecutor() == &pool);
+        {
+            cldes::backend::ScopedExecutor const inner{ serial };
+            assert(&cldes::backend::currentExecutor() == &serial);
+        }
+        assert(&cldes::backend::currentExecutor() == &pool);
+    }
+    assert(&cldes::backend::currentExecutor() ==
+           &cldes::backend::defaultExecutor());
+
+    std::cout << "Operations do not depend on the executor" << std::endl;
+    cldes::ScalarType const a0 = 0;
+    cldes::ScalarType const a1 = 1;
+    cldes::ScalarType const b0 = 2;
+    cldes::ScalarType const b1 = 3;
+
+    cldes::DESystem<4u>::EventsTable non_contr;
+    non_contr.insert(b0);
+    non_contr.insert(b1);
+
+    std::set<StorageIndex> plant_marked_states = { 0 };
+    cldes::DESystem<4u> plant{ 4, 0, plant_marked_states };
+    plant(0, 1) = a0;
+    plant(0, 2) = a1;
+    plant(1, 0) = b0;
+    plant(1, 3) = a1;
+    plant(2, 0) = b1;
+    plant(2, 3) = a0;
+    plant(3, 1) = b1;
+    plant(3, 2) = b0;
+
+    std::set<StorageIndex> spec_marked_states = { 0, 1 };
+    cldes::DESystem<4u> spec{ 2, 0, spec_marked_states };
+    spec(0, 1) = b0;
+    spec(1, 0) = a1;
+
+    auto const sync_serial = cldes::op::synchronize(plant, spec, serial);
+    auto const sync_pool = cldes::op::synchronize(plant, spec, pool);
+    assert(sync_serial == sync_pool);
+    assert(sync_serial.getGraph().nonZeros() ==
+           sync_pool.getGraph().nonZeros());
+
+    auto const supervisor_serial =
+      cldes::op::supC(plant, spec, non_contr, serial);
+    auto const supervisor_pool = cldes::op::supC(plant, spec, non_contr, pool);
+    assert(supervisor_serial == supervisor_pool);
+
+    std::ostringstream expected_result;
+    expected_result << "0 1 0 0 0 0 " << std::endl;
+    expected_result << "0 0 0 0 4 0 " << std::endl;
+    expected_result << "8 0 0 1 0 0 " << std::endl;
+    expected_result << "0 8 0 0 0 4 " << std::endl;
+    expected_result << "0 0 2 0 0 0 " << std::endl;
+    expected_result << "0 0 0 0 8 0 " << std::endl;
+    expected_result << ">" << std::endl;
+    ProcessResult(supervisor_pool.getGraph(),
+                  "< Supervisor on the thread pool",
+                  expected_result.str().c_str());
+
+    return 0;
+}
@@ -0,0 +1,184 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: tests/expression.cpp
+ Description: Test lazy operations graphs against eager operations.
+ =========================================================================
+*/
+
+
+#include "cldes/DESystem.hpp"
+#include "cldes/operations/Expression.hpp"
+#include "cldes/operations/Operations.hpp"
+#include "clustertool.hpp"
+#include "testlib.hpp"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using StorageIndex = unsigned;
+
+/*
+ * Check that aFused is the trim part of aEager, renumbered in order
+ */
+template<uint8_t NEvents>
+void
+checkTrimPart(cldes::DESystem<NEvents, StorageIndex> const& aEager,
+              cldes::DESystem<NEvents, StorageIndex> const& aFused,
+              cldes::EventsSet<NEvents> const& aAlphabet)
+{
+    auto const trim_states = aEager.trimStates();
+    std::vector<StorageIndex> states(trim_states.begin(), trim_states.end());
+    std::sort(states.begin(), states.end());
+    assert(aFused.size() == states.size());
+    for (auto i = 0ul; i < states.size(); ++i) {
+        for (cldes::ScalarType e = 0; e < NEvents; ++e) {
+            auto const qto = aEager.trans(states[i], e);
+            auto const it =
+              std::lower_bound(states.begin(), states.end(), qto);
+            if (qto < 0 || !aAlphabet.test(e) || it == states.end() ||
+                *it != static_cast<StorageIndex>(qto)) {
+                assert(aFused.trans(i, e) == -1);
+            } else {
+                assert(aFused.trans(i, e) == it - states.begin());
+            }
+        }
+    }
+}
+
+int
+main()
+{
+    cldes::ScalarType const a0 = 0;
+    cldes::ScalarType const a1 = 1;
+    cldes::ScalarType const b0 = 2;
+    cldes::ScalarType const b1 = 3;
+
+    cldes::DESystem<4u>::EventsTable non_contr;
+    non_contr.insert(b0);
+    non_contr.insert(b1);
+
+    std::set<StorageIndex> plant_marked_states = { 0 };
+
+    cldes::DESystem<4u> plant{ 4, 0, plant_marked_states };
+
+    plant(0, 1) = a0;
+    plant(0, 2) = a1;
+    plant(1, 0) = b0;
+    plant(1, 3) = a1;
+    plant(2, 0) = b1;
+    plant(2, 3) = a0;
+    plant(3, 1) = b1;
+    plant(3, 2) = b0;
+
+    std::set<StorageIndex> spec_marked_states = { 0, 1 };
+
+    cldes::DESystem<4u> spec{ 2, 0, spec_marked_states };
+
+    spec(0, 1) = b0;
+    spec(1, 0) = a1;
+
+    std::ostringstream expected_result;
+
+    expected_result << "0 1 0 0 0 0 " << std::endl;
+    expected_result << "0 0 0 0 4 0 " << std::endl;
+    expected_result << "8 0 0 1 0 0 " << std::endl;
+    expected_result << "0 8 0 0 0 4 " << std::endl;
+    expected_result << "0 0 2 0 0 0 " << std::endl;
+    expected_result << "0 0 0 0 8 0 " << std::endl;
+    expected_result << ">" << std::endl;
+
+    std::cout << "Fused supervisor synthesis" << std::endl;
+    auto const lazy_plant = cldes::op::lazy(plant);
+    auto const lazy_spec = cldes::op::lazy(spec);
+    auto const supervisor =
+      cldes::op::supC(lazy_plant, lazy_spec, non_contr).materialize();
+    ProcessResult(supervisor.getGraph(), "< Sync graph",
+                  expected_result.str().c_str());
+    assert(supervisor.getMarkedStates() ==
+           cldes::op::supC(plant, spec, non_contr).getMarkedStates());
+
+    std::cout << "Fused trim of a synchronization" << std::endl;
+    cldes::EventsSet<4u> const all_events{ 0xful };
+    auto const eager_sync = cldes::op::synchronize(plant, spec);
+    auto const fused_sync = cldes::op::evaluate(
+      cldes::op::trim(cldes::op::synchronize(lazy_plant, lazy_spec)));
+    checkTrimPart(eager_sync, fused_sync, all_events);
+
+    std::cout << "Fused projection" << std::endl;
+    cldes::EventsSet<4u> const alphabet{ 0x3ul };
+    auto const fused_proj = cldes::op::evaluate(cldes::op::proj(
+      cldes::op::trim(cldes::op::synchronize(lazy_plant, lazy_spec)),
+      alphabet));
+    checkTrimPart(eager_sync, fused_proj, alphabet);
+
+    std::cout << "Subexpressions out of the fused order" << std::endl;
+    auto const nested = cldes::op::supC(
+      cldes::op::trim(cldes::op::proj(lazy_plant, all_events)),
+      lazy_spec,
+      non_contr);
+    auto const stage = nested.plan();
+    assert(stage.supc);
+    assert(stage.materialized.size() == 1ul);
+    ProcessResult(nested.materialize().getGraph(), "< Sync graph",
+                  expected_result.str().c_str());
+
+    std::cout << "Fused ClusterTool(2) supervisor" << std::endl;
+    std::vector<cldes::DESystem<16>> plants;
+    std::vector<cldes::DESystem<16>> specs;
+    cldes::DESystem<16>::EventsTable ct_non_contr;
+    ClusterTool(2, plants, specs, ct_non_contr);
+
+    auto ct_plant = plants[0];
+    auto lazy_ct_plant = cldes::op::lazy(plants[0]);
+    for (auto i = 1ul; i < plants.size(); ++i) {
+        ct_plant = cldes::op::synchronize(ct_plant, plants[i]);
+        lazy_ct_plant =
+          cldes::op::synchronize(lazy_ct_plant, cldes::op::lazy(plants[i]));
+    }
+    auto ct_spec = specs[0];
+    auto lazy_ct_spec = cldes::op::lazy(specs[0]);
+    for (auto i = 1ul; i < specs.size(); ++i) {
+        ct_spec = cldes::op::synchronize(ct_spec, specs[i]);
+        lazy_ct_spec =
+          cldes::op::synchronize(lazy_ct_spec, cldes::op::lazy(specs[i]));
+    }
+    auto const eager_ct = cldes::op::supC(ct_plant, ct_spec, ct_non_contr);
+    auto const fused_ct =
+      cldes::op::supC(lazy_ct_plant, lazy_ct_spec, ct_non_contr)
+        .materialize();
+    std::cout << "Eager supervisor: " << eager_ct.size() << " states, "
+              << eager_ct.getGraph().nonZeros() << " transitions" << std::endl;
+    std::cout << "Fused supervisor: " << fused_ct.size() << " states, "
+              << fused_ct.getGraph().nonZeros() << " transitions" << std::endl;
+    assert(fused_ct.size() == eager_ct.size());
+    assert(fused_ct.getGraph().nonZeros() == eager_ct.getGraph().nonZeros());
+
+    std::cout << "Finishing test" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,190 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: tests/generic_system.cpp
+ Description: Test batched queries and fast paths of GenericSystem.
+ =========================================================================
+*/
+
+#include "cldes/DESystem.hpp"
+#include "cldes/GenericSystem.hpp"
+#include "cldes/operations/Operations.hpp"
+#include "testlib.hpp"
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using StorageIndex = unsigned;
+using Plant = cldes::DESystem<4u, StorageIndex>;
+using Sync = cldes::op::SyncSysProxy<Plant, Plant>;
+using Generic = cldes::GenericSystem<4u, StorageIndex>;
+
+/*
+ * Breadth first search which queries a whole frontier per call
+ */
+std::vector<StorageIndex>
+reachableBlocks(Generic const& aSys)
+{
+    std::vector<bool> visited(aSys.size(), false);
+    std::vector<StorageIndex> frontier{ aSys.getInitialState() };
+    std::vector<StorageIndex> reached{ aSys.getInitialState() };
+    visited[aSys.getInitialState()] = true;
+    Generic::TransitionsBlock block;
+    while (!frontier.empty()) {
+        aSys.getSuccessorsBlock(frontier.data(), frontier.size(), block);
+        frontier.clear();
+        for (auto qto : block.states) {
+            if (!visited[qto]) {
+                visited[qto] = true;
+                frontier.push_back(qto);
+                reached.push_back(qto);
+            }
+        }
+    }
+    std::sort(reached.begin(), reached.end());
+    return reached;
+}
+
+/*
+ * Depth first search on the statically typed system
+ */
+template<class SysT>
+std::vector<StorageIndex>
+reachable(SysT const& aSys)
+{
+    std::vector<bool> visited(aSys.size(), false);
+    std::vector<StorageIndex> stack{ aSys.getInitialState() };
+    std::vector<StorageIndex> reached{ aSys.getInitialState() };
+    visited[aSys.getInitialState()] = true;
+    while (!stack.empty()) {
+        auto const q = stack.back();
+        stack.pop_back();
+        aSys.forEachSuccessor(
+          q, [&](cldes::ScalarType, StorageIndex const aQto) {
+              if (!visited[aQto]) {
+                  visited[aQto] = true;
+                  stack.push_back(aQto);
+                  reached.push_back(aQto);
+              }
+          });
+    }
+    std::sort(reached.begin(), reached.end());
+    return reached;
+}
+
+int
+main()
+{
+    cldes::ScalarType const a0 = 0;
+    cldes::ScalarType const a1 = 1;
+    cldes::ScalarType const b0 = 2;
+    cldes::ScalarType const b1 = 3;
+
+    std::set<StorageIndex> plant_marked_states = { 0 };
+
+    Plant plant{ 4, 0, plant_marked_states };
+
+    plant(0, 1) = a0;
+    plant(0, 2) = a1;
+    plant(1, 0) = b0;
+    plant(1, 3) = a1;
+    plant(2, 0) = b1;
+    plant(2, 3) = a0;
+    plant(3, 1) = b1;
+    plant(3, 2) = b0;
+
+    std::set<StorageIndex> spec_marked_states = { 0, 1 };
+
+    Plant spec{ 2, 0, spec_marked_states };
+
+    spec(0, 1) = b0;
+    spec(1, 0) = a1;
+
+    Sync const sync{ plant, spec };
+    Generic const generic_plant{ plant };
+    Generic const generic_sync{ sync };
+
+    std::cout << "Batched events and marked flags" << std::endl;
+    std::vector<StorageIndex> states(sync.size());
+    for (StorageIndex q = 0; q < sync.size(); ++q) {
+        states[q] = q;
+    }
+    std::vector<cldes::EventsSet<4u>> events(states.size());
+    std::unique_ptr<bool[]> marked{ new bool[states.size()] };
+    generic_sync.getStatesEventsBlock(states.data(), states.size(),
+                                      events.data());
+    generic_sync.isMarkedBlock(states.data(), states.size(), marked.get());
+    auto const sync_marked = sync.getMarkedStates();
+    for (StorageIndex q = 0; q < sync.size(); ++q) {
+        assert(events[q] == sync.getStateEvents(q));
+        assert(marked[q] == (sync_marked.find(q) != sync_marked.end()));
+    }
+
+    std::cout << "Marked flags follow changes through cast()" << std::endl;
+    Generic mutable_plant{ plant };
+    mutable_plant.cast<Plant>().insertMarkedState(3);
+    StorageIndex const plant_states[] = { 0, 1, 2, 3 };
+    bool plant_marked[4];
+    mutable_plant.isMarkedBlock(plant_states, 4ul, plant_marked);
+    assert(plant_marked[0] && !plant_marked[1] && !plant_marked[2] &&
+           plant_marked[3]);
+    mutable_plant.cast<Plant>().setMarkedStates({ 1 });
+    mutable_plant.isMarkedBlock(plant_states, 4ul, plant_marked);
+    assert(!plant_marked[0] && plant_marked[1] && !plant_marked[2] &&
+           !plant_marked[3]);
+
+    std::cout << "Batched successors" << std::endl;
+    Generic::TransitionsBlock block;
+    generic_sync.getSuccessorsBlock(states.data(), states.size(), block);
+    assert(block.offsets.size() == states.size() + 1ul);
+    for (StorageIndex q = 0; q < sync.size(); ++q) {
+        auto const begin = block.offsets[q];
+        auto const end = block.offsets[q + 1ul];
+        assert(end - begin == sync.getStateEvents(q).count());
+        for (auto i = begin; i < end; ++i) {
+            assert(sync.trans(q, block.events[i]) ==
+                   static_cast<long>(block.states[i]));
+        }
+    }
+    ProcessResult(reachableBlocks(generic_plant), "< Reachable plant",
+                  "0 1 2 3 >");
+    assert(reachableBlocks(generic_sync) == reachable(sync));
+
+    std::cout << "Non-virtual fast paths" << std::endl;
+    assert(generic_plant.tryCast<Plant>() != nullptr);
+    assert(generic_plant.tryCast<Sync>() == nullptr);
+    assert(generic_sync.tryCast<Sync>() != nullptr);
+
+    auto n_states = 0ul;
+    auto const found = generic_sync.visitAs<Plant, Sync>(
+      [&n_states](auto const& aSys) { n_states = aSys.size(); });
+    assert(found);
+    assert(n_states == sync.size());
+    assert(!generic_plant.visitAs<Sync>([](auto const&) {}));
+
+    std::cout << "Finishing test" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,191 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: tests/memory_usage.cpp
+ Description: Memory held by systems and peak memory of operations.
+ =========================================================================
+*/
+
+
+#include "cldes/DESystem.hpp"
+#include "cldes/DESystemSnapshot.hpp"
+#include "cldes/GenericSystem.hpp"
+#include "cldes/MemoryHook.hpp"
+#include "cldes/MemoryUsage.hpp"
+#include "cldes/StaticDESystem.hpp"
+#include "cldes/operations/Operations.hpp"
+#include "testlib.hpp"
+#include <iostream>
+#include <vector>
+
+static void
+PrintUsage(cldes::MemoryUsage const& aUsage, char const* aName)
+{
+    std::cout << "    " << aName << ": graph " << aUsage.graph
+              << ", inverted graph " << aUsage.inverted_graph
+              << ", states events " << aUsage.states_events
+              << ", inverted states events " << aUsage.inv_states_events
+              << ", marked states " << aUsage.marked_states << ", tables "
+              << aUsage.tables << ", total " << aUsage.total() << std::endl;
+}
+
+int
+main()
+{
+    using StorageIndex = unsigned;
+    using System = cldes::DESystem<4u, StorageIndex>;
+
+    cldes::ScalarType const a0 = 0;
+    cldes::ScalarType const a1 = 1;
+    cldes::ScalarType const b0 = 2;
+    cldes::ScalarType const b1 = 3;
+
+    cldes::DESystem<4u>::EventsTable non_contr;
+    non_contr.insert(b0);
+    non_contr.insert(b1);
+
+    std::set<StorageIndex> plant_marked_states = { 0 };
+    System plant{ 4, 0, plant_marked_states };
+    plant(0, 1) = a0;
+    plant(0, 2) = a1;
+    plant(1, 0) = b0;
+    plant(1, 3) = a1;
+    plant(2, 0) = b1;
+    plant(2, 3) = a0;
+    plant(3, 1) = b1;
+    plant(3, 2) = b0;
+
+    std::set<StorageIndex> spec_marked_states = { 0, 1 };
+    System spec{ 2, 0, spec_marked_states };
+    spec(0, 1) = b0;
+    spec(1, 0) = a1;
+
+    std::cout << "DESystem breakdown" << std::endl;
+    auto const usage = plant.memoryUsage();
+    PrintUsage(usage, "plant");
+    assert(usage.graph >= 8u * (sizeof(cldes::EventsSet<4u>) + sizeof(int)));
+    assert(usage.states_events >= 4u * sizeof(cldes::EventsSet<4u>));
+    assert(usage.inv_states_events >= 4u * sizeof(cldes::EventsSet<4u>));
+    assert(usage.marked_states > sizeof(StorageIndex));
+    assert(usage.inverted_graph == 0u);
+    assert(usage.tables == 0u);
+
+    plant.allocateInvertedGraph();
+    auto const inverted_usage = plant.memoryUsage();
+    assert(inverted_usage.inverted_graph > 0u);
+    assert(inverted_usage.total() == usage.total() +
+                                       inverted_usage.inverted_graph);
+    plant.clearInvertedGraph();
+    assert(plant.memoryUsage().inverted_graph == 0u);
+
+    std::cout << "Proxies" << std::endl;
+    cldes::op::SyncSysProxy<System, System> const sync{ plant, spec };
+    PrintUsage(sync.memoryUsage(), "synchronization");
+    assert(sync.memoryUsage().graph == 0u);
+
+    cldes::op::SuperProxy<System, System> const supervisor{ plant,
+                                                             spec,
+                                                             non_contr };
+    auto const supervisor_usage = supervisor.memoryUsage();
+    PrintUsage(supervisor_usage, "supervisor");
+    // The states of the supervisor are on c_
+    assert(supervisor_usage.tables >=
+           supervisor.size() * sizeof(StorageIndex));
+
+    std::cout << "Other systems" << std::endl;
+    auto const snapshot = cldes::makeSnapshot(plant);
+    PrintUsage(snapshot.memoryUsage(), "snapshot");
+    assert(snapshot.memoryUsage().graph > 0u);
+    assert(snapshot.memoryUsage().inverted_graph > 0u);
+
+    constexpr cldes::StaticDESystem<2, 4u, StorageIndex> static_spec{
+        0, { 0, 1 }, { { 0, b0, 1 }, { 1, a1, 0 } }
+    };
+    assert(static_spec.memoryUsage().graph ==
+           2u * 4u * sizeof(std::make_signed<StorageIndex>::type));
+
+    cldes::GenericSystem<4u, StorageIndex> const generic{ plant };
+    assert(generic.memoryUsage().graph == usage.graph);
+    assert(generic.memoryUsage().marked_states == usage.marked_states);
+
+    std::cout << "Allocation hook" << std::endl;
+    assert(cldes::MemoryTracker::hooked());
+    {
+        cldes::MemoryTracker tracker;
+        {
+            std::vector<char> block(1u << 20u);
+            assert(tracker.currentBytes() >= 1l << 20l);
+        }
+        tracker.stop();
+        assert(tracker.peakBytes() >= 1u << 20u);
+        assert(tracker.currentBytes() == 0l);
+        assert(tracker.allocations() == tracker.deallocations());
+        assert(tracker.allocatedBytes() >= 1u << 20u);
+    }
+
+    std::cout << "Sparsepp tables" << std::endl;
+    {
+        cldes::MemoryTracker tracker;
+        {
+            spp::sparse_hash_set<StorageIndex> table;
+            for (StorageIndex q = 0u; q < 1u << 20u; ++q) {
+                table.insert(q);
+            }
+            assert(tracker.currentBytes() >=
+                   static_cast<int64_t>(table.size() * sizeof(StorageIndex)));
+        }
+        tracker.stop();
+        assert(tracker.peakBytes() >= (1u << 20u) * sizeof(StorageIndex));
+        assert(tracker.currentBytes() == 0l);
+    }
+
+    std::cout << "Nested trackers" << std::endl;
+    {
+        cldes::MemoryTracker outer;
+        {
+            std::vector<char> block(1u << 20u);
+        }
+        cldes::MemoryTracker inner;
+        {
+            std::vector<char> block(1u << 10u);
+        }
+        inner.stop();
+        outer.stop();
+        assert(inner.peakBytes() >= 1u << 10u);
+        assert(inner.peakBytes() < 1u << 20u);
+        assert(outer.peakBytes() >= 1u << 20u);
+    }
+
+    std::cout << "Peak memory of an operation" << std::endl;
+    cldes::MemoryTracker tracker;
+    auto const result = cldes::op::supC(plant, spec, non_contr);
+    tracker.stop();
+    std::cout << "    supC: peak " << tracker.peakBytes() << " bytes, "
+              << tracker.allocations() << " allocations" << std::endl;
+    assert(tracker.peakBytes() >= result.memoryUsage().graph);
+    assert(tracker.allocations() > 0u);
+
+    return 0;
+}
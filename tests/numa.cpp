@@ -0,0 +1,193 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: tests/numa.cpp
+ Description: NUMA topology, placement of graphs and tables, and NUMA aware
+ thread pool.
+ =========================================================================
+*/
+
+
+#include "cldes/ConcurrentStatesTable.hpp"
+#include "cldes/DESystem.hpp"
+#include "cldes/backend/Executor.hpp"
+#include "cldes/backend/Numa.hpp"
+#include "cldes/operations/Operations.hpp"
+#include "testlib.hpp"
+#include <atomic>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+int
+main()
+{
+    using StorageIndex = unsigned;
+    using cldes::backend::NumaPolicy;
+    using cldes::backend::NumaTopology;
+
+    std::cout << "Parse CPU lists" << std::endl;
+    ProcessResult(cldes::backend::parseCpuList_("0-3,8,10-11\n"),
+                  "< CPUs of 0-3,8,10-11",
+                  "0 1 2 3 8 10 11 >");
+
+    std::cout << "Split arrays over the nodes" << std::endl;
+    NumaTopology const topology{ { 0u, 2u }, { { 0u, 1u }, { 2u, 3u } } };
+    assert(topology.nodes() == 2u);
+    assert(topology.nodeId(1u) == 2u);
+    ProcessResult(topology.blocks(11ul), "< Blocks of 11", "0 5 11 >");
+    assert(topology.nodeOf(0ul, 4ul) == 0u);
+    assert(topology.nodeOf(1ul, 4ul) == 0u);
+    assert(topology.nodeOf(2ul, 4ul) == 1u);
+    assert(topology.nodeOf(3ul, 4ul) == 1u);
+
+    auto const& host = NumaTopology::system();
+    assert(host.nodes() >= 1u);
+    for (auto k = 0u; k < host.nodes(); ++k) {
+        assert(!host.cpus(k).empty());
+    }
+    std::cout << "Host nodes: " << host.nodes() << std::endl;
+
+    std::cout << "Placement keeps the data" << std::endl;
+    std::vector<uint64_t> data(1ul << 16);
+    for (auto i = 0ul; i < data.size(); ++i) {
+        data[i] = i * i;
+    }
+    for (auto policy : { NumaPolicy::kPartitioned,
+                         NumaPolicy::kInterleave,
+                         NumaPolicy::kDefault }) {
+        cldes::backend::numaPlace(data, policy);
+    }
+    assert(!cldes::backend::numaPlace(nullptr, 0ul, NumaPolicy::kInterleave));
+    for (auto i = 0ul; i < data.size(); ++i) {
+        assert(data[i] == i * i);
+    }
+
+    std::cout << "Blocks within a shared page are not moved" << std::endl;
+    {
+        // The last block starts on the page before the data: moving it
+        // to a node which does not exist would fail
+        NumaTopology const missing{ { 1000u, 1001u, 1002u },
+                                    { { 0u }, { 0u }, { 0u } } };
+        auto const page = cldes::backend::numaPageSize_();
+        std::vector<char> buffer(3ul * page);
+        auto const* data =
+          cldes::backend::numaPageUp_(buffer.data()) + page / 2ul;
+        assert(cldes::backend::numaPlaceBlocks(
+          data, 1ul, { 0ul, 16ul, 32ul, page }, missing));
+    }
+
+    std::cout << "Tables placed on the nodes grow" << std::endl;
+    cldes::backend::ExecutorOptions options;
+    options.threads = 3u;
+    options.grain = 1ul;
+    options.numa = true;
+    cldes::backend::ThreadPoolExecutor pool{ options };
+    {
+        cldes::backend::ScopedExecutor const scope{ pool };
+        cldes::ConcurrentStatesTable<StorageIndex> table{ 16ul, true };
+        table.setNumaPolicy(NumaPolicy::kPartitioned);
+        pool.parallelFor(
+          0ul,
+          10000ul,
+          [&table](
+            std::size_t const aBegin, std::size_t const aEnd, unsigned) {
+              for (auto i = aBegin; i < aEnd; ++i) {
+                  table.insertWithId(static_cast<StorageIndex>(i % 5000ul));
+              }
+          },
+          64ul);
+        assert(table.size() == 5000ul);
+        assert(table.find(4999u) != table.kNoValue);
+        assert(!table.contains(5000u));
+    }
+
+    std::cout << "NUMA aware pool runs every iteration once" << std::endl;
+    std::vector<std::atomic<unsigned>> hits(1000ul);
+    for (auto& hit : hits) {
+        hit.store(0u);
+    }
+    pool.parallelFor(
+      0ul, hits.size(), [&hits](std::size_t const aBegin,
+                                std::size_t const aEnd, unsigned const) {
+          for (auto i = aBegin; i < aEnd; ++i) {
+              ++hits[i];
+          }
+      });
+    for (auto& hit : hits) {
+        assert(hit.load() == 1u);
+    }
+
+    std::cout << "Operations on placed systems" << std::endl;
+    cldes::ScalarType const a0 = 0;
+    cldes::ScalarType const a1 = 1;
+    cldes::ScalarType const b0 = 2;
+    cldes::ScalarType const b1 = 3;
+
+    cldes::DESystem<4u>::EventsTable non_contr;
+    non_contr.insert(b0);
+    non_contr.insert(b1);
+
+    std::set<StorageIndex> plant_marked_states = { 0 };
+    cldes::DESystem<4u> plant{ 4, 0, plant_marked_states };
+    plant(0, 1) = a0;
+    plant(0, 2) = a1;
+    plant(1, 0) = b0;
+    plant(1, 3) = a1;
+    plant(2, 0) = b1;
+    plant(2, 3) = a0;
+    plant(3, 1) = b1;
+    plant(3, 2) = b0;
+
+    std::set<StorageIndex> spec_marked_states = { 0, 1 };
+    cldes::DESystem<4u> spec{ 2, 0, spec_marked_states };
+    spec(0, 1) = b0;
+    spec(1, 0) = a1;
+
+    cldes::backend::SerialExecutor serial;
+    auto const expected = cldes::op::supC(plant, spec, non_contr, serial);
+
+    plant.allocateInvertedGraph();
+    plant.placeMemory(NumaPolicy::kPartitioned);
+    spec.placeMemory(NumaPolicy::kInterleave);
+    auto const supervisor = cldes::op::supC(plant, spec, non_contr, pool);
+    assert(supervisor == expected);
+    assert(ReadResult(supervisor.getGraph(), "") ==
+           ReadResult(expected.getGraph(), ""));
+
+    std::ostringstream expected_result;
+    expected_result << "0 1 0 0 0 0 " << std::endl;
+    expected_result << "0 0 0 0 4 0 " << std::endl;
+    expected_result << "8 0 0 1 0 0 " << std::endl;
+    expected_result << "0 8 0 0 0 4 " << std::endl;
+    expected_result << "0 0 2 0 0 0 " << std::endl;
+    expected_result << "0 0 0 0 8 0 " << std::endl;
+    expected_result << ">" << std::endl;
+    ProcessResult(supervisor.getGraph(),
+                  "< Supervisor of placed systems",
+                  expected_result.str().c_str());
+
+    return 0;
+}
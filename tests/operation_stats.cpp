@@ -0,0 +1,162 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: tests/operation_stats.cpp
+ Description: Per-phase statistics of the operations.
+ =========================================================================
+*/
+
+
+#include "cldes/DESystem.hpp"
+#include "cldes/OperationStats.hpp"
+#include "cldes/backend/Executor.hpp"
+#include "cldes/operations/Operations.hpp"
+#include "testlib.hpp"
+#include <iostream>
+#include <string>
+
+static void
+PrintStats(cldes::OperationStats const& aStats)
+{
+    for (auto const& phase : aStats.phases()) {
+        std::cout << "    " << phase.name << ": " << phase.calls
+                  << " calls, " << phase.states_visited << " states, "
+                  << phase.transitions_examined << " transitions, "
+                  << phase.hash_probes << " probes, peak "
+                  << phase.peak_table_size << std::endl;
+    }
+}
+
+int
+main()
+{
+    using StorageIndex = unsigned;
+
+    static_assert(cldes::kStatsEnabled, "statistics are compiled in");
+
+    cldes::ScalarType const a0 = 0;
+    cldes::ScalarType const a1 = 1;
+    cldes::ScalarType const b0 = 2;
+    cldes::ScalarType const b1 = 3;
+
+    cldes::DESystem<4u>::EventsTable non_contr;
+    non_contr.insert(b0);
+    non_contr.insert(b1);
+
+    std::set<StorageIndex> plant_marked_states = { 0 };
+    cldes::DESystem<4u> plant{ 4, 0, plant_marked_states };
+    plant(0, 1) = a0;
+    plant(0, 2) = a1;
+    plant(1, 0) = b0;
+    plant(1, 3) = a1;
+    plant(2, 0) = b1;
+    plant(2, 3) = a0;
+    plant(3, 1) = b1;
+    plant(3, 2) = b0;
+
+    std::set<StorageIndex> spec_marked_states = { 0, 1 };
+    cldes::DESystem<4u> spec{ 2, 0, spec_marked_states };
+    spec(0, 1) = b0;
+    spec(1, 0) = a1;
+
+    std::cout << "Nothing is recorded without installed statistics"
+              << std::endl;
+    cldes::OperationStats stats;
+    auto const expected = cldes::op::supC(plant, spec, non_contr);
+    assert(stats.phases().empty());
+    assert(cldes::currentStats() == nullptr);
+
+    std::cout << "Supervisor synthesis phases" << std::endl;
+    {
+        cldes::ScopedStats const scope{ stats };
+        assert(cldes::currentStats() == &stats);
+        auto const supervisor = cldes::op::supC(plant, spec, non_contr);
+        assert(supervisor == expected);
+    }
+    assert(cldes::currentStats() == nullptr);
+    PrintStats(stats);
+
+    auto const explore = stats.phase("supC.findRemovedStates");
+    assert(explore.calls == 1ul);
+    assert(explore.states_visited >= expected.size());
+    assert(explore.transitions_examined > 0ul);
+    assert(explore.hash_probes > explore.transitions_examined);
+    assert(explore.hash_inserts > 0ul);
+    assert(explore.peak_table_size >= expected.size());
+
+    auto const remove = stats.phase("supC.removeBadStates");
+    assert(remove.calls > 0ul);
+    assert(remove.states_visited > 0ul);
+
+    auto const trim = stats.phase("supC.trim");
+    assert(trim.calls == 1ul);
+    assert(trim.peak_table_size == expected.size());
+    // Phase times include the phases they call
+    assert(explore.wall >= trim.wall);
+
+    auto const materialize = stats.phase("supC.materialize");
+    assert(materialize.calls == 1ul);
+    assert(materialize.states_visited == expected.size());
+    assert(materialize.peak_table_size ==
+           static_cast<uint64_t>(expected.getGraph().nonZeros()));
+
+    assert(stats.phase("synchronize.stage2").calls == 0ul);
+
+    std::cout << "Workers report to the statistics of the caller" << std::endl;
+    stats.clear();
+    assert(stats.phases().empty());
+    cldes::backend::ExecutorOptions options;
+    options.threads = 3u;
+    options.grain = 1u;
+    cldes::backend::ThreadPoolExecutor pool{ options };
+    {
+        cldes::ScopedStats const scope{ stats };
+        auto const product = cldes::op::synchronize(plant, spec, pool);
+        auto const stage2 = stats.phase("synchronize.stage2");
+        assert(stage2.calls == 1ul);
+        assert(stage2.states_visited == product.size());
+        assert(stage2.peak_table_size ==
+               static_cast<uint64_t>(product.getGraph().nonZeros()));
+        assert(stage2.allocated_bytes > 0ul);
+
+        auto untrimmed = product;
+        untrimmed.trim();
+        auto const bfs = stats.phase("bfs");
+        assert(bfs.calls > 0ul);
+        assert(bfs.states_visited > 0ul);
+        assert(bfs.transitions_examined > 0ul);
+    }
+    PrintStats(stats);
+
+    std::cout << "JSON output" << std::endl;
+    auto const json = stats.toJson();
+    std::cout << "    " << json << std::endl;
+    assert(json.find("{\"phases\": [{\"name\": \"synchronize.stage2\"") == 0ul);
+    assert(json.find("\"name\": \"bfs\"") != std::string::npos);
+    assert(json.find("\"wall_ns\": ") != std::string::npos);
+    assert(json.back() == '}');
+
+    return 0;
+}
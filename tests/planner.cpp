@@ -0,0 +1,227 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: tests/planner.cpp
+ Description: Test the lazy versus eager planner and its plans.
+ =========================================================================
+*/
+
+
+
+#include "cldes/DESystem.hpp"
+#include "cldes/backend/Executor.hpp"
+#include "cldes/operations/Expression.hpp"
+#include "cldes/operations/Operations.hpp"
+#include "cldes/operations/Planner.hpp"
+#include "clustertool.hpp"
+#include "testlib.hpp"
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using StorageIndex = unsigned;
+
+int
+main()
+{
+    cldes::ScalarType const a0 = 0;
+    cldes::ScalarType const a1 = 1;
+    cldes::ScalarType const b0 = 2;
+    cldes::ScalarType const b1 = 3;
+
+    cldes::DESystem<4u>::EventsTable non_contr;
+    non_contr.insert(b0);
+    non_contr.insert(b1);
+
+    std::set<StorageIndex> plant_marked_states = { 0 };
+
+    cldes::DESystem<4u> plant{ 4, 0, plant_marked_states };
+
+    plant(0, 1) = a0;
+    plant(0, 2) = a1;
+    plant(1, 0) = b0;
+    plant(1, 3) = a1;
+    plant(2, 0) = b1;
+    plant(2, 3) = a0;
+    plant(3, 1) = b1;
+    plant(3, 2) = b0;
+
+    std::set<StorageIndex> spec_marked_states = { 0, 1 };
+
+    cldes::DESystem<4u> spec{ 2, 0, spec_marked_states };
+
+    spec(0, 1) = b0;
+    spec(1, 0) = a1;
+
+    std::ostringstream expected_result;
+
+    expected_result << "0 1 0 0 0 0 " << std::endl;
+    expected_result << "0 0 0 0 4 0 " << std::endl;
+    expected_result << "8 0 0 1 0 0 " << std::endl;
+    expected_result << "0 8 0 0 0 4 " << std::endl;
+    expected_result << "0 0 2 0 0 0 " << std::endl;
+    expected_result << "0 0 0 0 8 0 " << std::endl;
+    expected_result << ">" << std::endl;
+
+    auto const lazy_plant = cldes::op::lazy(plant);
+    auto const lazy_spec = cldes::op::lazy(spec);
+
+    std::cout << "Exact estimate of a small product" << std::endl;
+    auto const sync_plan =
+      cldes::op::plan(cldes::op::synchronize(lazy_plant, lazy_spec));
+    auto const accessible =
+      cldes::op::evaluate(cldes::op::synchronize(lazy_plant, lazy_spec));
+    assert(sync_plan.root()->estimate.exact);
+    assert(sync_plan.root()->estimate.full_states == 8.0);
+    assert(sync_plan.root()->estimate.reachable_states ==
+           static_cast<double>(accessible.size()));
+
+    std::cout << "Planned supervisor synthesis" << std::endl;
+    auto const supc_plan =
+      cldes::op::plan(cldes::op::supC(lazy_plant, lazy_spec, non_contr));
+    std::cout << supc_plan.explain();
+    assert(supc_plan.cost() > 0.0);
+    ProcessResult(supc_plan.execute().getGraph(), "< Sync graph",
+                  expected_result.str().c_str());
+
+    std::cout << "Operands which can not be fused are cached" << std::endl;
+    cldes::EventsSet<4u> const all_events{ 0xful };
+    auto const nested_plan = cldes::op::plan(cldes::op::supC(
+      cldes::op::trim(cldes::op::proj(lazy_plant, all_events)),
+      lazy_spec,
+      non_contr));
+    std::cout << nested_plan.explain();
+    auto const& trim_node = *nested_plan.root()->children[0];
+    assert(trim_node.decision == cldes::op::PlanDecision::kCacheRows);
+    assert(trim_node.reason.find("can not be fused") != std::string::npos);
+    assert(trim_node.children[0]->decision ==
+           cldes::op::PlanDecision::kCacheRows);
+    ProcessResult(nested_plan.execute().getGraph(), "< Sync graph",
+                  expected_result.str().c_str());
+
+    std::cout << "Products with no pruning are materialized" << std::endl;
+    // The eager product pays off when it is split among workers
+    cldes::backend::ExecutorOptions eager_options;
+    eager_options.threads = 7u;
+    cldes::backend::ThreadPoolExecutor eager_pool{ eager_options };
+    std::unique_ptr<cldes::backend::ScopedExecutor> eager_scope{
+        new cldes::backend::ScopedExecutor{ eager_pool }
+    };
+    std::set<StorageIndex> free_marked_states = { 0 };
+    cldes::DESystem<4u> left{ 2, 0, free_marked_states };
+    left(0, 1) = a0;
+    left(1, 0) = a1;
+    cldes::DESystem<4u> right{ 2, 0, free_marked_states };
+    right(0, 1) = b0;
+    right(1, 0) = b1;
+    auto const free_plan = cldes::op::plan(
+      cldes::op::synchronize(cldes::op::lazy(left), cldes::op::lazy(right)));
+    std::cout << free_plan.explain();
+    assert(free_plan.root()->estimate.reachable_states == 4.0);
+    assert(free_plan.root()->decision ==
+           cldes::op::PlanDecision::kMaterialize);
+    assert(ReadResult(free_plan.execute().getGraph(), "< Sync graph") ==
+           ReadResult(cldes::op::synchronize(left, right).getGraph(),
+                      "< Sync graph"));
+    eager_scope.reset();
+
+    std::cout << "Eager and fused plans give the same system" << std::endl;
+    // State 2 of pruned is not accessible: 4 of the 6 product states are
+    std::set<StorageIndex> pruned_marked_states = { 0 };
+    cldes::DESystem<4u> pruned{ 3, 0, pruned_marked_states };
+    pruned(0, 1) = a0;
+    pruned(1, 0) = a1;
+    pruned(2, 0) = a0;
+    auto const pruned_expr =
+      cldes::op::synchronize(cldes::op::lazy(pruned), cldes::op::lazy(right));
+    auto const pruned_fused = cldes::op::evaluate(pruned_expr);
+    assert(pruned_fused.size() == 4ul);
+    auto const pruned_plan = cldes::op::plan(pruned_expr);
+    assert(pruned_plan.root()->estimate.reachable_states <
+           pruned_plan.root()->estimate.full_states);
+    auto const supc_expr = cldes::op::supC(lazy_plant, lazy_spec, non_contr);
+    auto const supc_fused = cldes::op::evaluate(supc_expr);
+    for (auto const* expr : { &pruned_expr, &supc_expr }) {
+        auto const& fused = expr == &pruned_expr ? pruned_fused : supc_fused;
+        for (auto decision : { cldes::op::PlanDecision::kMaterialize,
+                               cldes::op::PlanDecision::kCacheRows }) {
+            auto root = std::make_shared<cldes::op::PlanNode<4u, uint32_t>>(
+              *cldes::op::plan(*expr).root());
+            root->decision = decision;
+            cldes::op::ExecutionPlan<4u, uint32_t> const forced{ root };
+            assert(forced.execute() == fused);
+        }
+        assert(cldes::op::evaluateAuto(*expr) == fused);
+        cldes::backend::ExecutorOptions pool_options;
+        pool_options.threads = 15u;
+        cldes::backend::ThreadPoolExecutor pool{ pool_options };
+        cldes::backend::ScopedExecutor const scope{ pool };
+        assert(cldes::op::evaluateAuto(*expr) == fused);
+    }
+
+    std::cout << "Planned ClusterTool(2) supervisor" << std::endl;
+    std::vector<cldes::DESystem<16>> plants;
+    std::vector<cldes::DESystem<16>> specs;
+    cldes::DESystem<16>::EventsTable ct_non_contr;
+    ClusterTool(2, plants, specs, ct_non_contr);
+
+    auto lazy_ct_plant = cldes::op::lazy(plants[0]);
+    for (auto i = 1ul; i < plants.size(); ++i) {
+        lazy_ct_plant =
+          cldes::op::synchronize(lazy_ct_plant, cldes::op::lazy(plants[i]));
+    }
+    auto lazy_ct_spec = cldes::op::lazy(specs[0]);
+    for (auto i = 1ul; i < specs.size(); ++i) {
+        lazy_ct_spec =
+          cldes::op::synchronize(lazy_ct_spec, cldes::op::lazy(specs[i]));
+    }
+    auto const ct_expr =
+      cldes::op::supC(lazy_ct_plant, lazy_ct_spec, ct_non_contr);
+    auto const ct_plan = cldes::op::plan(ct_expr);
+    std::cout << ct_plan.explain();
+    auto const planned_ct = ct_plan.execute();
+    assert(planned_ct.size() == 45ul);
+    assert(planned_ct.getGraph().nonZeros() == 74);
+
+    std::cout << "Sampled estimate and memory limit" << std::endl;
+    cldes::op::PlannerOptions options;
+    options.exact_limit = 16ul;
+    options.memory_limit = 1ul;
+    auto const sampled_plan = cldes::op::plan(ct_expr, options);
+    std::cout << sampled_plan.explain();
+    auto const& estimate = sampled_plan.root()->estimate;
+    assert(!estimate.exact);
+    assert(estimate.reachable_states > 16.0);
+    assert(estimate.reachable_states <= estimate.full_states);
+    auto const limited_ct = cldes::op::evaluateAuto(ct_expr, options);
+    assert(limited_ct.size() == 45ul);
+    assert(limited_ct.getGraph().nonZeros() == 74);
+
+    std::cout << "Finishing test" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: tests/random_walk.cpp
+ Description: Test cldes::op::RandomWalkSimulator, the parallel Monte
+ Carlo simulator.
+ =========================================================================
+*/
+
+
+#include "cldes/DESystem.hpp"
+#include "cldes/backend/Executor.hpp"
+#include "cldes/operations/Operations.hpp"
+#include "cldes/operations/RandomWalk.hpp"
+#include "testlib.hpp"
+#include <iostream>
+#include <numeric>
+#include <string>
+
+template<class StatsT>
+static void
+CheckConsistency(StatsT const& aStats, uint64_t const aWalks)
+{
+    assert(aStats.walks == aWalks);
+    auto const fired = std::accumulate(
+      aStats.event_counts.begin(), aStats.event_counts.end(), 0ul);
+    assert(fired == aStats.steps);
+    if (!aStats.visits.empty()) {
+        auto const visits =
+          std::accumulate(aStats.visits.begin(), aStats.visits.end(), 0ul);
+        assert(visits == aStats.steps + aStats.walks);
+    }
+}
+
+int
+main()
+{
+    using StorageIndex = unsigned;
+
+    cldes::ScalarType const a0 = 0;
+    cldes::ScalarType const a1 = 1;
+    cldes::ScalarType const b0 = 2;
+    cldes::ScalarType const b1 = 3;
+
+    std::set<StorageIndex> plant_marked_states = { 0 };
+
+    cldes::DESystem<4u> plant{ 4, 0, plant_marked_states };
+
+    plant(0, 1) = a0;
+    plant(0, 2) = a1;
+    plant(1, 0) = b0;
+    plant(1, 3) = a1;
+    plant(2, 0) = b1;
+    plant(2, 3) = a0;
+    plant(3, 1) = b1;
+    plant(3, 2) = b0;
+
+    uint64_t const walks = 1000ul;
+    uint64_t const steps = 10ul;
+
+    cldes::op::RandomWalkSimulator<cldes::DESystem<4u>> simulator{ plant };
+    simulator.trackVisits(true);
+
+    cldes::backend::SerialExecutor serial;
+    cldes::backend::ExecutorOptions options;
+    options.threads = 3u;
+    cldes::backend::ThreadPoolExecutor pool{ options };
+
+    auto const single = [&]() {
+        cldes::backend::ScopedExecutor const scope{ serial };
+        return simulator.run(walks, steps);
+    }();
+    auto const multi = [&]() {
+        cldes::backend::ScopedExecutor const scope{ pool };
+        return simulator.run(walks, steps);
+    }();
+
+    std::cout << "Uniform walks: " << single.steps << " steps, "
+              << single.marked_hits << " marked hits" << std::endl;
+    CheckConsistency(single, walks);
+    assert(single.steps == walks * steps);
+    assert(single.blocking_hits == 0ul);
+
+    // Results must not depend on the number of threads
+    assert(multi.steps == single.steps);
+    assert(multi.marked_hits == single.marked_hits);
+    assert(multi.event_counts == single.event_counts);
+    assert(multi.visits == single.visits);
+    for (auto e = 0ul; e < 4ul; ++e) {
+        assert(single.event_counts[e] > 0ul);
+    }
+
+    std::cout << "Weighted walks" << std::endl;
+    simulator.setEventsWeights({ { 1.0, 0.0, 1.0, 0.0 } });
+    auto const weighted = simulator.run(walks, steps);
+    CheckConsistency(weighted, walks);
+    assert(weighted.event_counts[a0] == walks * steps / 2ul);
+    assert(weighted.event_counts[b0] == walks * steps / 2ul);
+    assert(weighted.event_counts[a1] == 0ul);
+    assert(weighted.event_counts[b1] == 0ul);
+    assert(weighted.marked_hits == walks * (steps / 2ul + 1ul));
+
+    std::cout << "Blocking walks" << std::endl;
+    cldes::DESystem<4u> blocking{ 2, 0, plant_marked_states };
+    blocking(0, 1) = a0;
+    cldes::op::RandomWalkSimulator<cldes::DESystem<4u>> blocking_simulator{
+        blocking
+    };
+    auto const blocked = blocking_simulator.run(walks, steps);
+    CheckConsistency(blocked, walks);
+    assert(blocked.blocking_hits == walks);
+    assert(blocked.steps == walks);
+    assert(blocked.visits.empty());
+
+    std::cout << "Walks on a lazy parallel composition" << std::endl;
+    std::set<StorageIndex> spec_marked_states = { 0, 1 };
+    cldes::DESystem<4u> spec{ 2, 0, spec_marked_states };
+    spec(0, 1) = b0;
+    spec(1, 0) = a1;
+
+    auto virtualsys = cldes::op::synchronizeStage1(plant, spec);
+    cldes::op::RandomWalkSimulator<decltype(virtualsys)> sync_simulator{
+        virtualsys
+    };
+    sync_simulator.trackVisits(true);
+    auto const sync_stats = sync_simulator.run(walks, steps);
+    CheckConsistency(sync_stats, walks);
+    assert(sync_stats.visits.size() == 8ul);
+
+    return 0;
+}
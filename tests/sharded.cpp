@@ -0,0 +1,171 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: tests/sharded.cpp
+ Description: Test sharded explorations on local worker processes.
+ =========================================================================
+*/
+
+
+
+#include "cldes/DESystem.hpp"
+#include "cldes/backend/Executor.hpp"
+#include "cldes/operations/Expression.hpp"
+#include "cldes/operations/Operations.hpp"
+#include "cldes/operations/Sharded.hpp"
+#include "clustertool.hpp"
+#include "testlib.hpp"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using StorageIndex = unsigned;
+
+int
+main()
+{
+    cldes::ScalarType const a0 = 0;
+    cldes::ScalarType const a1 = 1;
+    cldes::ScalarType const b0 = 2;
+    cldes::ScalarType const b1 = 3;
+
+    cldes::DESystem<4u>::EventsTable non_contr;
+    non_contr.insert(b0);
+    non_contr.insert(b1);
+
+    std::set<StorageIndex> plant_marked_states = { 0 };
+
+    cldes::DESystem<4u> plant{ 4, 0, plant_marked_states };
+
+    plant(0, 1) = a0;
+    plant(0, 2) = a1;
+    plant(1, 0) = b0;
+    plant(1, 3) = a1;
+    plant(2, 0) = b1;
+    plant(2, 3) = a0;
+    plant(3, 1) = b1;
+    plant(3, 2) = b0;
+
+    std::set<StorageIndex> spec_marked_states = { 0, 1 };
+
+    cldes::DESystem<4u> spec{ 2, 0, spec_marked_states };
+
+    spec(0, 1) = b0;
+    spec(1, 0) = a1;
+
+    std::ostringstream expected_result;
+
+    expected_result << "0 1 0 0 0 0 " << std::endl;
+    expected_result << "0 0 0 0 4 0 " << std::endl;
+    expected_result << "8 0 0 1 0 0 " << std::endl;
+    expected_result << "0 8 0 0 0 4 " << std::endl;
+    expected_result << "0 0 2 0 0 0 " << std::endl;
+    expected_result << "0 0 0 0 8 0 " << std::endl;
+    expected_result << ">" << std::endl;
+
+    std::cout << "Sharded supervisor synthesis" << std::endl;
+    cldes::op::ShardOptions options;
+    options.shards = 3ul;
+    cldes::op::ShardStats stats;
+    auto const supervisor =
+      cldes::op::shardedSupC(plant, spec, non_contr, options, &stats);
+    ProcessResult(supervisor.getGraph(), "< Sync graph",
+                  expected_result.str().c_str());
+    assert(supervisor.getMarkedStates() ==
+           cldes::op::supC(plant, spec, non_contr).getMarkedStates());
+    assert(stats.workers.size() == 3ul);
+    assert(stats.states() == 8ul);
+
+    std::cout << "Sharded synchronization" << std::endl;
+    auto const accessible = cldes::op::evaluate(cldes::op::synchronize(
+      cldes::op::lazy(plant), cldes::op::lazy(spec)));
+    auto const sharded_sync =
+      cldes::op::shardedSynchronize(plant, spec, options);
+    assert(ReadResult(sharded_sync.getGraph(), "< Sync graph") ==
+           ReadResult(accessible.getGraph(), "< Sync graph"));
+    assert(sharded_sync.getMarkedStates() == accessible.getMarkedStates());
+
+    std::cout << "Sharded ClusterTool(2) supervisor" << std::endl;
+    std::vector<cldes::DESystem<16>> plants;
+    std::vector<cldes::DESystem<16>> specs;
+    cldes::DESystem<16>::EventsTable ct_non_contr;
+    ClusterTool(2, plants, specs, ct_non_contr);
+
+    auto ct_plant = plants[0];
+    for (auto i = 1ul; i < plants.size(); ++i) {
+        ct_plant = cldes::op::synchronize(ct_plant, plants[i]);
+    }
+    auto ct_spec = specs[0];
+    for (auto i = 1ul; i < specs.size(); ++i) {
+        ct_spec = cldes::op::synchronize(ct_spec, specs[i]);
+    }
+    auto const eager_ct = cldes::op::supC(ct_plant, ct_spec, ct_non_contr);
+
+    for (auto shards : { 1ul, 4ul }) {
+        options.shards = shards;
+        options.batch_states = 8ul;
+        auto const sharded_ct = cldes::op::shardedSupC(
+          ct_plant, ct_spec, ct_non_contr, options, &stats);
+        std::cout << shards << " shards: " << sharded_ct.size()
+                  << " states, " << sharded_ct.getGraph().nonZeros()
+                  << " transitions, " << stats.states()
+                  << " explored states, " << stats.tableBytes()
+                  << " table bytes, " << stats.supersteps << " supersteps"
+                  << std::endl;
+        assert(sharded_ct.size() == eager_ct.size());
+        assert(sharded_ct.getGraph().nonZeros() ==
+               eager_ct.getGraph().nonZeros());
+        assert(sharded_ct.getMarkedStates().size() ==
+               eager_ct.getMarkedStates().size());
+        for (auto const& worker : stats.workers) {
+            assert(worker.states > 0ul);
+            assert(worker.max_rss_bytes > 0ul);
+        }
+        assert(stats.tableBytes() > 0ul);
+    }
+
+    std::cout << "Sharded supC with a thread pool running" << std::endl;
+    options.shards = 2ul;
+    {
+        cldes::backend::ExecutorOptions pool_options;
+        pool_options.threads = 3u;
+        pool_options.grain = 1u;
+        cldes::backend::ThreadPoolExecutor pool{ pool_options };
+        cldes::backend::ScopedExecutor const pool_scope{ pool };
+        // Starts the workers of the default pool too, if there are any
+        cldes::backend::defaultExecutor();
+        auto const with_pool =
+          cldes::op::shardedSupC(plant, spec, non_contr, options);
+        assert(with_pool == supervisor);
+        // The workers are back
+        assert(pool.concurrency() == 4u);
+        assert(cldes::op::supC(plant, spec, non_contr) == supervisor);
+    }
+
+    std::cout << "Finishing test" << std::endl;
+
+    return 0;
+}
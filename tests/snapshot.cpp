@@ -0,0 +1,124 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: tests/snapshot.cpp
+ Description: Test cldes::DESystemSnapshot, the immutable system shared
+ by concurrent queries.
+ =========================================================================
+*/
+
+
+#include "cldes/DESystem.hpp"
+#include "cldes/DESystemSnapshot.hpp"
+#include "cldes/operations/Operations.hpp"
+#include "testlib.hpp"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+int
+main()
+{
+    using StorageIndex = unsigned;
+
+    cldes::ScalarType const a0 = 0;
+    cldes::ScalarType const a1 = 1;
+    cldes::ScalarType const b0 = 2;
+    cldes::ScalarType const b1 = 3;
+
+    cldes::DESystem<4u>::EventsTable non_contr;
+    non_contr.insert(b0);
+    non_contr.insert(b1);
+
+    std::set<StorageIndex> plant_marked_states = { 0 };
+
+    cldes::DESystem<4u> plant{ 4, 0, plant_marked_states };
+
+    plant(0, 1) = a0;
+    plant(0, 2) = a1;
+    plant(1, 0) = b0;
+    plant(1, 3) = a1;
+    plant(2, 0) = b1;
+    plant(2, 3) = a0;
+    plant(3, 1) = b1;
+    plant(3, 2) = b0;
+
+    std::set<StorageIndex> spec_marked_states = { 0, 1 };
+
+    cldes::DESystem<4u> spec{ 2, 0, spec_marked_states };
+
+    spec(0, 1) = b0;
+    spec(1, 0) = a1;
+
+    auto const splant = cldes::makeSnapshot(plant);
+    auto const sspec = cldes::makeSnapshot(spec);
+
+    std::cout << "Comparing snapshot and system transitions" << std::endl;
+    plant.allocateInvertedGraph();
+    for (StorageIndex q = 0; q < plant.size(); ++q) {
+        assert(splant.getStateEvents(q) == plant.getStateEvents(q));
+        assert(splant.getInvStateEvents(q) == plant.getInvStateEvents(q));
+        for (cldes::ScalarType e = 0; e < 4; ++e) {
+            assert(splant.containstrans(q, e) == plant.containstrans(q, e));
+            assert(splant.trans(q, e) == plant.trans(q, e));
+            assert(splant.invtrans(q, e) == plant.invtrans(q, e));
+        }
+    }
+    plant.clearInvertedGraph();
+    ProcessResult(splant.invtrans(0, b1), "< Inverse transition (0, b1)",
+                  "2 >");
+
+    std::ostringstream expected_result;
+
+    expected_result << "0 1 0 0 0 0 " << std::endl;
+    expected_result << "0 0 0 0 4 0 " << std::endl;
+    expected_result << "8 0 0 1 0 0 " << std::endl;
+    expected_result << "0 8 0 0 0 4 " << std::endl;
+    expected_result << "0 0 2 0 0 0 " << std::endl;
+    expected_result << "0 0 0 0 8 0 " << std::endl;
+    expected_result << ">" << std::endl;
+
+    std::cout << "Concurrent supervisor synthesis sharing snapshots"
+              << std::endl;
+    unsigned const n_threads = 4u;
+    std::vector<cldes::DESystem<4u>> supervisors(n_threads);
+    std::vector<std::thread> workers;
+    for (auto t = 0u; t < n_threads; ++t) {
+        workers.emplace_back([&splant, &sspec, &non_contr, &supervisors, t]() {
+            supervisors[t] = cldes::op::supC(splant, sspec, non_contr);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (auto const& supervisor : supervisors) {
+        ProcessResult(
+          supervisor.getGraph(), "< Sync graph", expected_result.str().c_str());
+    }
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: tests/state_estimator.cpp
+ Description: Test cldes::op::StateEstimator, the online current-state
+ estimator.
+ =========================================================================
+*/
+
+#include "cldes/DESystem.hpp"
+#include "cldes/operations/Operations.hpp"
+#include "cldes/operations/StateEstimator.hpp"
+#include "testlib.hpp"
+#include <iostream>
+#include <string>
+
+int
+main()
+{
+    using StorageIndex = unsigned;
+
+    cldes::ScalarType const a0 = 0;
+    cldes::ScalarType const a1 = 1;
+    cldes::ScalarType const b0 = 2;
+    cldes::ScalarType const b1 = 3;
+
+    std::set<StorageIndex> plant_marked_states = { 0 };
+
+    cldes::DESystem<4u> plant{ 4, 0, plant_marked_states };
+
+    plant(0, 1) = a0;
+    plant(0, 2) = a1;
+    plant(1, 0) = b0;
+    plant(1, 3) = a1;
+    plant(2, 0) = b1;
+    plant(2, 3) = a0;
+    plant(3, 1) = b1;
+    plant(3, 2) = b0;
+
+    cldes::EventsSet<4u> unobservable;
+    unobservable.set(b0);
+
+    cldes::op::StateEstimator<cldes::DESystem<4u>> estimator{ plant,
+                                                             unobservable };
+
+    ProcessResult(estimator.getEstimate(), "< Initial estimate", "0 >");
+
+    assert(estimator.update(a0));
+    ProcessResult(estimator.getEstimate(), "< Estimate after a0", "0 1 >");
+
+    assert(estimator.update(a1));
+    ProcessResult(estimator.getEstimate(), "< Estimate after a1", "2 3 >");
+
+    assert(estimator.update(b1));
+    ProcessResult(estimator.getEstimate(), "< Estimate after b1", "0 1 >");
+
+    assert(estimator.update(a0));
+    ProcessResult(estimator.getEstimate(), "< Estimate after a0", "0 1 >");
+    assert(estimator.contains(1));
+    assert(!estimator.contains(2));
+    assert(estimator.cacheHits() == 1ul);
+
+    assert(!estimator.update(b1));
+    ProcessResult(estimator.getEstimate(), "< Estimate after b1", ">");
+
+    estimator.reset();
+    ProcessResult(estimator.getEstimate(), "< Estimate after reset", "0 >");
+
+    std::cout << "Estimating a lazy parallel composition" << std::endl;
+
+    std::set<StorageIndex> spec_marked_states = { 0, 1 };
+    cldes::DESystem<4u> spec{ 2, 0, spec_marked_states };
+    spec(0, 1) = b0;
+    spec(1, 0) = a1;
+
+    auto virtualsys = cldes::op::synchronizeStage1(plant, spec);
+    cldes::op::StateEstimator<decltype(virtualsys)> sync_estimator{
+        virtualsys, unobservable
+    };
+
+    ProcessResult(sync_estimator.getEstimate(), "< Initial estimate", "0 >");
+
+    assert(sync_estimator.update(a0));
+    ProcessResult(
+      sync_estimator.getEstimate(), "< Estimate after a0", "1 4 >");
+
+    assert(sync_estimator.update(a1));
+    ProcessResult(sync_estimator.getEstimate(), "< Estimate after a1", "2 >");
+
+    return 0;
+}
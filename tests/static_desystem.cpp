@@ -0,0 +1,169 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: tests/static_desystem.cpp
+ Description: Test cldes::StaticDESystem, the compile-time automata, and
+ its use as a proxy component.
+ =========================================================================
+*/
+
+
+#include "cldes/DESystem.hpp"
+#include "cldes/StaticDESystem.hpp"
+#include "cldes/operations/Operations.hpp"
+#include "testlib.hpp"
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+int
+main()
+{
+    using StorageIndex = unsigned;
+
+    cldes::ScalarType constexpr a0 = 0;
+    cldes::ScalarType constexpr a1 = 1;
+    cldes::ScalarType constexpr b0 = 2;
+    cldes::ScalarType constexpr b1 = 3;
+
+    cldes::DESystem<4u>::EventsTable non_contr;
+    non_contr.insert(b0);
+    non_contr.insert(b1);
+
+    std::set<StorageIndex> plant_marked_states = { 0 };
+
+    cldes::DESystem<4u> plant{ 4, 0, plant_marked_states };
+
+    plant(0, 1) = a0;
+    plant(0, 2) = a1;
+    plant(1, 0) = b0;
+    plant(1, 3) = a1;
+    plant(2, 0) = b1;
+    plant(2, 3) = a0;
+    plant(3, 1) = b1;
+    plant(3, 2) = b0;
+
+    using StaticPlant = cldes::StaticDESystem<4, 4u, StorageIndex>;
+    constexpr StaticPlant static_plant{ 0,
+                                        { 0 },
+                                        { { 0, a0, 1 },
+                                          { 0, a1, 2 },
+                                          { 1, b0, 0 },
+                                          { 1, a1, 3 },
+                                          { 2, b1, 0 },
+                                          { 2, a0, 3 },
+                                          { 3, b1, 1 },
+                                          { 3, b0, 2 } } };
+
+    // Queries on constexpr systems are constant expressions
+    static_assert(static_plant.trans(0, a0) == 1, "trans(0, a0)");
+    static_assert(static_plant.trans(1, a0) == -1, "trans(1, a0)");
+    static_assert(static_plant.containstrans(3, b1), "containstrans(3, b1)");
+    constexpr auto q0_events = static_plant.getStateEvents(0);
+    static_assert(q0_events[a0] && q0_events[a1] && !q0_events[b0],
+                  "getStateEvents(0)");
+    constexpr auto q0_inv_events = static_plant.getInvStateEvents(0);
+    static_assert(q0_inv_events[b1] && !q0_inv_events[a0],
+                  "getInvStateEvents(0)");
+    static_assert(static_plant.getTransNumber() == 8ul, "getTransNumber()");
+    static_assert(static_plant.isMarked(0) && !static_plant.isMarked(1),
+                  "isMarked()");
+
+    std::cout << "Comparing static and dynamic systems" << std::endl;
+    plant.allocateInvertedGraph();
+    assert(static_plant.getEvents() == plant.getEvents());
+    assert(static_plant.getMarkedStates() == plant.getMarkedStates());
+    for (StorageIndex q = 0; q < plant.size(); ++q) {
+        assert(static_plant.getStateEvents(q) == plant.getStateEvents(q));
+        assert(static_plant.getInvStateEvents(q) ==
+               plant.getInvStateEvents(q));
+        for (cldes::ScalarType e = 0; e < 4; ++e) {
+            assert(static_plant.containstrans(q, e) ==
+                   plant.containstrans(q, e));
+            assert(static_plant.trans(q, e) == plant.trans(q, e));
+            assert(static_plant.invtrans(q, e) == plant.invtrans(q, e));
+        }
+    }
+    plant.clearInvertedGraph();
+
+    std::set<StorageIndex> spec_marked_states = { 0, 1 };
+
+    cldes::DESystem<4u> spec{ 2, 0, spec_marked_states };
+
+    spec(0, 1) = b0;
+    spec(1, 0) = a1;
+
+    using StaticSpec = cldes::StaticDESystem<2, 4u, StorageIndex>;
+    constexpr StaticSpec static_spec{ 0, { 0, 1 }, { { 0, b0, 1 },
+                                                     { 1, a1, 0 } } };
+
+    std::cout << "Repeated and nondeterministic transitions" << std::endl;
+    constexpr StaticSpec repeated{
+        0, { 0 }, { { 0, b0, 1 }, { 0, b0, 1 }, { 1, a1, 0 } }
+    };
+    static_assert(repeated.getTransNumber() == 2ul, "getTransNumber()");
+    auto thrown = false;
+    try {
+        StaticSpec const nondeterministic{ 0, { 0 }, { { 0, b0, 1 },
+                                                       { 0, b0, 0 } } };
+        (void)nondeterministic;
+    } catch (std::invalid_argument const&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "Synchronizing a system with a static component"
+              << std::endl;
+    auto const sync = cldes::op::synchronize(plant, spec);
+    auto const static_sync = cldes::op::synchronize(plant, static_spec);
+    assert(static_sync.getGraph().nonZeros() == sync.getGraph().nonZeros());
+    ProcessResult(static_sync.getGraph(),
+                  "< Sync graph",
+                  ReadResult(sync.getGraph(), "< Sync graph").c_str());
+
+    std::ostringstream expected_result;
+
+    expected_result << "0 1 0 0 0 0 " << std::endl;
+    expected_result << "0 0 0 0 4 0 " << std::endl;
+    expected_result << "8 0 0 1 0 0 " << std::endl;
+    expected_result << "0 8 0 0 0 4 " << std::endl;
+    expected_result << "0 0 2 0 0 0 " << std::endl;
+    expected_result << "0 0 0 0 8 0 " << std::endl;
+    expected_result << ">" << std::endl;
+
+    std::cout << "Supervisor synthesis with static components" << std::endl;
+    auto const supervisor = cldes::op::supC(plant, static_spec, non_contr);
+    ProcessResult(
+      supervisor.getGraph(), "< Sync graph", expected_result.str().c_str());
+
+    auto const static_supervisor =
+      cldes::op::supC(static_plant, static_spec, non_contr);
+    ProcessResult(static_supervisor.getGraph(),
+                  "< Sync graph",
+                  expected_result.str().c_str());
+
+    return 0;
+}
@@ -35,6 +35,7 @@
 #include <sstream>
 #include <string>
 
+#include "cldes/operations/Expression.hpp"
 #include "cldes/operations/Operations.hpp"
 #include "testlib.hpp"
 
@@ -104,6 +105,25 @@ main()
     expected_result << ">" << std::endl;
     ProcessResult(
       supervisor.getGraph(), "< Sync graph", expected_result.str().c_str());
+
+    // Marked states are states of the supervisor, not of the product: the
+    // product state (3, 1) has index 7
+    std::cout << "Marked states of the supervisor" << std::endl;
+    auto marked_plant = plant;
+    marked_plant.insertMarkedState(3);
+    auto const marked_supervisor =
+      cldes::op::supC(marked_plant, spec, non_contr);
+    for (auto q : marked_supervisor.getMarkedStates()) {
+        std::cout << q << " ";
+        assert(q < marked_supervisor.size());
+    }
+    std::cout << std::endl;
+    // Same supremal supervisor as the fused synthesis
+    auto const fused = cldes::op::evaluate(cldes::op::supC(
+      cldes::op::lazy(marked_plant), cldes::op::lazy(spec), non_contr));
+    assert(marked_supervisor == fused);
+    assert(marked_supervisor.getMarkedStates() ==
+           (std::set<StorageIndex>{ 0, 3, 4 }));
     std::cout << "synchronize time: " << duration << " microseconds"
               << std::endl;
 
@@ -0,0 +1,137 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: tests/trace.cpp
+ Description: Chrome trace of the phases of the operations.
+ =========================================================================
+*/
+
+
+#include "cldes/DESystem.hpp"
+#include "cldes/Trace.hpp"
+#include "cldes/backend/Executor.hpp"
+#include "cldes/operations/Operations.hpp"
+#include "testlib.hpp"
+#include <iostream>
+#include <sstream>
+#include <string>
+
+static std::size_t
+Count(std::string const& aText, std::string const& aPattern)
+{
+    auto count = 0ul;
+    for (auto pos = aText.find(aPattern); pos != std::string::npos;
+         pos = aText.find(aPattern, pos + 1ul)) {
+        ++count;
+    }
+    return count;
+}
+
+int
+main()
+{
+    using StorageIndex = unsigned;
+
+    cldes::ScalarType const a0 = 0;
+    cldes::ScalarType const a1 = 1;
+    cldes::ScalarType const b0 = 2;
+    cldes::ScalarType const b1 = 3;
+
+    cldes::DESystem<4u>::EventsTable non_contr;
+    non_contr.insert(b0);
+    non_contr.insert(b1);
+
+    std::set<StorageIndex> plant_marked_states = { 0 };
+    cldes::DESystem<4u> plant{ 4, 0, plant_marked_states };
+    plant(0, 1) = a0;
+    plant(0, 2) = a1;
+    plant(1, 0) = b0;
+    plant(1, 3) = a1;
+    plant(2, 0) = b1;
+    plant(2, 3) = a0;
+    plant(3, 1) = b1;
+    plant(3, 2) = b0;
+
+    std::set<StorageIndex> spec_marked_states = { 0, 1 };
+    cldes::DESystem<4u> spec{ 2, 0, spec_marked_states };
+    spec(0, 1) = b0;
+    spec(1, 0) = a1;
+
+    cldes::backend::ExecutorOptions options;
+    options.threads = 3u;
+    options.grain = 1u;
+    cldes::backend::ThreadPoolExecutor pool{ options };
+
+    std::cout << "Nothing is recorded after the session stops" << std::endl;
+    cldes::TraceSession stopped;
+    stopped.stop();
+    cldes::op::supC(plant, spec, non_contr, pool);
+    assert(stopped.size() == 0ul);
+
+    std::cout << "Phases and ranges are recorded" << std::endl;
+    cldes::TraceSession trace;
+    auto product = cldes::op::synchronize(plant, spec, pool);
+    auto const supervisor = cldes::op::supC(plant, spec, non_contr, pool);
+    product.trim();
+    trace.stop();
+    assert(supervisor.size() > 0u);
+    // Spans end on noexcept functions: they never throw
+    static_assert(noexcept(trace.record_("span", 0l, 0l)),
+                  "TraceSession::record_ must be noexcept");
+    assert(trace.dropped() == 0ul);
+    // Nothing else after stop()
+    auto const size = trace.size();
+    cldes::op::supC(plant, spec, non_contr, pool);
+    assert(trace.size() == size);
+
+    std::ostringstream out;
+    trace.write(out);
+    auto const json = out.str();
+    std::cout << json.substr(0ul, 400ul) << "..." << std::endl;
+    std::cout << Count(json, "\"ph\": \"M\"") << " thread(s)" << std::endl;
+
+    assert(json.find("{\"traceEvents\": [") == 0ul);
+    assert(json.find("\"displayTimeUnit\": \"ms\"}") != std::string::npos);
+    assert(Count(json, "\"ph\": \"X\"") == size);
+    for (auto const name : { "\"synchronize\"",
+                             "\"synchronize.stage2\"",
+                             "\"synchronize.stage2.range\"",
+                             "\"synchronize.setFromTriplets\"",
+                             "\"supC\"",
+                             "\"supC.findRemovedStates\"",
+                             "\"supC.trim\"",
+                             "\"supC.materialize\"",
+                             "\"supC.materialize.range\"",
+                             "\"trim\"",
+                             "\"bfs\"" }) {
+        assert(json.find(name) != std::string::npos);
+    }
+    // The calling thread and at least one worker got a buffer
+    assert(Count(json, "\"ph\": \"M\"") >= 1ul);
+    assert(json.find("\"ts\": -") == std::string::npos);
+    assert(json.find("\"dur\": -") == std::string::npos);
+
+    return 0;
+}
@@ -0,0 +1,196 @@
+/*
+ =========================================================================
+ This file is part of clDES
+
+ clDES: an OpenCL library for Discrete Event Systems computing.
+
+ clDES is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ clDES is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with clDES.  If not, see <http://www.gnu.org/licenses/>.
+
+ Copyright (c) 2018 - Adriano Mourao <adrianomourao@protonmail.com>
+                      madc0ww @ [https://github.com/madc0ww]
+
+ LacSED - Laboratorio de Analise e Controle de Sistemas a Eventos Discretos
+ Universidade Federal de Minas Gerais
+
+ File: tests/visitors.cpp
+ Description: Test successor and predecessor visitors against the
+ transition functions on concrete systems and proxies.
+ =========================================================================
+*/
+
+
+
+#include "cldes/DESystem.hpp"
+#include "cldes/DESystemSnapshot.hpp"
+#include "cldes/GenericSystem.hpp"
+#include "cldes/StaticDESystem.hpp"
+#include "cldes/operations/Operations.hpp"
+#include "cldes/operations/SuperProxy.hpp"
+#include "testlib.hpp"
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+using StorageIndex = unsigned;
+using Transitions = std::vector<std::pair<cldes::ScalarType, StorageIndex>>;
+
+cldes::EventsSet<4u> const kAllEvents{ 0xful };
+
+template<class SysT>
+Transitions
+successors(SysT const& aSys, StorageIndex const aQ)
+{
+    Transitions transitions;
+    aSys.forEachSuccessor(
+      aQ, [&transitions](cldes::ScalarType const aEvent, StorageIndex aQto) {
+          transitions.emplace_back(aEvent, aQto);
+      });
+    std::sort(transitions.begin(), transitions.end());
+    return transitions;
+}
+
+template<class SysT>
+Transitions
+predecessors(SysT const& aSys,
+             StorageIndex const aQ,
+             cldes::EventsSet<4u> const& aEvents)
+{
+    Transitions transitions;
+    aSys.forEachPredecessor(
+      aQ,
+      aEvents,
+      [&transitions](cldes::ScalarType const aEvent, StorageIndex aQfrom) {
+          transitions.emplace_back(aEvent, aQfrom);
+      });
+    std::sort(transitions.begin(), transitions.end());
+    return transitions;
+}
+
+template<class SysT>
+void
+checkVisitors(SysT const& aSys, StorageIndex const aStatesNumber)
+{
+    aSys.allocateInvertedGraph();
+    for (StorageIndex q = 0; q < aStatesNumber; ++q) {
+        Transitions expected_succ;
+        Transitions expected_pred;
+        Transitions expected_masked;
+        for (cldes::ScalarType e = 0; e < 4; ++e) {
+            auto const qto = aSys.trans(q, e);
+            if (qto >= 0) {
+                expected_succ.emplace_back(e, static_cast<StorageIndex>(qto));
+            }
+            for (auto qfrom : aSys.invtrans(q, e)) {
+                expected_pred.emplace_back(e, qfrom);
+                if (e % 2 == 1) {
+                    expected_masked.emplace_back(e, qfrom);
+                }
+            }
+        }
+        std::sort(expected_pred.begin(), expected_pred.end());
+        std::sort(expected_masked.begin(), expected_masked.end());
+        assert(successors(aSys, q) == expected_succ);
+        assert(predecessors(aSys, q, kAllEvents) == expected_pred);
+        assert(predecessors(aSys, q, cldes::EventsSet<4u>{ 0xaul }) ==
+               expected_masked);
+    }
+    aSys.clearInvertedGraph();
+}
+
+int
+main()
+{
+    cldes::ScalarType const a0 = 0;
+    cldes::ScalarType const a1 = 1;
+    cldes::ScalarType const b0 = 2;
+    cldes::ScalarType const b1 = 3;
+
+    cldes::DESystem<4u>::EventsTable non_contr;
+    non_contr.insert(b0);
+    non_contr.insert(b1);
+
+    std::set<StorageIndex> plant_marked_states = { 0 };
+
+    cldes::DESystem<4u> plant{ 4, 0, plant_marked_states };
+
+    plant(0, 1) = a0;
+    plant(0, 2) = a1;
+    plant(1, 0) = b0;
+    plant(1, 3) = a1;
+    plant(2, 0) = b1;
+    plant(2, 3) = a0;
+    plant(3, 1) = b1;
+    plant(3, 2) = b0;
+
+    std::set<StorageIndex> spec_marked_states = { 0, 1 };
+
+    cldes::DESystem<4u> spec{ 2, 0, spec_marked_states };
+
+    spec(0, 1) = b0;
+    spec(1, 0) = a1;
+
+    std::cout << "Visitors on a concrete system" << std::endl;
+    checkVisitors(plant, plant.size());
+    plant.allocateInvertedGraph();
+    std::vector<StorageIndex> pred_states;
+    plant.forEachPredecessor(
+      3, kAllEvents, [&pred_states](cldes::ScalarType, StorageIndex aQfrom) {
+          pred_states.push_back(aQfrom);
+      });
+    plant.clearInvertedGraph();
+    ProcessResult(pred_states, "< Predecessors of 3", "1 2 >");
+
+    std::cout << "Visitors on a snapshot" << std::endl;
+    auto const splant = cldes::makeSnapshot(plant);
+    checkVisitors(splant, splant.size());
+
+    std::cout << "Visitors on a static system" << std::endl;
+    using StaticPlant = cldes::StaticDESystem<4, 4u, StorageIndex>;
+    StaticPlant const static_plant{ 0,
+                                    { 0 },
+                                    { { 0, a0, 1 },
+                                      { 0, a1, 2 },
+                                      { 1, b0, 0 },
+                                      { 1, a1, 3 },
+                                      { 2, b1, 0 },
+                                      { 2, a0, 3 },
+                                      { 3, b1, 1 },
+                                      { 3, b0, 2 } } };
+    checkVisitors(static_plant, 4u);
+
+    std::cout << "Visitors on a synchronous composition proxy" << std::endl;
+    cldes::op::SyncSysProxy<cldes::DESystem<4u>, cldes::DESystem<4u>> const
+      sync{ plant, spec };
+    checkVisitors(sync, sync.size());
+
+    std::cout << "Visitors on nested proxies" << std::endl;
+    cldes::op::SyncSysProxy<
+      cldes::op::SyncSysProxy<cldes::DESystem<4u>, cldes::DESystem<4u>>,
+      cldes::DESystem<4u>> const nested{ sync, spec };
+    checkVisitors(nested, nested.size());
+
+    std::cout << "Visitors on a supervisor proxy" << std::endl;
+    cldes::op::SuperProxy<cldes::DESystem<4u>, cldes::DESystem<4u>> const
+      supervisor{ plant, spec, non_contr };
+    checkVisitors(supervisor, plant.size() * spec.size());
+
+    std::cout << "Visitors on a type erased system" << std::endl;
+    cldes::GenericSystem<4u, StorageIndex> const generic{ plant };
+    checkVisitors(generic, plant.size());
+
+    std::cout << "Finishing test" << std::endl;
+
+    return 0;
+}